@@ -0,0 +1,603 @@
+// 샘플 처리 핫 루프 마이크로 벤치마크 (호스트, JSON 출력)
+//
+// 펌웨어 소스를 그대로 링크해 고정 입력(TYPE1 두 채널 인터리브: CH6 1 kHz 사인, CH7 250 Hz 사각 + 잡음)으로
+// 커널별 ns/sample과 samples/s를 재고, 커밋 사이 회귀를 비교할 수 있게 JSON 한 덩어리로 낸다.
+//   - deinterleave: adc_data_process_task의 adc_ring_write_interleaved (256바이트 DMA 프레임 단위,
+//     sample = 변환 워드 하나)
+//   - measure: adc_dma_get_statistics가 읽는 min/max/평균 누적 (measure_process의 meas_push, 채널당 프레임분)
+//   - compat_copy: get_adc_buffer 호환 버퍼 채우기 (최근 256개 스냅샷 + 채널별 adc_ring_view_copy)
+//   - raw_to_uv: 펌웨어 화면 측정 줄이 쓰는 adc_calib_uv 샘플 단위 표 조회 (256개씩, 블록 변환 adc_calib_convert와 비교)
+//   - draw_ui: 펌웨어 interactive_draw_frame 그대로 (스코프 조작 화면: 정적 부분 캐시 append, 상태/측정 글씨,
+//     두 채널 250열 waveform_draw). 화면이 읽는 hardware_test/adc_dma 값(표시 열, 시간축, 측정 결과)만
+//     고정 입력으로 대신한다. sample = 표시 열 하나. SPI는 명령 FIFO를 곧바로 비운 것으로 답하는 싱크에
+//     연결해 FT800 처리 시간은 빠짐
+// 각 커널은 먼저 결과를 기준 계산(또는 FT800 에뮬레이터)과 비교하고, 다르면 실패로 끝낸다.
+// 시간은 BENCH_REPEATS번 잰 것 중 가장 빠른 값 (다른 프로세스 영향 줄임). checksum은 커널 출력의 CRC라
+// 속도와 함께 결과가 바뀌었는지도 보인다.
+//
+//   bench [out.json]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "adc_ring.h"
+#include "measure.h"
+#include "adc_calib.h"
+#include "stream_frame.h"
+#include "ft800.h"
+#include "render_sched.h"
+#include "hardware_test.h"
+#include "interactive_test.h"
+#include "adc_dma_continuous.h"
+#include "ch423_service.h"
+#include "rotary_encoder.h"
+#include "sample_stream.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "driver/spi_master.h"
+#include "ft800_emu.h"
+
+// 펌웨어 adc_dma_continuous.c / hardware_test.c와 같은 값
+#define FRAME_WORDS         128             // ADC_BUFFER_SIZE 256바이트
+#define CHANNEL_HZ          10000
+#define MEAS_WINDOW         (CHANNEL_HZ / 5)
+#define RING_POINTS         4096            // ADC_RECORD_LENGTH_DEFAULT
+#define RING_GUARD          (FRAME_WORDS / 2)
+#define COMPAT_SIZE         256
+
+#define SIGNAL_WORDS        (1u << 16)
+#define SIGNAL_PAIRS        (SIGNAL_WORDS / 2)
+#define CALIB_BLOCK         256
+#define DRAW_FRAMES         16              // 돌려 쓰는 고정 열 세트 수
+
+#define BENCH_REPEATS       5
+#define BENCH_MIN_SEC       0.05            // 한 번 잴 때 최소 시간
+
+typedef struct {
+    const char *name;
+    const char *unit;
+    double ns_per_sample;
+    double samples_per_s;
+    double ns_per_call;
+    uint32_t samples_per_call;
+    uint32_t checksum;
+} bench_result_t;
+
+static uint16_t signal_words[SIGNAL_WORDS];
+static uint16_t signal_ch[2][SIGNAL_PAIRS];
+static uint16_t ring_mem[2][RING_POINTS];
+static adc_ring_t ring;
+static meas_t meas[2];
+static uint16_t compat[COMPAT_SIZE * 2];
+static int32_t uv_buf[SIGNAL_PAIRS];
+static decim_column_t draw_cols[DRAW_FRAMES][2][ADC_DISPLAY_COLUMNS];
+static volatile uint32_t sink;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 코프로세서가 명령을 바로 처리하므로 기다릴 것이 없음 (render_sched.c 대신)
+uint32_t render_sched_wait(uint32_t mask, uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return mask;
+}
+
+/*** 고정 입력 ********************************************************************/
+static void make_signal(void)
+{
+    uint32_t rng = 1;
+    for (uint32_t i = 0; i < SIGNAL_PAIRS; i++) {
+        double t = (double)i / CHANNEL_HZ;
+        rng = rng * 1103515245u + 12345u;
+        int noise = (int)((rng >> 16) % 9) - 4;
+        int v0 = 2048 + (int)lround(1500 * sin(2 * M_PI * 1000.0 * t)) + noise;
+        int v1 = (fmod(t * 250.0, 1.0) < 0.25 ? 3048 : 1048) - noise;
+        signal_ch[0][i] = (uint16_t)v0;
+        signal_ch[1][i] = (uint16_t)v1;
+        signal_words[2 * i] = (uint16_t)((6 << 12) | v0);
+        signal_words[2 * i + 1] = (uint16_t)((7 << 12) | v1);
+    }
+    for (int f = 0; f < DRAW_FRAMES; f++) {
+        for (int i = 0; i < ADC_DISPLAY_COLUMNS; i++) {
+            int c = 2048 + (int)(1500 * sin(2 * M_PI * (i + f * 3) / 83.0));
+            draw_cols[f][0][i].min = (uint16_t)(c - 40);
+            draw_cols[f][0][i].max = (uint16_t)(c + 40);
+            int level = ((i + f * 2) / 40) & 1 ? 3400 : 700;
+            draw_cols[f][1][i].min = (uint16_t)(level - (i * 7 + f) % 64);
+            draw_cols[f][1][i].max = (uint16_t)(level + (i * 5 + f) % 64);
+        }
+    }
+}
+
+/*** 시간 측정 ********************************************************************/
+typedef void (*kernel_fn)(uint32_t iter);
+
+// 가장 빠른 호출당 시간 (ns)
+static double time_kernel(kernel_fn fn)
+{
+    double best = 0;
+    uint32_t iter = 0;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        uint32_t calls = 0;
+        double t0 = now_sec(), t1;
+        do {
+            for (int k = 0; k < 16; k++) {
+                fn(iter++);
+            }
+            calls += 16;
+            t1 = now_sec();
+        } while (t1 - t0 < BENCH_MIN_SEC);
+        double ns = (t1 - t0) * 1e9 / calls;
+        best = (r == 0 || ns < best) ? ns : best;
+    }
+    return best;
+}
+
+static void fill_result(bench_result_t *res, const char *name, const char *unit, uint32_t samples_per_call,
+                        double ns_per_call, uint32_t checksum)
+{
+    res->name = name;
+    res->unit = unit;
+    res->samples_per_call = samples_per_call;
+    res->ns_per_call = ns_per_call;
+    res->ns_per_sample = ns_per_call / samples_per_call;
+    res->samples_per_s = 1e9 / res->ns_per_sample;
+    res->checksum = checksum;
+}
+
+/*** deinterleave *****************************************************************/
+static void kernel_deinterleave(uint32_t iter)
+{
+    uint32_t off = (iter * FRAME_WORDS) % SIGNAL_WORDS;
+    adc_ring_write_interleaved(&ring, signal_words + off, FRAME_WORDS);
+}
+
+static int bench_deinterleave(bench_result_t *res)
+{
+    adc_ring_init(&ring, ring_mem[0], ring_mem[1], RING_POINTS, RING_GUARD);
+    for (uint32_t i = 0; i < SIGNAL_WORDS / FRAME_WORDS; i++) {
+        kernel_deinterleave(i);
+    }
+    // 링에는 마지막 RING_POINTS 쌍이 12비트로 들어 있어야 함
+    adc_ring_view_t view;
+    if (!adc_ring_snapshot(&ring, RING_POINTS - RING_GUARD, &view)) {
+        fprintf(stderr, "deinterleave: empty ring MISMATCH\n");
+        return 1;
+    }
+    uint32_t first = SIGNAL_PAIRS - view.count;
+    uint32_t crc = 0;
+    for (int ch = 0; ch < 2; ch++) {
+        for (uint32_t i = 0; i < view.count; i++) {
+            uint16_t v = adc_ring_view_at(&view, ch, i);
+            if (v != (signal_ch[ch][first + i] & ADC_RING_SAMPLE_MASK)) {
+                fprintf(stderr, "deinterleave: ch%d sample %u MISMATCH\n", ch, i);
+                return 1;
+            }
+            crc = stream_crc32(crc, &v, sizeof(v));
+        }
+    }
+    fill_result(res, "deinterleave", "conversion", FRAME_WORDS, time_kernel(kernel_deinterleave), crc);
+    return 0;
+}
+
+/*** measure **********************************************************************/
+static void kernel_measure(uint32_t iter)
+{
+    uint32_t off = (iter * (FRAME_WORDS / 2)) % SIGNAL_PAIRS;
+    meas_push(&meas[0], signal_ch[0] + off, FRAME_WORDS / 2);
+    meas_push(&meas[1], signal_ch[1] + off, FRAME_WORDS / 2);
+}
+
+static int bench_measure(bench_result_t *res)
+{
+    int failures = 0;
+    uint32_t crc = 0;
+    for (int ch = 0; ch < 2; ch++) {
+        meas_init(&meas[ch], MEAS_WINDOW, CHANNEL_HZ);
+    }
+    for (uint32_t i = 0; i < SIGNAL_PAIRS / (FRAME_WORDS / 2); i++) {
+        kernel_measure(i);
+    }
+    // 마지막으로 끝난 창을 직접 계산한 값과 비교
+    uint32_t windows = SIGNAL_PAIRS / MEAS_WINDOW;
+    uint32_t start = (windows - 1) * MEAS_WINDOW;
+    for (int ch = 0; ch < 2; ch++) {
+        meas_result_t r;
+        uint32_t lo = 4095, hi = 0;
+        uint64_t sum = 0;
+        for (uint32_t i = start; i < start + MEAS_WINDOW; i++) {
+            uint16_t v = signal_ch[ch][i];
+            lo = v < lo ? v : lo;
+            hi = v > hi ? v : hi;
+            sum += v;
+        }
+        double mean = (double)sum / MEAS_WINDOW;
+        if (!meas_read(&meas[ch], &r) || r.index != windows - 1 || r.min != lo || r.max != hi ||
+            fabs(r.mean - mean) > 0.01) {
+            fprintf(stderr, "measure: ch%d window %u min/max/mean MISMATCH\n", ch, windows - 1);
+            failures++;
+            continue;
+        }
+        uint32_t fields[4] = { r.index, r.min, r.max, (uint32_t)lround(r.mean * 100) };
+        crc = stream_crc32(crc, fields, sizeof(fields));
+    }
+    fill_result(res, "measure", "sample", FRAME_WORDS, time_kernel(kernel_measure), crc);
+    return failures;
+}
+
+/*** compat_copy ******************************************************************/
+static void kernel_compat_copy(uint32_t iter)
+{
+    (void)iter;
+    adc_ring_view_t view;
+    if (adc_ring_snapshot(&ring, COMPAT_SIZE, &view)) {
+        uint32_t count = adc_ring_view_copy(&view, 0, compat, COMPAT_SIZE);
+        adc_ring_view_copy(&view, 1, compat + COMPAT_SIZE, COMPAT_SIZE);
+        if (adc_ring_view_valid(&view)) {
+            sink += compat[count - 1];
+        }
+    }
+}
+
+static int bench_compat_copy(bench_result_t *res)
+{
+    // deinterleave 시간 측정이 신호 중간에서 멈췄을 수 있으므로 신호 전체를 다시 넣음
+    adc_ring_reset(&ring);
+    for (uint32_t i = 0; i < SIGNAL_WORDS / FRAME_WORDS; i++) {
+        kernel_deinterleave(i);
+    }
+    kernel_compat_copy(0);
+    for (int ch = 0; ch < 2; ch++) {
+        const uint16_t *expect = signal_ch[ch] + SIGNAL_PAIRS - COMPAT_SIZE;
+        if (memcmp(compat + ch * COMPAT_SIZE, expect, sizeof(uint16_t) * COMPAT_SIZE) != 0) {
+            fprintf(stderr, "compat_copy: ch%d MISMATCH\n", ch);
+            return 1;
+        }
+    }
+    uint32_t crc = stream_crc32(0, compat, sizeof(compat));
+    fill_result(res, "compat_copy", "sample", COMPAT_SIZE * 2, time_kernel(kernel_compat_copy), crc);
+    return 0;
+}
+
+/*** raw_to_uv ********************************************************************/
+// 펌웨어가 쓰는 샘플 단위 조회 (format_measurement의 adc_calib_uv)
+static void kernel_raw_to_uv(uint32_t iter)
+{
+    uint32_t off = (iter * CALIB_BLOCK) % SIGNAL_PAIRS;
+    for (uint32_t i = off; i < off + CALIB_BLOCK; i++) {
+        uv_buf[i] = adc_calib_uv(0, signal_ch[0][i]);
+    }
+}
+
+static int bench_raw_to_uv(bench_result_t *res)
+{
+    // bench_adc_calib과 같은 두 점, 1/91.9 + 1/5 감쇠 DC
+    adc_calib_init(256, 230000, 3840, 3020000);
+    adc_front_end_t fe = { 1, 2, 2 };
+    adc_calib_set_front_end(0, &fe);
+    for (uint32_t i = 0; i < SIGNAL_PAIRS / CALIB_BLOCK; i++) {
+        kernel_raw_to_uv(i);
+    }
+    // 블록 변환(adc_calib_convert)과 같은 값이어야 함
+    static int32_t ref[CALIB_BLOCK];
+    for (uint32_t off = 0; off < SIGNAL_PAIRS; off += CALIB_BLOCK) {
+        adc_calib_convert(0, signal_ch[0] + off, ref, CALIB_BLOCK);
+        if (memcmp(ref, uv_buf + off, sizeof(ref)) != 0) {
+            fprintf(stderr, "raw_to_uv: block at %u MISMATCH\n", off);
+            return 1;
+        }
+    }
+    uint32_t crc = stream_crc32(0, uv_buf, sizeof(uv_buf));
+    fill_result(res, "raw_to_uv", "sample", CALIB_BLOCK, time_kernel(kernel_raw_to_uv), crc);
+    return 0;
+}
+
+/*** draw_ui **********************************************************************/
+// SPI 대상: 에뮬레이터 또는 싱크. 싱크는 쓰기를 버리고 REG_CMD_READ를 마지막 REG_CMD_WRITE로 답함
+static bool spi_to_sink;
+static uint32_t sink_cmd_write;
+static uint32_t sink_crc;
+
+static void bench_spi_transfer(const uint8_t *tx, uint8_t *rx, size_t len, int clock_hz)
+{
+    if (!spi_to_sink) {
+        ft800_emu_spi_transfer(tx, rx, len, clock_hz);
+        return;
+    }
+    uint8_t type = tx[0] & 0xC0;
+    uint32_t addr = len >= 3 ? (((uint32_t)tx[0] & 0x3F) << 16) | ((uint32_t)tx[1] << 8) | tx[2] : 0;
+    if (type == 0x80 && len > 3) {
+        sink_crc = stream_crc32(sink_crc, tx + 3, len - 3);
+        if (addr == REG_CMD_WRITE && len >= 7) {
+            sink_cmd_write = tx[3] | (uint32_t)tx[4] << 8 | (uint32_t)tx[5] << 16 | (uint32_t)tx[6] << 24;
+        }
+    } else if (type == 0x00 && len > 4 && rx) {
+        memset(rx, 0, len);
+        for (size_t i = 0; i + 4 <= len - 4; i += 4) {
+            if (addr + i == REG_CMD_READ || addr + i == REG_CMD_WRITE) {
+                memcpy(rx + 4 + i, &sink_cmd_write, 4);
+            }
+        }
+    }
+}
+
+/*** draw_ui 데이터 공급 *********************************************************/
+// interactive_draw_frame이 읽는 hardware_test / adc_dma 값을 고정 입력으로 대신함 (화면 코드는 펌웨어 그대로)
+static uint32_t draw_frame;     // get_adc_display_columns가 돌려줄 열 세트
+
+uint32_t get_adc_display_columns(decim_column_t *ch0, decim_column_t *ch1, uint32_t max)
+{
+    uint32_t n = max < ADC_DISPLAY_COLUMNS ? max : ADC_DISPLAY_COLUMNS;
+    memcpy(ch0, draw_cols[draw_frame][0], n * sizeof(decim_column_t));
+    memcpy(ch1, draw_cols[draw_frame][1], n * sizeof(decim_column_t));
+    return n;
+}
+
+uint32_t get_adc_display_timebase(decim_mode_t *mode)
+{
+    *mode = DECIM_MODE_PEAK;
+    return 1;
+}
+
+uint32_t get_adc_display_spectrum(spectrum_window_t *window)
+{
+    *window = SPECTRUM_WINDOW_HANN;
+    return 0;
+}
+
+uint16_t get_adc_latest_value1(void)
+{
+    return draw_cols[draw_frame][0][ADC_DISPLAY_COLUMNS - 1].max;
+}
+
+uint16_t get_adc_latest_value2(void)
+{
+    return draw_cols[draw_frame][1][ADC_DISPLAY_COLUMNS - 1].max;
+}
+
+// bench_draw_ui가 고정 신호로 채운 측정 엔진의 마지막 창
+esp_err_t adc_dma_get_measurement(int channel, meas_result_t *result)
+{
+    return meas_read(&meas[channel], result) ? ESP_OK : ESP_ERR_NOT_FOUND;
+}
+
+uint32_t adc_dma_get_sample_rate_hz(void)
+{
+    return CHANNEL_HZ;
+}
+
+// 아래는 상호작용 태스크에서만 쓰임 (벤치는 태스크를 띄우지 않음)
+esp_err_t set_adc_display_timebase(uint32_t samples_per_column, decim_mode_t mode)
+{
+    (void)samples_per_column;
+    (void)mode;
+    return ESP_OK;
+}
+
+esp_err_t set_adc_display_spectrum(uint32_t points, spectrum_window_t window)
+{
+    (void)points;
+    (void)window;
+    return ESP_OK;
+}
+
+uint32_t get_adc_spectrum_max_points(void)
+{
+    return 0;
+}
+
+uint32_t adc_dma_acq_max_length(void)
+{
+    return RING_POINTS;
+}
+
+esp_err_t adc_dma_set_trigger_level(uint8_t dac_value)
+{
+    (void)dac_value;
+    return ESP_OK;
+}
+
+void ch423_begin(void)
+{
+}
+
+void ch423_set(uint8_t pin, bool state)
+{
+    (void)pin;
+    (void)state;
+}
+
+esp_err_t ch423_commit(void)
+{
+    return ESP_OK;
+}
+
+esp_err_t ch423_set_output(uint8_t pin, bool state)
+{
+    (void)pin;
+    (void)state;
+    return ESP_OK;
+}
+
+esp_err_t ch423_read_input(uint8_t *data)
+{
+    *data = 0xFF;
+    return ESP_OK;
+}
+
+esp_err_t ch423_service_start(void)
+{
+    return ESP_FAIL;
+}
+
+bool ch423_service_running(void)
+{
+    return false;
+}
+
+bool ch423_service_pop_event(input_event_t *event)
+{
+    (void)event;
+    return false;
+}
+
+esp_err_t rotary_encoder_init(rotary_backend_t backend)
+{
+    (void)backend;
+    return ESP_FAIL;
+}
+
+int32_t rotary_encoder_take_detents(int id)
+{
+    (void)id;
+    return 0;
+}
+
+esp_err_t render_sched_init(void)
+{
+    return ESP_FAIL;
+}
+
+bool render_sched_wait_frame(void)
+{
+    return true;
+}
+
+void sample_stream_set_gain_state(uint16_t gain_state)
+{
+    (void)gain_state;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    (void)fn;
+    (void)name;
+    (void)stack_depth;
+    (void)arg;
+    (void)priority;
+    (void)handle;
+    return pdFAIL;
+}
+
+static void kernel_draw_ui(uint32_t iter)
+{
+    draw_frame = iter % DRAW_FRAMES;
+    interactive_draw_frame();
+}
+
+static int bench_draw_ui(bench_result_t *res)
+{
+    int failures = 0;
+    uint32_t emu_bytes[DRAW_FRAMES];
+
+    ft800_emu_init();
+    spi_host_set_device_model(SPI2_HOST, bench_spi_transfer);
+    // 처음 부를 때 장치 인스턴스를 새로 만든다는 오류 로그는 정상 동작이므로 감춤
+    esp_log_level_set("*", ESP_LOG_NONE);
+    uint8_t init_ret = initFT800();
+    esp_log_level_set("*", ESP_LOG_WARN);
+    if (init_ret != 0) {
+        fprintf(stderr, "draw_ui: initFT800 failed against the emulator\n");
+        return 1;
+    }
+    // 측정 줄이 있는 스코프 조작 화면. 측정 엔진은 measure 시간 측정이 넣은 만큼 진행됐으므로
+    // 고정 신호 전체로 다시 채워 화면 글씨(와 checksum)가 실행마다 같게 함
+    interactive_set_scope_mode(true);
+    for (int ch = 0; ch < 2; ch++) {
+        meas_init(&meas[ch], MEAS_WINDOW, CHANNEL_HZ);
+    }
+    for (uint32_t i = 0; i < SIGNAL_PAIRS / (FRAME_WORDS / 2); i++) {
+        kernel_measure(i);
+    }
+
+    // 에뮬레이터에서 한 바퀴: 화면 DL이 맞는지, 프레임마다 보낸 명령 바이트 기록
+    kernel_draw_ui(0);
+    for (uint32_t f = 0; f < DRAW_FRAMES; f++) {
+        uint32_t before = cmd_flushed_bytes();
+        kernel_draw_ui(f);
+        emu_bytes[f] = cmd_flushed_bytes() - before;
+        ft800_emu_stats_t st;
+        ft800_emu_frame_stats(&st);
+        if (st.dl_bytes == 0 || st.dl_bytes > 8192) {
+            fprintf(stderr, "draw_ui: frame %u display list %lu bytes MISMATCH\n", f, (unsigned long)st.dl_bytes);
+            failures++;
+        }
+    }
+    if (!ft800_emu_cmd_idle() || ft800_emu_unsupported() != 0) {
+        fprintf(stderr, "draw_ui: co-processor left commands or saw unsupported ones MISMATCH\n");
+        failures++;
+    }
+
+    // 싱크로 바꾸면 같은 명령 바이트를 보내야 함 (FIFO는 모두 처리된 상태에서 넘김)
+    sink_cmd_write = *(const uint32_t *)ft800_emu_mem(REG_CMD_WRITE, 4);
+    spi_to_sink = true;
+    sink_crc = 0;
+    for (uint32_t f = 0; f < DRAW_FRAMES; f++) {
+        uint32_t before = cmd_flushed_bytes();
+        kernel_draw_ui(f);
+        if (cmd_flushed_bytes() - before != emu_bytes[f]) {
+            fprintf(stderr, "draw_ui: frame %u sent %lu command bytes to the sink, %lu to the emulator MISMATCH\n",
+                    f, (unsigned long)(cmd_flushed_bytes() - before), (unsigned long)emu_bytes[f]);
+            failures++;
+        }
+    }
+    uint32_t crc = sink_crc;
+    fill_result(res, "draw_ui", "column", ADC_DISPLAY_COLUMNS * 2, time_kernel(kernel_draw_ui), crc);
+    spi_to_sink = false;
+    return failures;
+}
+
+/*** 출력 *************************************************************************/
+static void write_json(FILE *f, const bench_result_t *res, int count)
+{
+    fprintf(f, "{\n  \"bench\": \"sample_kernels\",\n  \"repeats\": %d,\n  \"kernels\": [\n", BENCH_REPEATS);
+    for (int i = 0; i < count; i++) {
+        const bench_result_t *r = &res[i];
+        fprintf(f,
+                "    {\"name\": \"%s\", \"unit\": \"%s\", \"samples_per_call\": %lu, \"ns_per_call\": %.1f, "
+                "\"ns_per_sample\": %.3f, \"samples_per_s\": %.0f, \"checksum\": \"%08lx\"}%s\n",
+                r->name, r->unit, (unsigned long)r->samples_per_call, r->ns_per_call, r->ns_per_sample,
+                r->samples_per_s, (unsigned long)r->checksum, i + 1 < count ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_path = argc > 1 ? argv[1] : NULL;
+    bench_result_t res[5];
+    int failures = 0;
+
+    make_signal();
+    failures += bench_deinterleave(&res[0]);
+    failures += bench_measure(&res[1]);
+    failures += bench_compat_copy(&res[2]);
+    failures += bench_raw_to_uv(&res[3]);
+    failures += bench_draw_ui(&res[4]);
+    if (failures) {
+        fprintf(stderr, "%d kernel check(s) failed\n", failures);
+        return 1;
+    }
+
+    write_json(stdout, res, 5);
+    if (out_path) {
+        FILE *f = fopen(out_path, "w");
+        if (f == NULL) {
+            fprintf(stderr, "cannot write %s\n", out_path);
+            return 1;
+        }
+        write_json(f, res, 5);
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,354 @@
+// 트리거 획득 상태 머신 확인 (호스트)
+//
+// acq_on_samples를 DMA 프레임(채널당 64샘플, 10 kHz에서 6.4 ms) 단위로, acq_on_trigger/acq_on_trigger_at을
+// 합성 시각으로 불러 시나리오별로 상태, 트리거 시퀀스, 레코드 위치를 계산값과 비교한다.
+//   - NORMAL: 프리트리거를 채우기 전 엣지 무시, 엣지 시각 → 시퀀스 보정, 프리트리거 앞 엣지 제한,
+//     포스트트리거 완료 프레임, 고정된 레코드 위치, 해제 후 재무장
+//   - 홀드오프, AUTO 강제 트리거, SINGLE 정지, 트리거 위치 0/100%, 소프트 트리거, 끊김(acq_on_gap)
+//   - 설정 교체(acq_reconfigure): 진행 중인 레코드를 멈추고 새 트리거 위치로 다시 무장
+// 끝으로 ISR 역할 스레드와 생산자 스레드가 동시에 무시된 엣지를 세어 개수가 빠지지 않는지 본다.
+//
+//   bench_acquisition
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "acquisition.h"
+
+#define SAMPLE_RATE     10000
+#define FRAME           64                              // DMA 프레임당 채널 샘플 수
+#define FRAME_US        (FRAME * 1000000LL / SAMPLE_RATE)
+#define RACE_EDGES      1000000
+
+// 생산자 흉내: 쓰기 시퀀스와 시각
+typedef struct {
+    acq_t acq;
+    uint32_t seq;
+    int64_t now_us;
+} sim_t;
+
+static int failures;
+
+static void expect(bool ok, const char *scenario, const char *what)
+{
+    if (!ok) {
+        printf("MISMATCH: %s: %s\n", scenario, what);
+        failures++;
+    }
+}
+
+static void sim_init(sim_t *sim, acq_mode_t mode, uint32_t record_length, uint8_t pos_pct, uint32_t holdoff_us,
+                     uint32_t auto_timeout_us)
+{
+    acq_config_t cfg = {
+        .mode = mode,
+        .record_length = record_length,
+        .trigger_pos_pct = pos_pct,
+        .holdoff_us = holdoff_us,
+        .auto_timeout_us = auto_timeout_us,
+        .sample_rate_hz = SAMPLE_RATE,
+    };
+    acq_init(&sim->acq, &cfg);
+    // 32비트 wrap 직전에서 시작해 모든 비교가 부호 없는 차이로 되는지 함께 확인
+    sim->seq = 0xFFFFFFFFu - 4 * FRAME;
+    sim->now_us = 1000000;
+}
+
+// 프레임 하나 기록
+static bool sim_frame(sim_t *sim)
+{
+    sim->seq += FRAME;
+    sim->now_us += FRAME_US;
+    return acq_on_samples(&sim->acq, sim->seq, sim->now_us);
+}
+
+// 상태가 바뀌거나 max_frames가 지날 때까지 프레임 기록. 지난 프레임 수
+static int sim_until_not(sim_t *sim, acq_state_t state, int max_frames)
+{
+    int n = 0;
+    while (acq_get_state(&sim->acq) == state && n < max_frames) {
+        sim_frame(sim);
+        n++;
+    }
+    return n;
+}
+
+static uint32_t ignored(const acq_t *acq)
+{
+    return atomic_load(&((acq_t *)acq)->ignored_edges);
+}
+
+static void report(const char *scenario, int before)
+{
+    printf("%-22s %s\n", scenario, failures == before ? "ok" : "MISMATCH");
+}
+
+/*** 시나리오 *********************************************************************/
+static void normal_mode(void)
+{
+    const char *name = "normal";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_NORMAL, 1000, 25, 0, 0);     // pre 250, post 750
+    expect(sim.acq.pre_count == 250 && sim.acq.post_count == 750, name, "pre/post split");
+
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    uint32_t arm_seq = sim.seq;
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_PRETRIGGER, name, "arm starts with pretrigger fill");
+    expect(!acq_on_trigger(&sim.acq, sim.now_us) && ignored(&sim.acq) == 1, name, "edge during pretrigger fill");
+
+    // 250샘플 = 프레임 4개째에 무장
+    int frames = sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(frames == 4 && acq_get_state(&sim.acq) == ACQ_STATE_ARMED, name, "armed after pre_count samples");
+
+    // 마지막 공개 후 1 ms 뒤 엣지 -> 10샘플 뒤
+    uint32_t pub_seq = sim.seq;
+    expect(acq_on_trigger(&sim.acq, sim.now_us + 1000), name, "edge accepted when armed");
+    expect(sim.acq.trigger_seq == pub_seq + 10, name, "edge time converted to sequence");
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_POSTTRIGGER, name, "posttrigger after edge");
+    expect(!acq_on_trigger(&sim.acq, sim.now_us + 2000), name, "second edge during posttrigger");
+
+    // write_seq - trigger_seq >= 750: 10 + 750 = 760샘플 -> 프레임 12개째
+    frames = sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    expect(frames == 12 && acq_get_state(&sim.acq) == ACQ_STATE_DONE, name, "done after post_count samples");
+    expect(sim.acq.record_count == 1 && !sim.acq.forced, name, "record count / not forced");
+
+    uint32_t start, length, trig_index;
+    expect(acq_get_record(&sim.acq, &start, &length, &trig_index) && start == pub_seq + 10 - 250 &&
+           length == 1000 && trig_index == 250, name, "record position");
+    expect((int32_t)(start - arm_seq) >= 0, name, "record starts after arm");
+    expect(!sim_frame(&sim) && acq_get_state(&sim.acq) == ACQ_STATE_DONE, name, "record stays frozen");
+
+    acq_release(&sim.acq, sim.seq, sim.now_us);
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_PRETRIGGER && sim.acq.arm_seq == sim.seq, name, "release re-arms");
+
+    // 프리트리거 구간보다 이른 엣지 시각은 프리트리거가 찬 위치로 제한
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us - 5000) &&
+           sim.acq.trigger_seq == acq_trigger_min_seq(&sim.acq), name, "early edge clamped to pretrigger");
+    report(name, before);
+}
+
+static void holdoff(void)
+{
+    const char *name = "holdoff 50 ms";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_NORMAL, 256, 50, 50000, 0);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    int64_t first = sim.now_us;
+    expect(acq_on_trigger(&sim.acq, first), name, "first edge");
+    sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    acq_release(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+
+    // 무장은 됐지만 첫 엣지 후 50 ms 이내
+    expect(sim.now_us - first < 50000, name, "re-armed inside holdoff");
+    uint32_t ign = ignored(&sim.acq);
+    expect(!acq_on_trigger(&sim.acq, first + 49999) && ignored(&sim.acq) == ign + 1, name, "edge inside holdoff");
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_ARMED, name, "still armed");
+    expect(acq_on_trigger(&sim.acq, first + 50000), name, "edge at holdoff end");
+    report(name, before);
+}
+
+static void auto_mode(void)
+{
+    const char *name = "auto 20 ms";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_AUTO, 512, 50, 0, 20000);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    int64_t armed_us = sim.now_us;
+
+    // 무장 후 20 ms가 지난 첫 프레임에서 그 위치를 트리거로
+    int frames = sim_until_not(&sim, ACQ_STATE_ARMED, 100);
+    expect(frames == (int)((20000 + FRAME_US - 1) / FRAME_US), name, "forced after timeout");
+    expect(sim.now_us - armed_us >= 20000 && sim.now_us - armed_us < 20000 + FRAME_US, name, "forced frame time");
+    expect(sim.acq.forced && sim.acq.trigger_seq == sim.seq, name, "forced trigger at write_seq");
+
+    // 포스트트리거 256샘플 = 프레임 4개
+    frames = sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    expect(frames == 4 && acq_get_state(&sim.acq) == ACQ_STATE_DONE, name, "done after forced trigger");
+
+    // 트리거가 오면 강제 트리거를 기다리지 않음
+    acq_release(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us) && !sim.acq.forced, name, "real edge before timeout");
+    report(name, before);
+}
+
+static void single_mode(void)
+{
+    const char *name = "single";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_SINGLE, 256, 50, 0, 0);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us), name, "edge");
+    sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_DONE, name, "done");
+    acq_release(&sim.acq, sim.seq, sim.now_us);
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_IDLE, name, "release stops");
+    expect(!acq_on_trigger(&sim.acq, sim.now_us) && sim_frame(&sim) &&
+           acq_get_state(&sim.acq) == ACQ_STATE_IDLE, name, "idle ignores edges");
+    report(name, before);
+}
+
+static void trigger_position(void)
+{
+    const char *name = "trigger position";
+    int before = failures;
+    sim_t sim;
+
+    // 0%: 프리트리거 없이 바로 무장, 레코드가 트리거에서 시작
+    sim_init(&sim, ACQ_MODE_NORMAL, 640, 0, 0, 0);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_ARMED, name, "0%: armed immediately");
+    expect(acq_on_trigger_at(&sim.acq, sim.seq, sim.now_us), name, "0%: trigger at arm");
+    int frames = sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    uint32_t start, length, trig_index;
+    expect(frames == 10 && acq_get_record(&sim.acq, &start, &length, &trig_index) &&
+           start == sim.acq.trigger_seq && trig_index == 0 && length == 640, name, "0%: record");
+
+    // 100%: 포스트트리거 없음, 트리거 다음 프레임에서 고정
+    sim_init(&sim, ACQ_MODE_NORMAL, 640, 100, 0, 0);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    frames = sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(frames == 10, name, "100%: pretrigger fills whole record");
+    expect(acq_on_trigger_at(&sim.acq, sim.seq, sim.now_us), name, "100%: trigger");
+    sim_frame(&sim);
+    expect(acq_get_record(&sim.acq, &start, &length, &trig_index) && trig_index == 640 &&
+           start + length == sim.acq.trigger_seq, name, "100%: record ends at trigger");
+    report(name, before);
+}
+
+static void soft_trigger(void)
+{
+    const char *name = "soft trigger";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_NORMAL, 1000, 30, 0, 0);      // pre 300
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    uint32_t min_seq = acq_trigger_min_seq(&sim.acq);
+    expect(!acq_on_trigger_at(&sim.acq, min_seq - 1, sim.now_us), name, "before pretrigger ignored");
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_ARMED && ignored(&sim.acq) == 1, name, "still armed");
+    expect(acq_on_trigger_at(&sim.acq, min_seq + 5, sim.now_us) && sim.acq.trigger_seq == min_seq + 5, name,
+           "exact sample position");
+    report(name, before);
+}
+
+static void gap(void)
+{
+    const char *name = "gap";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_NORMAL, 1000, 50, 0, 0);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us), name, "edge");
+    sim_frame(&sim);
+
+    // 포스트트리거 도중 끊기면 끊긴 위치부터 프리트리거를 다시 채움
+    sim.seq += 5 * FRAME;
+    sim.now_us += 5 * FRAME_US;
+    acq_on_gap(&sim.acq, sim.seq, sim.now_us);
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_PRETRIGGER && sim.acq.arm_seq == sim.seq, name,
+           "posttrigger restarts at gap");
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us), name, "edge after gap");
+    sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    uint32_t start, length;
+    expect(acq_get_record(&sim.acq, &start, &length, NULL), name, "done after gap");
+
+    // 고정된 레코드는 끊기기 전 데이터라 그대로 둠
+    acq_on_gap(&sim.acq, sim.seq, sim.now_us);
+    uint32_t start2, length2;
+    expect(acq_get_record(&sim.acq, &start2, &length2, NULL) && start2 == start, name, "frozen record kept");
+    report(name, before);
+}
+
+static void reconfigure(void)
+{
+    const char *name = "reconfigure";
+    int before = failures;
+    sim_t sim;
+    sim_init(&sim, ACQ_MODE_NORMAL, 1000, 50, 0, 0);
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us), name, "edge");
+    sim_frame(&sim);
+
+    // 포스트트리거 도중 교체하면 정지하고 새 설정만 남음 (무시된 엣지 수는 새로 셈)
+    acq_on_trigger(&sim.acq, sim.now_us);   // 포스트트리거 중: 무시됨
+    acq_config_t cfg = { .mode = ACQ_MODE_NORMAL, .record_length = 400, .trigger_pos_pct = 25,
+                         .sample_rate_hz = SAMPLE_RATE };
+    expect(acq_reconfigure(&sim.acq, &cfg), name, "accepted");
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_IDLE && ignored(&sim.acq) == 0, name, "stopped");
+    expect(sim.acq.pre_count == 100 && sim.acq.post_count == 300, name, "new trigger position");
+    sim_until_not(&sim, ACQ_STATE_IDLE, 20);
+    expect(acq_get_state(&sim.acq) == ACQ_STATE_IDLE, name, "record not resumed");
+    cfg.trigger_pos_pct = 101;
+    expect(!acq_reconfigure(&sim.acq, &cfg) && sim.acq.pre_count == 100, name, "invalid config rejected");
+
+    // 새 설정으로 무장하면 새 길이로 고정
+    acq_arm(&sim.acq, sim.seq, sim.now_us);
+    sim_until_not(&sim, ACQ_STATE_PRETRIGGER, 100);
+    expect(acq_on_trigger(&sim.acq, sim.now_us), name, "edge after reconfigure");
+    sim_until_not(&sim, ACQ_STATE_POSTTRIGGER, 100);
+    uint32_t start, length, trig;
+    expect(acq_get_record(&sim.acq, &start, &length, &trig) && length == 400 && trig == 100, name,
+           "record with new length");
+    report(name, before);
+}
+
+/*** ISR/생산자 동시 카운트 *******************************************************/
+static acq_t race_acq;
+
+static void *race_isr(void *arg)
+{
+    (void)arg;
+    for (int i = 0; i < RACE_EDGES; i++) {
+        acq_on_trigger(&race_acq, i);
+    }
+    return NULL;
+}
+
+static void race(void)
+{
+    const char *name = "ignored edge count";
+    int before = failures;
+    acq_config_t cfg = { .mode = ACQ_MODE_NORMAL, .record_length = 256, .trigger_pos_pct = 50,
+                         .sample_rate_hz = SAMPLE_RATE };
+    acq_init(&race_acq, &cfg);   // IDLE: 모든 엣지를 무시
+    pthread_t t;
+    pthread_create(&t, NULL, race_isr, NULL);
+    for (int i = 0; i < RACE_EDGES; i++) {
+        acq_on_trigger_at(&race_acq, (uint32_t)i, i);
+    }
+    pthread_join(t, NULL);
+    expect(ignored(&race_acq) == 2u * RACE_EDGES, name, "edges lost between ISR and producer");
+    printf("%-22s %s (%lu of %u)\n", name, failures == before ? "ok" : "MISMATCH",
+           (unsigned long)ignored(&race_acq), 2u * RACE_EDGES);
+}
+
+int main(void)
+{
+    printf("acquisition: %d Hz, %d-sample frames\n", SAMPLE_RATE, FRAME);
+    normal_mode();
+    holdoff();
+    auto_mode();
+    single_mode();
+    trigger_position();
+    soft_trigger();
+    gap();
+    reconfigure();
+    race();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,175 @@
+// ADC 변환표 벤치마크 (호스트)
+//
+// 감쇠/AC-DC 상태 32가지 모두에서 표 값이 배정밀도 기준식(README 감쇠 회로 식)과
+// 1 uV 이내로 같은지, 상태가 같으면 표를 다시 만들지 않는지 먼저 확인하고,
+// 블록 변환 속도를 샘플마다 계산하는 방식(정수 나눗셈, float)과 비교한다.
+//
+//   bench_adc_calib
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "adc_calib.h"
+
+#define BLOCK           256
+#define SIGNAL_LEN      (1u << 16)
+#define REALTIME_SPS    20000.0     // 두 채널 합계
+
+// ESP32 line fitting 결과와 비슷한 두 점 (raw 256 -> 230 mV, raw 3840 -> 3020 mV)
+#define RAW_LO          256
+#define UV_LO           230000
+#define RAW_HI          3840
+#define UV_HI           3020000
+
+static const double primary_div[4] = { 1.0, 10.0, 91.9, 101.0 };
+static const double secondary_div[4] = { 1.0, 2.0, 5.0, 6.0 };
+
+static uint16_t raw_buf[SIGNAL_LEN];
+static int32_t uv_buf[SIGNAL_LEN];
+static volatile int32_t sink;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double ref_uv(const adc_front_end_t *fe, uint16_t raw)
+{
+    double pin = UV_LO + (double)(raw - RAW_LO) * (UV_HI - UV_LO) / (RAW_HI - RAW_LO);
+    double offset = ADC_CALIB_V12_UV / ADC_CALIB_SHIFTER_DIV;
+    return (pin - offset) * primary_div[fe->primary] * secondary_div[fe->secondary] / ADC_CALIB_SHIFTER_GAIN;
+}
+
+static int check_tables(void)
+{
+    int failures = 0;
+    double worst = 0;
+
+    for (int state = 0; state < 32; state++) {
+        adc_front_end_t fe = { (uint8_t)(state & 1), (uint8_t)((state >> 1) & 3), (uint8_t)(state >> 3) };
+        adc_calib_set_front_end(0, &fe);
+        const int32_t *t = adc_calib_table(0);
+        for (uint32_t raw = 0; raw < ADC_CALIB_TABLE_SIZE; raw++) {
+            // 반올림 1 uV + Q16 기울기 절단분 (감쇠비만큼 커짐)
+            double tol = 1.0 + 0.01 * primary_div[fe.primary] * secondary_div[fe.secondary];
+            double err = fabs(t[raw] - ref_uv(&fe, (uint16_t)raw));
+            if (err > worst) {
+                worst = err;
+            }
+            if (err > tol) {
+                printf("state %d raw %u: table %d, reference %.1f MISMATCH\n", state, raw, t[raw],
+                       ref_uv(&fe, (uint16_t)raw));
+                failures++;
+                break;
+            }
+        }
+    }
+    printf("table vs double reference: 32 front-end states, worst error %.1f uV\n", worst);
+
+    // 같은 상태는 다시 만들지 않음, 바뀌면 버전 증가
+    adc_front_end_t fe = { 1, 2, 3 };
+    adc_calib_set_front_end(1, &fe);
+    uint32_t v = adc_calib_version(1);
+    if (adc_calib_set_front_end(1, &fe) || adc_calib_version(1) != v) {
+        printf("unchanged state rebuilt MISMATCH\n");
+        failures++;
+    }
+    fe.secondary = 0;
+    if (!adc_calib_set_front_end(1, &fe) || adc_calib_version(1) == v) {
+        printf("changed state not rebuilt MISMATCH\n");
+        failures++;
+    }
+
+    // 블록 변환 == 한 샘플 변환
+    adc_calib_convert(1, raw_buf, uv_buf, BLOCK);
+    for (uint32_t i = 0; i < BLOCK; i++) {
+        if (uv_buf[i] != adc_calib_uv(1, raw_buf[i])) {
+            printf("convert MISMATCH at %u\n", i);
+            failures++;
+            break;
+        }
+    }
+    return failures;
+}
+
+// 비교 대상 1: 샘플마다 정수 직선 + 감쇠 (나눗셈 두 번)
+static void convert_divide(const uint16_t *raw, int32_t *uv, uint32_t n, int32_t num, int32_t den)
+{
+    int64_t offset = (int64_t)(ADC_CALIB_V12_UV / ADC_CALIB_SHIFTER_DIV);
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t pin = UV_LO + (int64_t)((int32_t)raw[i] - RAW_LO) * (UV_HI - UV_LO) / (RAW_HI - RAW_LO);
+        uv[i] = (int32_t)((pin - offset) * num / den);
+    }
+}
+
+// 비교 대상 2: 샘플마다 float
+static void convert_float(const uint16_t *raw, int32_t *uv, uint32_t n, float scale)
+{
+    const float slope = (float)(UV_HI - UV_LO) / (RAW_HI - RAW_LO);
+    const float offset = (float)(ADC_CALIB_V12_UV / ADC_CALIB_SHIFTER_DIV);
+    for (uint32_t i = 0; i < n; i++) {
+        float pin = UV_LO + ((int32_t)raw[i] - RAW_LO) * slope;
+        uv[i] = (int32_t)((pin - offset) * scale);
+    }
+}
+
+typedef enum { MODE_TABLE, MODE_DIVIDE, MODE_FLOAT } mode_t_;
+
+static double measure(mode_t_ mode)
+{
+    uint32_t rounds = 0;
+    double t0 = now_sec(), t1;
+    do {
+        for (uint32_t pos = 0; pos < SIGNAL_LEN; pos += BLOCK) {
+            switch (mode) {
+            case MODE_TABLE:
+                adc_calib_convert(0, raw_buf + pos, uv_buf + pos, BLOCK);
+                break;
+            case MODE_DIVIDE:
+                convert_divide(raw_buf + pos, uv_buf + pos, BLOCK, 919 * 5, 10 * ADC_CALIB_SHIFTER_GAIN);
+                break;
+            case MODE_FLOAT:
+                convert_float(raw_buf + pos, uv_buf + pos, BLOCK, 91.9f * 5.0f / ADC_CALIB_SHIFTER_GAIN);
+                break;
+            }
+        }
+        sink += uv_buf[rounds % SIGNAL_LEN];
+        rounds++;
+        t1 = now_sec();
+    } while (t1 - t0 < 0.2);
+    return (double)SIGNAL_LEN * rounds / (t1 - t0);
+}
+
+int main(void)
+{
+    int failures = 0;
+    uint32_t rng = 1;
+
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        rng = rng * 1103515245u + 12345u;
+        raw_buf[i] = (uint16_t)(2048 + (int)(1800 * sin(2.0 * M_PI * 50.0 * i / 10000.0)) +
+                                (int)((rng >> 16) % 7) - 3);
+    }
+
+    adc_calib_init(RAW_LO, UV_LO, RAW_HI, UV_HI);
+    failures += check_tables();
+
+    adc_front_end_t fe = { 1, 2, 2 };
+    adc_calib_set_front_end(0, &fe);
+
+    printf("%-18s %12s %11s\n", "raw -> uV", "Msamples/s", "x realtime");
+    static const char *names[] = { "table lookup", "int divide", "float" };
+    for (int m = 0; m <= MODE_FLOAT; m++) {
+        double sps = measure((mode_t_)m);
+        printf("%-18s %12.1f %11.0f\n", names[m], sps / 1e6, sps / REALTIME_SPS);
+    }
+    printf("table memory: %u bytes (%d channels + 1 spare)\n",
+           (unsigned)((ADC_CALIB_CHANNELS + 1) * ADC_CALIB_TABLE_SIZE * sizeof(int32_t)), ADC_CALIB_CHANNELS);
+
+    return failures ? 1 : 0;
+}
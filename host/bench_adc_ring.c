@@ -0,0 +1,329 @@
+// ADC 링버퍼 스트레스 테스트 (호스트, pthread 생산자/소비자)
+//
+// 생산자 스레드가 DMA 프레임(채널당 64쌍) 단위로 adc_ring_write_interleaved를 계속 부르고,
+// 소비자 스레드 둘이 동시에 읽는다. 샘플 값은 시퀀스 번호에서 정해지므로(ch0 = seq, ch1 = seq * 7,
+// 12비트) 소비자는 읽은 값만으로 어긋남을 안다.
+//   - snapshot: 최신 구간 스냅샷을 복사. adc_ring_view_valid가 true면 값이 모두 맞아야 하고,
+//     복사 중 덮어써진 뷰(랩)는 false여야 함 (일부러 느리게 읽어 랩을 만듦)
+//   - follow: adc_ring_view_since로 빠짐없이 따라감. 덮어써져 앞이 잘린 뷰(start_seq가 요청보다 뒤)를
+//     끊김으로 세고, 끊김이 아닌 구간은 시퀀스가 이어져야 함
+// 쓰기 시퀀스는 32비트 wrap 직전에서 시작해 실행 중 wrap을 지난다. 먼저 단일 스레드로 wrap 전후
+// 스냅샷 길이(링이 찬 뒤에는 capacity - guard), view_since 잘림, 끊김 표시, 읽는 쪽 참조 수, 폐기되거나
+// 다시 초기화된(세대가 바뀐) 링의 뷰 무효를 확인한다.
+// 생산자 처리량(Msamples/s, 소비자 두 개와 경합)과 소비자별 뷰/랩/끊김 수를 출력한다.
+//
+//   bench_adc_ring [seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "adc_ring.h"
+
+#define CAPACITY        4096
+#define GUARD           64              // DMA 프레임 하나 (채널당 쌍 수)
+#define FRAME_WORDS     (GUARD * 2)
+#define SEQ_START       (0xFFFFFFFFu - 3 * CAPACITY)   // 곧 32비트 wrap
+#define SNAPSHOT_LEN    2048
+#define FOLLOW_MAX      512
+
+static uint16_t ring_mem[2][CAPACITY];
+static adc_ring_t ring;
+static _Atomic bool run;
+static _Atomic uint32_t errors;
+
+typedef struct {
+    uint64_t views;
+    uint64_t samples;
+    uint64_t torn;          // 유효하지 않다고 판정된 뷰 (랩)
+    uint64_t gaps;          // view_since가 앞을 잘라낸 횟수
+    uint64_t lost;          // 잘려서 건너뛴 샘플
+} reader_stats_t;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline uint16_t value_of(int ch, uint32_t seq)
+{
+    return (uint16_t)((ch == 0 ? seq : seq * 7u) & ADC_RING_SAMPLE_MASK);
+}
+
+static void fail(const char *what, uint32_t seq)
+{
+    if (atomic_fetch_add(&errors, 1) < 10) {
+        printf("MISMATCH: %s at seq %lu\n", what, (unsigned long)seq);
+    }
+}
+
+// 시퀀스 seq부터 한 프레임 (채널 비트 포함 TYPE1 워드처럼 상위 비트를 채움)
+static void make_frame(uint16_t *frame, uint32_t seq)
+{
+    for (uint32_t i = 0; i < GUARD; i++) {
+        frame[2 * i] = (uint16_t)((6 << 12) | value_of(0, seq + i));
+        frame[2 * i + 1] = (uint16_t)((7 << 12) | value_of(1, seq + i));
+    }
+}
+
+// 링 시퀀스를 seq에서 시작하도록 (테스트 전용: 비운 링의 시퀀스만 옮김)
+static void ring_start_at(uint32_t seq)
+{
+    adc_ring_init(&ring, ring_mem[0], ring_mem[1], CAPACITY, GUARD);
+    atomic_store(&ring.write_seq, seq);
+}
+
+static void check_view(const adc_ring_view_t *view, const uint16_t *ch0, const uint16_t *ch1)
+{
+    for (uint32_t i = 0; i < view->count; i++) {
+        uint32_t seq = view->start_seq + i;
+        if (ch0[i] != value_of(0, seq) || ch1[i] != value_of(1, seq)) {
+            fail("sample value", seq);
+            return;
+        }
+    }
+}
+
+/*** 단일 스레드 확인 *************************************************************/
+static int check_sequential(void)
+{
+    static uint16_t frame[FRAME_WORDS];
+    int failures = 0;
+    adc_ring_view_t view;
+
+    // 처음에는 기록한 만큼만
+    ring_start_at(SEQ_START);
+    uint32_t seq = SEQ_START;
+    make_frame(frame, seq);
+    adc_ring_write_interleaved(&ring, frame, FRAME_WORDS);
+    seq += GUARD;
+    if (!adc_ring_snapshot(&ring, CAPACITY, &view) || view.count != GUARD || view.start_seq != SEQ_START) {
+        printf("MISMATCH: partial ring snapshot %lu samples, expected %d\n", (unsigned long)view.count, GUARD);
+        failures++;
+    }
+
+    // wrap을 지나는 동안 가득 찬 링은 계속 capacity - guard
+    uint32_t short_views = 0;
+    bool wrapped = false;
+    for (int f = 0; f < 8 * CAPACITY / GUARD; f++) {
+        make_frame(frame, seq);
+        adc_ring_write_interleaved(&ring, frame, FRAME_WORDS);
+        seq += GUARD;
+        wrapped |= seq < GUARD;
+        if (seq - SEQ_START >= CAPACITY &&
+            (!adc_ring_snapshot(&ring, CAPACITY, &view) || view.count != CAPACITY - GUARD)) {
+            short_views++;
+        }
+    }
+    if (!wrapped || short_views != 0) {
+        printf("MISMATCH: %lu short snapshots around the 32-bit sequence wrap (wrapped %d)\n",
+               (unsigned long)short_views, wrapped);
+        failures++;
+    }
+
+    // 덮어써진 위치부터 요청하면 읽을 수 있는 가장 오래된 곳으로 잘림
+    uint32_t old = seq - CAPACITY;
+    if (!adc_ring_view_since(&ring, old, &view) || view.start_seq != seq - (CAPACITY - GUARD) ||
+        view.count != CAPACITY - GUARD) {
+        printf("MISMATCH: view_since on overwritten data not clipped\n");
+        failures++;
+    }
+    // 밀린 게 없으면 빈 뷰
+    if (adc_ring_view_since(&ring, seq, &view)) {
+        printf("MISMATCH: view_since at write_seq is not empty\n");
+        failures++;
+    }
+    // 스냅샷은 다 읽은 뒤 한 바퀴 돌면 무효
+    adc_ring_snapshot(&ring, CAPACITY - GUARD, &view);
+    bool valid_before = adc_ring_view_valid(&view);
+    make_frame(frame, seq);
+    adc_ring_write_interleaved(&ring, frame, FRAME_WORDS);
+    if (!valid_before || adc_ring_view_valid(&view)) {
+        printf("MISMATCH: view validity around one overwriting frame (%d, %d)\n", valid_before,
+               adc_ring_view_valid(&view));
+        failures++;
+    }
+    // 끊김 표시는 횟수와 다음 기록 위치로 공개
+    uint32_t gap_seq = 0;
+    uint32_t gaps_before = adc_ring_gaps(&ring, NULL);
+    adc_ring_mark_gap(&ring);
+    if (adc_ring_gaps(&ring, &gap_seq) != gaps_before + 1 || gap_seq != adc_ring_write_seq(&ring)) {
+        printf("MISMATCH: gap mark not published at write_seq\n");
+        failures++;
+    }
+    // 읽는 쪽 참조는 개수로 세고, 폐기된 링은 새 참조를 거절
+    if (!adc_ring_acquire(&ring) || adc_ring_readers(&ring) != 1) {
+        printf("MISMATCH: reader not counted on a live ring\n");
+        failures++;
+    }
+    // 폐기된 링의 뷰는 덮어쓰이지 않았어도 무효
+    adc_ring_snapshot(&ring, GUARD, &view);
+    adc_ring_set_retired(&ring, true);
+    if (adc_ring_view_valid(&view)) {
+        printf("MISMATCH: view on a retired ring still valid\n");
+        failures++;
+    }
+    if (adc_ring_acquire(&ring) || adc_ring_readers(&ring) != 1) {
+        printf("MISMATCH: retired ring accepted a new reader\n");
+        failures++;
+    }
+    adc_ring_release(&ring);
+    if (adc_ring_readers(&ring) != 0) {
+        printf("MISMATCH: reader count not released\n");
+        failures++;
+    }
+    // 같은 메모리로 다시 초기화한 링: 시퀀스가 겹쳐도 세대가 달라 예전 뷰는 무효
+    uint32_t reuse_seq = view.start_seq;
+    ring_start_at(reuse_seq);
+    make_frame(frame, reuse_seq);
+    adc_ring_write_interleaved(&ring, frame, FRAME_WORDS);
+    if (adc_ring_view_valid(&view)) {
+        printf("MISMATCH: view from a previous ring generation still valid\n");
+        failures++;
+    }
+    return failures;
+}
+
+/*** 스레드 ***********************************************************************/
+static void *producer(void *arg)
+{
+    uint64_t *pairs = arg;
+    static uint16_t frame[FRAME_WORDS];
+    uint32_t seq = adc_ring_write_seq(&ring);
+    while (atomic_load_explicit(&run, memory_order_relaxed)) {
+        make_frame(frame, seq);
+        adc_ring_write_interleaved(&ring, frame, FRAME_WORDS);
+        seq += GUARD;
+        *pairs += GUARD;
+    }
+    return NULL;
+}
+
+static void *snapshot_reader(void *arg)
+{
+    reader_stats_t *st = arg;
+    static uint16_t ch0[SNAPSHOT_LEN], ch1[SNAPSHOT_LEN];
+    uint32_t n = 0;
+    while (atomic_load_explicit(&run, memory_order_relaxed)) {
+        adc_ring_view_t view;
+        if (!adc_ring_snapshot(&ring, SNAPSHOT_LEN, &view)) {
+            continue;
+        }
+        uint32_t count = adc_ring_view_copy(&view, 0, ch0, SNAPSHOT_LEN);
+        // 가끔 채널 사이에서 쉬어 랩을 만듦
+        if ((++n & 63) == 0) {
+            struct timespec ts = { 0, 200000 };
+            nanosleep(&ts, NULL);
+        }
+        adc_ring_view_copy(&view, 1, ch1, SNAPSHOT_LEN);
+        st->views++;
+        if (!adc_ring_view_valid(&view)) {
+            st->torn++;
+            continue;
+        }
+        if (count != view.count) {
+            fail("snapshot copy length", view.start_seq);
+        }
+        check_view(&view, ch0, ch1);
+        st->samples += count;
+    }
+    return NULL;
+}
+
+static void *follow_reader(void *arg)
+{
+    reader_stats_t *st = arg;
+    static uint16_t ch0[FOLLOW_MAX], ch1[FOLLOW_MAX];
+    uint32_t next = adc_ring_write_seq(&ring);
+    uint32_t n = 0;
+    while (atomic_load_explicit(&run, memory_order_relaxed)) {
+        adc_ring_view_t view;
+        if (!adc_ring_view_since(&ring, next, &view)) {
+            continue;
+        }
+        if (view.start_seq != next) {
+            // 요청보다 뒤에서 시작하면 그 사이가 덮어써진 것
+            if ((int32_t)(view.start_seq - next) < 0) {
+                fail("view_since started before the requested sequence", view.start_seq);
+            }
+            st->gaps++;
+            st->lost += view.start_seq - next;
+        }
+        if (view.count > FOLLOW_MAX) {
+            view.count = FOLLOW_MAX;
+        }
+        adc_ring_view_copy(&view, 0, ch0, FOLLOW_MAX);
+        adc_ring_view_copy(&view, 1, ch1, FOLLOW_MAX);
+        st->views++;
+        if (!adc_ring_view_valid(&view)) {
+            // 복사 중 덮어써짐: 다음 view_since가 잘린 위치를 알려 줌
+            st->torn++;
+            next = view.start_seq;
+            continue;
+        }
+        check_view(&view, ch0, ch1);
+        st->samples += view.count;
+        next = view.start_seq + view.count;
+        // 가끔 한참 쉬어 랩을 만듦
+        if ((++n & 1023) == 0) {
+            struct timespec ts = { 0, 2000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+    return NULL;
+}
+
+static void print_reader(const char *name, const reader_stats_t *st)
+{
+    printf("%-10s %10llu views %12llu samples checked %8llu torn %8llu gaps (%llu samples skipped)\n", name,
+           (unsigned long long)st->views, (unsigned long long)st->samples, (unsigned long long)st->torn,
+           (unsigned long long)st->gaps, (unsigned long long)st->lost);
+}
+
+int main(int argc, char **argv)
+{
+    double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+    int failures = check_sequential();
+
+    ring_start_at(SEQ_START);
+    uint64_t pairs = 0;
+    reader_stats_t snap = { 0 }, follow = { 0 };
+    pthread_t tp, ts, tf;
+    atomic_store(&run, true);
+    double t0 = now_sec();
+    pthread_create(&tp, NULL, producer, &pairs);
+    pthread_create(&ts, NULL, snapshot_reader, &snap);
+    pthread_create(&tf, NULL, follow_reader, &follow);
+    struct timespec wait = { (time_t)seconds, (long)((seconds - (time_t)seconds) * 1e9) };
+    nanosleep(&wait, NULL);
+    atomic_store(&run, false);
+    pthread_join(tp, NULL);
+    pthread_join(ts, NULL);
+    pthread_join(tf, NULL);
+    double dt = now_sec() - t0;
+
+    printf("producer: %.1f Msample pairs/s over %.1f s, write_seq wrapped %s\n", pairs / dt / 1e6, dt,
+           pairs > 3 * CAPACITY ? "yes" : "no");
+    print_reader("snapshot", &snap);
+    print_reader("follow", &follow);
+
+    if (atomic_load(&errors) != 0) {
+        printf("MISMATCH: %lu sample errors\n", (unsigned long)atomic_load(&errors));
+        failures++;
+    }
+    if (snap.samples == 0 || follow.samples == 0) {
+        printf("MISMATCH: a reader checked no samples\n");
+        failures++;
+    }
+    if (snap.torn == 0 || follow.gaps == 0) {
+        printf("MISMATCH: run did not exercise lapping (torn %llu, gaps %llu)\n", (unsigned long long)snap.torn,
+               (unsigned long long)follow.gaps);
+        failures++;
+    }
+    return failures ? 1 : 0;
+}
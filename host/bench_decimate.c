@@ -0,0 +1,106 @@
+// 데시메이션 벤치마크 (호스트)
+//
+// 임의 길이 조각으로 나눠 넣은 결과가 레코드 전체를 한 번에 계산한 참조 구현과
+// 같은지 먼저 확인하고, 모드/시간축별 처리 속도를 출력한다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "decimate.h"
+
+#define SIGNAL_LEN      (1u << 20)
+#define FRAME_SAMPLES   64
+#define REALTIME_SPS    20000.0
+
+static uint16_t signal_buf[SIGNAL_LEN];
+static decim_column_t cols_fast[DECIM_MAX_COLUMNS];
+static decim_column_t cols_ref[DECIM_MAX_COLUMNS];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 참조 구현: 레코드 끝에서부터 열 단위로 직접 계산
+static uint32_t ref_decimate(decim_mode_t mode, uint32_t spc, uint32_t columns, uint32_t len,
+                             decim_column_t *out)
+{
+    uint32_t total = len / spc;
+    uint32_t n = total < columns ? total : columns;
+    uint32_t first = total - n;
+
+    for (uint32_t c = 0; c < n; c++) {
+        const uint16_t *p = signal_buf + (first + c) * spc;
+        uint32_t lo = 0xFFFF, hi = 0, sum = 0;
+        for (uint32_t i = 0; i < spc; i++) {
+            lo = p[i] < lo ? p[i] : lo;
+            hi = p[i] > hi ? p[i] : hi;
+            sum += p[i];
+        }
+        if (mode == DECIM_MODE_AVERAGE) {
+            lo = hi = (sum + spc / 2) / spc;
+        }
+        out[c].min = (uint16_t)lo;
+        out[c].max = (uint16_t)hi;
+    }
+    return n;
+}
+
+int main(void)
+{
+    static const uint32_t spcs[] = {1, 3, 16, 100, 2048};
+    static const decim_mode_t modes[] = {DECIM_MODE_PEAK, DECIM_MODE_AVERAGE};
+    uint32_t rng = 1;
+    int failures = 0;
+
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        rng = rng * 1103515245u + 12345u;
+        signal_buf[i] = (uint16_t)((rng >> 16) & 0x0FFF);
+    }
+
+    printf("decimation: %u samples, %u columns\n", SIGNAL_LEN, DECIM_MAX_COLUMNS);
+    printf("%-8s %8s %14s %12s\n", "mode", "smp/col", "samples/s", "x realtime");
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (size_t s = 0; s < sizeof(spcs) / sizeof(spcs[0]); s++) {
+            const char *name = modes[m] == DECIM_MODE_PEAK ? "peak" : "average";
+            static decim_t d;
+
+            // 정확도: 불규칙한 조각 길이로 넣기
+            uint32_t len = SIGNAL_LEN - 7;
+            decim_init(&d, modes[m], spcs[s], DECIM_MAX_COLUMNS);
+            for (uint32_t pos = 0, step = 1; pos < len; step = (step * 7 + 3) % 509 + 1) {
+                uint32_t n = (len - pos < step) ? len - pos : step;
+                decim_push(&d, signal_buf + pos, n);
+                pos += n;
+            }
+            uint32_t n_fast = decim_read(&d, cols_fast, DECIM_MAX_COLUMNS);
+            uint32_t n_ref = ref_decimate(modes[m], spcs[s], DECIM_MAX_COLUMNS, len, cols_ref);
+            if (n_fast != n_ref || memcmp(cols_fast, cols_ref, n_ref * sizeof(decim_column_t)) != 0) {
+                printf("%-8s %8u MISMATCH (ref %u cols, fast %u cols)\n", name, spcs[s], n_ref, n_fast);
+                failures++;
+                continue;
+            }
+
+            // 속도: DMA 프레임 크기로 넣기
+            uint32_t rounds = 0;
+            double t0 = now_sec(), t1;
+            do {
+                decim_reset(&d);
+                for (uint32_t pos = 0; pos < SIGNAL_LEN; pos += FRAME_SAMPLES) {
+                    decim_push(&d, signal_buf + pos, FRAME_SAMPLES);
+                }
+                rounds++;
+                t1 = now_sec();
+            } while (t1 - t0 < 0.2);
+
+            double sps = (double)SIGNAL_LEN * rounds / (t1 - t0);
+            printf("%-8s %8u %14.3e %12.0f\n", name, spcs[s], sps, sps / REALTIME_SPS);
+        }
+    }
+
+    return failures ? 1 : 0;
+}
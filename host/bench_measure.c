@@ -0,0 +1,218 @@
+// 자동 측정 엔진 벤치마크 (호스트)
+//
+// 합성 파형(사인, 사다리꼴+오버슈트, PWM, DC)을 10 kHz로 만들어 meas_push에 넣고
+// 주파수/듀티/상승·하강 시간/오버슈트/Vpp/평균/RMS가 생성식과 맞는지 먼저 확인한다.
+// 같은 신호를 무작위 크기로 잘라 넣어도 한 번에 넣은 것과 결과가 같아야 한다.
+// 끝으로 처리 속도를 출력한다.
+//
+//   bench_measure
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "measure.h"
+
+#define SAMPLE_RATE     10000
+#define WINDOW          2000        // 200 ms
+#define SIGNAL_LEN      (WINDOW * 16)
+#define FRAME           128         // DMA 프레임당 채널 샘플 수 (SIGNAL_LEN의 약수)
+#define REALTIME_SPS    20000.0     // 두 채널 합계
+
+static uint16_t signal_buf[SIGNAL_LEN];
+static meas_t meas;
+static meas_t meas_split;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t rng = 1;
+
+static int noise(int amp)
+{
+    rng = rng * 1103515245u + 12345u;
+    return (int)((rng >> 16) % (2 * amp + 1)) - amp;
+}
+
+static uint16_t clamp12(double v)
+{
+    return (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : lround(v));
+}
+
+// 사다리꼴: base -> top 선형 상승(rise), 상단 유지, 선형 하강(fall). 상승 직후 overshoot 샘플 구간
+static double trapezoid(double t, double period, double duty, double rise, double fall,
+                        double base, double top, double overshoot, double ring)
+{
+    double ph = fmod(t, period);
+    double high = duty * period;    // 50% 지점 사이 간격
+    double r0 = -rise / 2, f0 = high - fall / 2;
+    if (ph > period + r0) {
+        ph -= period;
+    }
+    if (ph < r0) {
+        return base;
+    }
+    if (ph < r0 + rise) {
+        return base + (top - base) * (ph - r0) / rise;
+    }
+    if (ph < f0) {
+        return top + ((ph - r0 - rise) < ring ? overshoot * (top - base) : 0);
+    }
+    if (ph < f0 + fall) {
+        return top - (top - base) * (ph - f0) / fall;
+    }
+    return base;
+}
+
+typedef struct {
+    const char *name;
+    double freq, duty, rise_us, fall_us, overshoot_pct;
+    double vpp;
+    uint32_t expect_valid;
+} expect_t;
+
+static bool near(double got, double want, double tol)
+{
+    return fabs(got - want) <= tol;
+}
+
+// 마지막 창 결과를 기대값과 비교
+static int check(const expect_t *e, const uint16_t *sig)
+{
+    meas_result_t r;
+    if (!meas_read(&meas, &r)) {
+        printf("%-16s no result MISMATCH\n", e->name);
+        return 1;
+    }
+
+    // 평균/RMS는 마지막 창 샘플로 직접 계산한 값과 비교
+    const uint16_t *w = sig + SIGNAL_LEN - WINDOW;
+    double sum = 0, sq = 0;
+    uint16_t mn = 4095, mx = 0;
+    for (uint32_t i = 0; i < WINDOW; i++) {
+        sum += w[i];
+        sq += (double)w[i] * w[i];
+        mn = w[i] < mn ? w[i] : mn;
+        mx = w[i] > mx ? w[i] : mx;
+    }
+    double mean = sum / WINDOW;
+    double rms = sqrt(sq / WINDOW);
+    double ac = sqrt(sq / WINDOW - mean * mean);
+
+    bool ok = (r.valid & e->expect_valid) == e->expect_valid && r.samples == WINDOW &&
+              r.min == mn && r.max == mx && near(r.mean, mean, 0.01) && near(r.rms, rms, 0.05) &&
+              near(r.ac_rms, ac, 0.05);
+    if (e->vpp > 0) {
+        ok = ok && near(r.max - r.min, e->vpp, 12);
+    }
+    if (e->freq > 0) {
+        ok = ok && near(r.frequency_hz, e->freq, e->freq * 0.002) &&
+              near(r.period_us, 1e6 / e->freq, 1e6 / e->freq * 0.002);
+    }
+    if (e->duty > 0) {
+        ok = ok && near(r.duty_pct, e->duty, 1.0);
+    }
+    if (e->rise_us > 0) {
+        ok = ok && near(r.rise_us, e->rise_us, 1e6 / SAMPLE_RATE * 0.1);
+    }
+    if (e->fall_us > 0) {
+        ok = ok && near(r.fall_us, e->fall_us, 1e6 / SAMPLE_RATE * 0.1);
+    }
+    if (e->overshoot_pct >= 0) {
+        ok = ok && (r.valid & MEAS_VALID_LEVELS) && near(r.overshoot_pct, e->overshoot_pct, 1.0);
+    }
+    if (e->expect_valid == 0) {
+        ok = ok && (r.valid & (MEAS_VALID_FREQ | MEAS_VALID_DUTY | MEAS_VALID_RISE | MEAS_VALID_FALL)) == 0;
+    }
+
+    printf("%-16s %4u %7.1f %7.1f %7.1f %9.3f %6.2f %7.1f %7.1f %6.1f  %s\n", e->name, r.max - r.min,
+           r.mean, r.ac_rms, r.top - r.base,
+           r.valid & MEAS_VALID_FREQ ? r.frequency_hz : 0.0f, r.valid & MEAS_VALID_DUTY ? r.duty_pct : 0.0f,
+           r.valid & MEAS_VALID_RISE ? r.rise_us : 0.0f, r.valid & MEAS_VALID_FALL ? r.fall_us : 0.0f,
+           r.valid & MEAS_VALID_LEVELS ? r.overshoot_pct : 0.0f, ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
+
+// 한 번에 넣은 결과와 무작위 크기로 잘라 넣은 결과가 같은지
+static int run(const expect_t *e)
+{
+    meas_init(&meas, WINDOW, SAMPLE_RATE);
+    meas_init(&meas_split, WINDOW, SAMPLE_RATE);
+    meas_push(&meas, signal_buf, SIGNAL_LEN);
+
+    uint32_t pos = 0;
+    while (pos < SIGNAL_LEN) {
+        uint32_t n = 1 + (uint32_t)(noise(400) + 400);
+        n = n > SIGNAL_LEN - pos ? SIGNAL_LEN - pos : n;
+        meas_push(&meas_split, signal_buf + pos, n);
+        pos += n;
+    }
+    meas_result_t a, b;
+    if (!meas_read(&meas, &a) || !meas_read(&meas_split, &b) || memcmp(&a, &b, sizeof(a)) != 0) {
+        printf("%-16s split push MISMATCH\n", e->name);
+        return 1;
+    }
+    return check(e, signal_buf);
+}
+
+int main(void)
+{
+    int failures = 0;
+
+    printf("measure: %u-sample windows at %u Hz\n", WINDOW, SAMPLE_RATE);
+    printf("%-16s %4s %7s %7s %7s %9s %6s %7s %7s %6s\n", "waveform", "p-p", "mean", "ac rms", "top-bas",
+           "freq Hz", "duty%", "rise us", "fall us", "ovs%");
+
+    // 50Hz 사인 + 잡음 +-3 LSB (진폭 1800 -> AC RMS 1273)
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = clamp12(2048 + 1800 * sin(2.0 * M_PI * 50.0 * i / SAMPLE_RATE + 0.3) + noise(3));
+    }
+    expect_t sine = { "sine 50Hz", 50.0, 50.0, 0, 0, -1, 3600, MEAS_VALID_FREQ | MEAS_VALID_DUTY };
+    failures += run(&sine);
+
+    // 사다리꼴 97.3 Hz, 듀티 30%, 상승 1 ms / 하강 2 ms (10-90% = 0.8 / 1.6 ms), 상승 직후 8% 오버슈트
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        double t = (double)i / SAMPLE_RATE;
+        signal_buf[i] = clamp12(trapezoid(t, 1.0 / 97.3, 0.30, 1e-3, 2e-3, 600, 3400, 0.08, 0.4e-3) + noise(2));
+    }
+    expect_t trap = { "trapezoid", 97.3, 30.0, 800.0, 1600.0, 8.0, 0,
+                      MEAS_VALID_FREQ | MEAS_VALID_DUTY | MEAS_VALID_RISE | MEAS_VALID_FALL | MEAS_VALID_LEVELS };
+    failures += run(&trap);
+
+    // DC + 잡음: 교차 측정 없음
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = clamp12(1900 + noise(4));
+    }
+    expect_t dc = { "dc+noise", 0, 0, 0, 0, -1, 0, 0 };
+    failures += run(&dc);
+
+    // PWM 1234.5 Hz, 듀티 25% (주기 8.1 샘플, 엣지는 샘플 사이에서 바로 바뀜)
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        double ph = fmod(i * 1234.5 / SAMPLE_RATE, 1.0);
+        signal_buf[i] = clamp12((ph < 0.25 ? 3500 : 500) + noise(3));
+    }
+    expect_t pwm = { "pwm 1234.5Hz", 1234.5, 25.0, 0, 0, 0.0, 3000, MEAS_VALID_FREQ | MEAS_VALID_DUTY };
+    failures += run(&pwm);
+
+    // 처리 속도 (위 PWM, 교차가 가장 많은 경우)
+    meas_init(&meas, WINDOW, SAMPLE_RATE);
+    uint32_t rounds = 0;
+    double t0 = now_sec(), t1;
+    do {
+        for (uint32_t pos = 0; pos < SIGNAL_LEN; pos += FRAME) {
+            meas_push(&meas, signal_buf + pos, FRAME);
+        }
+        rounds++;
+        t1 = now_sec();
+    } while (t1 - t0 < 0.2);
+    double sps = (double)SIGNAL_LEN * rounds / (t1 - t0);
+    printf("meas_push %.1f Msamples/s = %.0fx realtime (%u-sample frames)\n", sps / 1e6, sps / REALTIME_SPS, FRAME);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+// 쿼드러처 디코더 검증/벤치마크 (호스트)
+//
+// A/B 에지 트레이스를 quad_decoder 표에 그대로 흘려 클릭 수와 오류 수를 기대값과 비교한다.
+// 내장 트레이스: 정/역회전, 접점 바운스, 중간 역회전, 상태를 건너뛴 고속 회전.
+// 로직 분석기에서 뽑은 CSV를 인자로 주면 그것도 재생한다:
+//   # expect_detents: 12        (선택: 기대 클릭 수)
+//   time_us,A,B                 (한 줄에 한 샘플, 같은 상태가 반복돼도 됨)
+// 마지막으로 가속(quad_accel) 배율과 디코딩 속도를 출력한다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "quad_decoder.h"
+
+#define MAX_TRACE   4096
+
+typedef struct {
+    const char *name;
+    uint8_t ab[MAX_TRACE];
+    int len;
+    int32_t expect_detents;
+    uint32_t expect_errors;
+} trace_t;
+
+static trace_t trace;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void trace_add(uint8_t ab)
+{
+    if (trace.len < MAX_TRACE) {
+        trace.ab[trace.len++] = ab;
+    }
+}
+
+// 클릭 n개 (+: 00->01->11->10->00), bounce면 에지마다 바운스 두 번
+static void trace_detents(int n, int bounce)
+{
+    static const uint8_t fwd[4] = {0, 1, 3, 2};
+    int dir = n >= 0 ? 1 : -1;
+    int steps = (n >= 0 ? n : -n) * QUAD_STEPS_PER_DETENT;
+    int pos = 0;
+
+    for (int i = 0; i < steps; i++) {
+        uint8_t prev = fwd[pos & 3];
+        pos += dir;
+        uint8_t next = fwd[pos & 3];
+        if (bounce) {
+            trace_add(next);
+            trace_add(prev);
+            trace_add(next);
+            trace_add(prev);
+        }
+        trace_add(next);
+    }
+}
+
+static void trace_begin(const char *name, int32_t detents, uint32_t errors)
+{
+    trace.name = name;
+    trace.len = 0;
+    trace.expect_detents = detents;
+    trace.expect_errors = errors;
+    trace_add(0);
+}
+
+static int run_trace(void)
+{
+    quad_decoder_t q;
+    int32_t pos = 0, taken = 0, detents = 0;
+
+    quad_decoder_init(&q, trace.ab[0]);
+    for (int i = 1; i < trace.len; i++) {
+        pos += quad_decoder_step(&q, trace.ab[i]);
+        detents += quad_take_detents(pos, &taken);
+    }
+
+    int ok = detents == trace.expect_detents && (trace.expect_errors == UINT32_MAX || q.errors == trace.expect_errors);
+    printf("%-28s %6d samples  detents %4d (expect %4d)  errors %3u  %s\n",
+           trace.name, trace.len, detents, trace.expect_detents, q.errors, ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+// CSV 트레이스 재생
+static int run_file(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    char line[128];
+    int32_t expect = 0;
+    trace_begin(path, 0, UINT32_MAX);
+    trace.len = 0;
+    while (fgets(line, sizeof(line), f)) {
+        long t;
+        int a, b;
+        if (line[0] == '#') {
+            sscanf(line, "# expect_detents: %d", &expect);
+            continue;
+        }
+        if (sscanf(line, "%ld,%d,%d", &t, &a, &b) == 3) {
+            trace_add((uint8_t)(((a & 1) << 1) | (b & 1)));
+        }
+    }
+    fclose(f);
+    if (trace.len == 0) {
+        printf("%s: no samples\n", path);
+        return 1;
+    }
+    trace.expect_detents = expect;
+    return run_trace();
+}
+
+int main(int argc, char **argv)
+{
+    int failures = 0;
+
+    trace_begin("clockwise 10", 10, 0);
+    trace_detents(10, 0);
+    failures += run_trace();
+
+    trace_begin("counter-clockwise 7", -7, 0);
+    trace_detents(-7, 0);
+    failures += run_trace();
+
+    trace_begin("bounce on every edge", 5, 0);
+    trace_detents(5, 1);
+    failures += run_trace();
+
+    // 반 클릭 가고 돌아옴 -> 0, 그 뒤 3클릭
+    trace_begin("half detent and back", 3, 0);
+    trace_add(1);
+    trace_add(3);
+    trace_add(1);
+    trace_add(0);
+    trace_detents(3, 0);
+    failures += run_trace();
+
+    // 01 -> 10 건너뜀: 방향을 모르므로 그 두 스텝은 빠지고 오류 1
+    trace_begin("skipped state (fast spin)", 1, 1);
+    trace_add(1);
+    trace_add(2);
+    trace_add(0);
+    trace_detents(1, 0);
+    failures += run_trace();
+
+    for (int i = 1; i < argc; i++) {
+        failures += run_file(argv[i]);
+    }
+
+    // 가속 배율: 일정 속도로 1초 돌렸을 때 마지막 클릭의 배율
+    printf("\nacceleration (5..30 clicks/s -> x1..x10)\n");
+    static const float rates[] = {2.0f, 5.0f, 10.0f, 20.0f, 30.0f, 60.0f};
+    for (size_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+        quad_accel_t a;
+        quad_accel_init(&a, 5.0f, 30.0f, 10.0f);
+        int64_t period_us = (int64_t)(1e6f / rates[r]);
+        int32_t units = 0;
+        for (int64_t t = 0; t < 1000000; t += period_us) {
+            units = quad_accel_apply(&a, 1, t);
+        }
+        printf("  %5.1f clicks/s -> x%d\n", rates[r], units);
+    }
+
+    // 속도: ISR에서 에지 하나 처리 비용
+    trace_begin("speed", 0, 0);
+    trace_detents(MAX_TRACE / QUAD_STEPS_PER_DETENT - 1, 0);
+    quad_decoder_t q;
+    int32_t pos = 0;
+    uint64_t edges = 0;
+    double t0 = now_sec(), t1;
+    do {
+        quad_decoder_init(&q, trace.ab[0]);
+        for (int i = 1; i < trace.len; i++) {
+            pos += quad_decoder_step(&q, trace.ab[i]);
+        }
+        edges += (uint64_t)trace.len - 1;
+        t1 = now_sec();
+    } while (t1 - t0 < 0.2);
+    printf("\ndecode: %.3e edges/s (pos %d)\n", edges / (t1 - t0), pos);
+
+    return failures ? 1 : 0;
+}
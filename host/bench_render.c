@@ -0,0 +1,293 @@
+// 화면 렌더링 SPI 비용 벤치마크 (호스트, FT800 에뮬레이터)
+//
+// 펌웨어의 ft800.c(initFT800 포함), waveform_render.c, ui_dl_cache.c를 그대로 링크하고
+// SPI를 FT800 에뮬레이터에 연결해 스코프 화면 한 프레임(draw_ui와 같은 구성:
+// 정적 테두리/제목/안내문 + 매 프레임 수치 글씨 + 두 채널 250열 트레이스)을 두 방식으로 그린다.
+//   - cached: 정적 UI는 RAM_G 캐시를 CMD_APPEND, 트레이스는 RAM_G 스니펫 (현재 펌웨어)
+//   - inline: 모두 명령 FIFO로 직접 (캐시/스니펫 없을 때)
+// 확인:
+//   - 두 방식의 래스터 결과가 픽셀 단위로 같음
+//   - 화면 DL이 RAM_DL(8KB) 안, 처리 못 한 코프로세서 명령 없음, 스왑한 프레임 수가 맞음
+//   - 드라이버의 버스 카운터(bus_stats)가 에뮬레이터가 받은 SPI 트랜잭션/바이트와 같음
+// 프레임당 SPI 트랜잭션/바이트/모의 버스 시간(20MHz)과 그 버스 시간만으로 낼 수 있는 최대 fps를 출력하고,
+// 출력 디렉터리를 주면 두 방식의 마지막 프레임을 PNG로 저장한다.
+//
+//   bench_render [out_dir]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "ft800.h"
+#include "waveform_render.h"
+#include "ui_dl_cache.h"
+#include "render_sched.h"
+#include "bus_stats.h"
+#include "esp_log.h"
+#include "driver/spi_master.h"
+#include "ft800_emu.h"
+#include "png_write.h"
+
+#define FRAMES          100
+#define GRAPH_X         200
+#define GRAPH_Y         25
+#define GRAPH_WIDTH     250
+#define GRAPH_HEIGHT    180
+#define PIXELS          (FT800_EMU_WIDTH * FT800_EMU_HEIGHT)
+
+typedef enum {
+    VARIANT_CACHED = 0,
+    VARIANT_INLINE,
+} variant_t;
+
+static const char *variant_names[] = { "cached", "inline" };
+
+static decim_column_t cols[2][GRAPH_WIDTH];
+static ui_dl_cache_t chrome_cache;
+static uint32_t pixels[2][PIXELS];
+static int64_t frame_clock_us;      // 60 fps로 가정한 프레임 시각 (bus_stats 구간용)
+
+// 코프로세서가 명령을 바로 처리하므로 기다릴 것이 없음 (render_sched.c 대신)
+uint32_t render_sched_wait(uint32_t mask, uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    return mask;
+}
+
+// 프레임마다 조금씩 움직이는 두 채널 (사인, 잡음 섞인 구형파)
+static void make_columns(uint32_t frame)
+{
+    uint32_t rng = 12345 + frame;
+    for (int i = 0; i < GRAPH_WIDTH; i++) {
+        double phase = 2 * M_PI * (i + frame * 3) / 83.0;
+        int c = 2048 + (int)(1500 * sin(phase));
+        cols[0][i].min = (uint16_t)(c - 40);
+        cols[0][i].max = (uint16_t)(c + 40);
+
+        rng = rng * 1103515245u + 12345u;
+        int jitter = (int)((rng >> 16) & 63);
+        int level = ((i + frame * 2) / 40) & 1 ? 3400 : 700;
+        cols[1][i].min = (uint16_t)(level - jitter);
+        cols[1][i].max = (uint16_t)(level + jitter);
+    }
+}
+
+// 정적 부분 (draw_ui_layout(true)의 스코프 모드)
+static void draw_chrome(void *arg)
+{
+    (void)arg;
+    cmd(COLOR_RGB(0x40, 0x40, 0x40));
+    cmd(BEGIN(LINES));
+    cmd(VERTEX2F(10 * 16, 37 * 16));
+    cmd(VERTEX2F(470 * 16, 37 * 16));
+    cmd(END());
+
+    cmd(COLOR_RGB(0x00, 0xFF, 0x00));
+    cmd_text(10, 120, 24, 0, "SCOPE CONTROL:");
+
+    cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+    cmd(BEGIN(LINES));
+    cmd(VERTEX2F(GRAPH_X * 16, GRAPH_Y * 16));
+    cmd(VERTEX2F(GRAPH_X * 16, (GRAPH_Y + GRAPH_HEIGHT) * 16));
+    cmd(VERTEX2F((GRAPH_X + GRAPH_WIDTH) * 16, GRAPH_Y * 16));
+    cmd(VERTEX2F((GRAPH_X + GRAPH_WIDTH) * 16, (GRAPH_Y + GRAPH_HEIGHT) * 16));
+    cmd(VERTEX2F(GRAPH_X * 16, GRAPH_Y * 16));
+    cmd(VERTEX2F((GRAPH_X + GRAPH_WIDTH) * 16, GRAPH_Y * 16));
+    cmd(VERTEX2F(GRAPH_X * 16, (GRAPH_Y + GRAPH_HEIGHT) * 16));
+    cmd(VERTEX2F((GRAPH_X + GRAPH_WIDTH) * 16, (GRAPH_Y + GRAPH_HEIGHT) * 16));
+    cmd(END());
+    cmd_text(320, 10, 28, OPT_CENTER, "Interactive Hardware Test");
+
+    cmd(COLOR_RGB(0x00, 0xFF, 0xFF));
+    cmd_text(10, 212, 18, 0, "RE0: Timebase, RE1: Trigger Level (spin fast = big steps), RE1 push: FFT");
+    cmd_text(10, 227, 18, 0, "SW0: Toggle Relay Mode, SW2: Toggle Gain Mode");
+    cmd_text(10, 242, 18, 0, "SW1: Timebase, SW3: Peak/Average, RE0 Push: Scope");
+
+    cmd(COLOR_RGB(0xFF, 0x00, 0x00));
+    cmd(BEGIN(LINES));
+    cmd(VERTEX2F(10 * 16, 262 * 16));
+    cmd(VERTEX2F(110 * 16, 262 * 16));
+    cmd(END());
+}
+
+// waveform_draw와 같은 LINE_STRIP을 명령 FIFO로 직접
+static void draw_trace_inline(const decim_column_t *c, uint32_t color)
+{
+    const int32_t bottom16 = (GRAPH_Y + GRAPH_HEIGHT) * 16;
+    cmd(color);
+    cmd(BEGIN(LINE_STRIP));
+    for (int i = 0; i < GRAPH_WIDTH; i++) {
+        int32_t x16 = (GRAPH_X + i) * 16;
+        int32_t y_min = bottom16 - ((int32_t)c[i].min * GRAPH_HEIGHT * 16) / 4096;
+        int32_t y_max = bottom16 - ((int32_t)c[i].max * GRAPH_HEIGHT * 16) / 4096;
+        cmd(VERTEX2F(x16, (i & 1) ? y_max : y_min));
+        cmd(VERTEX2F(x16, (i & 1) ? y_min : y_max));
+    }
+    cmd(END());
+}
+
+// 매 프레임 바뀌는 글씨 (draw_ui_layout(false)의 스코프 모드)
+static void draw_status(uint32_t frame)
+{
+    static const int ys[] = { 0, 15, 45, 60, 75, 90, 105, 150, 165, 180, 195 };
+    char text[96];
+    cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+    for (size_t i = 0; i < sizeof(ys) / sizeof(ys[0]); i++) {
+        snprintf(text, sizeof(text), "CH%u: Vpp %.2fV Vrms %.2fV %lu", (unsigned)(i & 1) + 1,
+                 1.5 + 0.01 * (frame % 50), 0.53 + 0.001 * i, (unsigned long)(frame * 7 + i));
+        cmd_text(10, (int16_t)ys[i], 20, 0, text);
+    }
+}
+
+static void draw_frame(variant_t variant, uint32_t frame)
+{
+    make_columns(frame);
+    if (variant == VARIANT_CACHED) {
+        ui_dl_cache_update(&chrome_cache, 1, draw_chrome, NULL);
+    }
+
+    cmd(CMD_DLSTART);
+    if (variant == VARIANT_CACHED) {
+        waveform_begin_frame();
+    }
+    cmd(COLOR_RGB(0x20, 0x20, 0x20));
+    cmd(CLEAR(1, 1, 1));
+    if (variant != VARIANT_CACHED || !ui_dl_cache_append(&chrome_cache)) {
+        draw_chrome(NULL);
+    }
+    draw_status(frame);
+
+    if (variant == VARIANT_CACHED) {
+        wave_area_t area = { .x = GRAPH_X, .y = GRAPH_Y, .height = GRAPH_HEIGHT };
+        waveform_draw(0, cols[0], GRAPH_WIDTH, &area, COLOR_RGB(0x00, 0xFF, 0x00));
+        waveform_draw(1, cols[1], GRAPH_WIDTH, &area, COLOR_RGB(0x00, 0x00, 0xFF));
+    } else {
+        draw_trace_inline(cols[0], COLOR_RGB(0x00, 0xFF, 0x00));
+        draw_trace_inline(cols[1], COLOR_RGB(0x00, 0x00, 0xFF));
+    }
+
+    cmd(DISPLAY());
+    cmd(CMD_SWAP);
+}
+
+static void print_stats(const char *name, const ft800_emu_stats_t *s, uint32_t frames, uint32_t dl_bytes)
+{
+    double tr = (double)s->transactions / frames;
+    double bytes = (double)s->bytes / frames;
+    double us = s->bus_ns / 1e3 / frames;
+    printf("%-14s %7.1f %9.0f %9.0f %9.0f %7lu %8.1f %8.0f\n", name, tr, bytes, (double)s->cmd_bytes / frames,
+           (double)s->ram_g_bytes / frames, (unsigned long)dl_bytes, us, 1e6 / us);
+}
+
+static int run(variant_t variant, const char *out_dir)
+{
+    int failures = 0;
+    ft800_emu_stats_t first, total, last;
+    bus_stats_t bus_before, bus_after;
+    bus_stats_window_t bus_frame;
+    uint32_t bus_mismatch = 0;
+
+    ui_dl_cache_init(&chrome_cache);
+    uint32_t frames_before = ft800_emu_frames();
+
+    // 첫 프레임 (cached는 정적 UI 캐시를 만드는 비용 포함)
+    draw_frame(variant, 0);
+    bus_stats_frame_mark(frame_clock_us += 16667);
+    ft800_emu_frame_stats(&first);
+    ft800_emu_reset_totals();
+    bus_stats_get_total(BUS_STATS_SPI_FT800, &bus_before);
+    uint32_t max_dl = first.dl_bytes;
+    for (uint32_t f = 1; f < FRAMES; f++) {
+        draw_frame(variant, f);
+        bus_stats_frame_mark(frame_clock_us += 16667);
+        ft800_emu_frame_stats(&last);
+        max_dl = last.dl_bytes > max_dl ? last.dl_bytes : max_dl;
+        // 프레임 경계가 같음 (스왑이 프레임의 마지막 SPI)
+        if (!bus_stats_get_frame(&bus_frame) || bus_frame.bus[BUS_STATS_SPI_FT800].bytes != last.bytes ||
+            bus_frame.bus[BUS_STATS_SPI_FT800].transactions != last.transactions) {
+            bus_mismatch++;
+        }
+    }
+    ft800_emu_total_stats(&total);
+    bus_stats_get_total(BUS_STATS_SPI_FT800, &bus_after);
+
+    char name[32];
+    snprintf(name, sizeof(name), "%s first", variant_names[variant]);
+    print_stats(name, &first, 1, first.dl_bytes);
+    snprintf(name, sizeof(name), "%s steady", variant_names[variant]);
+    print_stats(name, &total, FRAMES - 1, last.dl_bytes);
+
+    if (ft800_emu_frames() - frames_before != FRAMES) {
+        printf("  MISMATCH: %lu frames swapped, expected %d\n",
+               (unsigned long)(ft800_emu_frames() - frames_before), FRAMES);
+        failures++;
+    }
+    if (bus_mismatch != 0 || bus_after.bytes - bus_before.bytes != total.bytes ||
+        bus_after.transactions - bus_before.transactions != total.transactions) {
+        printf("  MISMATCH: bus counters disagree with the emulator (%lu frames, %lu vs %lu bytes)\n",
+               (unsigned long)bus_mismatch, (unsigned long)(bus_after.bytes - bus_before.bytes),
+               (unsigned long)total.bytes);
+        failures++;
+    }
+    if (max_dl > 8192) {
+        printf("  MISMATCH: display list %lu bytes exceeds RAM_DL\n", (unsigned long)max_dl);
+        failures++;
+    }
+    if (!ft800_emu_cmd_idle()) {
+        printf("  MISMATCH: co-processor did not drain the command FIFO\n");
+        failures++;
+    }
+    if (!ft800_emu_render(pixels[variant])) {
+        printf("  MISMATCH: nothing to render\n");
+        failures++;
+    }
+    if (out_dir != NULL) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/render_%s.png", out_dir, variant_names[variant]);
+        if (!png_write_rgb(path, pixels[variant], FT800_EMU_WIDTH, FT800_EMU_HEIGHT)) {
+            printf("  failed to write %s\n", path);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out_dir = argc > 1 ? argv[1] : NULL;
+    int failures = 0;
+
+    ft800_emu_init();
+    spi_host_set_device_model(SPI2_HOST, ft800_emu_spi_transfer);
+    // 처음 부를 때 장치 인스턴스를 새로 만든다는 오류 로그는 정상 동작이므로 감춤
+    esp_log_level_set("*", ESP_LOG_NONE);
+    uint8_t init_ret = initFT800();
+    esp_log_level_set("*", ESP_LOG_WARN);
+    if (init_ret != 0) {
+        printf("initFT800 failed against the emulator\n");
+        return 1;
+    }
+
+    printf("%-14s %7s %9s %9s %9s %7s %8s %8s\n", "frame", "trans", "bytes", "cmd B", "RAM_G B", "DL B", "bus us",
+           "max fps");
+    failures += run(VARIANT_CACHED, out_dir);
+    failures += run(VARIANT_INLINE, out_dir);
+
+    // 같은 마지막 프레임이므로 래스터 결과가 같아야 함
+    uint32_t diff = 0, lit = 0;
+    for (uint32_t i = 0; i < PIXELS; i++) {
+        diff += pixels[VARIANT_CACHED][i] != pixels[VARIANT_INLINE][i];
+        lit += pixels[VARIANT_CACHED][i] != 0;     // CLEAR 색은 기본값(검정)
+    }
+    printf("pixels: %lu drawn, %lu differ between variants\n", (unsigned long)lit, (unsigned long)diff);
+    if (diff != 0 || lit == 0) {
+        printf("MISMATCH: variants rendered differently\n");
+        failures++;
+    }
+    if (ft800_emu_unsupported() != 0) {
+        printf("MISMATCH: %lu unsupported co-processor commands\n", (unsigned long)ft800_emu_unsupported());
+        failures++;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+// 샘플 압축 벤치마크 (호스트)
+//
+// 파형별로 스트림 블록 크기(256)로 나눠 압축/복원해 원본과 같은지 먼저 확인하고,
+// 압축률(uint16 대비)과 샘플당 비트, 인코드/디코드 속도를 출력한다.
+// 인자로 host/stream_decode.py --csv 로 저장한 캡처(sample,time_us,ch0,ch1)를 주면
+// 채널별로 같은 측정을 한다.
+//
+//   bench_sample_codec [capture.csv ...]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "sample_codec.h"
+
+#define SIGNAL_LEN      (1u << 18)
+#define BLOCK           256
+#define REALTIME_SPS    20000.0     // 두 채널 합계
+#define MAX_CAPTURE     (1u << 22)
+
+static uint16_t signal_buf[MAX_CAPTURE];
+static uint16_t decoded[BLOCK];
+static uint8_t packed[(MAX_CAPTURE / BLOCK + 1) * SAMPLE_CODEC_MAX_BYTES(BLOCK)];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t rng = 1;
+
+static int noise(int amp)
+{
+    rng = rng * 1103515245u + 12345u;
+    return (int)((rng >> 16) % (2 * amp + 1)) - amp;
+}
+
+static uint16_t clamp12(int v)
+{
+    return (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+}
+
+// 블록 단위로 전부 압축. 압축 바이트 수 반환
+static size_t encode_all(const uint16_t *in, uint32_t len)
+{
+    size_t total = 0;
+    for (uint32_t pos = 0; pos < len; pos += BLOCK) {
+        uint32_t n = len - pos < BLOCK ? len - pos : BLOCK;
+        total += sample_codec_encode(in + pos, n, packed + total, SAMPLE_CODEC_MAX_BYTES(BLOCK));
+    }
+    return total;
+}
+
+// 전부 복원하며 원본과 비교. 틀리면 false
+static bool verify_all(const uint16_t *in, uint32_t len, size_t packed_len)
+{
+    size_t off = 0;
+    for (uint32_t pos = 0; pos < len; pos += BLOCK) {
+        uint32_t n = len - pos < BLOCK ? len - pos : BLOCK;
+        size_t used = sample_codec_decode(packed + off, packed_len - off, decoded, n);
+        if (used == 0 || used > SAMPLE_CODEC_MAX_BYTES(n) || memcmp(decoded, in + pos, n * sizeof(uint16_t)) != 0) {
+            return false;
+        }
+        off += used;
+    }
+    return off == packed_len;
+}
+
+static size_t decode_all(uint32_t len, size_t packed_len)
+{
+    size_t off = 0;
+    for (uint32_t pos = 0; pos < len; pos += BLOCK) {
+        uint32_t n = len - pos < BLOCK ? len - pos : BLOCK;
+        off += sample_codec_decode(packed + off, packed_len - off, decoded, n);
+    }
+    return off;
+}
+
+static int run(const char *name, const uint16_t *in, uint32_t len)
+{
+    size_t packed_len = encode_all(in, len);
+    if (!verify_all(in, len, packed_len)) {
+        printf("%-16s MISMATCH\n", name);
+        return 1;
+    }
+
+    uint32_t rounds = 0;
+    double t0 = now_sec(), t1;
+    do {
+        encode_all(in, len);
+        rounds++;
+        t1 = now_sec();
+    } while (t1 - t0 < 0.2);
+    double enc = (double)len * 2 * rounds / (t1 - t0);
+
+    rounds = 0;
+    t0 = now_sec();
+    do {
+        decode_all(len, packed_len);
+        rounds++;
+        t1 = now_sec();
+    } while (t1 - t0 < 0.2);
+    double dec = (double)len * 2 * rounds / (t1 - t0);
+
+    double ratio = (double)len * 2 / packed_len;
+    printf("%-16s %9u %7.2fx %9.2f %9.1f %9.1f %11.0f\n", name, len, ratio, packed_len * 8.0 / len,
+           enc / 1e6, dec / 1e6, enc / 2 / REALTIME_SPS);
+    return 0;
+}
+
+// stream_decode.py CSV (sample,time_us,ch0,ch1)의 한 채널
+static uint32_t load_csv(const char *path, int ch)
+{
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return 0;
+    }
+    char line[128];
+    uint32_t n = 0;
+    while (n < MAX_CAPTURE && fgets(line, sizeof(line), f) != NULL) {
+        unsigned long sample, t;
+        int v0, v1;
+        int got = sscanf(line, "%lu,%lu,%d,%d", &sample, &t, &v0, &v1);
+        if (got >= 3 + ch) {
+            signal_buf[n++] = (uint16_t)((ch == 0 ? v0 : v1) & 0x0FFF);
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    int failures = 0;
+
+    printf("sample codec: delta + zigzag + %u-sample group bit packing, %u-sample blocks\n",
+           SAMPLE_CODEC_GROUP, BLOCK);
+    printf("%-16s %9s %8s %9s %9s %9s %11s\n", "waveform", "samples", "ratio", "bits/smp",
+           "enc MB/s", "dec MB/s", "x realtime");
+
+    // 50Hz 사인 (10kHz 샘플링) + ADC 잡음 +-3 LSB
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = clamp12(2048 + (int)(1800 * sin(2.0 * M_PI * 50.0 * i / 10000.0)) + noise(3));
+    }
+    failures += run("sine+noise", signal_buf, SIGNAL_LEN);
+
+    // 1kHz 구형파 (가장자리에서 큰 차분)
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = clamp12(((i / 5) & 1 ? 3500 : 500) + noise(2));
+    }
+    failures += run("square+noise", signal_buf, SIGNAL_LEN);
+
+    // 입력 없음 (잡음만)
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = clamp12(1900 + noise(4));
+    }
+    failures += run("idle noise", signal_buf, SIGNAL_LEN);
+
+    // 완전히 평평한 신호 (RLE 경로)
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = 0;
+    }
+    failures += run("flat", signal_buf, SIGNAL_LEN);
+
+    // 최악: 무작위 12비트
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        signal_buf[i] = (uint16_t)(noise(2048) + 2047) & 0x0FFF;
+    }
+    failures += run("random (worst)", signal_buf, SIGNAL_LEN);
+
+    // 블록 끝 처리 (그룹 크기로 나누어떨어지지 않는 길이)
+    for (uint32_t n = 1; n <= 40; n++) {
+        uint8_t buf[SAMPLE_CODEC_MAX_BYTES(40)];
+        size_t used = sample_codec_encode(signal_buf, n, buf, sizeof(buf));
+        if (used == 0 || sample_codec_decode(buf, used, decoded, n) != used ||
+            memcmp(decoded, signal_buf, n * sizeof(uint16_t)) != 0) {
+            printf("length %u MISMATCH\n", n);
+            failures++;
+        }
+    }
+
+    // 녹화된 캡처
+    for (int a = 1; a < argc; a++) {
+        for (int ch = 0; ch < 2; ch++) {
+            uint32_t n = load_csv(argv[a], ch);
+            if (n == 0) {
+                continue;
+            }
+            char name[64];
+            const char *base = strrchr(argv[a], '/');
+            snprintf(name, sizeof(name), "%.12s ch%d", base ? base + 1 : argv[a], ch);
+            failures += run(name, signal_buf, n);
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+// 소프트웨어 트리거 스캔 벤치마크 (호스트)
+//
+// 합성 신호(사인 + 노이즈 + 펄스/런트)를 DMA 프레임 크기(채널당 64샘플)로 잘라
+// 트리거 모드별로 스캔하고 초당 처리 샘플 수를 출력한다.
+// 결과가 맞는지 먼저 한 샘플씩 처리하는 단순 구현과 트리거 위치를 비교한다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "soft_trigger.h"
+#include "adc_dma_continuous.h"
+
+#define SIGNAL_LEN      (1u << 20)  // 1M 샘플
+#define FRAME_SAMPLES   64          // DMA 프레임 하나의 채널당 샘플 수
+#define MAX_HITS        (1u << 16)
+#define REALTIME_SPS    ((double)ADC_CHANNEL_SAMPLE_HZ)    // 펌웨어 채널당 샘플레이트
+
+static uint16_t signal_buf[SIGNAL_LEN];
+static uint32_t hits_fast[MAX_HITS];
+static uint32_t hits_ref[MAX_HITS];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 사인파 + 노이즈, 가끔 좁은 펄스와 런트를 섞은 12비트 신호
+static void make_signal(void)
+{
+    uint32_t rng = 12345;
+
+    for (uint32_t i = 0; i < SIGNAL_LEN; i++) {
+        rng = rng * 1103515245u + 12345u;
+        double noise = ((int)((rng >> 16) & 0x3F) - 32);
+        double v = 2048.0 + 1500.0 * sin(2.0 * M_PI * i / 400.0) + noise;
+
+        uint32_t phase = i % 5000;
+        if (phase >= 100 && phase < 108) {
+            v = 3800.0;             // 좁은 펄스
+        } else if (phase >= 2500 && phase < 2530) {
+            v = 2600.0;             // 런트 (1500~3000 사이)
+        }
+        if (v < 0) {
+            v = 0;
+        }
+        if (v > 4095) {
+            v = 4095;
+        }
+        signal_buf[i] = (uint16_t)v;
+    }
+}
+
+// ---- 참조 구현: 한 샘플씩, 같은 규칙 ----
+
+typedef struct {
+    int state;          // 0: 중립, 1: 아래, 2: 위, 3: 런트(아래에서), 4: 런트(위에서)
+    int edge_valid;
+    int edge_rising;
+    uint32_t edge_seq;
+} ref_state_t;
+
+static int ref_has(soft_trig_slope_t slope, int rising)
+{
+    return slope == SOFT_TRIG_SLOPE_EITHER || (rising ? slope == SOFT_TRIG_SLOPE_RISING
+                                                     : slope == SOFT_TRIG_SLOPE_FALLING);
+}
+
+static int ref_clamp(int v)
+{
+    return v < 0 ? 0 : (v > 0x1000 ? 0x1000 : v);
+}
+
+static uint32_t ref_scan(const soft_trig_config_t *cfg, uint32_t *hits)
+{
+    ref_state_t st = {0};
+    uint32_t nhits = 0;
+    int level = cfg->level;
+    int edge = cfg->type == SOFT_TRIG_EDGE;
+    int want_rise = !edge || ref_has(cfg->slope, 1);
+    int want_fall = !edge || ref_has(cfg->slope, 0);
+
+    for (uint32_t i = 0; i < SIGNAL_LEN && nhits < MAX_HITS; i++) {
+        int x = signal_buf[i];
+        int crossing = -1;
+
+        if (cfg->type == SOFT_TRIG_RUNT) {
+            int lo = cfg->level, hi = cfg->level_high;
+            int ret_lo = ref_clamp(lo - cfg->hysteresis), ret_hi = ref_clamp(hi + cfg->hysteresis);
+            switch (st.state) {
+                case 0: if (x < lo) st.state = 1; else if (x >= hi) st.state = 2; break;
+                case 1: if (x >= lo) { st.edge_seq = i; st.state = 3; } break;
+                case 2: if (x < hi) { st.edge_seq = i; st.state = 4; } break;
+                case 3:
+                    if (x >= hi) st.state = 2;
+                    else if (x < ret_lo) { st.state = 1; if (ref_has(cfg->slope, 1)) hits[nhits++] = i; }
+                    break;
+                case 4:
+                    if (x < lo) st.state = 1;
+                    else if (x >= ret_hi) { st.state = 2; if (ref_has(cfg->slope, 0)) hits[nhits++] = i; }
+                    break;
+            }
+            continue;
+        }
+
+        int arm_rise = ref_clamp(level - cfg->hysteresis);
+        int arm_fall = ref_clamp(level + cfg->hysteresis);
+        switch (st.state) {
+            case 0:
+                if (want_rise && x < arm_rise) st.state = 1;
+                else if (want_fall && x >= arm_fall) st.state = 2;
+                break;
+            case 1: if (x >= level) { crossing = 1; st.state = 0; } break;
+            case 2: if (x < level) { crossing = 0; st.state = 0; } break;
+        }
+        if (crossing < 0) {
+            continue;
+        }
+        if (edge) {
+            if (ref_has(cfg->slope, crossing)) hits[nhits++] = i;
+        } else if (st.edge_valid && st.edge_rising != crossing) {
+            uint32_t width = i - st.edge_seq;
+            int positive = !crossing;
+            int match = cfg->width_cond == SOFT_TRIG_WIDTH_GREATER ? width > cfg->width_samples
+                                                                  : width < cfg->width_samples;
+            if (ref_has(cfg->slope, positive) && match) hits[nhits++] = i;
+        }
+        st.edge_seq = i;
+        st.edge_rising = crossing;
+        st.edge_valid = 1;
+    }
+    return nhits;
+}
+
+// ---- 실제 구현: DMA 프레임 단위로 ----
+
+static uint32_t fast_scan(const soft_trig_config_t *cfg, uint32_t *hits)
+{
+    soft_trig_t trig;
+    uint32_t nhits = 0;
+
+    soft_trig_init(&trig, cfg);
+    for (uint32_t base = 0; base < SIGNAL_LEN; base += FRAME_SAMPLES) {
+        uint32_t off = 0;
+        while (off < FRAME_SAMPLES) {
+            uint32_t used;
+            if (soft_trig_scan(&trig, signal_buf + base + off, FRAME_SAMPLES - off, &used)) {
+                if (hits && nhits < MAX_HITS) {
+                    hits[nhits] = trig.trigger_seq;
+                }
+                nhits++;
+            }
+            off += used;
+        }
+    }
+    return nhits;
+}
+
+typedef struct {
+    const char *name;
+    soft_trig_config_t cfg;
+} bench_case_t;
+
+static const bench_case_t cases[] = {
+    { "edge rising",      { SOFT_TRIG_EDGE, SOFT_TRIG_SLOPE_RISING, 2048, 0, 40, 0, 0 } },
+    { "edge falling",     { SOFT_TRIG_EDGE, SOFT_TRIG_SLOPE_FALLING, 2048, 0, 40, 0, 0 } },
+    { "edge either",      { SOFT_TRIG_EDGE, SOFT_TRIG_SLOPE_EITHER, 2048, 0, 40, 0, 0 } },
+    { "edge no-hyst",     { SOFT_TRIG_EDGE, SOFT_TRIG_SLOPE_RISING, 2048, 0, 0, 0, 0 } },
+    { "pulse width < 20", { SOFT_TRIG_PULSE_WIDTH, SOFT_TRIG_SLOPE_RISING, 3600, 0, 40, SOFT_TRIG_WIDTH_LESS, 20 } },
+    { "pulse width > 150",{ SOFT_TRIG_PULSE_WIDTH, SOFT_TRIG_SLOPE_EITHER, 2048, 0, 40, SOFT_TRIG_WIDTH_GREATER, 150 } },
+    { "runt",             { SOFT_TRIG_RUNT, SOFT_TRIG_SLOPE_RISING, 1500, 3000, 40, 0, 0 } },
+    { "idle (no trigger)",{ SOFT_TRIG_EDGE, SOFT_TRIG_SLOPE_RISING, 4090, 0, 10, 0, 0 } },
+};
+
+int main(void)
+{
+    int failures = 0;
+
+    make_signal();
+    printf("soft trigger scan: %u samples, %u-sample frames\n", SIGNAL_LEN, FRAME_SAMPLES);
+    printf("%-20s %8s %14s %12s\n", "mode", "hits", "samples/s", "x realtime");
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const bench_case_t *bc = &cases[c];
+
+        // 정확도 확인
+        uint32_t n_ref = ref_scan(&bc->cfg, hits_ref);
+        uint32_t n_fast = fast_scan(&bc->cfg, hits_fast);
+        if (n_ref != n_fast || memcmp(hits_ref, hits_fast, n_ref * sizeof(uint32_t)) != 0) {
+            printf("%-20s MISMATCH (ref %u hits, fast %u hits)\n", bc->name, n_ref, n_fast);
+            failures++;
+            continue;
+        }
+
+        // 속도 (최소 0.2초 반복)
+        uint32_t rounds = 0;
+        double t0 = now_sec(), t1;
+        do {
+            fast_scan(&bc->cfg, NULL);
+            rounds++;
+            t1 = now_sec();
+        } while (t1 - t0 < 0.2);
+
+        double sps = (double)SIGNAL_LEN * rounds / (t1 - t0);
+        printf("%-20s %8u %14.3e %12.0f\n", bc->name, n_fast, sps, sps / REALTIME_SPS);
+    }
+
+    return failures ? 1 : 0;
+}
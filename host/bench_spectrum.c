@@ -0,0 +1,167 @@
+// 스펙트럼(고정소수점 FFT) 정확도/속도 벤치마크 (호스트)
+//
+// 창 함수 4종 x 점 수(256/1024/4096)마다 12비트로 양자화한 두 톤 신호(큰 톤 + -43 dBFS 작은 톤)를
+// 넣고, 같은 입력과 같은 Q15 창의 배정밀도 DFT와 비교한다.
+//   - -60 dBFS 이상 빈의 dB 오차 최대값
+//   - 고정소수점 연산 오차 바닥 (복소 오차 전력, dBFS)
+//   - 플랫탑 창: 빈 사이 주파수 톤의 진폭 오차
+// 끝으로 spectrum_push + spectrum_compute + spectrum_columns 한 번(한 채널)에 걸린 시간과
+// 두 채널 기준 초당 갱신 수를 출력한다.
+//
+//   bench_spectrum
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "spectrum.h"
+
+#define COLUMNS         480
+#define MAX_DB_ERROR    0.05        // -60 dBFS 이상 빈 (그 아래는 오차 바닥으로 확인)
+#define MAX_ERR_FLOOR   (-100.0)    // 연산 오차 바닥 상한 (dBFS)
+#define TARGET_UPDATES  10.0        // 두 채널 스펙트럼 초당 갱신 목표
+
+static spectrum_t spec;
+static uint16_t signal_buf[SPECTRUM_MAX_POINTS];
+static double ref_re[SPECTRUM_MAX_POINTS / 2 + 1];
+static double ref_im[SPECTRUM_MAX_POINTS / 2 + 1];
+static double cos_tab[SPECTRUM_MAX_POINTS];
+static int32_t fixed_out[SPECTRUM_MAX_POINTS + 2];
+static decim_column_t cols[COLUMNS];
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t rng = 1;
+
+static double noise(void)
+{
+    rng = rng * 1103515245u + 12345u;
+    return ((rng >> 8) & 0xFFFF) / 65536.0 - 0.5;
+}
+
+// 두 톤 + 디더 후 12비트 양자화
+static void make_signal(uint32_t n, double bin_a, double amp_a, double bin_b, double amp_b)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        double v = 2048 + amp_a * sin(2 * M_PI * bin_a * i / n) + amp_b * sin(2 * M_PI * bin_b * i / n + 1.0) +
+                   noise();
+        long q = lround(v);
+        signal_buf[i] = (uint16_t)(q < 0 ? 0 : q > 4095 ? 4095 : q);
+    }
+}
+
+// 같은 입력, 같은 Q15 창으로 배정밀도 DFT (raw 단위)
+static void reference_dft(uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        cos_tab[i] = cos(2 * M_PI * i / n);
+    }
+    for (uint32_t k = 0; k <= n / 2; k++) {
+        double re = 0, im = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            double x = ((int)signal_buf[i] - 2048) * (spec.win_q15[i] / 32768.0);
+            uint32_t idx = (uint32_t)(((uint64_t)i * k) % n);
+            re += x * cos_tab[idx];
+            im -= x * cos_tab[(idx + 3 * n / 4) % n];     // sin(a) = cos(a - pi/2)
+        }
+        ref_re[k] = re;
+        ref_im[k] = im;
+    }
+}
+
+// 풀스케일 사인(진폭 2048) 피크의 |X|
+static double full_scale(void)
+{
+    double sum = 0;
+    for (uint32_t i = 0; i < spec.points; i++) {
+        sum += spec.win_q15[i] / 32768.0;
+    }
+    return 2048 * sum / 2;
+}
+
+static int check(uint32_t n, spectrum_window_t window)
+{
+    double bin_a = n / 8 + (window == SPECTRUM_WINDOW_FLATTOP ? 0.37 : 0.0);
+    double amp_a = 1500, amp_b = 15;
+    make_signal(n, bin_a, amp_a, n / 3 + 0.5, amp_b);
+
+    spectrum_init(&spec, n, window);
+    spectrum_push(&spec, signal_buf, n);
+    // spectrum_compute가 작업 버퍼를 덮어쓰므로 복소 결과 비교용으로 따로 한 번 더
+    memcpy(fixed_out, spec.work, n * sizeof(int32_t));
+    fft_fixed_real(&spec.fft, fixed_out);
+    spectrum_compute(&spec);
+    reference_dft(n);
+
+    double fs = full_scale();
+    double max_err = 0, err_pow = 0;
+    for (uint32_t k = 0; k <= n / 2; k++) {
+        // 고정소수점 입력은 raw * 2^8 (>> 9 후 2^17 = 2048 * 2^6 이므로 raw 단위로 되돌리면 / 64), 출력은 2X
+        double fr = fixed_out[2 * k] / 128.0, fi = fixed_out[2 * k + 1] / 128.0;
+        double er = fr - ref_re[k], ei = fi - ref_im[k];
+        err_pow += er * er + ei * ei;
+
+        double ref_db = 10 * log10((ref_re[k] * ref_re[k] + ref_im[k] * ref_im[k]) / (fs * fs) + 1e-30);
+        if (ref_db > -60) {
+            double e = fabs(spec.db[k] / 100.0 - ref_db);
+            max_err = e > max_err ? e : max_err;
+        }
+    }
+    double floor_db = 10 * log10(err_pow / (n / 2 + 1) / (fs * fs) + 1e-30);
+
+    // 큰 톤 진폭 (플랫탑은 빈 사이에서도 맞아야 함, 나머지는 빈 중앙)
+    int peak = -32768;
+    for (uint32_t k = 1; k <= n / 2; k++) {
+        peak = spec.db[k] > peak ? spec.db[k] : peak;
+    }
+    double want = 20 * log10(amp_a / 2048);
+    double amp_err = peak / 100.0 - want;
+
+    uint32_t c = spectrum_columns(&spec, cols, COLUMNS);
+    bool ok = max_err <= MAX_DB_ERROR && floor_db <= MAX_ERR_FLOOR && fabs(amp_err) <= 0.1 && c == COLUMNS;
+    printf("%5u %-16s %8.4f %9.1f %+8.3f %6.3f %5.2f  %s\n", n, spectrum_window_name(window), max_err, floor_db,
+           amp_err, spec.coherent_gain, spec.enbw_bins, ok ? "ok" : "MISMATCH");
+    return ok ? 0 : 1;
+}
+
+int main(void)
+{
+    int failures = 0;
+    static const uint32_t sizes[] = { 256, 1024, 4096 };
+
+    printf("%5s %-16s %8s %9s %8s %6s %5s\n", "N", "window", "dB err", "err floor", "amp err", "CG", "ENBW");
+    for (int w = 0; w < SPECTRUM_WINDOW_COUNT; w++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            failures += check(sizes[i], (spectrum_window_t)w);
+        }
+    }
+
+    // 속도: 한 채널 스펙트럼 (창 곱 + FFT + dB + 열)
+    printf("%5s %12s %14s\n", "N", "us/spectrum", "updates/s x2ch");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        uint32_t n = sizes[i];
+        spectrum_init(&spec, n, SPECTRUM_WINDOW_HANN);
+        make_signal(n, n / 8, 1500, n / 3, 15);
+        uint32_t rounds = 0;
+        double t0 = now_sec(), t1;
+        do {
+            spectrum_push(&spec, signal_buf, n);
+            spectrum_compute(&spec);
+            spectrum_columns(&spec, cols, COLUMNS);
+            rounds++;
+            t1 = now_sec();
+        } while (t1 - t0 < 0.2);
+        double us = (t1 - t0) / rounds * 1e6;
+        double updates = 1e6 / (2 * us);
+        printf("%5u %12.1f %14.0f%s\n", n, us, updates, updates < TARGET_UPDATES ? "  BELOW TARGET" : "");
+    }
+
+    return failures ? 1 : 0;
+}
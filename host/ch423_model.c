@@ -0,0 +1,138 @@
+// CH423 I/O 익스팬더 모델 (호스트)
+
+#include <stdatomic.h>
+#include <string.h>
+#include "ch423_model.h"
+
+#define CH423_ADDR_CMD      0x20    // 명령 바이트 방식
+#define CH423_ADDR_OC_L     0x22
+#define CH423_ADDR_OC_H     0x23
+#define CH423_ADDR_SYS      0x24
+#define CH423_ADDR_IO_IN    0x26
+#define CH423_ADDR_IO_OUT   0x30
+
+#define CH423_CMD_IO_OUT    0x48
+#define CH423_CMD_IO_IN     0x49
+#define CH423_CMD_IO_DIR    0x4A
+
+static _Atomic uint8_t model_input = 0xFF;
+static _Atomic uint16_t model_oc;
+static _Atomic uint8_t model_io_out;
+static uint8_t model_last_cmd;          // 0x20에 마지막으로 쓴 명령 (버스 잠금 안에서만 접근)
+static bool model_io_out_pending;       // 0x48 다음 바이트가 IO 출력 값
+static _Atomic uint32_t stat_writes, stat_reads, stat_oc_writes, stat_nacks;
+
+void ch423_model_init(void)
+{
+    atomic_store(&model_input, 0xFF);
+    atomic_store(&model_oc, 0);
+    atomic_store(&model_io_out, 0);
+    model_last_cmd = 0;
+    model_io_out_pending = false;
+    atomic_store(&stat_writes, 0);
+    atomic_store(&stat_reads, 0);
+    atomic_store(&stat_oc_writes, 0);
+    atomic_store(&stat_nacks, 0);
+}
+
+static void set_oc_byte(bool high, uint8_t value)
+{
+    uint16_t cur = atomic_load(&model_oc);
+    uint16_t next;
+    do {
+        next = high ? (uint16_t)((cur & 0x00FF) | (value << 8)) : (uint16_t)((cur & 0xFF00) | value);
+    } while (!atomic_compare_exchange_weak(&model_oc, &cur, next));
+    atomic_fetch_add(&stat_oc_writes, 1);
+}
+
+esp_err_t ch423_model_transfer(uint8_t addr, const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len)
+{
+    if (wr_len > 0) {
+        atomic_fetch_add(&stat_writes, 1);
+    }
+
+    switch (addr) {
+    case CH423_ADDR_CMD:
+        // 펌웨어는 명령과 데이터를 각각 한 바이트 전송으로 보낸다
+        for (size_t i = 0; i < wr_len; i++) {
+            if (model_io_out_pending) {
+                atomic_store(&model_io_out, wr[i]);
+                model_io_out_pending = false;
+                continue;
+            }
+            model_last_cmd = wr[i];
+            model_io_out_pending = wr[i] == CH423_CMD_IO_OUT;
+        }
+        if (rd_len > 0) {
+            if (model_last_cmd != CH423_CMD_IO_IN) {
+                atomic_fetch_add(&stat_nacks, 1);
+                return ESP_FAIL;
+            }
+            memset(rd, atomic_load(&model_input), rd_len);
+            atomic_fetch_add(&stat_reads, 1);
+        }
+        return ESP_OK;
+
+    case CH423_ADDR_OC_L:
+    case CH423_ADDR_OC_H:
+        if (wr_len > 0) {
+            set_oc_byte(addr == CH423_ADDR_OC_H, wr[wr_len - 1]);
+        }
+        return rd_len ? ESP_FAIL : ESP_OK;
+
+    case CH423_ADDR_SYS:
+        return rd_len ? ESP_FAIL : ESP_OK;
+
+    case CH423_ADDR_IO_OUT:
+        if (wr_len > 0) {
+            atomic_store(&model_io_out, wr[wr_len - 1]);
+        }
+        return rd_len ? ESP_FAIL : ESP_OK;
+
+    case CH423_ADDR_IO_IN:
+        if (rd_len > 0) {
+            memset(rd, atomic_load(&model_input), rd_len);
+            atomic_fetch_add(&stat_reads, 1);
+        }
+        return ESP_OK;
+
+    default:
+        atomic_fetch_add(&stat_nacks, 1);
+        return ESP_FAIL;
+    }
+}
+
+void ch423_model_set_input_bit(int bit, bool level)
+{
+    if (bit < 0 || bit > 7) {
+        return;
+    }
+    if (level) {
+        atomic_fetch_or(&model_input, (uint8_t)(1u << bit));
+    } else {
+        atomic_fetch_and(&model_input, (uint8_t)~(1u << bit));
+    }
+}
+
+uint8_t ch423_model_input(void)
+{
+    return atomic_load(&model_input);
+}
+
+uint16_t ch423_model_outputs(void)
+{
+    return atomic_load(&model_oc);
+}
+
+uint8_t ch423_model_io_outputs(void)
+{
+    return atomic_load(&model_io_out);
+}
+
+void ch423_model_get_stats(ch423_model_stats_t *stats)
+{
+    stats->writes = atomic_load(&stat_writes);
+    stats->reads = atomic_load(&stat_reads);
+    stats->oc_writes = atomic_load(&stat_oc_writes);
+    stats->nacks = atomic_load(&stat_nacks);
+}
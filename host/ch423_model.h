@@ -0,0 +1,52 @@
+#ifndef CH423_MODEL_H
+#define CH423_MODEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// CH423 I/O 익스팬더 모델 (호스트)
+//
+// i2c_host_set_device_model(I2C_NUM_0, ch423_model_transfer)로 연결한다.
+// CH423은 명령을 I2C 주소 자리에 넣는 칩이라 "주소"마다 동작이 다르다.
+//   - 0x20: 이 보드 펌웨어가 쓰는 명령 바이트 방식 (0x48 IO 출력, 0x49 IO 입력 읽기, 0x4A 방향)
+//           명령 0x49 뒤 읽기는 IO 입력 바이트, 그 밖의 쓰기는 받기만 함
+//   - 0x22/0x23: OC0~7 / OC8~15 쓰기
+//   - 0x24: 시스템 설정, 0x30: IO 출력 쓰기, 0x26: IO 입력 읽기 (데이터시트 주소 방식)
+//   - 다른 주소는 응답 없음 (ESP_FAIL)
+// 입력 핀(버튼 등)은 ch423_model_set_input_bit로 바꾼다. 기본값은 모두 1 (풀업, 안 눌림)
+
+typedef struct {
+    uint32_t writes;        // 받은 쓰기 전송
+    uint32_t reads;         // 입력 읽기
+    uint32_t oc_writes;     // OC 바이트 쓰기
+    uint32_t nacks;         // 응답하지 않은 전송
+} ch423_model_stats_t;
+
+// 상태 초기화 (입력 0xFF, 출력 0)
+void ch423_model_init(void);
+
+// I2C 버스 모델 (i2c_host_transfer_fn과 같은 모양)
+esp_err_t ch423_model_transfer(uint8_t addr, const uint8_t *wr, size_t wr_len, uint8_t *rd, size_t rd_len);
+
+// IO 입력 핀 (0~7) 레벨
+void ch423_model_set_input_bit(int bit, bool level);
+uint8_t ch423_model_input(void);
+
+// OC0~15 출력 (비트 n = OCn)
+uint16_t ch423_model_outputs(void);
+// IO 출력 (명령 0x48 또는 주소 0x30으로 쓴 값)
+uint8_t ch423_model_io_outputs(void);
+
+void ch423_model_get_stats(ch423_model_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CH423_MODEL_H
@@ -0,0 +1,446 @@
+// 펌웨어 태스크 그래프 호스트 실행 (FreeRTOS/ESP-IDF 대역 + 주변장치 모델)
+//
+// app_main의 hardware_test_task와 같은 순서(run_hardware_test -> print_hardware_test_results ->
+// start_interactive_test)로 펌웨어를 고치지 않고 Linux 스레드 위에서 돌린다.
+//   - ADC: 합성 continuous 드라이버 (CH6 1 kHz 사인, CH7 250 Hz 사각), 실제와 같은 프레임 주기로
+//     on_conv_done -> adc 처리 태스크 큐. 트리거 비교기가 CH6과 DAC 레벨로 TRIG0(GPIO9)을 움직임
+//   - FT800: 에뮬레이터 + 60 Hz vsync 스레드, INT_N -> GPIO27 (render_sched가 그대로 페이싱)
+//   - CH423: I2C 모델 (버튼 입력, OC 출력)
+//   - 로터리 인코더: PCNT가 없어 ISR 백엔드, A/B 핀을 gpio_host_set_level로 움직임
+// 상호작용 루프가 돌기 시작하면 초마다 통계를 찍고, 중간에 RE1 한 클릭(LED0 토글)과 SW1 누름
+// (시간축 1 -> 2)을 넣는다.
+// 확인:
+//   - 화면 프레임이 vsync 속도(60 fps)에 맞음
+//   - ADC 변환이 설정 속도에서 나오는 수의 98% 이상, 처리 태스크 큐가 넘치지 않음
+//   - 측정 엔진의 CH0 주파수가 1 kHz
+//   - RE1 클릭으로 CH423 OC12(LED0)가 바뀌고, SW1로 시간축이 2 smp/px가 됨
+//
+// 캡처 재생 (--replay): 합성 파형 대신 프레임 덤프(--record로 저장) 또는 stream_decode.py CSV를
+// 드라이버 자리에서 재생한다. 반복하지 않는 재생은 상호작용 확인이 끝날 때까지 잡아 두었다가
+// 수집을 멈추고(트리거 재무장 시점이 실행 속도에 따라 달라지지 않게) 풀어 준다.
+// 파일 끝까지 재생하고 처리 태스크가 다 소화하면 링 샘플의 CRC와 측정 결과를 "digest"로 찍는다.
+// 같은 파일이면 실시간/최대 속도(--max-speed) 어느 쪽이든 같아야 하고, --expect로 기대값을 주면
+// 다를 때 실패한다. 재생 중에는 합성 파형 전용 확인(1 kHz, 변환 속도)은 뺀다.
+//
+//   firmware_host [seconds] [out.png] [-v] [--record dump.adcf]
+//   firmware_host [seconds] --replay dump.adcf|capture.csv [--max-speed] [--loop] [--expect crc32]
+// 모르는 옵션('-'로 시작)이나 값이 빠진 옵션은 사용법을 찍고 2로 끝난다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "driver/i2c.h"
+#include "driver/spi_master.h"
+#include "esp_adc/adc_continuous.h"
+#include "hardware_test.h"
+#include "interactive_test.h"
+#include "adc_dma_continuous.h"
+#include "ch423_service.h"
+#include "bus_stats.h"
+#include "ft800_emu.h"
+#include "ch423_model.h"
+#include "png_write.h"
+#include "stream_frame.h"
+#include "adc_ring.h"
+
+#define FT800_INT_GPIO      27
+#define TRIG0_GPIO          9
+#define RE1_A_GPIO          13
+#define RE1_B_GPIO          12
+#define CH423_BIT_SW1       3
+#define CH423_OC_LED0       12
+
+#define VSYNC_HZ            60
+#define SINE_HZ             1000.0f
+#define SETTLE_MS           500         // 상호작용 루프 시작 후 통계 전 대기
+#define STARTUP_TIMEOUT_S   30
+#define DIGEST_SAMPLES      4096        // digest에 넣는 최근 샘플 (채널당)
+#define DRAIN_QUIET_MS      300         // 이만큼 링이 안 바뀌면 처리가 끝난 것으로 봄
+
+static volatile bool vsync_run = true;
+
+static void sleep_ms(uint32_t ms)
+{
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+// INT_N (active low) -> GPIO27, 하강 에지에서 render_sched ISR
+static void ft800_int_changed(bool asserted)
+{
+    gpio_host_set_level(FT800_INT_GPIO, asserted ? 0 : 1);
+}
+
+static void *vsync_thread(void *arg)
+{
+    (void)arg;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (vsync_run) {
+        next.tv_nsec += 1000000000L / VSYNC_HZ;
+        if (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        ft800_emu_vsync();
+    }
+    return NULL;
+}
+
+// app_main.c의 hardware_test_task와 같은 순서
+static void hardware_test_task(void *arg)
+{
+    (void)arg;
+    hardware_test_results_t results;
+    esp_err_t ret = run_hardware_test(&results);
+    if (ret == ESP_OK) {
+        print_hardware_test_results(&results);
+    } else {
+        printf("run_hardware_test failed: %s\n", esp_err_to_name(ret));
+    }
+    // 보드에서는 상호작용 테스트 초기값(128)과 같은 트리거 레벨
+    adc_dma_set_trigger_level(128);
+    start_interactive_test();
+    vTaskDelete(NULL);
+}
+
+// RE1 시계 방향 한 클릭 (쉬는 상태 AB=11에서 11 -> 10 -> 00 -> 01 -> 11)
+static void encoder_detent_cw(void)
+{
+    static const uint8_t seq[] = { 0x2, 0x0, 0x1, 0x3 };   // (A << 1) | B
+    for (size_t i = 0; i < sizeof(seq); i++) {
+        gpio_host_set_level(RE1_A_GPIO, (seq[i] >> 1) & 1);
+        gpio_host_set_level(RE1_B_GPIO, seq[i] & 1);
+        sleep_ms(3);
+    }
+}
+
+typedef struct {
+    uint32_t frames;
+    uint64_t adc_frames;
+    uint64_t conversions;
+    uint32_t queue_full;
+    uint32_t pool_overflows;
+    uint32_t late_frames;
+    int64_t t_us;
+} snapshot_t;
+
+static void take_snapshot(snapshot_t *s)
+{
+    adc_continuous_host_stats_t st;
+    adc_continuous_host_get_stats(&st);
+    s->frames = ft800_emu_frames();
+    s->adc_frames = st.frames;
+    s->conversions = st.conversions;
+    s->queue_full = queue_host_full_count();
+    s->pool_overflows = st.pool_overflows;
+    s->late_frames = st.late_frames;
+    s->t_us = esp_timer_get_time();
+}
+
+static void print_second(const snapshot_t *a, const snapshot_t *b)
+{
+    double dt = (b->t_us - a->t_us) / 1e6;
+    bus_stats_window_t w;
+    bool have_bus = bus_stats_get_second(&w);
+    meas_result_t m;
+    bool have_meas = adc_dma_get_measurement(0, &m) == ESP_OK && (m.valid & MEAS_VALID_FREQ);
+
+    printf("%5.1f fps  ADC %6.1f fr/s %8.0f S/s  qfull %lu  ovf %lu  late %lu",
+           (b->frames - a->frames) / dt, (b->adc_frames - a->adc_frames) / dt,
+           (b->conversions - a->conversions) / dt, (unsigned long)b->queue_full,
+           (unsigned long)b->pool_overflows, (unsigned long)b->late_frames);
+    if (have_bus) {
+        printf("  SPI %lutr %luB  I2C %lutr", (unsigned long)w.bus[BUS_STATS_SPI_FT800].transactions,
+               (unsigned long)w.bus[BUS_STATS_SPI_FT800].bytes,
+               (unsigned long)w.bus[BUS_STATS_I2C_CH423].transactions);
+    }
+    if (have_meas) {
+        printf("  CH0 %.1f Hz", m.frequency_hz);
+    }
+    printf("\n");
+}
+
+// 재생 끝 + 처리 태스크가 남은 프레임을 다 쓸 때까지 대기
+static bool wait_replay_drained(int timeout_s)
+{
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_s * 1000000;
+    while (!adc_continuous_host_replay_done()) {
+        if (esp_timer_get_time() > deadline) {
+            return false;
+        }
+        sleep_ms(10);
+    }
+    uint32_t seq = adc_dma_get_write_seq();
+    int quiet_ms = 0;
+    while (quiet_ms < DRAIN_QUIET_MS) {
+        sleep_ms(10);
+        uint32_t now = adc_dma_get_write_seq();
+        quiet_ms = now == seq ? quiet_ms + 10 : 0;
+        seq = now;
+    }
+    return true;
+}
+
+// 링의 최근 샘플 CRC (두 채널) + 마지막 측정 창
+static uint32_t replay_digest(void)
+{
+    static uint16_t samples[DIGEST_SAMPLES];
+    adc_ring_view_t view;
+    uint32_t crc = 0;
+    uint32_t seq = adc_dma_get_write_seq();
+    crc = stream_crc32(crc, &seq, sizeof(seq));
+    if (adc_dma_get_snapshot(DIGEST_SAMPLES, &view) == ESP_OK) {
+        for (int ch = 0; ch < ADC_RING_CHANNELS; ch++) {
+            uint32_t n = adc_ring_view_copy(&view, ch, samples, DIGEST_SAMPLES);
+            crc = stream_crc32(crc, samples, n * sizeof(uint16_t));
+        }
+        adc_dma_put_view(&view);
+    }
+    printf("replay: %lu sample pairs processed\n", (unsigned long)seq);
+    for (int ch = 0; ch < ADC_RING_CHANNELS; ch++) {
+        meas_result_t m;
+        if (adc_dma_get_measurement(ch, &m) != ESP_OK) {
+            printf("  CH%d: no measurement\n", ch);
+            continue;
+        }
+        printf("  CH%d: window %lu min %u max %u mean %.2f rms %.2f", ch, (unsigned long)m.index, m.min, m.max,
+               m.mean, m.rms);
+        if (m.valid & MEAS_VALID_FREQ) {
+            printf(" %.2f Hz duty %.1f%%", m.frequency_hz, m.duty_pct);
+        }
+        printf("\n");
+        uint32_t fields[4] = { m.index, m.valid, m.min, m.max };
+        crc = stream_crc32(crc, fields, sizeof(fields));
+    }
+    return crc;
+}
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [seconds] [out.png] [-v] [--record dump.adcf]\n"
+           "       %s [seconds] --replay dump.adcf|capture.csv [--max-speed] [--loop] [--expect crc32]\n",
+           prog, prog);
+}
+
+int main(int argc, char **argv)
+{
+    int seconds = 5;
+    const char *png_path = NULL;
+    const char *replay_path = NULL;
+    const char *record_path = NULL;
+    bool verbose = false;
+    bool max_speed = false;
+    bool loop = false;
+    bool have_expect = false;
+    uint32_t expect = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--expect") == 0 && i + 1 < argc) {
+            expect = (uint32_t)strtoul(argv[++i], NULL, 16);
+            have_expect = true;
+        } else if (strcmp(argv[i], "--max-speed") == 0) {
+            max_speed = true;
+        } else if (strcmp(argv[i], "--loop") == 0) {
+            loop = true;
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else if (argv[i][0] == '-') {
+            printf("unknown or incomplete option: %s\n", argv[i]);
+            usage(argv[0]);
+            return 2;
+        } else if (atoi(argv[i]) > 0) {
+            seconds = atoi(argv[i]);
+        } else {
+            png_path = argv[i];
+        }
+    }
+    esp_log_level_set("*", verbose ? ESP_LOG_INFO : ESP_LOG_WARN);
+
+    // 주변장치 모델
+    ft800_emu_init();
+    ft800_emu_set_int_callback(ft800_int_changed);
+    ft800_emu_set_vsync_deferred(true);
+    spi_host_set_device_model(SPI2_HOST, ft800_emu_spi_transfer);
+    ch423_model_init();
+    i2c_host_set_device_model(I2C_NUM_0, ch423_model_transfer);
+
+    adc_host_wave_t sine = { .shape = ADC_HOST_WAVE_SINE, .freq_hz = SINE_HZ, .amplitude = 1500, .offset = 2048,
+                             .noise = 8 };
+    adc_host_wave_t square = { .shape = ADC_HOST_WAVE_SQUARE, .freq_hz = 250, .amplitude = 1000, .offset = 2048,
+                               .duty = 0.25f, .noise = 8 };
+    adc_continuous_host_set_wave(ADC_CHANNEL_6, &sine);
+    adc_continuous_host_set_wave(ADC_CHANNEL_7, &square);
+    adc_continuous_host_set_comparator(TRIG0_GPIO, ADC_CHANNEL_6, 0);
+    if (replay_path && adc_continuous_host_replay(replay_path, !max_speed, loop) != ESP_OK) {
+        printf("FAIL: cannot load capture %s\n", replay_path);
+        return 1;
+    }
+    if (replay_path && !loop) {
+        adc_continuous_host_replay_hold(true);
+    }
+    if (record_path && adc_continuous_host_record(record_path) != ESP_OK) {
+        printf("FAIL: cannot create %s\n", record_path);
+        return 1;
+    }
+
+    pthread_t vsync;
+    pthread_create(&vsync, NULL, vsync_thread, NULL);
+
+    xTaskCreate(hardware_test_task, "hardware_test_task", 8192, NULL, 5, NULL);
+
+    // 상호작용 루프 시작 대기 (CH423 서비스가 돌면 곧이어 render_sched_init)
+    int waited_ms = 0;
+    while (!ch423_service_running() && waited_ms < STARTUP_TIMEOUT_S * 1000) {
+        sleep_ms(50);
+        waited_ms += 50;
+    }
+    if (!ch423_service_running()) {
+        printf("FAIL: interactive test did not start within %d s\n", STARTUP_TIMEOUT_S);
+        return 1;
+    }
+    sleep_ms(SETTLE_MS);
+    printf("interactive loop running after %.1f s\n", esp_timer_get_time() / 1e6);
+
+    snapshot_t first, prev, cur;
+    take_snapshot(&first);
+    prev = first;
+    uint16_t oc_before = ch423_model_outputs();
+    bool led_toggled = false;
+    for (int s = 0; s < seconds; s++) {
+        if (s == seconds / 2) {
+            encoder_detent_cw();
+            // SW1 누름 (active low, 서비스 폴링 주기보다 길게)
+            ch423_model_set_input_bit(CH423_BIT_SW1, false);
+            sleep_ms(100);
+            ch423_model_set_input_bit(CH423_BIT_SW1, true);
+            sleep_ms(900 - 12);
+        } else {
+            sleep_ms(1000);
+        }
+        take_snapshot(&cur);
+        print_second(&prev, &cur);
+        prev = cur;
+        led_toggled |= ((ch423_model_outputs() ^ oc_before) >> CH423_OC_LED0) & 1;
+    }
+
+    // 확인
+    int failures = 0;
+    double dt = (cur.t_us - first.t_us) / 1e6;
+    double fps = (cur.frames - first.frames) / dt;
+    adc_continuous_host_stats_t st;
+    adc_continuous_host_get_stats(&st);
+    uint32_t rate = adc_dma_get_sample_rate_hz() * 2;      // 두 채널 합 변환 속도
+    // 프레임 크기는 펌웨어 내부 값이므로 변환 수로 비교 (프레임 = 변환 묶음)
+    double adc_ratio = (cur.conversions - first.conversions) / (dt * rate);
+    double frame_rate = (cur.adc_frames - first.adc_frames) / dt;
+    meas_result_t m;
+    bool have_meas = adc_dma_get_measurement(0, &m) == ESP_OK && (m.valid & MEAS_VALID_FREQ);
+    decim_mode_t mode;
+    uint32_t timebase = get_adc_display_timebase(&mode);
+    ch423_model_stats_t cs;
+    ch423_model_get_stats(&cs);
+
+    printf("\nframes %.1f fps (vsync %d), ADC %.1f%% of expected at %.1f frames/s, queue full %lu, pool overflows %lu, "
+           "late %lu (max %lld us), resyncs %lu, trigger edges %lu\n",
+           fps, VSYNC_HZ, adc_ratio * 100, frame_rate, (unsigned long)cur.queue_full,
+           (unsigned long)st.pool_overflows, (unsigned long)st.late_frames, (long long)st.max_late_us,
+           (unsigned long)st.resyncs, (unsigned long)st.comparator_edges);
+    printf("CH423: %lu writes, %lu reads, %lu OC writes, %lu NACKs, OC=0x%04x; timebase %lu smp/px\n",
+           (unsigned long)cs.writes, (unsigned long)cs.reads, (unsigned long)cs.oc_writes,
+           (unsigned long)cs.nacks, ch423_model_outputs(), (unsigned long)timebase);
+
+    if (fps < VSYNC_HZ * 0.9 || fps > VSYNC_HZ * 1.02) {
+        printf("FAIL: frame rate %.1f does not follow vsync\n", fps);
+        failures++;
+    }
+    // 합성 파형이거나 실시간 반복 재생일 때만 변환 속도가 일정함
+    bool steady_source = replay_path == NULL || (!max_speed && loop);
+    if (steady_source && adc_ratio < 0.98) {
+        printf("FAIL: ADC delivered %.1f%% of expected conversions\n", adc_ratio * 100);
+        failures++;
+    }
+    // 펌웨어는 adc_continuous_read를 쓰지 않고 on_conv_done 큐로만 받으므로 드라이버 풀은 몇 프레임 뒤
+    // 계속 넘친다 (보드에서도 같음). 프레임 손실은 처리 태스크 큐에서 본다
+    if (cur.queue_full != 0) {
+        printf("FAIL: ADC frames dropped (processing queue full %lu times)\n", (unsigned long)cur.queue_full);
+        failures++;
+    }
+    if (replay_path == NULL && (!have_meas || fabsf(m.frequency_hz - SINE_HZ) > SINE_HZ * 0.01f)) {
+        printf("FAIL: measured frequency %.1f Hz, expected %.0f Hz\n", have_meas ? m.frequency_hz : 0.0f, SINE_HZ);
+        failures++;
+    }
+    if (!led_toggled) {
+        printf("FAIL: RE1 detent did not toggle LED0 (OC%d)\n", CH423_OC_LED0);
+        failures++;
+    }
+    if (timebase != 2) {
+        printf("FAIL: SW1 press left timebase at %lu smp/px, expected 2\n", (unsigned long)timebase);
+        failures++;
+    }
+
+    if (record_path) {
+        adc_continuous_host_record(NULL);
+        printf("recorded ADC frames to %s\n", record_path);
+    }
+    if (replay_path && !loop) {
+        adc_dma_acq_stop();
+        adc_continuous_host_replay_hold(false);
+        if (!wait_replay_drained(STARTUP_TIMEOUT_S)) {
+            printf("FAIL: replay did not finish\n");
+            failures++;
+        } else {
+            adc_continuous_host_get_stats(&st);
+            uint64_t file_frames = adc_continuous_host_replay_frames();
+            uint32_t digest = replay_digest();
+            printf("replay: %llu frames delivered%s, queue full %lu, digest %08lx\n",
+                   (unsigned long long)st.frames, max_speed ? " at max speed" : "",
+                   (unsigned long)queue_host_full_count(), (unsigned long)digest);
+            if (file_frames && st.frames != file_frames) {
+                printf("FAIL: delivered %llu of %llu recorded frames\n", (unsigned long long)st.frames,
+                       (unsigned long long)file_frames);
+                failures++;
+            }
+            if (queue_host_full_count() != 0) {
+                printf("FAIL: frames dropped during replay\n");
+                failures++;
+            }
+            if (have_expect && digest != expect) {
+                printf("FAIL: digest %08lx, expected %08lx\n", (unsigned long)digest, (unsigned long)expect);
+                failures++;
+            }
+        }
+    }
+
+    if (png_path) {
+        static uint32_t pixels[FT800_EMU_WIDTH * FT800_EMU_HEIGHT];
+        if (!ft800_emu_render(pixels) || !png_write_rgb(png_path, pixels, FT800_EMU_WIDTH, FT800_EMU_HEIGHT)) {
+            printf("FAIL: could not write %s\n", png_path);
+            failures++;
+        } else {
+            printf("wrote %s\n", png_path);
+        }
+    }
+    printf("%s\n", failures ? "FAILED" : "OK");
+    // 펌웨어 태스크는 끝나지 않으므로 프로세스째 종료
+    vsync_run = false;
+    fflush(stdout);
+    _Exit(failures ? 1 : 0);
+}
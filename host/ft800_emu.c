@@ -0,0 +1,924 @@
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "ft800.h"
+#include "ft800_emu.h"
+
+// 메모리 맵 크기
+#define EMU_RAM_G_SIZE      (256 * 1024)
+#define EMU_RAM_DL_SIZE     FT_DL_SIZE
+#define EMU_RAM_PAL_SIZE    1024
+#define EMU_RAM_REG_SIZE    4096
+#define EMU_RAM_CMD_SIZE    FT800_CMD_FIFO_SIZE
+#define EMU_DL_WORDS        (EMU_RAM_DL_SIZE / 4)
+
+#define EMU_CHIP_ID         0x7C
+#define EMU_CONTEXT_DEPTH   4       // SAVE_CONTEXT 스택
+#define EMU_CALL_DEPTH      4       // CALL 스택
+#define EMU_DL_STEPS_MAX    65536   // JUMP 순환 방지
+
+static uint8_t ram_g[EMU_RAM_G_SIZE];
+static uint8_t ram_dl[EMU_RAM_DL_SIZE];
+static uint8_t ram_pal[EMU_RAM_PAL_SIZE];
+static uint8_t ram_reg[EMU_RAM_REG_SIZE];
+static uint8_t ram_cmd[EMU_RAM_CMD_SIZE];
+
+// 화면에 나가는 DL (스왑 때 RAM_DL에서 복사)
+static uint32_t disp_dl[EMU_DL_WORDS];
+static bool disp_valid;
+
+static uint32_t emu_frames;
+static uint32_t emu_unsupported;
+static uint32_t emu_overhead_ns = FT800_EMU_OVERHEAD_NS;
+static ft800_emu_stats_t stats_frame, stats_last, stats_total;
+
+// 코프로세서 상태
+static uint32_t cop_fgcolor = 0x003870;
+static uint32_t cop_bgcolor = 0x002040;
+
+// 스레드에서 쓸 때: 공개 함수는 모두 이 잠금 안에서 돈다 (SPI 태스크와 vsync 스레드)
+static pthread_mutex_t emu_lock = PTHREAD_MUTEX_INITIALIZER;
+static ft800_emu_int_fn emu_int_cb;
+static bool emu_int_line;           // INT_N 내려감 (true = 인터럽트 요청 중)
+static bool emu_vsync_deferred;     // 스왑을 ft800_emu_vsync()까지 미룸
+static bool cop_swap_wait;          // 코프로세서가 CMD_SWAP에서 vsync를 기다리는 중
+
+/*** 메모리 ***********************************************************************/
+static uint8_t *mem_ptr(uint32_t addr, size_t len)
+{
+    if (addr + len <= EMU_RAM_G_SIZE) {
+        return ram_g + addr;
+    }
+    if (addr >= RAM_DL && addr + len <= RAM_DL + EMU_RAM_DL_SIZE) {
+        return ram_dl + (addr - RAM_DL);
+    }
+    if (addr >= RAM_PAL && addr + len <= RAM_PAL + EMU_RAM_PAL_SIZE) {
+        return ram_pal + (addr - RAM_PAL);
+    }
+    if (addr >= RAM_REG && addr + len <= RAM_REG + EMU_RAM_REG_SIZE) {
+        return ram_reg + (addr - RAM_REG);
+    }
+    if (addr >= RAM_CMD && addr + len <= RAM_CMD + EMU_RAM_CMD_SIZE) {
+        return ram_cmd + (addr - RAM_CMD);
+    }
+    return NULL;
+}
+
+const uint8_t *ft800_emu_mem(uint32_t addr, size_t len)
+{
+    // 포인터를 돌려주므로 내용은 다른 스레드가 바꿀 수 있음 (멈춘 뒤에 읽을 것)
+    return mem_ptr(addr, len);
+}
+
+static uint32_t rd32(const uint8_t *p)
+{
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wr32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static uint32_t reg_get(uint32_t reg)
+{
+    return rd32(ram_reg + (reg - RAM_REG));
+}
+
+static void reg_set(uint32_t reg, uint32_t v)
+{
+    wr32(ram_reg + (reg - RAM_REG), v);
+}
+
+/*** 통계 *************************************************************************/
+static void stats_add(ft800_emu_stats_t *dst, const ft800_emu_stats_t *src)
+{
+    dst->transactions += src->transactions;
+    dst->reads += src->reads;
+    dst->bytes += src->bytes;
+    dst->cmd_bytes += src->cmd_bytes;
+    dst->ram_g_bytes += src->ram_g_bytes;
+    dst->bus_ns += src->bus_ns;
+}
+
+// 화면 DL 크기 (첫 DISPLAY까지)
+static uint32_t disp_dl_bytes(void)
+{
+    for (uint32_t i = 0; i < EMU_DL_WORDS; i++) {
+        if (disp_dl[i] == DISPLAY()) {
+            return (i + 1) * 4;
+        }
+    }
+    return EMU_RAM_DL_SIZE;
+}
+
+// RAM_DL -> 화면, 프레임 통계 마감
+static void dl_swap(void)
+{
+    for (uint32_t i = 0; i < EMU_DL_WORDS; i++) {
+        disp_dl[i] = rd32(ram_dl + i * 4);
+    }
+    disp_valid = true;
+    emu_frames++;
+    reg_set(REG_FRAMES, reg_get(REG_FRAMES) + 1);
+    reg_set(REG_INT_FLAGS, reg_get(REG_INT_FLAGS) | INT_SWAP);
+    reg_set(REG_DLSWAP, DLSWAP_DONE);
+
+    stats_add(&stats_total, &stats_frame);
+    stats_last = stats_frame;
+    stats_last.dl_bytes = disp_dl_bytes();
+    memset(&stats_frame, 0, sizeof(stats_frame));
+}
+
+/*** 코프로세서 *******************************************************************/
+// ROM 글꼴 16~31의 글자 높이와 평균 글자 폭 (픽셀, 근사값)
+static const uint8_t rom_font_height[16] = { 8, 8, 16, 16, 13, 17, 20, 22, 29, 38, 16, 20, 25, 28, 36, 49 };
+static const uint8_t rom_font_advance[16] = { 8, 8, 8, 8, 7, 8, 10, 11, 14, 18, 8, 10, 13, 15, 19, 25 };
+
+static uint32_t cmd_word(uint32_t rd, uint32_t i)
+{
+    return rd32(ram_cmd + ((rd + i * 4) & FT800_CMD_FIFO_MASK));
+}
+
+// DL에 한 워드 (RAM_DL 밖으로 넘치면 버림)
+static void dl_emit(uint32_t word)
+{
+    uint32_t ptr = reg_get(REG_CMD_DL);
+    if (ptr + 4 <= EMU_RAM_DL_SIZE) {
+        wr32(ram_dl + ptr, word);
+        reg_set(REG_CMD_DL, ptr + 4);
+    }
+}
+
+// 문자열 인자 길이 (NUL 포함 4바이트 단위 워드 수). 아직 다 안 들어왔으면 0
+static uint32_t cmd_str_words(uint32_t rd, uint32_t first, uint32_t avail_words)
+{
+    for (uint32_t w = first; w < avail_words; w++) {
+        uint32_t v = cmd_word(rd, w);
+        if ((v & 0xFF) == 0 || (v & 0xFF00) == 0 || (v & 0xFF0000) == 0 || (v & 0xFF000000) == 0) {
+            return w - first + 1;
+        }
+    }
+    return 0;
+}
+
+static void cmd_str_copy(uint32_t rd, uint32_t first, char *out, size_t len)
+{
+    size_t n = 0;
+    for (uint32_t w = first; n + 1 < len; w++) {
+        uint32_t v = cmd_word(rd, w);
+        for (int b = 0; b < 4 && n + 1 < len; b++) {
+            char c = (char)((v >> (8 * b)) & 0xFF);
+            if (c == 0) {
+                out[n] = 0;
+                return;
+            }
+            out[n++] = c;
+        }
+    }
+    out[n] = 0;
+}
+
+static int text_width(int font, const char *s)
+{
+    int adv = (font >= 16 && font <= 31) ? rom_font_advance[font - 16] : 8;
+    return adv * (int)strlen(s);
+}
+
+// CMD_TEXT와 같은 DL: BEGIN(BITMAPS), 글자마다 VERTEX2II, END
+static void emit_text(int x, int y, int font, uint32_t options, const char *s)
+{
+    int height = (font >= 16 && font <= 31) ? rom_font_height[font - 16] : 16;
+    int adv = (font >= 16 && font <= 31) ? rom_font_advance[font - 16] : 8;
+
+    if (options & OPT_RIGHTX) {
+        x -= text_width(font, s);
+    } else if (options & OPT_CENTERX) {
+        x -= text_width(font, s) / 2;
+    }
+    if (options & OPT_CENTERY) {
+        y -= height / 2;
+    }
+    dl_emit(BEGIN(BITMAPS));
+    bool handle_set = false;
+    for (; *s; s++, x += adv) {
+        if (*s == ' ' || x <= -adv || x >= 512 || y <= -height || y >= 512) {
+            continue;
+        }
+        if (x >= 0 && y >= 0) {
+            dl_emit(VERTEX2II(x, y, font, (uint8_t)*s));
+        } else {
+            // VERTEX2II는 음수 좌표를 못 쓰므로 실제 코프로세서처럼 핸들/셀 + VERTEX2F
+            if (!handle_set) {
+                dl_emit(BITMAP_HANDLE(font));
+                handle_set = true;
+            }
+            dl_emit(CELL((uint8_t)*s));
+            dl_emit(VERTEX2F(x * 16, y * 16));
+        }
+    }
+    dl_emit(END());
+}
+
+static int16_t lo16(uint32_t v)
+{
+    return (int16_t)(v & 0xFFFF);
+}
+
+static int16_t hi16(uint32_t v)
+{
+    return (int16_t)(v >> 16);
+}
+
+// 명령 하나 처리. 인자가 아직 다 안 들어왔으면 0, 아니면 소비한 워드 수
+static uint32_t cop_execute(uint32_t rd, uint32_t avail_words)
+{
+    uint32_t op = cmd_word(rd, 0);
+    uint32_t need = 1;
+    char text[256];
+
+#define NEED(n) do { need = (n); if (avail_words < need) return 0; } while (0)
+#define ARG(i)  cmd_word(rd, (i))
+
+    if ((op & 0xFFFFFF00UL) != 0xFFFFFF00UL) {
+        dl_emit(op);    // 일반 DL 명령은 그대로
+        return 1;
+    }
+
+    switch (op) {
+    case CMD_DLSTART:
+        reg_set(REG_CMD_DL, 0);
+        break;
+    case CMD_SWAP:
+        if (emu_vsync_deferred) {
+            // 실제 칩처럼 다음 vsync까지 코프로세서가 여기서 멈춤 (REG_CMD_READ가 안 움직임)
+            if (!cop_swap_wait) {
+                cop_swap_wait = true;
+                reg_set(REG_DLSWAP, DLSWAP_FRAME);
+            }
+            return 0;
+        }
+        dl_swap();
+        break;
+    case CMD_APPEND: {
+        NEED(3);
+        uint32_t ptr = ARG(1), num = ARG(2) & ~3u;
+        const uint8_t *src = mem_ptr(ptr, num);
+        for (uint32_t i = 0; src && i < num; i += 4) {
+            dl_emit(rd32(src + i));
+        }
+        break;
+    }
+    case CMD_MEMCPY: {
+        NEED(4);
+        uint8_t *dst = mem_ptr(ARG(1), ARG(3));
+        const uint8_t *src = mem_ptr(ARG(2), ARG(3));
+        if (dst && src) {
+            memmove(dst, src, ARG(3));
+        }
+        break;
+    }
+    case CMD_MEMSET:
+    case CMD_MEMZERO: {
+        uint32_t value = 0, num;
+        if (op == CMD_MEMSET) {
+            NEED(4);
+            value = ARG(2);
+            num = ARG(3);
+        } else {
+            NEED(3);
+            num = ARG(2);
+        }
+        uint8_t *dst = mem_ptr(ARG(1), num);
+        if (dst) {
+            memset(dst, (int)(value & 0xFF), num);
+        }
+        break;
+    }
+    case CMD_MEMWRITE: {
+        NEED(3);
+        uint32_t num = ARG(2);
+        NEED(3 + (num + 3) / 4);
+        uint8_t *dst = mem_ptr(ARG(1), num);
+        for (uint32_t i = 0; dst && i < num; i++) {
+            dst[i] = (uint8_t)(ARG(3 + i / 4) >> (8 * (i & 3)));
+        }
+        break;
+    }
+    case CMD_TEXT: {
+        NEED(3);
+        uint32_t sw = cmd_str_words(rd, 3, avail_words);
+        if (sw == 0) {
+            return 0;
+        }
+        need = 3 + sw;
+        cmd_str_copy(rd, 3, text, sizeof(text));
+        emit_text(lo16(ARG(1)), hi16(ARG(1)), lo16(ARG(2)), (uint16_t)hi16(ARG(2)), text);
+        break;
+    }
+    case CMD_NUMBER: {
+        NEED(4);
+        uint32_t opt = (uint16_t)hi16(ARG(2));
+        if (opt & OPT_SIGNED) {
+            snprintf(text, sizeof(text), "%ld", (long)(int32_t)ARG(3));
+        } else {
+            snprintf(text, sizeof(text), "%lu", (unsigned long)ARG(3));
+        }
+        emit_text(lo16(ARG(1)), hi16(ARG(1)), lo16(ARG(2)), opt, text);
+        break;
+    }
+    case CMD_BUTTON: {
+        NEED(4);
+        uint32_t sw = cmd_str_words(rd, 4, avail_words);
+        if (sw == 0) {
+            return 0;
+        }
+        need = 4 + sw;
+        int x = lo16(ARG(1)), y = hi16(ARG(1)), w = lo16(ARG(2)), h = hi16(ARG(2));
+        cmd_str_copy(rd, 4, text, sizeof(text));
+        dl_emit(SAVE_CONTEXT());
+        dl_emit(COLOR_RGB((cop_fgcolor >> 16) & 0xFF, (cop_fgcolor >> 8) & 0xFF, cop_fgcolor & 0xFF));
+        dl_emit(BEGIN(RECTS));
+        dl_emit(VERTEX2F(x * 16, y * 16));
+        dl_emit(VERTEX2F((x + w) * 16, (y + h) * 16));
+        dl_emit(END());
+        dl_emit(RESTORE_CONTEXT());
+        emit_text(x + w / 2, y + h / 2, lo16(ARG(3)), OPT_CENTER, text);
+        break;
+    }
+    case CMD_FGCOLOR:
+        NEED(2);
+        cop_fgcolor = ARG(1);
+        break;
+    case CMD_BGCOLOR:
+        NEED(2);
+        cop_bgcolor = ARG(1);
+        break;
+    case CMD_GRADCOLOR:
+    case CMD_ROTATE:
+    case CMD_INTERRUPT:
+        NEED(2);
+        break;
+    case CMD_TRANSLATE:
+    case CMD_SCALE:
+        NEED(3);
+        break;
+    case CMD_LOADIDENTITY:
+    case CMD_SETMATRIX:
+    case CMD_STOP:
+    case CMD_COLDSTART:
+        break;
+
+    // 그리지 않는 위젯 (인자만 건너뜀)
+    case CMD_SPINNER:
+        NEED(3);
+        emu_unsupported++;
+        break;
+    case CMD_TRACK:
+        NEED(4);
+        emu_unsupported++;
+        break;
+    case CMD_GRADIENT:
+    case CMD_SLIDER:
+    case CMD_PROGRESS:
+    case CMD_SCROLLBAR:
+    case CMD_GAUGE:
+    case CMD_CLOCK:
+        NEED(5);
+        emu_unsupported++;
+        break;
+    case CMD_KEYS: {
+        NEED(4);
+        uint32_t sw = cmd_str_words(rd, 4, avail_words);
+        if (sw == 0) {
+            return 0;
+        }
+        need = 4 + sw;
+        emu_unsupported++;
+        break;
+    }
+    default:
+        // 인자 길이를 모르는 명령: 실제 칩처럼 여기서 멈추지 않고 명령 워드만 건너뜀
+        emu_unsupported++;
+        break;
+    }
+#undef NEED
+#undef ARG
+    return need;
+}
+
+// REG_CMD_READ부터 REG_CMD_WRITE까지 처리 (인자가 덜 들어온 명령은 다음 쓰기까지 보류)
+static void cop_run(void)
+{
+    uint32_t wr = reg_get(REG_CMD_WRITE) & FT800_CMD_FIFO_MASK;
+    uint32_t rd = reg_get(REG_CMD_READ) & FT800_CMD_FIFO_MASK;
+
+    while (rd != wr) {
+        uint32_t avail_words = ((wr - rd) & FT800_CMD_FIFO_MASK) / 4;
+        uint32_t used = avail_words ? cop_execute(rd, avail_words) : 0;
+        if (used == 0) {
+            break;
+        }
+        rd = (rd + used * 4) & FT800_CMD_FIFO_MASK;
+        reg_set(REG_CMD_READ, rd);
+    }
+    if (rd == wr) {
+        reg_set(REG_INT_FLAGS, reg_get(REG_INT_FLAGS) | INT_CMDEMPTY);
+    }
+}
+
+bool ft800_emu_cmd_idle(void)
+{
+    pthread_mutex_lock(&emu_lock);
+    bool idle = (reg_get(REG_CMD_READ) & FT800_CMD_FIFO_MASK) == (reg_get(REG_CMD_WRITE) & FT800_CMD_FIFO_MASK);
+    pthread_mutex_unlock(&emu_lock);
+    return idle;
+}
+
+// INT_N 레벨 갱신 (REG_INT_EN && REG_INT_FLAGS & REG_INT_MASK), 바뀌면 콜백
+static void int_update(void)
+{
+    bool asserted = (reg_get(REG_INT_EN) & 1) && (reg_get(REG_INT_FLAGS) & reg_get(REG_INT_MASK));
+    if (asserted != emu_int_line) {
+        emu_int_line = asserted;
+        if (emu_int_cb) {
+            emu_int_cb(asserted);
+        }
+    }
+}
+
+/*** SPI **************************************************************************/
+static bool range_has(uint32_t addr, size_t len, uint32_t reg)
+{
+    return reg >= addr && reg < addr + len;
+}
+
+void ft800_emu_spi_transfer(const uint8_t *tx, uint8_t *rx, size_t len, int clock_hz)
+{
+    if (len == 0) {
+        return;
+    }
+    pthread_mutex_lock(&emu_lock);
+    stats_frame.transactions++;
+    stats_frame.bytes += (uint32_t)len;
+    stats_frame.bus_ns += (uint64_t)len * 8 * 1000000000ULL / (uint64_t)(clock_hz > 0 ? clock_hz : 1) +
+                          emu_overhead_ns;
+
+    uint8_t type = tx[0] & 0xC0;
+    uint32_t addr = len >= 3 ? (((uint32_t)tx[0] & 0x3F) << 16) | ((uint32_t)tx[1] << 8) | tx[2] : 0;
+
+    if (type == 0x40 || len < 4) {
+        // 호스트 명령 (ACTIVE/CLKEXT/CLK48M 등): 상태 변화 없음
+    } else if (type == 0x80) {
+        size_t n = len - 3;
+        uint8_t *dst = mem_ptr(addr, n);
+        if (dst) {
+            memcpy(dst, tx + 3, n);
+        }
+        if (addr >= RAM_CMD && addr < RAM_CMD + EMU_RAM_CMD_SIZE) {
+            stats_frame.cmd_bytes += (uint32_t)n;
+        } else if (addr < EMU_RAM_G_SIZE) {
+            stats_frame.ram_g_bytes += (uint32_t)n;
+        }
+    } else if (type == 0x00 && len > 4) {
+        stats_frame.reads++;
+        size_t n = len - 4;
+        const uint8_t *src = mem_ptr(addr, n);
+        if (rx) {
+            memset(rx, 0, 4);
+            if (src) {
+                memcpy(rx + 4, src, n);
+            } else {
+                memset(rx + 4, 0, n);
+            }
+        }
+        if (range_has(addr, n, REG_INT_FLAGS)) {
+            reg_set(REG_INT_FLAGS, 0);  // 읽으면 지워짐
+        }
+    }
+
+    // 스왑은 이 트랜잭션까지 센 뒤에 (프레임을 끝낸 쓰기도 그 프레임에 들어감)
+    if (type == 0x80 && len > 3) {
+        size_t n = len - 3;
+        // 미룸 모드에서 DLSWAP_FRAME은 vsync에서, DLSWAP_LINE은 바로
+        if (range_has(addr, n, REG_DLSWAP) && reg_get(REG_DLSWAP) != DLSWAP_DONE &&
+            !(emu_vsync_deferred && reg_get(REG_DLSWAP) == DLSWAP_FRAME)) {
+            dl_swap();
+        }
+        if (range_has(addr, n, REG_CMD_WRITE)) {
+            cop_run();
+        }
+    }
+    int_update();
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_set_int_callback(ft800_emu_int_fn fn)
+{
+    pthread_mutex_lock(&emu_lock);
+    emu_int_cb = fn;
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_set_vsync_deferred(bool deferred)
+{
+    pthread_mutex_lock(&emu_lock);
+    emu_vsync_deferred = deferred;
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_vsync(void)
+{
+    pthread_mutex_lock(&emu_lock);
+    if (cop_swap_wait) {
+        cop_swap_wait = false;
+        dl_swap();
+        // 멈춰 있던 CMD_SWAP을 넘기고 뒤에 쌓인 명령을 이어서 처리
+        reg_set(REG_CMD_READ, (reg_get(REG_CMD_READ) + 4) & FT800_CMD_FIFO_MASK);
+        cop_run();
+    } else if (reg_get(REG_DLSWAP) == DLSWAP_FRAME) {
+        dl_swap();
+    }
+    int_update();
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_set_overhead_ns(uint32_t ns)
+{
+    pthread_mutex_lock(&emu_lock);
+    emu_overhead_ns = ns;
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_init(void)
+{
+    pthread_mutex_lock(&emu_lock);
+    memset(ram_g, 0, sizeof(ram_g));
+    memset(ram_dl, 0, sizeof(ram_dl));
+    memset(ram_pal, 0, sizeof(ram_pal));
+    memset(ram_reg, 0, sizeof(ram_reg));
+    memset(ram_cmd, 0, sizeof(ram_cmd));
+    memset(disp_dl, 0, sizeof(disp_dl));
+    disp_valid = false;
+    emu_frames = 0;
+    emu_unsupported = 0;
+    cop_fgcolor = 0x003870;
+    cop_bgcolor = 0x002040;
+    reg_set(REG_ID, EMU_CHIP_ID);
+    reg_set(REG_HSIZE, FT800_EMU_WIDTH);
+    reg_set(REG_VSIZE, FT800_EMU_HEIGHT);
+    memset(&stats_frame, 0, sizeof(stats_frame));
+    memset(&stats_last, 0, sizeof(stats_last));
+    memset(&stats_total, 0, sizeof(stats_total));
+    emu_int_line = false;
+    cop_swap_wait = false;
+    pthread_mutex_unlock(&emu_lock);
+}
+
+uint32_t ft800_emu_frames(void)
+{
+    pthread_mutex_lock(&emu_lock);
+    uint32_t frames = emu_frames;
+    pthread_mutex_unlock(&emu_lock);
+    return frames;
+}
+
+void ft800_emu_frame_stats(ft800_emu_stats_t *stats)
+{
+    pthread_mutex_lock(&emu_lock);
+    *stats = stats_last;
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_total_stats(ft800_emu_stats_t *stats)
+{
+    pthread_mutex_lock(&emu_lock);
+    *stats = stats_total;
+    stats_add(stats, &stats_frame);
+    pthread_mutex_unlock(&emu_lock);
+}
+
+void ft800_emu_reset_totals(void)
+{
+    pthread_mutex_lock(&emu_lock);
+    memset(&stats_total, 0, sizeof(stats_total));
+    memset(&stats_frame, 0, sizeof(stats_frame));
+    pthread_mutex_unlock(&emu_lock);
+}
+
+uint32_t ft800_emu_unsupported(void)
+{
+    pthread_mutex_lock(&emu_lock);
+    uint32_t n = emu_unsupported;
+    pthread_mutex_unlock(&emu_lock);
+    return n;
+}
+
+/*** 래스터화 *********************************************************************/
+// 5x7 대체 글꼴 (0x20~0x7E, 열 단위, bit0 = 맨 위)
+static const uint8_t font5x7[95][5] = {
+    {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+    {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00},
+    {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x08,0x2A,0x1C,0x2A,0x08}, {0x08,0x08,0x3E,0x08,0x08},
+    {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+    {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+    {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+    {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+    {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+    {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+    {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A},
+    {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+    {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+    {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+    {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},
+    {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+    {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},
+    {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20},
+    {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E},
+    {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00},
+    {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},
+    {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+    {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},
+    {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},
+    {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x04,0x08,0x10,0x08},
+};
+
+// 그래픽 상태 (SAVE_CONTEXT/RESTORE_CONTEXT 대상)
+typedef struct {
+    uint32_t color;             // 0xRRGGBB
+    uint8_t alpha;
+    uint32_t clear_color;
+    int line_width;             // 1/16 픽셀 (선 굵기의 절반)
+    int point_size;             // 1/16 픽셀 (반지름)
+    int scissor_x, scissor_y, scissor_w, scissor_h;
+    int handle, cell;
+} gfx_state_t;
+
+typedef struct {
+    uint32_t *fb;
+    gfx_state_t st;
+    uint32_t prim;              // BEGIN 인자 (0 = 없음)
+    int nverts;                 // 이번 BEGIN 이후 정점 수
+    int px, py;                 // 이전 정점 (1/16 픽셀)
+} raster_t;
+
+static void plot(raster_t *r, int x, int y)
+{
+    const gfx_state_t *st = &r->st;
+    if (x < st->scissor_x || y < st->scissor_y || x >= st->scissor_x + st->scissor_w ||
+        y >= st->scissor_y + st->scissor_h || x < 0 || y < 0 || x >= FT800_EMU_WIDTH || y >= FT800_EMU_HEIGHT) {
+        return;
+    }
+    uint32_t *p = &r->fb[y * FT800_EMU_WIDTH + x];
+    if (st->alpha == 255) {
+        *p = st->color;
+        return;
+    }
+    uint32_t a = st->alpha, out = 0;
+    for (int sh = 0; sh <= 16; sh += 8) {
+        uint32_t s = (st->color >> sh) & 0xFF, d = (*p >> sh) & 0xFF;
+        out |= ((s * a + d * (255 - a)) / 255) << sh;
+    }
+    *p = out;
+}
+
+// 굵은 선분 (양 끝 둥근 캡슐): 픽셀 중심이 선분에서 line_width 안쪽이면 칠함
+static void draw_line(raster_t *r, int x0, int y0, int x1, int y1)
+{
+    float ax = x0 / 16.0f, ay = y0 / 16.0f, bx = x1 / 16.0f, by = y1 / 16.0f;
+    float rad = r->st.line_width / 16.0f;
+    float dx = bx - ax, dy = by - ay, len2 = dx * dx + dy * dy;
+    int minx = (int)((ax < bx ? ax : bx) - rad) - 1, maxx = (int)((ax > bx ? ax : bx) + rad) + 1;
+    int miny = (int)((ay < by ? ay : by) - rad) - 1, maxy = (int)((ay > by ? ay : by) + rad) + 1;
+
+    for (int y = miny; y <= maxy; y++) {
+        for (int x = minx; x <= maxx; x++) {
+            float cx = x + 0.5f - ax, cy = y + 0.5f - ay;
+            float t = len2 > 0 ? (cx * dx + cy * dy) / len2 : 0;
+            t = t < 0 ? 0 : t > 1 ? 1 : t;
+            float ex = cx - t * dx, ey = cy - t * dy;
+            if (ex * ex + ey * ey < rad * rad) {
+                plot(r, x, y);
+            }
+        }
+    }
+}
+
+static void draw_point(raster_t *r, int x16, int y16)
+{
+    float cx0 = x16 / 16.0f, cy0 = y16 / 16.0f, rad = r->st.point_size / 16.0f;
+    for (int y = (int)(cy0 - rad) - 1; y <= (int)(cy0 + rad) + 1; y++) {
+        for (int x = (int)(cx0 - rad) - 1; x <= (int)(cx0 + rad) + 1; x++) {
+            float dx = x + 0.5f - cx0, dy = y + 0.5f - cy0;
+            if (dx * dx + dy * dy < rad * rad) {
+                plot(r, x, y);
+            }
+        }
+    }
+}
+
+static void draw_rect(raster_t *r, int x0, int y0, int x1, int y1)
+{
+    int ax = (x0 < x1 ? x0 : x1), bx = (x0 > x1 ? x0 : x1);
+    int ay = (y0 < y1 ? y0 : y1), by = (y0 > y1 ? y0 : y1);
+    // 모서리 둥글기는 무시하고 line_width - 1픽셀만큼 넓힘
+    int grow = r->st.line_width > 16 ? r->st.line_width - 16 : 0;
+    ax -= grow;
+    ay -= grow;
+    bx += grow;
+    by += grow;
+    for (int y = (ay + 15) >> 4; y <= (by - 1) >> 4; y++) {
+        for (int x = (ax + 15) >> 4; x <= (bx - 1) >> 4; x++) {
+            plot(r, x, y);
+        }
+    }
+}
+
+// ROM 글꼴 글자 하나 (글꼴 높이에 맞춰 5x7을 정수배로 키움)
+static void draw_glyph(raster_t *r, int x, int y, int handle, int cell)
+{
+    if (handle < 16 || handle > 31 || cell < 0x20 || cell > 0x7E) {
+        return;     // RAM_G 비트맵은 그리지 않음
+    }
+    int height = rom_font_height[handle - 16];
+    int scale = height / 9 > 0 ? height / 9 : 1;
+    int top = y + (height - 8 * scale) / 2;
+    const uint8_t *g = font5x7[cell - 0x20];
+    for (int col = 0; col < 5; col++) {
+        for (int row = 0; row < 7; row++) {
+            if (!(g[col] & (1u << row))) {
+                continue;
+            }
+            for (int sy = 0; sy < scale; sy++) {
+                for (int sx = 0; sx < scale; sx++) {
+                    plot(r, x + col * scale + sx, top + row * scale + sy);
+                }
+            }
+        }
+    }
+}
+
+static void raster_vertex(raster_t *r, int x16, int y16, int handle, int cell)
+{
+    switch (r->prim) {
+    case BITMAPS:
+        draw_glyph(r, x16 >> 4, y16 >> 4, handle, cell);
+        break;
+    case POINTS:
+        draw_point(r, x16, y16);
+        break;
+    case LINES:
+        if (r->nverts & 1) {
+            draw_line(r, r->px, r->py, x16, y16);
+        }
+        break;
+    case LINE_STRIP:
+        if (r->nverts > 0) {
+            draw_line(r, r->px, r->py, x16, y16);
+        }
+        break;
+    case RECTS:
+        if (r->nverts & 1) {
+            draw_rect(r, r->px, r->py, x16, y16);
+        }
+        break;
+    default:
+        break;      // EDGE_STRIP 등은 그리지 않음
+    }
+    r->px = x16;
+    r->py = y16;
+    r->nverts++;
+}
+
+static int32_t sign_extend(uint32_t v, int bits)
+{
+    uint32_t m = 1u << (bits - 1);
+    return (int32_t)((v ^ m) - m);
+}
+
+static bool render_locked(uint32_t *pixels)
+{
+    if (!disp_valid) {
+        return false;
+    }
+    raster_t r = {
+        .fb = pixels,
+        .st = {
+            .color = 0xFFFFFF, .alpha = 255, .clear_color = 0, .line_width = 16, .point_size = 8,
+            .scissor_x = 0, .scissor_y = 0, .scissor_w = 512, .scissor_h = 512,
+        },
+    };
+    gfx_state_t ctx[EMU_CONTEXT_DEPTH];
+    uint32_t calls[EMU_CALL_DEPTH];
+    int ctx_depth = 0, call_depth = 0;
+    uint32_t pc = 0;
+
+    memset(pixels, 0, FT800_EMU_WIDTH * FT800_EMU_HEIGHT * sizeof(uint32_t));
+
+    for (uint32_t steps = 0; steps < EMU_DL_STEPS_MAX && pc < EMU_DL_WORDS; steps++) {
+        uint32_t w = disp_dl[pc++];
+
+        if ((w >> 30) == 1) {           // VERTEX2F
+            raster_vertex(&r, sign_extend((w >> 15) & 0x7FFF, 15), sign_extend(w & 0x7FFF, 15), r.st.handle,
+                          r.st.cell);
+            continue;
+        }
+        if ((w >> 30) == 2) {           // VERTEX2II
+            raster_vertex(&r, (int)((w >> 21) & 0x1FF) * 16, (int)((w >> 12) & 0x1FF) * 16, (w >> 7) & 0x1F,
+                          w & 0x7F);
+            continue;
+        }
+        switch (w >> 24) {
+        case 0:                         // DISPLAY
+            return true;
+        case 2:
+            r.st.clear_color = w & 0xFFFFFF;
+            break;
+        case 4:
+            r.st.color = w & 0xFFFFFF;
+            break;
+        case 5:
+            r.st.handle = w & 0x1F;
+            break;
+        case 6:
+            r.st.cell = w & 0x7F;
+            break;
+        case 13:
+            r.st.point_size = w & 0x1FFF;
+            break;
+        case 14:
+            r.st.line_width = w & 0xFFF;
+            break;
+        case 16:
+            r.st.alpha = w & 0xFF;
+            break;
+        case 27:
+            r.st.scissor_x = (w >> 9) & 0x1FF;
+            r.st.scissor_y = w & 0x1FF;
+            break;
+        case 28:
+            r.st.scissor_w = (w >> 10) & 0x3FF;
+            r.st.scissor_h = w & 0x3FF;
+            break;
+        case 29:                        // CALL
+            if (call_depth < EMU_CALL_DEPTH) {
+                calls[call_depth++] = pc;
+                pc = w & 0xFFFF;
+            }
+            break;
+        case 30:                        // JUMP
+            pc = w & 0xFFFF;
+            break;
+        case 31:                        // BEGIN
+            r.prim = w & 0xF;
+            r.nverts = 0;
+            break;
+        case 33:                        // END
+            r.prim = 0;
+            r.nverts = 0;
+            break;
+        case 34:                        // SAVE_CONTEXT
+            if (ctx_depth < EMU_CONTEXT_DEPTH) {
+                ctx[ctx_depth++] = r.st;
+            }
+            break;
+        case 35:                        // RESTORE_CONTEXT
+            if (ctx_depth > 0) {
+                r.st = ctx[--ctx_depth];
+            }
+            break;
+        case 36:                        // RETURN
+            if (call_depth > 0) {
+                pc = calls[--call_depth];
+            }
+            break;
+        case 38:                        // CLEAR (색 버퍼만)
+            if (w & 4) {
+                gfx_state_t saved = r.st;
+                r.st.color = r.st.clear_color;
+                r.st.alpha = 255;
+                for (int y = 0; y < FT800_EMU_HEIGHT; y++) {
+                    for (int x = 0; x < FT800_EMU_WIDTH; x++) {
+                        plot(&r, x, y);
+                    }
+                }
+                r.st = saved;
+            }
+            break;
+        default:
+            break;                      // 비트맵 설정, 스텐실, 태그 등은 무시
+        }
+    }
+    return true;
+}
+
+bool ft800_emu_render(uint32_t *pixels)
+{
+    pthread_mutex_lock(&emu_lock);
+    bool ok = render_locked(pixels);
+    pthread_mutex_unlock(&emu_lock);
+    return ok;
+}
@@ -0,0 +1,90 @@
+#ifndef FT800_EMU_H
+#define FT800_EMU_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// FT800 에뮬레이터 (호스트)
+//
+// ft800.c가 쓰는 SPI 트랜잭션을 그대로 받아 해석하는 FT800 모델.
+// spi_host_set_device_model(SPI2_HOST, ft800_emu_spi_transfer)로 연결하면 initFT800()부터
+// cmd()/ft800_write_block()까지 펌웨어 코드를 고치지 않고 호스트에서 돌릴 수 있다.
+//   - 메모리 맵: RAM_G(256KB), RAM_DL(8KB), RAM_PAL, RAM_REG, RAM_CMD(4KB 링)
+//   - REG_CMD_WRITE가 바뀌면 코프로세서가 바로 명령을 처리 (REG_CMD_READ/REG_CMD_DL 갱신)
+//     이 프로젝트가 쓰는 명령(DLSTART, SWAP, APPEND, MEMCPY, TEXT, BUTTON, 색 등)은 DL을 만들고,
+//     나머지 위젯은 인자만 건너뛰며 ft800_emu_unsupported()로 센다
+//   - CMD_SWAP/REG_DLSWAP에서 RAM_DL을 화면 DL로 바꾸고 INT_SWAP을 올림. 기본은 vsync 대기 없이
+//     바로 바꾸고, ft800_emu_set_vsync_deferred(true)면 실제 칩처럼 ft800_emu_vsync()까지 미룸
+//     (CMD_SWAP에서 코프로세서가 멈추고 REG_DLSWAP은 DLSWAP_FRAME으로 남음)
+//   - INT_N 핀: REG_INT_EN과 REG_INT_FLAGS & REG_INT_MASK로 정하고, 바뀔 때 콜백
+//   - 화면 DL을 480x272 RGB로 래스터화 (선/점/사각형/ROM 글꼴 글자, 안티에일리어싱 없음,
+//     글자는 5x7 대체 글꼴을 글꼴 높이에 맞춰 키움). 픽셀 단위 정확도보다 배치 확인과 회귀 비교용
+//   - SPI 통계: 트랜잭션/바이트와 모의 버스 시간 (비트 / SPI 클럭 + 트랜잭션당 고정 비용)을
+//     프레임(스왑)마다 끊어서 보관
+// 공개 함수는 내부 잠금 하나로 직렬화되어 여러 스레드(펌웨어 태스크, vsync 스레드)에서 불러도 된다.
+
+#define FT800_EMU_WIDTH             480
+#define FT800_EMU_HEIGHT            272
+#define FT800_EMU_OVERHEAD_NS       2000    // 트랜잭션당 고정 비용 기본값 (CS, 드라이버 설정)
+
+typedef struct {
+    uint32_t transactions;      // CS 구간 수
+    uint32_t reads;             // 그중 읽기
+    uint32_t bytes;             // SPI 바이트 (주소/더미 포함)
+    uint32_t cmd_bytes;         // RAM_CMD에 쓴 데이터
+    uint32_t ram_g_bytes;       // RAM_G에 쓴 데이터
+    uint32_t dl_bytes;          // 화면 DL 크기 (프레임 통계에서만, DISPLAY까지)
+    uint64_t bus_ns;            // 모의 버스 시간
+} ft800_emu_stats_t;
+
+// 메모리/레지스터 초기화 (REG_ID = 0x7C), 통계 지움
+void ft800_emu_init(void);
+
+// SPI 장치 모델 (CS 한 번 동안의 전이중 전송). spi_host_transfer_fn과 같은 모양
+void ft800_emu_spi_transfer(const uint8_t *tx, uint8_t *rx, size_t len, int clock_hz);
+
+// INT_N 레벨이 바뀔 때 (asserted = 핀이 내려감). 에뮬레이터 잠금 안에서 불림
+typedef void (*ft800_emu_int_fn)(bool asserted);
+void ft800_emu_set_int_callback(ft800_emu_int_fn fn);
+
+// 스왑을 vsync까지 미룰지 (기본 false: 바로 스왑)
+void ft800_emu_set_vsync_deferred(bool deferred);
+
+// 화면 갱신 시점: 미뤄 둔 스왑을 처리 (호출하는 쪽이 주기를 정함, 예: 60 Hz 스레드)
+void ft800_emu_vsync(void);
+
+// 트랜잭션당 고정 비용 (ns)
+void ft800_emu_set_overhead_ns(uint32_t ns);
+
+// 지금까지 스왑한 프레임 수
+uint32_t ft800_emu_frames(void);
+
+// 마지막으로 끝난 프레임 (이전 스왑 직후 ~ 이번 스왑까지의 SPI)
+void ft800_emu_frame_stats(ft800_emu_stats_t *stats);
+
+// 초기화(또는 ft800_emu_reset_totals) 이후 누적
+void ft800_emu_total_stats(ft800_emu_stats_t *stats);
+void ft800_emu_reset_totals(void);
+
+// 처리하지 못하고 건너뛴 코프로세서 명령 수 (그리기 결과가 실제와 다를 수 있음)
+uint32_t ft800_emu_unsupported(void);
+
+// 코프로세서가 처리할 명령이 남아 있지 않으면 true
+bool ft800_emu_cmd_idle(void);
+
+// 메모리 직접 읽기 (RAM_G/RAM_DL/RAM_REG/RAM_CMD 주소). 범위 밖이면 NULL
+const uint8_t *ft800_emu_mem(uint32_t addr, size_t len);
+
+// 화면 DL을 래스터화 (0x00RRGGBB, FT800_EMU_WIDTH x FT800_EMU_HEIGHT). 스왑 전이면 false
+bool ft800_emu_render(uint32_t *pixels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FT800_EMU_H
@@ -0,0 +1,902 @@
+// 호스트 빌드용 ESP-IDF 대역: 합성 ADC continuous 드라이버, 레거시 ADC, ADC 캘리브레이션, DAC
+//
+// 생산자 스레드 하나가 실제 DMA처럼 시간에 맞춰 프레임을 낸다. 프레임 k는 변환
+// k*N ~ (k+1)*N-1 (N = 프레임당 변환 수)을 담고, 마지막 변환 시각에 on_conv_done을 부른다.
+// 호스트가 늦어지면 밀린 프레임을 바로 이어서 낸다 (실제 장치에서 처리 태스크가 늦었을 때처럼
+// 큐에 몰려 들어감). 100 ms 넘게 밀리면 시간축을 다시 잡고 resyncs에 센다.
+// 프레임 내용은 합성 파형, CSV 캡처 재생, 프레임 덤프 재생 중 하나에서 나온다.
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "driver/gpio.h"
+#include "driver/adc.h"
+#include "driver/dac_oneshot.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+
+#define ADC_HOST_RESYNC_NS      100000000LL     // 이보다 밀리면 시간축 재설정
+#define ADC_HOST_COMP_HYST      16              // 비교기 히스테리시스 (raw 코드, DAC 1 LSB)
+#define ADC_HOST_MAX_CODE       4095
+
+// 프레임 덤프 파일: 헤더 16바이트 ("ADCF", 버전, 변환 속도 Hz, 0) + 프레임마다 (크기 u32, 데이터). 리틀 엔디언
+#define ADC_DUMP_MAGIC          0x46434441u     // "ADCF"
+#define ADC_DUMP_VERSION        1
+#define ADC_DUMP_MAX_FRAME      4092            // IDF conv_frame_size 최대값
+
+static const char *TAG = "adc_host";
+
+struct adc_continuous_ctx_t {
+    pthread_mutex_t lock;
+    pthread_cond_t pool_cond;
+    uint32_t frame_size;
+    uint8_t *dma[ADC_HOST_REPLAY_BUFS];
+    uint32_t dma_count;             // 돌려 쓰는 DMA 버퍼 수 (start에서 정함)
+    uint32_t dma_size;              // 버퍼 하나 크기 (덤프 재생이면 가장 큰 프레임)
+    uint32_t dma_next;
+    uint8_t *pool;                  // 프레임 단위 링 (adc_continuous_read)
+    uint32_t *pool_len;
+    uint32_t pool_frames;
+    uint32_t pool_head, pool_count;
+    uint32_t pool_offset;           // 맨 앞 프레임에서 이미 읽은 바이트
+    adc_digi_pattern_config_t pattern[ADC_HOST_PATTERN_MAX];
+    uint32_t pattern_num;
+    uint32_t freq_hz;
+    bool configured;
+    adc_continuous_evt_cbs_t cbs;
+    void *user_data;
+    _Atomic bool running;
+    pthread_t thread;
+    uint64_t conv_index;            // 다음 변환 번호 (start부터)
+    uint32_t noise_state;
+};
+
+// 캡처 재생 (adc_continuous_host_replay). 생산자 스레드만 진행 상태를 바꿈
+typedef enum {
+    REPLAY_NONE = 0,
+    REPLAY_CSV,                     // 변환 단위 (행 = 패턴 한 바퀴)
+    REPLAY_DUMP,                    // 프레임 단위 (크기까지 그대로)
+} replay_kind_t;
+
+typedef struct {
+    replay_kind_t kind;
+    bool realtime;
+    bool loop;
+    uint16_t (*rows)[2];            // CSV: ch0, ch1 raw
+    uint32_t row_count;
+    uint8_t *frames;                // 덤프: 프레임 데이터를 이어 붙인 것
+    uint32_t *frame_off;
+    uint32_t *frame_len;
+    uint32_t frame_count;
+    uint32_t max_frame;
+    uint32_t rate_hz;               // 덤프 헤더의 변환 속도 (0이면 드라이버 설정)
+    uint32_t next_frame;
+    uint64_t delivered;             // 재생한 프레임 (반복 포함)
+    _Atomic bool hold;              // 잡혀 있으면 프레임을 내지 않음 (풀리면 그 시각부터 다시 셈)
+    _Atomic bool done;
+} adc_replay_t;
+
+static adc_replay_t adc_replay;
+
+// 녹화 (adc_continuous_host_record)
+static FILE *adc_record_file;
+static pthread_mutex_t adc_record_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static adc_continuous_handle_t adc_host_handle;     // 하나만
+static adc_host_wave_t adc_host_waves[ADC_HOST_CHANNEL_COUNT];
+static bool adc_host_waves_set[ADC_HOST_CHANNEL_COUNT];
+static uint32_t adc_host_freq_override;
+static uint32_t adc_host_frame_override;
+static pthread_mutex_t adc_host_wave_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// 트리거 비교기
+static int adc_comp_gpio = -1;
+static adc_channel_t adc_comp_channel;
+static int adc_comp_dac;
+static int adc_comp_level = 1;                      // 출력 (입력이 기준보다 높으면 0)
+
+static adc_continuous_host_stats_t adc_host_stats;
+static pthread_mutex_t adc_host_stats_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*** 파형 *************************************************************************/
+void adc_continuous_host_set_wave(adc_channel_t channel, const adc_host_wave_t *wave)
+{
+    if ((unsigned)channel >= ADC_HOST_CHANNEL_COUNT || wave == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&adc_host_wave_lock);
+    adc_host_waves[channel] = *wave;
+    adc_host_waves_set[channel] = true;
+    pthread_mutex_unlock(&adc_host_wave_lock);
+}
+
+// 잡음 없는 값 (실수)
+static double wave_eval(const adc_host_wave_t *w, double t)
+{
+    double phase = w->freq_hz * t;
+    phase -= floor(phase);
+    double duty = (w->duty > 0 && w->duty < 1) ? w->duty : 0.5;
+    double shape;
+
+    switch (w->shape) {
+    case ADC_HOST_WAVE_SINE:
+        shape = sin(2 * M_PI * phase);
+        break;
+    case ADC_HOST_WAVE_SQUARE:
+        shape = phase < duty ? 1.0 : -1.0;
+        break;
+    case ADC_HOST_WAVE_TRIANGLE:
+        shape = phase < 0.5 ? 4 * phase - 1 : 3 - 4 * phase;
+        break;
+    case ADC_HOST_WAVE_SAWTOOTH:
+        shape = 2 * phase - 1;
+        break;
+    case ADC_HOST_WAVE_DC:
+    default:
+        shape = 0;
+        break;
+    }
+    return w->offset + w->amplitude * shape;
+}
+
+static uint16_t clamp_code(double v)
+{
+    long q = lround(v);
+    return (uint16_t)(q < 0 ? 0 : q > ADC_HOST_MAX_CODE ? ADC_HOST_MAX_CODE : q);
+}
+
+// 설정하지 않은 채널은 중간값 DC
+static adc_host_wave_t wave_get(adc_channel_t channel)
+{
+    adc_host_wave_t w = { .shape = ADC_HOST_WAVE_DC, .offset = 2048 };
+    if ((unsigned)channel < ADC_HOST_CHANNEL_COUNT) {
+        pthread_mutex_lock(&adc_host_wave_lock);
+        if (adc_host_waves_set[channel]) {
+            w = adc_host_waves[channel];
+        }
+        pthread_mutex_unlock(&adc_host_wave_lock);
+    }
+    return w;
+}
+
+uint16_t adc_continuous_host_wave_at(adc_channel_t channel, double t)
+{
+    adc_host_wave_t w = wave_get(channel);
+    return clamp_code(wave_eval(&w, t));
+}
+
+void adc_continuous_host_override(uint32_t sample_freq_hz, uint32_t conv_frame_size)
+{
+    adc_host_freq_override = sample_freq_hz;
+    adc_host_frame_override = conv_frame_size;
+}
+
+void adc_continuous_host_set_comparator(int gpio, adc_channel_t channel, int dac_chan)
+{
+    adc_comp_gpio = gpio;
+    adc_comp_channel = channel;
+    adc_comp_dac = dac_chan;
+    adc_comp_level = 1;
+    if (gpio >= 0) {
+        gpio_host_set_level(gpio, 1);
+    }
+}
+
+void adc_continuous_host_get_stats(adc_continuous_host_stats_t *stats)
+{
+    pthread_mutex_lock(&adc_host_stats_lock);
+    *stats = adc_host_stats;
+    pthread_mutex_unlock(&adc_host_stats_lock);
+}
+
+
+/*** 캡처 재생 / 녹화 *************************************************************/
+static void replay_free(void)
+{
+    free(adc_replay.rows);
+    free(adc_replay.frames);
+    free(adc_replay.frame_off);
+    free(adc_replay.frame_len);
+    memset(&adc_replay, 0, sizeof(adc_replay));
+}
+
+static uint32_t rd_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void wr_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// stream_decode.py --csv 출력 (sample,time_us,ch0,ch1). 헤더/주석 줄은 건너뜀
+static esp_err_t replay_load_csv(FILE *f)
+{
+    uint32_t cap = 65536;
+    uint16_t (*rows)[2] = malloc(cap * sizeof(*rows));
+    uint32_t n = 0;
+    char line[128];
+
+    if (rows == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long sample, t;
+        int v0, v1;
+        if (sscanf(line, "%lu,%lu,%d,%d", &sample, &t, &v0, &v1) != 4) {
+            continue;
+        }
+        if (n == cap) {
+            void *grown = realloc(rows, (size_t)cap * 2 * sizeof(*rows));
+            if (grown == NULL) {
+                free(rows);
+                return ESP_ERR_NO_MEM;
+            }
+            rows = grown;
+            cap *= 2;
+        }
+        rows[n][0] = (uint16_t)(v0 & ADC_HOST_MAX_CODE);
+        rows[n][1] = (uint16_t)(v1 & ADC_HOST_MAX_CODE);
+        n++;
+    }
+    if (n == 0) {
+        free(rows);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    adc_replay.kind = REPLAY_CSV;
+    adc_replay.rows = rows;
+    adc_replay.row_count = n;
+    return ESP_OK;
+}
+
+static esp_err_t replay_load_dump(FILE *f)
+{
+    uint8_t hdr[16];
+    if (fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) || rd_le32(hdr) != ADC_DUMP_MAGIC ||
+        rd_le32(hdr + 4) != ADC_DUMP_VERSION) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (fseek(f, 0, SEEK_END) != 0) {
+        return ESP_FAIL;
+    }
+    long file_size = ftell(f);
+    fseek(f, sizeof(hdr), SEEK_SET);
+    size_t body = file_size > (long)sizeof(hdr) ? (size_t)file_size - sizeof(hdr) : 0;
+    uint32_t max_frames = (uint32_t)(body / 6);     // 가장 작은 레코드 (크기 + 워드 하나)
+
+    adc_replay.frames = malloc(body ? body : 1);
+    adc_replay.frame_off = malloc((max_frames ? max_frames : 1) * sizeof(uint32_t));
+    adc_replay.frame_len = malloc((max_frames ? max_frames : 1) * sizeof(uint32_t));
+    if (adc_replay.frames == NULL || adc_replay.frame_off == NULL || adc_replay.frame_len == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    uint32_t off = 0, count = 0;
+    uint8_t len_buf[4];
+    while (fread(len_buf, 1, 4, f) == 4) {
+        uint32_t len = rd_le32(len_buf);
+        if (len == 0 || len % sizeof(uint16_t) != 0 || len > ADC_DUMP_MAX_FRAME || count == max_frames ||
+            fread(adc_replay.frames + off, 1, len, f) != len) {
+            ESP_LOGE(TAG, "replay: bad frame record %lu", (unsigned long)count);
+            return ESP_ERR_INVALID_SIZE;
+        }
+        adc_replay.frame_off[count] = off;
+        adc_replay.frame_len[count] = len;
+        adc_replay.max_frame = len > adc_replay.max_frame ? len : adc_replay.max_frame;
+        off += len;
+        count++;
+    }
+    if (count == 0) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    adc_replay.kind = REPLAY_DUMP;
+    adc_replay.frame_count = count;
+    adc_replay.rate_hz = rd_le32(hdr + 8);
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_host_replay(const char *path, bool realtime, bool loop)
+{
+    if (adc_host_handle != NULL && atomic_load(&adc_host_handle->running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    replay_free();
+    if (path == NULL) {
+        return ESP_OK;      // 합성 파형으로 돌아감
+    }
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        ESP_LOGE(TAG, "replay: cannot open %s", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+    uint8_t magic[4] = { 0 };
+    size_t got = fread(magic, 1, sizeof(magic), f);
+    rewind(f);
+    esp_err_t ret = (got == sizeof(magic) && rd_le32(magic) == ADC_DUMP_MAGIC) ? replay_load_dump(f)
+                                                                                : replay_load_csv(f);
+    fclose(f);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "replay: %s: %s", path, esp_err_to_name(ret));
+        replay_free();
+        return ret;
+    }
+    adc_replay.realtime = realtime;
+    adc_replay.loop = loop;
+    ESP_LOGI(TAG, "replay %s: %lu %s, %s%s", path,
+             (unsigned long)(adc_replay.kind == REPLAY_DUMP ? adc_replay.frame_count : adc_replay.row_count),
+             adc_replay.kind == REPLAY_DUMP ? "frames" : "rows", realtime ? "real time" : "max speed",
+             loop ? ", looping" : "");
+    return ESP_OK;
+}
+
+bool adc_continuous_host_replay_done(void)
+{
+    return adc_replay.kind != REPLAY_NONE && atomic_load(&adc_replay.done);
+}
+
+void adc_continuous_host_replay_hold(bool hold)
+{
+    atomic_store(&adc_replay.hold, hold);
+}
+
+uint64_t adc_continuous_host_replay_frames(void)
+{
+    return adc_replay.kind == REPLAY_DUMP ? adc_replay.frame_count : 0;
+}
+
+esp_err_t adc_continuous_host_record(const char *path)
+{
+    pthread_mutex_lock(&adc_record_lock);
+    if (adc_record_file) {
+        fclose(adc_record_file);
+        adc_record_file = NULL;
+    }
+    esp_err_t ret = ESP_OK;
+    if (path) {
+        adc_record_file = fopen(path, "wb");
+        if (adc_record_file == NULL) {
+            ret = ESP_ERR_NOT_FOUND;
+        } else {
+            // 변환 속도는 첫 프레임에서 채움 (config 전에 불릴 수 있음)
+            uint8_t hdr[16] = { 0 };
+            wr_le32(hdr, ADC_DUMP_MAGIC);
+            wr_le32(hdr + 4, ADC_DUMP_VERSION);
+            fwrite(hdr, 1, sizeof(hdr), adc_record_file);
+        }
+    }
+    pthread_mutex_unlock(&adc_record_lock);
+    return ret;
+}
+
+static void record_frame(const uint8_t *frame, uint32_t len, uint32_t rate_hz)
+{
+    pthread_mutex_lock(&adc_record_lock);
+    if (adc_record_file) {
+        if (ftell(adc_record_file) == 16) {
+            uint8_t rate[4];
+            wr_le32(rate, rate_hz);
+            fseek(adc_record_file, 8, SEEK_SET);
+            fwrite(rate, 1, sizeof(rate), adc_record_file);
+            fseek(adc_record_file, 0, SEEK_END);
+        }
+        uint8_t len_buf[4];
+        wr_le32(len_buf, len);
+        fwrite(len_buf, 1, sizeof(len_buf), adc_record_file);
+        fwrite(frame, 1, len, adc_record_file);
+    }
+    pthread_mutex_unlock(&adc_record_lock);
+}
+
+/*** 생산자 ***********************************************************************/
+static int64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleep_until_ns(int64_t t_ns)
+{
+    struct timespec ts = { .tv_sec = (time_t)(t_ns / 1000000000LL), .tv_nsec = (long)(t_ns % 1000000000LL) };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+    }
+}
+
+static double noise_next(adc_continuous_handle_t h)
+{
+    h->noise_state = h->noise_state * 1103515245u + 12345u;
+    return ((h->noise_state >> 8) & 0xFFFF) / 65536.0 - 0.5;
+}
+
+// 풀에 프레임 넣기 (가득 차면 false)
+static bool pool_push(adc_continuous_handle_t h, const uint8_t *frame, uint32_t len)
+{
+    pthread_mutex_lock(&h->lock);
+    bool ok = h->pool_count < h->pool_frames;
+    if (ok) {
+        uint32_t tail = (h->pool_head + h->pool_count) % h->pool_frames;
+        memcpy(h->pool + (size_t)tail * h->dma_size, frame, len);
+        h->pool_len[tail] = len;
+        h->pool_count++;
+        pthread_cond_signal(&h->pool_cond);
+    }
+    pthread_mutex_unlock(&h->lock);
+    return ok;
+}
+
+// 다음 프레임 채우기. 반환: 바이트 수 (재생이 끝났으면 0)
+static uint32_t fill_frame(adc_continuous_handle_t h, uint16_t *frame)
+{
+    uint32_t words = h->frame_size / sizeof(uint16_t);
+
+    if (adc_replay.kind == REPLAY_DUMP) {
+        if (adc_replay.next_frame == adc_replay.frame_count) {
+            if (!adc_replay.loop) {
+                return 0;
+            }
+            adc_replay.next_frame = 0;
+        }
+        uint32_t i = adc_replay.next_frame++;
+        memcpy(frame, adc_replay.frames + adc_replay.frame_off[i], adc_replay.frame_len[i]);
+        return adc_replay.frame_len[i];
+    }
+
+    if (adc_replay.kind == REPLAY_CSV) {
+        // 행 하나 = 패턴 한 바퀴, 패턴 p는 CSV 열 min(p, 1). 프레임 중간에서 끝나면 그 프레임은 버림
+        uint64_t rows_needed = (h->conv_index + words + h->pattern_num - 1) / h->pattern_num;
+        if (!adc_replay.loop && rows_needed > adc_replay.row_count) {
+            return 0;
+        }
+        for (uint32_t i = 0; i < words; i++) {
+            uint64_t n = h->conv_index + i;
+            uint32_t p = (uint32_t)(n % h->pattern_num);
+            uint32_t row = (uint32_t)((n / h->pattern_num) % adc_replay.row_count);
+            frame[i] = (uint16_t)((h->pattern[p].channel & 0xF) << 12) | adc_replay.rows[row][p < 1 ? 0 : 1];
+        }
+        return words * sizeof(uint16_t);
+    }
+
+    adc_host_wave_t waves[ADC_HOST_PATTERN_MAX];
+    for (uint32_t p = 0; p < h->pattern_num; p++) {
+        waves[p] = wave_get((adc_channel_t)h->pattern[p].channel);
+    }
+    for (uint32_t i = 0; i < words; i++) {
+        uint64_t n = h->conv_index + i;
+        uint32_t p = (uint32_t)(n % h->pattern_num);
+        double t = (double)n / h->freq_hz;
+        uint16_t code = clamp_code(wave_eval(&waves[p], t) + waves[p].noise * noise_next(h));
+        frame[i] = (uint16_t)((h->pattern[p].channel & 0xF) << 12) | code;
+    }
+    return words * sizeof(uint16_t);
+}
+
+static void *adc_host_producer(void *arg)
+{
+    adc_continuous_handle_t h = arg;
+    uint32_t rate = (adc_replay.kind == REPLAY_DUMP && adc_replay.rate_hz) ? adc_replay.rate_hz : h->freq_hz;
+    bool realtime = adc_replay.kind == REPLAY_NONE || adc_replay.realtime;
+    int64_t conv_ns = 1000000000LL / rate;
+    int64_t t0 = mono_ns();
+    uint64_t base = h->conv_index;      // t0에 해당하는 변환 번호
+
+    pthread_setname_np(pthread_self(), "adc_host_dma");
+    while (atomic_load_explicit(&h->running, memory_order_acquire)) {
+        if (adc_replay.kind != REPLAY_NONE && atomic_load(&adc_replay.hold)) {
+            sleep_until_ns(mono_ns() + 1000000);
+            t0 = mono_ns();
+            base = h->conv_index;
+            continue;
+        }
+        uint16_t *frame = (uint16_t *)h->dma[h->dma_next];
+        uint32_t len = fill_frame(h, frame);
+        if (len == 0) {
+            atomic_store(&adc_replay.done, true);
+            break;
+        }
+        h->dma_next = (h->dma_next + 1) % h->dma_count;
+        uint32_t words = len / sizeof(uint16_t);
+
+        // 비교기: 샘플 시각에 맞춰 GPIO 엣지 (최대 속도 재생이면 기다리지 않음)
+        int comp_gpio = adc_comp_gpio;
+        int comp_threshold = dac_oneshot_host_level((dac_channel_t)adc_comp_dac) * ADC_HOST_MAX_CODE / 255;
+        uint32_t edges = 0;
+        for (uint32_t i = 0; comp_gpio >= 0 && i < words; i++) {
+            if ((frame[i] >> 12) != (uint16_t)adc_comp_channel) {
+                continue;
+            }
+            int code = frame[i] & ADC_HOST_MAX_CODE;
+            int level = adc_comp_level;
+            if (level && code > comp_threshold + ADC_HOST_COMP_HYST / 2) {
+                level = 0;
+            } else if (!level && code < comp_threshold - ADC_HOST_COMP_HYST / 2) {
+                level = 1;
+            }
+            if (level != adc_comp_level) {
+                adc_comp_level = level;
+                if (realtime) {
+                    sleep_until_ns(t0 + (int64_t)(h->conv_index + i + 1 - base) * conv_ns);
+                }
+                gpio_host_set_level(comp_gpio, level);
+                edges++;
+            }
+        }
+        h->conv_index += words;
+
+        // 프레임 마지막 변환 시각까지 대기
+        int64_t late = 0;
+        if (realtime) {
+            int64_t due = t0 + (int64_t)(h->conv_index - base) * conv_ns;
+            sleep_until_ns(due);
+            late = mono_ns() - due;
+        }
+
+        adc_continuous_evt_data_t edata = {
+            .conv_frame_buffer = (uint8_t *)frame,
+            .size = len,
+        };
+        record_frame((const uint8_t *)frame, len, rate);
+        if (h->cbs.on_conv_done) {
+            h->cbs.on_conv_done(h, &edata, h->user_data);
+        }
+        bool pooled = pool_push(h, (const uint8_t *)frame, len);
+        if (!pooled && h->cbs.on_pool_ovf) {
+            h->cbs.on_pool_ovf(h, &edata, h->user_data);
+        }
+        adc_replay.delivered += adc_replay.kind != REPLAY_NONE;
+
+        pthread_mutex_lock(&adc_host_stats_lock);
+        adc_host_stats.frames++;
+        adc_host_stats.conversions += words;
+        adc_host_stats.pool_overflows += pooled ? 0 : 1;
+        adc_host_stats.comparator_edges += edges;
+        if (late > (int64_t)words * conv_ns) {
+            adc_host_stats.late_frames++;
+        }
+        if (late / 1000 > adc_host_stats.max_late_us) {
+            adc_host_stats.max_late_us = late / 1000;
+        }
+        if (late > ADC_HOST_RESYNC_NS) {
+            adc_host_stats.resyncs++;
+            t0 = mono_ns();
+            base = h->conv_index;
+        }
+        pthread_mutex_unlock(&adc_host_stats_lock);
+    }
+    return NULL;
+}
+
+/*** ADC continuous API ***********************************************************/
+static void dma_free(adc_continuous_handle_t h)
+{
+    for (uint32_t i = 0; i < ADC_HOST_REPLAY_BUFS; i++) {
+        free(h->dma[i]);
+        h->dma[i] = NULL;
+    }
+    free(h->pool);
+    free(h->pool_len);
+    h->pool = NULL;
+    h->pool_len = NULL;
+}
+
+// DMA 버퍼와 풀 (재생 방식에 따라 수/크기가 달라 start에서 만듦)
+static esp_err_t dma_alloc(adc_continuous_handle_t h)
+{
+    bool max_speed = adc_replay.kind != REPLAY_NONE && !adc_replay.realtime;
+    uint32_t size = h->frame_size;
+    if (adc_replay.kind == REPLAY_DUMP && adc_replay.max_frame > size) {
+        size = adc_replay.max_frame;
+    }
+    dma_free(h);
+    h->dma_count = max_speed ? ADC_HOST_REPLAY_BUFS : ADC_HOST_DMA_BUFS;
+    h->dma_size = size;
+    h->dma_next = 0;
+    h->pool = malloc((size_t)h->pool_frames * size);
+    h->pool_len = calloc(h->pool_frames, sizeof(uint32_t));
+    bool ok = h->pool != NULL && h->pool_len != NULL;
+    for (uint32_t i = 0; i < h->dma_count && ok; i++) {
+        h->dma[i] = calloc(1, size);
+        ok = h->dma[i] != NULL;
+    }
+    if (!ok) {
+        dma_free(h);
+        return ESP_ERR_NO_MEM;
+    }
+    h->pool_head = h->pool_count = h->pool_offset = 0;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle)
+{
+    if (hdl_config == NULL || ret_handle == NULL || hdl_config->conv_frame_size == 0 ||
+        hdl_config->conv_frame_size % sizeof(uint16_t) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (adc_host_handle != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    uint32_t pool_frames = hdl_config->max_store_buf_size / hdl_config->conv_frame_size;
+
+    adc_continuous_handle_t h = calloc(1, sizeof(*h));
+    if (h == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    h->frame_size = adc_host_frame_override ? adc_host_frame_override : hdl_config->conv_frame_size;
+    h->pool_frames = pool_frames > 0 ? pool_frames : 1;
+    pthread_mutex_init(&h->lock, NULL);
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&h->pool_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    h->noise_state = 1;
+
+    adc_host_handle = h;
+    *ret_handle = h;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config)
+{
+    if (handle == NULL || config == NULL || config->pattern_num == 0 ||
+        config->pattern_num > ADC_HOST_PATTERN_MAX || config->adc_pattern == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&handle->running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    uint32_t freq = adc_host_freq_override ? adc_host_freq_override : config->sample_freq_hz;
+    if (freq == 0 || freq > 2000000) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (uint32_t i = 0; i < config->pattern_num; i++) {
+        if (config->adc_pattern[i].channel >= ADC_HOST_CHANNEL_COUNT) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        handle->pattern[i] = config->adc_pattern[i];
+    }
+    handle->pattern_num = config->pattern_num;
+    handle->freq_hz = freq;
+    handle->configured = true;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs,
+                                                  void *user_data)
+{
+    if (handle == NULL || cbs == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&handle->running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    handle->cbs = *cbs;
+    handle->user_data = user_data;
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!handle->configured || atomic_load(&handle->running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t ret = dma_alloc(handle);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    // 최대 속도 재생은 프레임을 잃으면 결과가 달라지므로 ISR 큐 전송이 자리가 날 때까지 기다림
+    queue_host_set_isr_blocking(adc_replay.kind != REPLAY_NONE && !adc_replay.realtime);
+    atomic_store(&adc_replay.done, false);
+    atomic_store(&handle->running, true);
+    if (pthread_create(&handle->thread, NULL, adc_host_producer, handle) != 0) {
+        atomic_store(&handle->running, false);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!atomic_exchange(&handle->running, false)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    pthread_join(handle->thread, NULL);
+    return ESP_OK;
+}
+
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max,
+                              uint32_t *out_length, uint32_t timeout_ms)
+{
+    if (handle == NULL || buf == NULL || out_length == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    uint64_t ns = (uint64_t)timeout_ms * 1000000ULL + (uint64_t)deadline.tv_nsec;
+    deadline.tv_sec += (time_t)(ns / 1000000000ULL);
+    deadline.tv_nsec = (long)(ns % 1000000000ULL);
+
+    pthread_mutex_lock(&handle->lock);
+    while (handle->pool_count == 0 && timeout_ms != 0) {
+        if (pthread_cond_timedwait(&handle->pool_cond, &handle->lock, &deadline) != 0) {
+            break;
+        }
+    }
+    uint32_t copied = 0;
+    while (copied < length_max && handle->pool_count > 0) {
+        const uint8_t *src = handle->pool + (size_t)handle->pool_head * handle->dma_size;
+        uint32_t len = handle->pool_len[handle->pool_head];
+        uint32_t n = len - handle->pool_offset;
+        n = n < length_max - copied ? n : length_max - copied;
+        memcpy(buf + copied, src + handle->pool_offset, n);
+        copied += n;
+        handle->pool_offset += n;
+        if (handle->pool_offset == len) {
+            handle->pool_offset = 0;
+            handle->pool_head = (handle->pool_head + 1) % handle->pool_frames;
+            handle->pool_count--;
+        }
+    }
+    pthread_mutex_unlock(&handle->lock);
+
+    *out_length = copied;
+    return copied > 0 ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&handle->running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    dma_free(handle);
+    pthread_mutex_destroy(&handle->lock);
+    pthread_cond_destroy(&handle->pool_cond);
+    free(handle);
+    if (adc_host_handle == handle) {
+        adc_host_handle = NULL;
+    }
+    return ESP_OK;
+}
+
+/*** 레거시 ADC *******************************************************************/
+esp_err_t adc1_config_width(adc_bits_width_t width_bit)
+{
+    return width_bit <= ADC_WIDTH_BIT_12 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t adc1_config_channel_atten(adc1_channel_t channel, adc_atten_t atten)
+{
+    (void)atten;
+    return (unsigned)channel <= ADC1_CHANNEL_7 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+int adc1_get_raw(adc1_channel_t channel)
+{
+    if ((unsigned)channel > ADC1_CHANNEL_7) {
+        return -1;
+    }
+    return adc_continuous_host_wave_at((adc_channel_t)channel, esp_timer_get_time() / 1e6);
+}
+
+esp_err_t adc2_config_channel_atten(adc2_channel_t channel, adc_atten_t atten)
+{
+    (void)atten;
+    return (unsigned)channel <= ADC2_CHANNEL_9 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t adc2_get_raw(adc2_channel_t channel, adc_bits_width_t width_bit, int *raw_out)
+{
+    (void)channel;
+    (void)width_bit;
+    (void)raw_out;
+    return ESP_ERR_TIMEOUT;
+}
+
+/*** ADC 캘리브레이션 *************************************************************/
+struct adc_cali_host {
+    int full_scale_mv;
+};
+
+esp_err_t adc_cali_create_scheme_line_fitting(const adc_cali_line_fitting_config_t *config,
+                                              adc_cali_handle_t *ret_handle)
+{
+    static const int full_scale_mv[] = { 1100, 1500, 2200, 3900 };
+    if (config == NULL || ret_handle == NULL || (unsigned)config->atten > ADC_ATTEN_DB_12) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    adc_cali_handle_t h = calloc(1, sizeof(*h));
+    if (h == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    h->full_scale_mv = full_scale_mv[config->atten];
+    *ret_handle = h;
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_delete_scheme_line_fitting(adc_cali_handle_t handle)
+{
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage)
+{
+    if (handle == NULL || voltage == NULL || raw < 0 || raw > ADC_HOST_MAX_CODE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *voltage = (raw * handle->full_scale_mv + ADC_HOST_MAX_CODE / 2) / ADC_HOST_MAX_CODE;
+    return ESP_OK;
+}
+
+/*** DAC **************************************************************************/
+struct dac_oneshot_host {
+    dac_channel_t chan;
+};
+
+static _Atomic uint8_t dac_host_levels[DAC_HOST_CHANNEL_COUNT];
+static bool dac_host_in_use[DAC_HOST_CHANNEL_COUNT];
+
+esp_err_t dac_oneshot_new_channel(const dac_oneshot_config_t *oneshot_cfg, dac_oneshot_handle_t *ret_handle)
+{
+    if (oneshot_cfg == NULL || ret_handle == NULL || (unsigned)oneshot_cfg->chan_id >= DAC_HOST_CHANNEL_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dac_host_in_use[oneshot_cfg->chan_id]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    dac_oneshot_handle_t h = calloc(1, sizeof(*h));
+    if (h == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    h->chan = oneshot_cfg->chan_id;
+    dac_host_in_use[h->chan] = true;
+    *ret_handle = h;
+    return ESP_OK;
+}
+
+esp_err_t dac_oneshot_del_channel(dac_oneshot_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    dac_host_in_use[handle->chan] = false;
+    atomic_store(&dac_host_levels[handle->chan], 0);
+    free(handle);
+    return ESP_OK;
+}
+
+esp_err_t dac_oneshot_output_voltage(dac_oneshot_handle_t handle, uint8_t digi_value)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    atomic_store(&dac_host_levels[handle->chan], digi_value);
+    return ESP_OK;
+}
+
+uint8_t dac_oneshot_host_level(dac_channel_t chan)
+{
+    return (unsigned)chan < DAC_HOST_CHANNEL_COUNT ? atomic_load(&dac_host_levels[chan]) : 0;
+}
@@ -0,0 +1,42 @@
+#ifndef DRIVER_ADC_H
+#define DRIVER_ADC_H
+
+// 호스트 빌드용 ESP-IDF 대역: 레거시 ADC 폴링 API
+// ADC1은 합성 ADC(adc_continuous_host_set_wave)의 채널 파형을 지금 시각에서 읽고,
+// ADC2는 모델이 없어 Wi-Fi가 ADC2를 쓰는 중일 때와 같은 ESP_ERR_TIMEOUT을 돌려준다
+
+#include "esp_err.h"
+#include "hal/adc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ADC1_CHANNEL_0 = 0, ADC1_CHANNEL_1, ADC1_CHANNEL_2, ADC1_CHANNEL_3,
+    ADC1_CHANNEL_4, ADC1_CHANNEL_5, ADC1_CHANNEL_6, ADC1_CHANNEL_7,
+} adc1_channel_t;
+
+typedef enum {
+    ADC2_CHANNEL_0 = 0, ADC2_CHANNEL_1, ADC2_CHANNEL_2, ADC2_CHANNEL_3, ADC2_CHANNEL_4,
+    ADC2_CHANNEL_5, ADC2_CHANNEL_6, ADC2_CHANNEL_7, ADC2_CHANNEL_8, ADC2_CHANNEL_9,
+} adc2_channel_t;
+
+typedef enum {
+    ADC_WIDTH_BIT_9 = 0,
+    ADC_WIDTH_BIT_10,
+    ADC_WIDTH_BIT_11,
+    ADC_WIDTH_BIT_12,
+} adc_bits_width_t;
+
+esp_err_t adc1_config_width(adc_bits_width_t width_bit);
+esp_err_t adc1_config_channel_atten(adc1_channel_t channel, adc_atten_t atten);
+int adc1_get_raw(adc1_channel_t channel);
+esp_err_t adc2_config_channel_atten(adc2_channel_t channel, adc_atten_t atten);
+esp_err_t adc2_get_raw(adc2_channel_t channel, adc_bits_width_t width_bit, int *raw_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVER_ADC_H
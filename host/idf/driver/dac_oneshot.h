@@ -0,0 +1,37 @@
+#ifndef DRIVER_DAC_ONESHOT_H
+#define DRIVER_DAC_ONESHOT_H
+
+// 호스트 빌드용 ESP-IDF 대역: DAC는 마지막 출력 값만 기억한다 (합성 ADC의 트리거 비교기가 읽음)
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    DAC_CHAN_0 = 0,     // GPIO25
+    DAC_CHAN_1 = 1,     // GPIO26
+} dac_channel_t;
+
+#define DAC_HOST_CHANNEL_COUNT  2
+
+typedef struct {
+    dac_channel_t chan_id;
+} dac_oneshot_config_t;
+
+typedef struct dac_oneshot_host *dac_oneshot_handle_t;
+
+esp_err_t dac_oneshot_new_channel(const dac_oneshot_config_t *oneshot_cfg, dac_oneshot_handle_t *ret_handle);
+esp_err_t dac_oneshot_del_channel(dac_oneshot_handle_t handle);
+esp_err_t dac_oneshot_output_voltage(dac_oneshot_handle_t handle, uint8_t digi_value);
+
+// 호스트 전용: 채널의 현재 출력 (0~255, 채널을 만들기 전이면 0)
+uint8_t dac_oneshot_host_level(dac_channel_t chan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVER_DAC_ONESHOT_H
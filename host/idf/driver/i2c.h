@@ -0,0 +1,91 @@
+#ifndef DRIVER_I2C_H
+#define DRIVER_I2C_H
+
+// 호스트 빌드용 ESP-IDF 대역: 레거시 I2C 마스터 API
+//
+// 전송은 i2c_host_set_device_model로 연결한 버스 모델(CH423 모델 등)을 호출한다.
+// 명령 링크는 START마다 한 전송으로 나눠 넘기고, 버스 시간(9비트/바이트 + START/STOP)만큼
+// 호출한 스레드를 재운다. 버스는 포트마다 뮤텍스 하나 (드라이버의 버스 잠금과 같음)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "driver/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0           0
+#define I2C_NUM_1           1
+#define I2C_NUM_MAX         2
+
+typedef enum {
+    I2C_MODE_SLAVE = 0,
+    I2C_MODE_MASTER,
+} i2c_mode_t;
+
+typedef enum {
+    I2C_MASTER_WRITE = 0,
+    I2C_MASTER_READ,
+} i2c_rw_t;
+
+typedef enum {
+    I2C_MASTER_ACK = 0,
+    I2C_MASTER_NACK,
+    I2C_MASTER_LAST_NACK,
+} i2c_ack_type_t;
+
+typedef struct {
+    i2c_mode_t mode;
+    int sda_io_num;
+    int scl_io_num;
+    bool sda_pullup_en;
+    bool scl_pullup_en;
+    struct {
+        uint32_t clk_speed;
+    } master;
+    uint32_t clk_flags;
+} i2c_config_t;
+
+typedef struct i2c_cmd_host *i2c_cmd_handle_t;
+
+esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len,
+                             int intr_alloc_flags);
+esp_err_t i2c_driver_delete(i2c_port_t port);
+esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t *conf);
+
+i2c_cmd_handle_t i2c_cmd_link_create(void);
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t *data, size_t len, bool ack_en);
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd, uint8_t *data, i2c_ack_type_t ack);
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t *data, size_t len, i2c_ack_type_t ack);
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks_to_wait);
+
+esp_err_t i2c_master_write_to_device(i2c_port_t port, uint8_t addr, const uint8_t *write_buf, size_t write_size,
+                                     TickType_t ticks_to_wait);
+esp_err_t i2c_master_read_from_device(i2c_port_t port, uint8_t addr, uint8_t *read_buf, size_t read_size,
+                                      TickType_t ticks_to_wait);
+esp_err_t i2c_master_write_read_device(i2c_port_t port, uint8_t addr, const uint8_t *write_buf, size_t write_size,
+                                       uint8_t *read_buf, size_t read_size, TickType_t ticks_to_wait);
+
+// 버스 모델: 7비트 주소 장치와 한 번의 전송 (쓰기 후 반복 START 읽기는 한 호출로).
+// 응답이 없으면(NACK) ESP_FAIL
+typedef esp_err_t (*i2c_host_transfer_fn)(uint8_t addr, const uint8_t *wr, size_t wr_len, uint8_t *rd,
+                                          size_t rd_len);
+
+// 호스트 전용: 포트에 연결할 버스 모델
+void i2c_host_set_device_model(i2c_port_t port, i2c_host_transfer_fn fn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVER_I2C_H
@@ -0,0 +1,90 @@
+#ifndef DRIVER_SPI_MASTER_H
+#define DRIVER_SPI_MASTER_H
+
+// 호스트 빌드용 ESP-IDF 대역: SPI 마스터 API
+//
+// 트랜잭션은 큐에 넣는 순간 spi_host_transfer_fn(장치 모델)으로 바로 처리되고,
+// spi_device_get_trans_result는 넣은 순서대로 돌려준다.
+// SPI_TRANS_VARIABLE_ADDR의 주소 phase는 MSB부터 바이트로 풀어 데이터 앞에 붙여 넘긴다.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+    SPI3_HOST = 2,
+} spi_host_device_t;
+
+#define SPI_DMA_DISABLED        0
+#define SPI_DMA_CH_AUTO         3
+
+#define SPI_TRANS_VARIABLE_CMD  (1 << 10)
+#define SPI_TRANS_VARIABLE_ADDR (1 << 11)
+
+typedef struct {
+    int mosi_io_num;
+    int miso_io_num;
+    int sclk_io_num;
+    int quadwp_io_num;
+    int quadhd_io_num;
+    int max_transfer_sz;
+    uint32_t flags;
+} spi_bus_config_t;
+
+typedef struct {
+    uint8_t mode;
+    int clock_speed_hz;
+    int spics_io_num;
+    uint32_t flags;
+    int queue_size;
+} spi_device_interface_config_t;
+
+typedef struct {
+    uint32_t flags;
+    uint16_t cmd;
+    uint64_t addr;
+    size_t length;          // 비트
+    size_t rxlength;        // 비트 (0이면 length)
+    void *user;
+    const void *tx_buffer;
+    void *rx_buffer;
+} spi_transaction_t;
+
+typedef struct {
+    spi_transaction_t base;
+    uint8_t command_bits;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+} spi_transaction_ext_t;
+
+typedef struct spi_device_host *spi_device_handle_t;
+
+// 장치 모델: CS 한 번 동안의 전이중 전송 (tx/rx는 같은 길이, rx는 NULL 가능)
+typedef void (*spi_host_transfer_fn)(const uint8_t *tx, uint8_t *rx, size_t len, int clock_hz);
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans);
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t ticks_to_wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans,
+                                      TickType_t ticks_to_wait);
+
+// 호스트 전용: 버스에 연결할 장치 모델 (이후 추가되는 장치에 적용)
+void spi_host_set_device_model(spi_host_device_t host, spi_host_transfer_fn fn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVER_SPI_MASTER_H
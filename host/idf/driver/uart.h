@@ -0,0 +1,39 @@
+#ifndef DRIVER_UART_H
+#define DRIVER_UART_H
+
+// 호스트 빌드용 ESP-IDF 대역: UART는 보낸 바이트 수만 세고 버린다
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int uart_port_t;
+
+#define UART_NUM_0      0
+#define UART_NUM_1      1
+#define UART_NUM_2      2
+#define UART_NUM_MAX    3
+
+esp_err_t uart_driver_install(uart_port_t port, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags);
+esp_err_t uart_driver_delete(uart_port_t port);
+bool uart_is_driver_installed(uart_port_t port);
+esp_err_t uart_set_baudrate(uart_port_t port, uint32_t baudrate);
+int uart_write_bytes(uart_port_t port, const void *src, size_t size);
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t ticks_to_wait);
+
+// 호스트 전용: 지금까지 보낸 바이트
+uint64_t uart_host_tx_bytes(uart_port_t port);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DRIVER_UART_H
@@ -0,0 +1,20 @@
+#ifndef ESP_ADC_ADC_CALI_H
+#define ESP_ADC_ADC_CALI_H
+
+// 호스트 빌드용 ESP-IDF 대역: ADC 캘리브레이션 핸들
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct adc_cali_host *adc_cali_handle_t;
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_ADC_ADC_CALI_H
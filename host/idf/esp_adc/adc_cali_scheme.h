@@ -0,0 +1,31 @@
+#ifndef ESP_ADC_ADC_CALI_SCHEME_H
+#define ESP_ADC_ADC_CALI_SCHEME_H
+
+// 호스트 빌드용 ESP-IDF 대역: line fitting은 감쇠별 공칭 풀스케일 직선
+// (0 dB 1100 mV, 2.5 dB 1500 mV, 6 dB 2200 mV, 12 dB 3900 mV)
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "hal/adc_types.h"
+#include "esp_adc/adc_cali.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    adc_unit_t unit_id;
+    adc_atten_t atten;
+    adc_bitwidth_t bitwidth;
+    uint32_t default_vref;
+} adc_cali_line_fitting_config_t;
+
+esp_err_t adc_cali_create_scheme_line_fitting(const adc_cali_line_fitting_config_t *config,
+                                              adc_cali_handle_t *ret_handle);
+esp_err_t adc_cali_delete_scheme_line_fitting(adc_cali_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_ADC_ADC_CALI_SCHEME_H
@@ -0,0 +1,138 @@
+#ifndef ESP_ADC_ADC_CONTINUOUS_H
+#define ESP_ADC_ADC_CONTINUOUS_H
+
+// 호스트 빌드용 ESP-IDF 대역: 합성 ADC continuous 드라이버
+//
+// adc_continuous_start 후 생산자 스레드가 sample_freq_hz로 패턴 순서대로 변환한 값을
+// TYPE1 형식(12비트 값 | 채널 << 12)으로 conv_frame_size 바이트 프레임에 채우고, 프레임 시간이
+// 다 되면 on_conv_done을 부른다 (ISR과 같이 생산자 스레드에서).
+//   - DMA 버퍼는 IDF와 같이 프레임 5개를 돌려 쓰므로 conv_frame_buffer는 5프레임 뒤에 덮어써진다
+//   - 프레임은 max_store_buf_size 풀에도 들어가며(adc_continuous_read로 꺼냄), 가득 차면
+//     on_pool_ovf를 부르고 그 프레임은 풀에 넣지 않는다
+//   - 채널 값은 adc_continuous_host_set_wave로 정한 파형 (raw 코드 단위) 또는 캡처 재생
+//   - 트리거 비교기 모델: 지정한 채널이 DAC 레벨을 넘으면 지정한 GPIO를 0으로, 내려가면 1로
+//     (샘플 시각에 맞춰 gpio_host_set_level). DAC 0~255는 ADC 코드 0~4095에 대응시킨다
+// ADC 핸들은 하나만 만들 수 있다 (IDF와 같음).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "hal/adc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADC_HOST_PATTERN_MAX    16
+#define ADC_HOST_DMA_BUFS       5       // IDF INTERNAL_BUF_NUM
+#define ADC_HOST_REPLAY_BUFS    32      // 최대 속도 재생 (처리 큐 깊이보다 넉넉히)
+
+typedef struct adc_continuous_ctx_t *adc_continuous_handle_t;
+
+typedef struct {
+    uint32_t max_store_buf_size;
+    uint32_t conv_frame_size;
+    struct {
+        uint32_t flush_pool: 1;
+    } flags;
+} adc_continuous_handle_cfg_t;
+
+typedef struct {
+    uint8_t atten;
+    uint8_t channel;
+    uint8_t unit;
+    uint8_t bit_width;
+} adc_digi_pattern_config_t;
+
+typedef struct {
+    uint32_t pattern_num;
+    adc_digi_pattern_config_t *adc_pattern;
+    uint32_t sample_freq_hz;
+    adc_digi_convert_mode_t conv_mode;
+    adc_digi_output_format_t format;
+} adc_continuous_config_t;
+
+typedef struct {
+    uint8_t *conv_frame_buffer;
+    uint32_t size;
+} adc_continuous_evt_data_t;
+
+typedef bool (*adc_continuous_callback_t)(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata,
+                                          void *user_data);
+
+typedef struct {
+    adc_continuous_callback_t on_conv_done;
+    adc_continuous_callback_t on_pool_ovf;
+} adc_continuous_evt_cbs_t;
+
+esp_err_t adc_continuous_new_handle(const adc_continuous_handle_cfg_t *hdl_config, adc_continuous_handle_t *ret_handle);
+esp_err_t adc_continuous_config(adc_continuous_handle_t handle, const adc_continuous_config_t *config);
+esp_err_t adc_continuous_register_event_callbacks(adc_continuous_handle_t handle, const adc_continuous_evt_cbs_t *cbs,
+                                                  void *user_data);
+esp_err_t adc_continuous_start(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_stop(adc_continuous_handle_t handle);
+esp_err_t adc_continuous_read(adc_continuous_handle_t handle, uint8_t *buf, uint32_t length_max,
+                              uint32_t *out_length, uint32_t timeout_ms);
+esp_err_t adc_continuous_deinit(adc_continuous_handle_t handle);
+
+/*** 호스트 전용 ******************************************************************/
+typedef enum {
+    ADC_HOST_WAVE_DC,
+    ADC_HOST_WAVE_SINE,
+    ADC_HOST_WAVE_SQUARE,
+    ADC_HOST_WAVE_TRIANGLE,
+    ADC_HOST_WAVE_SAWTOOTH,
+} adc_host_wave_shape_t;
+
+// 값 = offset + amplitude * 모양(-1~1) + 잡음, 0~4095로 자름
+typedef struct {
+    adc_host_wave_shape_t shape;
+    float freq_hz;
+    float amplitude;        // 피크 (raw 코드)
+    float offset;           // raw 코드
+    float duty;             // 사각파 high 비율 (0이면 0.5)
+    float noise;            // 균일 잡음 피크-피크 (raw 코드)
+} adc_host_wave_t;
+
+typedef struct {
+    uint64_t frames;            // on_conv_done 호출 수
+    uint64_t conversions;       // 변환(샘플) 수
+    uint32_t pool_overflows;    // 풀이 가득 차 넣지 못한 프레임
+    uint32_t late_frames;       // 프레임 시각보다 한 프레임 이상 늦게 낸 프레임 (호스트 과부하)
+    int64_t max_late_us;
+    uint32_t resyncs;           // 너무 늦어 시간축을 다시 잡은 횟수
+    uint32_t comparator_edges;
+} adc_continuous_host_stats_t;
+
+// ADC1 채널 파형 (기본: 모든 채널 2048 DC)
+void adc_continuous_host_set_wave(adc_channel_t channel, const adc_host_wave_t *wave);
+// 시각 t(초)에서 채널 값 (잡음 제외)
+uint16_t adc_continuous_host_wave_at(adc_channel_t channel, double t);
+// 펌웨어 설정 대신 쓸 변환 속도/프레임 크기 (0이면 펌웨어 값). 다음 config부터 적용
+void adc_continuous_host_override(uint32_t sample_freq_hz, uint32_t conv_frame_size);
+// 트리거 비교기 (gpio < 0이면 끔)
+void adc_continuous_host_set_comparator(int gpio, adc_channel_t channel, int dac_chan);
+void adc_continuous_host_get_stats(adc_continuous_host_stats_t *stats);
+
+// 캡처 재생: 합성 파형 대신 파일의 샘플을 낸다 (adc_continuous_start 전에 부름, NULL이면 합성으로 돌아감)
+//   - 프레임 덤프 (adc_continuous_host_record로 저장): 프레임 경계와 evt size, 채널 비트까지 그대로
+//   - CSV (host/stream_decode.py --csv: sample,time_us,ch0,ch1): 행 하나가 패턴 한 바퀴, 프레임은
+//     드라이버 conv_frame_size로 자름 (끝에 남는 조각 프레임은 버림)
+// realtime=false면 최대 속도: 프레임 사이 대기 없이 내고, DMA 버퍼를 ADC_HOST_REPLAY_BUFS개로 늘리고
+// xQueueSendFromISR가 기다리게 해(queue_host_set_isr_blocking) 처리 태스크가 놓치는 프레임이 없다.
+// 이때 트리거 비교기 엣지는 샘플 시각에 맞추지 않으므로 하드웨어 트리거 시각은 의미가 없다.
+// loop=false면 파일 끝에서 멈춤 (adc_continuous_host_replay_done)
+esp_err_t adc_continuous_host_replay(const char *path, bool realtime, bool loop);
+bool adc_continuous_host_replay_done(void);
+// 재생을 잠시 잡아 둠 (start 전에 잡아 두면 첫 프레임부터 기다림). 풀면 그 시각부터 실시간을 다시 셈
+void adc_continuous_host_replay_hold(bool hold);
+// 덤프 재생이면 파일의 프레임 수 (CSV/합성이면 0)
+uint64_t adc_continuous_host_replay_frames(void);
+// 생산자가 낸 프레임을 덤프 파일로 저장 (NULL이면 닫음). 합성/재생 어느 쪽이든 저장됨
+esp_err_t adc_continuous_host_record(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_ADC_ADC_CONTINUOUS_H
@@ -0,0 +1,10 @@
+#ifndef ESP_ATTR_H
+#define ESP_ATTR_H
+
+// 호스트 빌드용 ESP-IDF 대역: 메모리 배치 속성은 정렬만 남김
+
+#define DMA_ATTR        __attribute__((aligned(4)))
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#endif // ESP_ATTR_H
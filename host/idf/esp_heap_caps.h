@@ -0,0 +1,20 @@
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+// 호스트 빌드용 ESP-IDF 대역: 메모리 종류 구분 없이 malloc
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+
+#define HEAP_HOST_LARGEST_BLOCK         (4 * 1024 * 1024)   // 내부 DRAM/PSRAM 크기 대신 고정값
+
+#define heap_caps_malloc(size, caps)    malloc(size)
+#define heap_caps_calloc(n, size, caps) calloc(n, size)
+#define heap_caps_free(p)               free(p)
+#define heap_caps_get_largest_free_block(caps)  ((size_t)HEAP_HOST_LARGEST_BLOCK)
+
+#endif // ESP_HEAP_CAPS_H
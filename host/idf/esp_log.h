@@ -0,0 +1,49 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+// 호스트 빌드용 ESP-IDF 대역: 로그는 stderr로 (기본 WARN 이상만)
+// esp_log_set_vprintf로 출력 함수를 바꿀 수 있다
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    ESP_LOG_NONE = 0,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+typedef int (*vprintf_like_t)(const char *fmt, va_list args);
+
+extern esp_log_level_t esp_log_host_level;
+
+// 태그별 설정은 없음 (모든 태그에 적용)
+void esp_log_level_set(const char *tag, esp_log_level_t level);
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func);
+void esp_log_host_write(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+#define ESP_HOST_LOG(level, letter, tag, fmt, ...) \
+    do { \
+        if (esp_log_host_level >= (level)) { \
+            esp_log_host_write(letter " (%s) " fmt "\n", tag, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define ESP_LOGE(tag, fmt, ...) ESP_HOST_LOG(ESP_LOG_ERROR, "E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) ESP_HOST_LOG(ESP_LOG_WARN, "W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) ESP_HOST_LOG(ESP_LOG_INFO, "I", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) ESP_HOST_LOG(ESP_LOG_DEBUG, "D", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) ESP_HOST_LOG(ESP_LOG_VERBOSE, "V", tag, fmt, ##__VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_LOG_H
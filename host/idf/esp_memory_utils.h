@@ -0,0 +1,14 @@
+#ifndef ESP_MEMORY_UTILS_H
+#define ESP_MEMORY_UTILS_H
+
+// 호스트 빌드용 ESP-IDF 대역: 모든 메모리를 DMA 가능으로 취급
+
+#include <stdbool.h>
+
+static inline bool esp_ptr_dma_capable(const void *p)
+{
+    (void)p;
+    return true;
+}
+
+#endif // ESP_MEMORY_UTILS_H
@@ -0,0 +1,18 @@
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+// 호스트 빌드용 ESP-IDF 대역: CLOCK_MONOTONIC 기준 us
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,37 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+// 호스트 빌드용 FreeRTOS 대역 (틱 = 1 ms, 필요한 정의만)
+// 태스크/큐/알림은 pthread로 구현 (freertos_host.c). 우선순위와 스택 크기는 무시하고
+// 스케줄링은 호스트 OS에 맡긴다. ISR은 인터럽트를 일으킨 호스트 스레드에서 바로 돈다.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_attr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ      1000
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS      (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define pdTRUE                  1
+#define pdFALSE                 0
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+
+// ISR에서 깨운 태스크는 호스트 스케줄러가 바로 돌리므로 할 일 없음
+#define portYIELD_FROM_ISR(...) do { } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FREERTOS_H
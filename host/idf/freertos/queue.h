@@ -0,0 +1,31 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+// 호스트 빌드용 FreeRTOS 대역: 고정 크기 항목 링 (뮤텍스 + 조건 변수)
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct queue_host *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_woken);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+// 호스트 전용: 큐가 가득 차서 실패한 보내기 횟수 (모든 큐 합계)
+uint32_t queue_host_full_count(void);
+// 호스트 전용: true면 xQueueSendFromISR가 자리가 날 때까지 기다림 (최대 속도 재생처럼
+// 생산자를 소비자 속도에 맞춰야 할 때). 기본 false (FreeRTOS와 같이 바로 실패)
+void queue_host_set_isr_blocking(bool blocking);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUEUE_H
@@ -0,0 +1,46 @@
+#ifndef TASK_H
+#define TASK_H
+
+// 호스트 빌드용 FreeRTOS 대역: 태스크는 분리(detached) pthread, 지연은 nanosleep, 양보는 sched_yield
+// 태스크 알림은 태스크마다 값 하나 (뮤텍스 + 조건 변수)
+
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct task_host *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+// 우선순위/스택 크기는 무시. 이름은 스레드 이름으로 (앞 15자)
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle);
+// 자기 자신(NULL)만 지울 수 있음
+void vTaskDelete(TaskHandle_t task);
+// xTaskCreate로 만들지 않은 스레드(main 등)도 처음 부를 때 핸들이 생김
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount(void);
+void taskYIELD(void);
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_woken);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASK_H
@@ -0,0 +1,362 @@
+// 호스트 빌드용 FreeRTOS 대역: 태스크, 태스크 알림, 큐 (pthread)
+//
+// 펌웨어 태스크 그래프를 Linux 스레드로 그대로 돌리기 위한 구현.
+//   - 태스크 = 분리 스레드. 우선순위/스택 크기/코어 지정은 없고 스케줄링은 호스트 OS가 한다
+//   - 알림 값과 큐는 뮤텍스 + CLOCK_MONOTONIC 조건 변수. 타임아웃은 틱(1 ms) 단위
+//   - FromISR 함수는 블록하지 않을 뿐 태스크용과 같다 (ISR은 호출한 스레드에서 돈다).
+//     queue_host_set_isr_blocking(true)면 xQueueSendFromISR도 자리가 날 때까지 기다린다
+// vTaskDelay/xTaskGetTickCount/taskYIELD는 idf_host.c에 있다 (스레드 없이 쓰는 벤치와 공유).
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+struct task_host {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify_value;
+    bool notify_pending;
+    TaskFunction_t fn;
+    void *arg;
+    char name[16];
+};
+
+struct queue_host {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    uint32_t length;
+    uint32_t item_size;
+    uint32_t head;              // 다음에 꺼낼 항목
+    uint32_t count;
+    uint8_t *items;
+};
+
+static __thread struct task_host *task_current;
+static _Atomic uint32_t queue_full_count;
+static _Atomic bool queue_isr_blocking;
+
+/*** 공통 *************************************************************************/
+static void host_cond_init(pthread_cond_t *cond)
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+// 틱 -> 절대 시각 (CLOCK_MONOTONIC)
+static struct timespec host_deadline(TickType_t ticks)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ULL + (uint64_t)ts.tv_nsec;
+    ts.tv_sec += (time_t)(ns / 1000000000ULL);
+    ts.tv_nsec = (long)(ns % 1000000000ULL);
+    return ts;
+}
+
+// 조건 변수 대기 (portMAX_DELAY면 무한). 시간이 다 되면 false
+static bool host_cond_wait(pthread_cond_t *cond, pthread_mutex_t *lock, TickType_t ticks,
+                           const struct timespec *deadline)
+{
+    if (ticks == portMAX_DELAY) {
+        pthread_cond_wait(cond, lock);
+        return true;
+    }
+    return pthread_cond_timedwait(cond, lock, deadline) != ETIMEDOUT;
+}
+
+/*** 태스크 ***********************************************************************/
+static struct task_host *task_alloc(const char *name)
+{
+    struct task_host *t = calloc(1, sizeof(*t));
+    if (t == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&t->lock, NULL);
+    host_cond_init(&t->cond);
+    strncpy(t->name, name ? name : "task", sizeof(t->name) - 1);
+    return t;
+}
+
+static void *task_entry(void *arg)
+{
+    struct task_host *t = arg;
+    task_current = t;
+    pthread_setname_np(pthread_self(), t->name);
+    t->fn(t->arg);
+    // FreeRTOS 태스크는 반환하면 안 되지만 호스트에서는 스레드를 끝내는 것으로 충분
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t priority, TaskHandle_t *handle)
+{
+    (void)stack_depth;
+    (void)priority;
+    struct task_host *t = task_alloc(name);
+    if (t == NULL) {
+        return pdFAIL;
+    }
+    t->fn = fn;
+    t->arg = arg;
+    // 스레드가 돌기 전에 핸들을 넘겨야 생성자가 곧바로 알림을 보낼 수 있음
+    if (handle) {
+        *handle = t;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_t thread;
+    int err = pthread_create(&thread, &attr, task_entry, t);
+    pthread_attr_destroy(&attr);
+    if (err != 0) {
+        if (handle) {
+            *handle = NULL;
+        }
+        free(t);
+        return pdFAIL;
+    }
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // 핸들은 다른 태스크가 알림용으로 들고 있을 수 있어 해제하지 않음
+    if (task == NULL || task == task_current) {
+        pthread_exit(NULL);
+    }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    if (task_current == NULL) {
+        task_current = task_alloc("main");
+    }
+    return task_current;
+}
+
+/*** 태스크 알림 ******************************************************************/
+static BaseType_t notify_locked(struct task_host *t, uint32_t value, eNotifyAction action)
+{
+    switch (action) {
+    case eSetBits:
+        t->notify_value |= value;
+        break;
+    case eIncrement:
+        t->notify_value++;
+        break;
+    case eSetValueWithOverwrite:
+        t->notify_value = value;
+        break;
+    case eSetValueWithoutOverwrite:
+        if (t->notify_pending) {
+            return pdFAIL;
+        }
+        t->notify_value = value;
+        break;
+    case eNoAction:
+    default:
+        break;
+    }
+    t->notify_pending = true;
+    pthread_cond_broadcast(&t->cond);
+    return pdPASS;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action)
+{
+    if (task == NULL) {
+        return pdFAIL;
+    }
+    pthread_mutex_lock(&task->lock);
+    BaseType_t ret = notify_locked(task, value, action);
+    pthread_mutex_unlock(&task->lock);
+    return ret;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    return xTaskNotify(task, 0, eIncrement);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *higher_priority_woken)
+{
+    xTaskNotify(task, 0, eIncrement);
+    if (higher_priority_woken) {
+        *higher_priority_woken = pdFALSE;
+    }
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, TickType_t ticks)
+{
+    struct task_host *t = xTaskGetCurrentTaskHandle();
+    struct timespec deadline = host_deadline(ticks);
+    BaseType_t ret = pdFALSE;
+
+    pthread_mutex_lock(&t->lock);
+    if (!t->notify_pending) {
+        t->notify_value &= ~clear_on_entry;
+        while (!t->notify_pending && ticks != 0) {
+            if (!host_cond_wait(&t->cond, &t->lock, ticks, &deadline)) {
+                break;
+            }
+        }
+    }
+    if (value) {
+        *value = t->notify_value;
+    }
+    if (t->notify_pending) {
+        t->notify_value &= ~clear_on_exit;
+        t->notify_pending = false;
+        ret = pdTRUE;
+    }
+    pthread_mutex_unlock(&t->lock);
+    return ret;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks)
+{
+    struct task_host *t = xTaskGetCurrentTaskHandle();
+    struct timespec deadline = host_deadline(ticks);
+
+    pthread_mutex_lock(&t->lock);
+    while (t->notify_value == 0 && ticks != 0) {
+        if (!host_cond_wait(&t->cond, &t->lock, ticks, &deadline)) {
+            break;
+        }
+    }
+    uint32_t value = t->notify_value;
+    if (value != 0) {
+        t->notify_value = clear_on_exit ? 0 : value - 1;
+    }
+    t->notify_pending = false;
+    pthread_mutex_unlock(&t->lock);
+    return value;
+}
+
+/*** 큐 ***************************************************************************/
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    if (length == 0 || item_size == 0) {
+        return NULL;
+    }
+    struct queue_host *q = calloc(1, sizeof(*q));
+    if (q == NULL) {
+        return NULL;
+    }
+    q->items = malloc((size_t)length * item_size);
+    if (q->items == NULL) {
+        free(q);
+        return NULL;
+    }
+    q->length = length;
+    q->item_size = item_size;
+    pthread_mutex_init(&q->lock, NULL);
+    host_cond_init(&q->not_empty);
+    host_cond_init(&q->not_full);
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+    pthread_cond_destroy(&queue->not_full);
+    free(queue->items);
+    free(queue);
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks)
+{
+    if (queue == NULL) {
+        return pdFAIL;
+    }
+    struct timespec deadline = host_deadline(ticks);
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == queue->length && ticks != 0) {
+        if (!host_cond_wait(&queue->not_full, &queue->lock, ticks, &deadline)) {
+            break;
+        }
+    }
+    if (queue->count == queue->length) {
+        pthread_mutex_unlock(&queue->lock);
+        atomic_fetch_add_explicit(&queue_full_count, 1, memory_order_relaxed);
+        return pdFAIL;      // errQUEUE_FULL
+    }
+    uint32_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(queue->items + (size_t)tail * queue->item_size, item, queue->item_size);
+    queue->count++;
+    pthread_cond_signal(&queue->not_empty);
+    pthread_mutex_unlock(&queue->lock);
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void *item, BaseType_t *higher_priority_woken)
+{
+    if (higher_priority_woken) {
+        *higher_priority_woken = pdFALSE;
+    }
+    bool block = atomic_load_explicit(&queue_isr_blocking, memory_order_relaxed);
+    return xQueueSend(queue, item, block ? portMAX_DELAY : 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks)
+{
+    if (queue == NULL) {
+        return pdFAIL;
+    }
+    struct timespec deadline = host_deadline(ticks);
+
+    pthread_mutex_lock(&queue->lock);
+    while (queue->count == 0 && ticks != 0) {
+        if (!host_cond_wait(&queue->not_empty, &queue->lock, ticks, &deadline)) {
+            break;
+        }
+    }
+    if (queue->count == 0) {
+        pthread_mutex_unlock(&queue->lock);
+        return pdFALSE;
+    }
+    memcpy(item, queue->items + (size_t)queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    pthread_cond_signal(&queue->not_full);
+    pthread_mutex_unlock(&queue->lock);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    if (queue == NULL) {
+        return 0;
+    }
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+uint32_t queue_host_full_count(void)
+{
+    return atomic_load_explicit(&queue_full_count, memory_order_relaxed);
+}
+
+void queue_host_set_isr_blocking(bool blocking)
+{
+    atomic_store_explicit(&queue_isr_blocking, blocking, memory_order_relaxed);
+}
@@ -0,0 +1,417 @@
+// 호스트 빌드용 ESP-IDF/FreeRTOS 대역 구현
+//
+// 펌웨어 모듈을 Linux에서 그대로 컴파일하기 위한 최소한의 구현만 둔다.
+// SPI 마스터는 spi_host_set_device_model로 연결한 장치 모델(FT800 에뮬레이터 등)을 바로 호출한다.
+// GPIO ISR은 gpio_host_set_level을 부른 스레드에서 돈다 (ISR끼리는 뮤텍스로 직렬화).
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <time.h>
+#include <pthread.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+
+#define SPI_HOST_COUNT          3
+#define SPI_HOST_QUEUE_MAX      8
+#define SPI_HOST_HEADER_MAX     8
+
+esp_log_level_t esp_log_host_level = ESP_LOG_WARN;
+
+static int esp_log_host_vprintf(const char *fmt, va_list args)
+{
+    return vfprintf(stderr, fmt, args);
+}
+
+static vprintf_like_t esp_log_host_func = esp_log_host_vprintf;
+
+void esp_log_level_set(const char *tag, esp_log_level_t level)
+{
+    (void)tag;
+    esp_log_host_level = level;
+}
+
+vprintf_like_t esp_log_set_vprintf(vprintf_like_t func)
+{
+    vprintf_like_t prev = esp_log_host_func;
+    esp_log_host_func = func;
+    return prev;
+}
+
+void esp_log_host_write(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    esp_log_host_func(fmt, args);
+    va_end(args);
+}
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK:                return "ESP_OK";
+    case ESP_FAIL:              return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:       return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_VERSION: return "ESP_ERR_INVALID_VERSION";
+    default:                    return "UNKNOWN ERROR";
+    }
+}
+
+/*** 시간 *************************************************************************/
+static int64_t host_time_origin;
+
+int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t us = (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+    if (host_time_origin == 0) {
+        host_time_origin = us - 1;
+    }
+    return us - host_time_origin;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    uint64_t ms = (uint64_t)ticks * portTICK_PERIOD_MS;
+    struct timespec ts = { .tv_sec = (time_t)(ms / 1000), .tv_nsec = (long)(ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(esp_timer_get_time() / (1000 * portTICK_PERIOD_MS));
+}
+
+void taskYIELD(void)
+{
+    sched_yield();
+}
+
+/*** GPIO ***********************************************************************/
+typedef struct {
+    gpio_int_type_t intr_type;
+    gpio_isr_t handler;
+    void *arg;
+} gpio_host_pin_t;
+
+static _Atomic uint64_t gpio_levels = ~0ULL;        // 비트 = 핀 레벨 (풀업 기본)
+static gpio_host_pin_t gpio_pins[GPIO_NUM_MAX];
+static bool gpio_isr_installed;
+static pthread_mutex_t gpio_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool gpio_valid(gpio_num_t gpio_num)
+{
+    return gpio_num >= 0 && gpio_num < GPIO_NUM_MAX;
+}
+
+esp_err_t gpio_config(const gpio_config_t *cfg)
+{
+    if (cfg == NULL || (cfg->pin_bit_mask >> GPIO_NUM_MAX) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        if (cfg->pin_bit_mask & (1ULL << i)) {
+            gpio_pins[i].intr_type = cfg->intr_type;
+        }
+    }
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio_num)
+{
+    if (!gpio_valid(gpio_num)) {
+        return 0;
+    }
+    return (int)((atomic_load_explicit(&gpio_levels, memory_order_acquire) >> gpio_num) & 1);
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level)
+{
+    if (!gpio_valid(gpio_num)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    gpio_host_set_level(gpio_num, level ? 1 : 0);
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    if (!gpio_valid(gpio_num)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    gpio_pins[gpio_num].intr_type = intr_type;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+esp_err_t gpio_pullup_en(gpio_num_t gpio_num)
+{
+    return gpio_valid(gpio_num) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    (void)intr_alloc_flags;
+    pthread_mutex_lock(&gpio_lock);
+    esp_err_t ret = gpio_isr_installed ? ESP_ERR_INVALID_STATE : ESP_OK;
+    gpio_isr_installed = true;
+    pthread_mutex_unlock(&gpio_lock);
+    return ret;
+}
+
+void gpio_uninstall_isr_service(void)
+{
+    pthread_mutex_lock(&gpio_lock);
+    gpio_isr_installed = false;
+    for (int i = 0; i < GPIO_NUM_MAX; i++) {
+        gpio_pins[i].handler = NULL;
+    }
+    pthread_mutex_unlock(&gpio_lock);
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args)
+{
+    if (!gpio_valid(gpio_num)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    esp_err_t ret = ESP_ERR_INVALID_STATE;
+    if (gpio_isr_installed) {
+        gpio_pins[gpio_num].handler = isr_handler;
+        gpio_pins[gpio_num].arg = args;
+        ret = ESP_OK;
+    }
+    pthread_mutex_unlock(&gpio_lock);
+    return ret;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    if (!gpio_valid(gpio_num)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&gpio_lock);
+    gpio_pins[gpio_num].handler = NULL;
+    pthread_mutex_unlock(&gpio_lock);
+    return ESP_OK;
+}
+
+// 바뀐 레벨이 인터럽트 조건에 맞는지 (레벨 인터럽트는 그 레벨로 바뀔 때 한 번)
+static bool gpio_host_triggers(gpio_int_type_t type, int level)
+{
+    switch (type) {
+    case GPIO_INTR_POSEDGE:
+    case GPIO_INTR_HIGH_LEVEL:
+        return level == 1;
+    case GPIO_INTR_NEGEDGE:
+    case GPIO_INTR_LOW_LEVEL:
+        return level == 0;
+    case GPIO_INTR_ANYEDGE:
+        return true;
+    case GPIO_INTR_DISABLE:
+    default:
+        return false;
+    }
+}
+
+void gpio_host_set_level(gpio_num_t gpio_num, int level)
+{
+    if (!gpio_valid(gpio_num)) {
+        return;
+    }
+    uint64_t bit = 1ULL << gpio_num;
+    pthread_mutex_lock(&gpio_lock);
+    uint64_t prev = level ? atomic_fetch_or_explicit(&gpio_levels, bit, memory_order_acq_rel)
+                          : atomic_fetch_and_explicit(&gpio_levels, ~bit, memory_order_acq_rel);
+    const gpio_host_pin_t *pin = &gpio_pins[gpio_num];
+    // 레벨이 그대로면 엣지 없음
+    if (((prev & bit) != 0) != (level != 0) && gpio_isr_installed && pin->handler &&
+        gpio_host_triggers(pin->intr_type, level != 0)) {
+        pin->handler(pin->arg);
+    }
+    pthread_mutex_unlock(&gpio_lock);
+}
+
+uint32_t soc_host_reg_read(uint32_t reg)
+{
+    uint64_t levels = atomic_load_explicit(&gpio_levels, memory_order_acquire);
+    switch (reg) {
+    case GPIO_IN_REG:
+        return (uint32_t)levels;
+    case GPIO_IN1_REG:
+        return (uint32_t)(levels >> 32) & 0xFF;
+    default:
+        return 0;
+    }
+}
+
+/*** SPI 마스터 *******************************************************************/
+struct spi_device_host {
+    spi_host_transfer_fn model;
+    int clock_hz;
+    spi_transaction_t *done[SPI_HOST_QUEUE_MAX];   // 처리 끝난 큐 트랜잭션 (넣은 순서)
+    uint32_t done_head, done_tail;
+};
+
+static spi_host_transfer_fn spi_host_models[SPI_HOST_COUNT];
+static bool spi_host_bus_ready[SPI_HOST_COUNT];
+
+void spi_host_set_device_model(spi_host_device_t host, spi_host_transfer_fn fn)
+{
+    if ((unsigned)host < SPI_HOST_COUNT) {
+        spi_host_models[host] = fn;
+    }
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *bus_config, int dma_chan)
+{
+    (void)bus_config;
+    (void)dma_chan;
+    if ((unsigned)host >= SPI_HOST_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (spi_host_bus_ready[host]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    spi_host_bus_ready[host] = true;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle)
+{
+    if ((unsigned)host >= SPI_HOST_COUNT || dev_config == NULL || handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!spi_host_bus_ready[host]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    struct spi_device_host *dev = calloc(1, sizeof(*dev));
+    if (dev == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    dev->model = spi_host_models[host];
+    dev->clock_hz = dev_config->clock_speed_hz;
+    *handle = dev;
+    return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle)
+{
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->done_head != handle->done_tail) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    free(handle);
+    return ESP_OK;
+}
+
+// 트랜잭션 하나 (주소 phase + 데이터)를 장치 모델에 넘김
+static esp_err_t spi_host_run(spi_device_handle_t dev, spi_transaction_t *t)
+{
+    size_t header = 0;
+    if (t->flags & SPI_TRANS_VARIABLE_ADDR) {
+        header = ((spi_transaction_ext_t *)t)->address_bits / 8;
+    }
+    size_t tx_len = t->length / 8;
+    size_t rx_len = t->rxlength ? t->rxlength / 8 : (t->rx_buffer ? tx_len : 0);
+    size_t data_len = tx_len > rx_len ? tx_len : rx_len;
+    if (header > SPI_HOST_HEADER_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->model == NULL) {
+        return ESP_OK;      // 연결된 장치 없음: 버스는 0을 읽음
+    }
+
+    if (header == 0 && t->tx_buffer && (t->rx_buffer == NULL || rx_len == tx_len)) {
+        dev->model(t->tx_buffer, t->rx_buffer, data_len, dev->clock_hz);
+        return ESP_OK;
+    }
+
+    // 주소 phase를 앞에 붙인 연속 버퍼로
+    uint8_t *tx = calloc(1, header + data_len);
+    uint8_t *rx = t->rx_buffer ? calloc(1, header + data_len) : NULL;
+    if (tx == NULL || (t->rx_buffer && rx == NULL)) {
+        free(tx);
+        free(rx);
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < header; i++) {
+        tx[i] = (uint8_t)(t->addr >> (8 * (header - 1 - i)));
+    }
+    if (t->tx_buffer) {
+        memcpy(tx + header, t->tx_buffer, tx_len);
+    }
+    dev->model(tx, rx, header + data_len, dev->clock_hz);
+    if (rx) {
+        memcpy(t->rx_buffer, rx + header, rx_len);
+    }
+    free(tx);
+    free(rx);
+    return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    if (handle == NULL || trans == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    return spi_host_run(handle, trans);
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t *trans)
+{
+    return spi_device_polling_transmit(handle, trans);
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    if (handle == NULL || trans == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->done_tail - handle->done_head >= SPI_HOST_QUEUE_MAX) {
+        return ESP_ERR_TIMEOUT;
+    }
+    esp_err_t ret = spi_host_run(handle, trans);
+    if (ret == ESP_OK) {
+        handle->done[handle->done_tail++ % SPI_HOST_QUEUE_MAX] = trans;
+    }
+    return ret;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans,
+                                      TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    if (handle == NULL || trans == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (handle->done_head == handle->done_tail) {
+        return ESP_ERR_TIMEOUT;
+    }
+    *trans = handle->done[handle->done_head++ % SPI_HOST_QUEUE_MAX];
+    return ESP_OK;
+}
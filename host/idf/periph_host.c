@@ -0,0 +1,489 @@
+// 호스트 빌드용 ESP-IDF 대역: 레거시 I2C 마스터, UART, PCNT
+//
+// I2C는 포트마다 버스 모델 하나 (i2c_host_set_device_model). 명령 링크는 연산 목록으로 쌓았다가
+// cmd_begin에서 START/STOP 경계마다 모델을 한 번씩 부르고, 버스 시간만큼 스레드를 재운다.
+// 반복 START로 이어진 쓰기 후 읽기는 한 호출로 묶는다 (write_read_device와 같게).
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+#include "esp_err.h"
+#include "driver/i2c.h"
+#include "driver/uart.h"
+#include "driver/pulse_cnt.h"
+
+#define I2C_HOST_DEFAULT_CLK    100000
+#define I2C_HOST_MAX_XFER       64          // 한 전송의 최대 바이트 (CH423/FT800 등에 충분)
+
+typedef enum {
+    I2C_OP_START,
+    I2C_OP_STOP,
+    I2C_OP_WRITE,
+    I2C_OP_READ,
+} i2c_op_kind_t;
+
+typedef struct i2c_op {
+    i2c_op_kind_t kind;
+    uint8_t *data;          // READ: 결과를 쓸 곳
+    size_t len;
+    uint8_t wr[I2C_HOST_MAX_XFER];
+    struct i2c_op *next;
+} i2c_op_t;
+
+struct i2c_cmd_host {
+    i2c_op_t *head;
+    i2c_op_t *tail;
+};
+
+typedef struct {
+    bool installed;
+    uint32_t clk_hz;
+    i2c_host_transfer_fn model;
+    pthread_mutex_t lock;
+} i2c_host_port_t;
+
+static i2c_host_port_t i2c_ports[I2C_NUM_MAX] = {
+    { .lock = PTHREAD_MUTEX_INITIALIZER },
+    { .lock = PTHREAD_MUTEX_INITIALIZER },
+};
+
+/*** I2C **************************************************************************/
+static bool i2c_port_valid(i2c_port_t port)
+{
+    return port >= 0 && port < I2C_NUM_MAX;
+}
+
+void i2c_host_set_device_model(i2c_port_t port, i2c_host_transfer_fn fn)
+{
+    if (i2c_port_valid(port)) {
+        pthread_mutex_lock(&i2c_ports[port].lock);
+        i2c_ports[port].model = fn;
+        pthread_mutex_unlock(&i2c_ports[port].lock);
+    }
+}
+
+esp_err_t i2c_driver_install(i2c_port_t port, i2c_mode_t mode, size_t slv_rx_buf_len, size_t slv_tx_buf_len,
+                             int intr_alloc_flags)
+{
+    (void)slv_rx_buf_len;
+    (void)slv_tx_buf_len;
+    (void)intr_alloc_flags;
+    if (!i2c_port_valid(port) || mode != I2C_MODE_MASTER) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&i2c_ports[port].lock);
+    esp_err_t ret = i2c_ports[port].installed ? ESP_FAIL : ESP_OK;     // IDF도 중복 설치는 ESP_FAIL
+    i2c_ports[port].installed = true;
+    if (i2c_ports[port].clk_hz == 0) {
+        i2c_ports[port].clk_hz = I2C_HOST_DEFAULT_CLK;
+    }
+    pthread_mutex_unlock(&i2c_ports[port].lock);
+    return ret;
+}
+
+esp_err_t i2c_driver_delete(i2c_port_t port)
+{
+    if (!i2c_port_valid(port)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&i2c_ports[port].lock);
+    esp_err_t ret = i2c_ports[port].installed ? ESP_OK : ESP_ERR_INVALID_STATE;
+    i2c_ports[port].installed = false;
+    pthread_mutex_unlock(&i2c_ports[port].lock);
+    return ret;
+}
+
+esp_err_t i2c_param_config(i2c_port_t port, const i2c_config_t *conf)
+{
+    if (!i2c_port_valid(port) || conf == NULL || conf->master.clk_speed == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pthread_mutex_lock(&i2c_ports[port].lock);
+    i2c_ports[port].clk_hz = conf->master.clk_speed;
+    pthread_mutex_unlock(&i2c_ports[port].lock);
+    return ESP_OK;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void)
+{
+    return calloc(1, sizeof(struct i2c_cmd_host));
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd)
+{
+    if (cmd == NULL) {
+        return;
+    }
+    i2c_op_t *op = cmd->head;
+    while (op) {
+        i2c_op_t *next = op->next;
+        free(op);
+        op = next;
+    }
+    free(cmd);
+}
+
+static esp_err_t cmd_append(i2c_cmd_handle_t cmd, i2c_op_kind_t kind, const uint8_t *wr, uint8_t *rd, size_t len)
+{
+    if (cmd == NULL || len > I2C_HOST_MAX_XFER) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    i2c_op_t *op = calloc(1, sizeof(*op));
+    if (op == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    op->kind = kind;
+    op->len = len;
+    op->data = rd;
+    if (wr) {
+        memcpy(op->wr, wr, len);
+    }
+    if (cmd->tail) {
+        cmd->tail->next = op;
+    } else {
+        cmd->head = op;
+    }
+    cmd->tail = op;
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd)
+{
+    return cmd_append(cmd, I2C_OP_START, NULL, NULL, 0);
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd)
+{
+    return cmd_append(cmd, I2C_OP_STOP, NULL, NULL, 0);
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd, uint8_t data, bool ack_en)
+{
+    (void)ack_en;
+    return cmd_append(cmd, I2C_OP_WRITE, &data, NULL, 1);
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd, const uint8_t *data, size_t len, bool ack_en)
+{
+    (void)ack_en;
+    return data ? cmd_append(cmd, I2C_OP_WRITE, data, NULL, len) : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd, uint8_t *data, i2c_ack_type_t ack)
+{
+    (void)ack;
+    return data ? cmd_append(cmd, I2C_OP_READ, NULL, data, 1) : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd, uint8_t *data, size_t len, i2c_ack_type_t ack)
+{
+    (void)ack;
+    return data ? cmd_append(cmd, I2C_OP_READ, NULL, data, len) : ESP_ERR_INVALID_ARG;
+}
+
+static void bus_sleep(uint32_t clk_hz, size_t bytes, int starts)
+{
+    // 바이트당 9클럭 (ACK 포함), START/STOP 각 1클럭 정도
+    uint64_t ns = ((uint64_t)bytes * 9 + (uint64_t)starts * 2) * 1000000000ULL / clk_hz;
+    struct timespec ts = { .tv_sec = (time_t)(ns / 1000000000ULL), .tv_nsec = (long)(ns % 1000000000ULL) };
+    nanosleep(&ts, NULL);
+}
+
+// 포트 잠금을 잡은 상태에서 전송 하나
+typedef struct {
+    bool active;
+    uint8_t addr;
+    uint8_t wr[I2C_HOST_MAX_XFER];
+    size_t wr_len;
+    uint8_t rd[I2C_HOST_MAX_XFER];
+    size_t rd_len;
+    uint8_t *rd_dst[I2C_HOST_MAX_XFER];     // 읽은 바이트를 돌려줄 곳
+    bool addr_pending;                      // START 직후 다음 바이트가 주소
+    bool reading;
+} i2c_segment_t;
+
+static esp_err_t segment_flush(i2c_host_port_t *p, i2c_segment_t *seg)
+{
+    if (!seg->active) {
+        return ESP_OK;
+    }
+    esp_err_t ret = p->model ? p->model(seg->addr, seg->wr, seg->wr_len, seg->rd, seg->rd_len) : ESP_FAIL;
+    if (ret == ESP_OK) {
+        for (size_t i = 0; i < seg->rd_len; i++) {
+            *seg->rd_dst[i] = seg->rd[i];
+        }
+    }
+    seg->active = false;
+    seg->wr_len = 0;
+    seg->rd_len = 0;
+    return ret;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t port, i2c_cmd_handle_t cmd, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    if (!i2c_port_valid(port) || cmd == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    i2c_host_port_t *p = &i2c_ports[port];
+    pthread_mutex_lock(&p->lock);
+    if (!p->installed) {
+        pthread_mutex_unlock(&p->lock);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    i2c_segment_t seg = { 0 };
+    esp_err_t ret = ESP_OK;
+    size_t bytes = 0;
+    int starts = 0;
+    for (i2c_op_t *op = cmd->head; op && ret == ESP_OK; op = op->next) {
+        switch (op->kind) {
+        case I2C_OP_START:
+            starts++;
+            // 같은 장치에 쓰고 반복 START로 읽는 경우는 한 전송으로 이어 붙임
+            if (seg.active && seg.wr_len > 0 && seg.rd_len == 0) {
+                seg.addr_pending = true;
+                break;
+            }
+            ret = segment_flush(p, &seg);
+            seg.addr_pending = true;
+            break;
+        case I2C_OP_STOP:
+            starts++;
+            ret = segment_flush(p, &seg);
+            break;
+        case I2C_OP_WRITE:
+            bytes += op->len;
+            for (size_t i = 0; i < op->len && ret == ESP_OK; i++) {
+                if (seg.addr_pending) {
+                    uint8_t addr = op->wr[i] >> 1;
+                    // 반복 START 뒤 같은 장치 읽기만 이어 붙이고 나머지는 새 전송
+                    if (seg.active && (addr != seg.addr || !(op->wr[i] & 1))) {
+                        ret = segment_flush(p, &seg);
+                    }
+                    seg.active = true;
+                    seg.addr = addr;
+                    seg.reading = op->wr[i] & 1;
+                    seg.addr_pending = false;
+                } else if (!seg.active || seg.reading || seg.wr_len >= I2C_HOST_MAX_XFER) {
+                    ret = ESP_ERR_INVALID_ARG;
+                } else {
+                    seg.wr[seg.wr_len++] = op->wr[i];
+                }
+            }
+            break;
+        case I2C_OP_READ:
+            bytes += op->len;
+            if (!seg.active || !seg.reading || seg.rd_len + op->len > I2C_HOST_MAX_XFER) {
+                ret = ESP_ERR_INVALID_ARG;
+                break;
+            }
+            for (size_t i = 0; i < op->len; i++) {
+                seg.rd_dst[seg.rd_len++] = op->data + i;
+            }
+            break;
+        }
+    }
+    if (ret == ESP_OK) {
+        ret = segment_flush(p, &seg);
+    }
+    bus_sleep(p->clk_hz, bytes, starts);
+    pthread_mutex_unlock(&p->lock);
+    return ret;
+}
+
+esp_err_t i2c_master_write_to_device(i2c_port_t port, uint8_t addr, const uint8_t *write_buf, size_t write_size,
+                                     TickType_t ticks_to_wait)
+{
+    return i2c_master_write_read_device(port, addr, write_buf, write_size, NULL, 0, ticks_to_wait);
+}
+
+esp_err_t i2c_master_read_from_device(i2c_port_t port, uint8_t addr, uint8_t *read_buf, size_t read_size,
+                                      TickType_t ticks_to_wait)
+{
+    return i2c_master_write_read_device(port, addr, NULL, 0, read_buf, read_size, ticks_to_wait);
+}
+
+esp_err_t i2c_master_write_read_device(i2c_port_t port, uint8_t addr, const uint8_t *write_buf, size_t write_size,
+                                       uint8_t *read_buf, size_t read_size, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    if (!i2c_port_valid(port) || (write_size && write_buf == NULL) || (read_size && read_buf == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    i2c_host_port_t *p = &i2c_ports[port];
+    pthread_mutex_lock(&p->lock);
+    esp_err_t ret;
+    if (!p->installed) {
+        ret = ESP_ERR_INVALID_STATE;
+    } else {
+        ret = p->model ? p->model(addr, write_buf, write_size, read_buf, read_size) : ESP_FAIL;
+        int starts = (write_size ? 1 : 0) + (read_size ? 1 : 0) + 1;
+        bus_sleep(p->clk_hz, write_size + read_size + (size_t)starts - 1, starts);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return ret;
+}
+
+/*** UART *************************************************************************/
+static bool uart_installed[UART_NUM_MAX];
+static _Atomic uint64_t uart_tx_count[UART_NUM_MAX];
+
+esp_err_t uart_driver_install(uart_port_t port, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              QueueHandle_t *uart_queue, int intr_alloc_flags)
+{
+    (void)rx_buffer_size;
+    (void)tx_buffer_size;
+    (void)queue_size;
+    (void)intr_alloc_flags;
+    if (port < 0 || port >= UART_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (uart_queue) {
+        *uart_queue = NULL;
+    }
+    uart_installed[port] = true;
+    return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t port)
+{
+    if (port < 0 || port >= UART_NUM_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uart_installed[port] = false;
+    return ESP_OK;
+}
+
+bool uart_is_driver_installed(uart_port_t port)
+{
+    return port >= 0 && port < UART_NUM_MAX && uart_installed[port];
+}
+
+esp_err_t uart_set_baudrate(uart_port_t port, uint32_t baudrate)
+{
+    return (port >= 0 && port < UART_NUM_MAX && baudrate > 0) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+int uart_write_bytes(uart_port_t port, const void *src, size_t size)
+{
+    if (!uart_is_driver_installed(port) || src == NULL) {
+        return -1;
+    }
+    atomic_fetch_add(&uart_tx_count[port], size);
+    return (int)size;
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    return uart_is_driver_installed(port) ? ESP_OK : ESP_FAIL;
+}
+
+uint64_t uart_host_tx_bytes(uart_port_t port)
+{
+    return (port >= 0 && port < UART_NUM_MAX) ? atomic_load(&uart_tx_count[port]) : 0;
+}
+
+/*** PCNT (없음) ******************************************************************/
+esp_err_t pcnt_new_unit(const pcnt_unit_config_t *config, pcnt_unit_handle_t *ret_unit)
+{
+    (void)config;
+    if (ret_unit) {
+        *ret_unit = NULL;
+    }
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t pcnt_del_unit(pcnt_unit_handle_t unit)
+{
+    (void)unit;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_set_glitch_filter(pcnt_unit_handle_t unit, const pcnt_glitch_filter_config_t *config)
+{
+    (void)unit;
+    (void)config;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_new_channel(pcnt_unit_handle_t unit, const pcnt_chan_config_t *config,
+                           pcnt_channel_handle_t *ret_chan)
+{
+    (void)unit;
+    (void)config;
+    (void)ret_chan;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_del_channel(pcnt_channel_handle_t chan)
+{
+    (void)chan;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_channel_set_edge_action(pcnt_channel_handle_t chan, pcnt_channel_edge_action_t pos_act,
+                                       pcnt_channel_edge_action_t neg_act)
+{
+    (void)chan;
+    (void)pos_act;
+    (void)neg_act;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_channel_set_level_action(pcnt_channel_handle_t chan, pcnt_channel_level_action_t high_act,
+                                        pcnt_channel_level_action_t low_act)
+{
+    (void)chan;
+    (void)high_act;
+    (void)low_act;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_add_watch_point(pcnt_unit_handle_t unit, int watch_point)
+{
+    (void)unit;
+    (void)watch_point;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_enable(pcnt_unit_handle_t unit)
+{
+    (void)unit;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_disable(pcnt_unit_handle_t unit)
+{
+    (void)unit;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_start(pcnt_unit_handle_t unit)
+{
+    (void)unit;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_stop(pcnt_unit_handle_t unit)
+{
+    (void)unit;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_clear_count(pcnt_unit_handle_t unit)
+{
+    (void)unit;
+    return ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_unit_get_count(pcnt_unit_handle_t unit, int *value)
+{
+    (void)unit;
+    (void)value;
+    return ESP_ERR_INVALID_ARG;
+}
@@ -0,0 +1,9 @@
+#ifndef SOC_GPIO_REG_H
+#define SOC_GPIO_REG_H
+
+// 호스트 빌드용 ESP-IDF 대역: GPIO 입력 레지스터 주소 (ESP32)
+
+#define GPIO_IN_REG     0x3FF4403C      // GPIO0~31
+#define GPIO_IN1_REG    0x3FF44040      // GPIO32~39
+
+#endif // SOC_GPIO_REG_H
@@ -0,0 +1,20 @@
+#ifndef SOC_SOC_H
+#define SOC_SOC_H
+
+// 호스트 빌드용 ESP-IDF 대역: 레지스터 읽기는 호스트 모델로 (GPIO 입력 레지스터만)
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t soc_host_reg_read(uint32_t reg);
+
+#define REG_READ(reg)   soc_host_reg_read((uint32_t)(reg))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOC_SOC_H
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "png_write.h"
+
+#define PNG_STORED_MAX  65535   // stored 블록 하나의 최대 바이트
+
+static uint32_t crc_table[256];
+
+static void crc_init(void)
+{
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        crc_table[n] = c;
+    }
+}
+
+static uint32_t crc_update(uint32_t crc, const uint8_t *p, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc = crc_table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+// 청크 하나: 길이, 타입, 데이터, CRC(타입 + 데이터)
+static bool write_chunk(FILE *f, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t hdr[8], tail[4];
+    put32(hdr, len);
+    for (int i = 0; i < 4; i++) {
+        hdr[4 + i] = (uint8_t)type[i];
+    }
+    uint32_t crc = crc_update(0xFFFFFFFFu, hdr + 4, 4);
+    crc = crc_update(crc, data, len) ^ 0xFFFFFFFFu;
+    put32(tail, crc);
+    return fwrite(hdr, 1, 8, f) == 8 && (len == 0 || fwrite(data, 1, len, f) == len) && fwrite(tail, 1, 4, f) == 4;
+}
+
+bool png_write_rgb(const char *path, const uint32_t *pixels, int width, int height)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    crc_init();
+
+    // 필터 없는 행 (행마다 필터 바이트 0 + RGB)
+    size_t row = (size_t)width * 3 + 1;
+    size_t raw_len = row * (size_t)height;
+    size_t blocks = (raw_len + PNG_STORED_MAX - 1) / PNG_STORED_MAX;
+    size_t z_len = 2 + blocks * 5 + raw_len + 4;
+    uint8_t *raw = malloc(raw_len);
+    uint8_t *z = malloc(z_len);
+    if (raw == NULL || z == NULL) {
+        free(raw);
+        free(z);
+        return false;
+    }
+    for (int y = 0; y < height; y++) {
+        uint8_t *p = raw + row * (size_t)y;
+        *p++ = 0;
+        for (int x = 0; x < width; x++) {
+            uint32_t c = pixels[(size_t)y * width + x];
+            *p++ = (uint8_t)(c >> 16);
+            *p++ = (uint8_t)(c >> 8);
+            *p++ = (uint8_t)c;
+        }
+    }
+
+    // zlib: 헤더, stored 블록들, adler32
+    uint8_t *q = z;
+    uint32_t a = 1, b = 0;
+    *q++ = 0x78;
+    *q++ = 0x01;
+    for (size_t off = 0; off < raw_len; off += PNG_STORED_MAX) {
+        size_t n = raw_len - off < PNG_STORED_MAX ? raw_len - off : PNG_STORED_MAX;
+        *q++ = (off + n == raw_len) ? 1 : 0;
+        *q++ = (uint8_t)n;
+        *q++ = (uint8_t)(n >> 8);
+        *q++ = (uint8_t)~n;
+        *q++ = (uint8_t)(~n >> 8);
+        for (size_t i = 0; i < n; i++) {
+            uint8_t v = raw[off + i];
+            *q++ = v;
+            a = (a + v) % 65521;
+            b = (b + a) % 65521;
+        }
+    }
+    put32(q, (b << 16) | a);
+
+    uint8_t ihdr[13];
+    put32(ihdr, (uint32_t)width);
+    put32(ihdr + 4, (uint32_t)height);
+    ihdr[8] = 8;        // 비트 깊이
+    ihdr[9] = 2;        // RGB
+    ihdr[10] = 0;
+    ihdr[11] = 0;
+    ihdr[12] = 0;
+
+    FILE *f = fopen(path, "wb");
+    bool ok = f != NULL;
+    if (ok) {
+        ok = fwrite(signature, 1, 8, f) == 8 && write_chunk(f, "IHDR", ihdr, 13) &&
+             write_chunk(f, "IDAT", z, (uint32_t)z_len) && write_chunk(f, "IEND", NULL, 0);
+        ok = (fclose(f) == 0) && ok;
+    }
+    free(raw);
+    free(z);
+    return ok;
+}
@@ -0,0 +1,23 @@
+#ifndef PNG_WRITE_H
+#define PNG_WRITE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 최소 PNG 저장 (호스트, 외부 라이브러리 없음)
+//
+// 8비트 RGB, 압축하지 않은 deflate 블록(stored)으로 쓴다. 파일은 크지만(480x272 = 약 390KB)
+// 어떤 뷰어로도 열리고 같은 픽셀이면 바이트까지 같다 (회귀 비교용).
+
+// pixels: 0x00RRGGBB, 행 우선. 실패하면 false
+bool png_write_rgb(const char *path, const uint32_t *pixels, int width, int height);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PNG_WRITE_H
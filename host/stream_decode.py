@@ -0,0 +1,263 @@
+#!/usr/bin/env python3
+"""
+Small Oscilloscope - 바이너리 샘플 스트림 디코더
+main/stream_frame.h 형식의 프레임을 시리얼 포트(또는 pty, 저장된 파일)에서 읽어
+CRC를 확인하고 샘플을 CSV로 저장하거나 초당 요약을 출력한다.
+압축 프레임(STREAM_FLAG_PACKED)은 main/sample_codec.c와 같은 방식으로 푼다 (codec_decode).
+
+  python3 host/stream_decode.py COM5 --csv capture.csv
+  python3 host/stream_decode.py /dev/ttyUSB0 --baud 921600
+  python3 host/stream_decode.py /dev/pts/3          (build_host/stream_loopback --pty)
+  python3 host/stream_decode.py --file dump.bin
+"""
+
+import argparse
+import os
+import stat
+import struct
+import sys
+import time
+import zlib
+
+SYNC = b'\xA5\x5A'
+VERSION = 1
+MAX_CHANNELS = 2
+MAX_SAMPLES = 512
+FLAG_GAP = 0x01
+FLAG_PACKED = 0x02
+CODEC_GROUP = 16
+CODEC_MAX_WIDTH = 13
+# version, flags, channel_mask, reserved, gain_state, sample_count, seq, first_sample, timestamp_us, sample_rate_hz
+HEADER = struct.Struct('<BBBBHHIIQI')
+HEADER_BYTES = 2 + HEADER.size      # 30
+CRC_BYTES = 4
+
+
+def channels_of(mask):
+    return [c for c in range(MAX_CHANNELS) if mask & (1 << c)]
+
+
+def codec_max_bytes(n):
+    return (12 + (n + CODEC_GROUP - 1) // CODEC_GROUP * 4 + n * CODEC_MAX_WIDTH + 7) // 8
+
+
+def codec_decode(data, off, n):
+    """sample_codec_decode() 참조 구현. (샘플 튜플, 다음 오프셋) 반환, 잘못된 데이터면 None"""
+    acc = 0
+    bits = 0
+    pos = off
+
+    def get(width):
+        nonlocal acc, bits, pos
+        while bits < width:
+            if pos >= len(data):
+                raise ValueError('truncated')
+            acc |= data[pos] << bits
+            pos += 1
+            bits += 8
+        v = acc & ((1 << width) - 1)
+        acc >>= width
+        bits -= width
+        return v
+
+    try:
+        prev = get(12)
+        out = [prev]
+        i = 1
+        while i < n:
+            count = min(CODEC_GROUP, n - i)
+            width = get(4)
+            if width > CODEC_MAX_WIDTH:
+                return None
+            for _ in range(count):
+                z = get(width) if width else 0
+                prev += (z >> 1) ^ -(z & 1)
+                if not 0 <= prev <= 0x0FFF:
+                    return None
+                out.append(prev)
+            i += count
+    except ValueError:
+        return None
+    return tuple(out), pos
+
+
+def gain_text(gain_state, ch):
+    """채널 감쇠 상태 (bit0 AC/DC, bit1-2 1차, bit3-4 2차)"""
+    b = (gain_state >> (8 * ch)) & 0xFF
+    primary = ['1', '1/10', '1/91.9', '1/101'][(b >> 1) & 3]
+    secondary = ['1', '1/2', '1/5', '1/6'][(b >> 3) & 3]
+    return f"{'DC' if b & 1 else 'AC'} {primary}x {secondary}x"
+
+
+class StreamParser:
+    """stream_parser_feed()와 같은 동작: sync 검색 -> 헤더 검사 -> CRC 확인"""
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.frames = 0
+        self.crc_errors = 0
+        self.bad_headers = 0
+        self.decode_errors = 0
+        self.skipped_bytes = 0
+
+    def _drop(self, n):
+        del self.buf[:n]
+
+    def feed(self, data):
+        self.buf += data
+        out = []
+        while True:
+            i = self.buf.find(SYNC)
+            if i < 0:
+                # 마지막 바이트가 SYNC0이면 남겨 둠
+                keep = 1 if self.buf[-1:] == SYNC[:1] else 0
+                self.skipped_bytes += len(self.buf) - keep
+                self._drop(len(self.buf) - keep)
+                return out
+            if i > 0:
+                self.skipped_bytes += i
+                self._drop(i)
+            if len(self.buf) < HEADER_BYTES:
+                return out
+
+            fields = HEADER.unpack_from(self.buf, 2)
+            version, flags, mask, _, gain, count, seq, first, ts, rate = fields
+            if version != VERSION or mask == 0 or mask >> MAX_CHANNELS or not 0 < count <= MAX_SAMPLES:
+                self.bad_headers += 1
+                self.skipped_bytes += 1
+                self._drop(1)
+                continue
+
+            chans = channels_of(mask)
+            body = HEADER_BYTES + len(chans) * count * 2
+            if flags & FLAG_PACKED:
+                # 압축 프레임: 헤더 뒤 uint16 길이
+                if len(self.buf) < HEADER_BYTES + 2:
+                    return out
+                packed, = struct.unpack_from('<H', self.buf, HEADER_BYTES)
+                if packed > len(chans) * codec_max_bytes(count):
+                    self.bad_headers += 1
+                    self.skipped_bytes += 1
+                    self._drop(1)
+                    continue
+                body = HEADER_BYTES + 2 + packed
+            if len(self.buf) < body + CRC_BYTES:
+                return out
+            crc, = struct.unpack_from('<I', self.buf, body)
+            if zlib.crc32(bytes(self.buf[2:body])) != crc:
+                self.crc_errors += 1
+                self.skipped_bytes += 1
+                self._drop(1)
+                continue
+
+            samples = {}
+            if flags & FLAG_PACKED:
+                data = bytes(self.buf[:body])
+                off = HEADER_BYTES + 2
+                for c in chans:
+                    r = codec_decode(data, off, count)
+                    if r is None:
+                        break
+                    samples[c], off = r
+                if len(samples) != len(chans) or off != body:
+                    self.decode_errors += 1
+                    self._drop(body + CRC_BYTES)
+                    continue
+            else:
+                for k, c in enumerate(chans):
+                    off = HEADER_BYTES + k * count * 2
+                    samples[c] = struct.unpack_from(f'<{count}H', self.buf, off)
+            out.append({
+                'flags': flags, 'channel_mask': mask, 'gain_state': gain, 'sample_count': count,
+                'seq': seq, 'first_sample': first, 'timestamp_us': ts, 'sample_rate_hz': rate,
+                'samples': samples,
+            })
+            self.frames += 1
+            self._drop(body + CRC_BYTES)
+
+
+def open_source(args):
+    """read(n) 함수 반환. 실제 시리얼 포트는 pyserial, pty/파일은 그대로 읽음"""
+    if args.file:
+        f = open(args.file, 'rb')
+        return lambda n: f.read(n)
+
+    st = os.stat(args.port) if os.path.exists(args.port) else None
+    if st is not None and (stat.S_ISREG(st.st_mode) or os.path.basename(os.path.dirname(args.port)) == 'pts'):
+        fd = os.open(args.port, os.O_RDONLY | os.O_NOCTTY)
+        return lambda n: os.read(fd, n)
+
+    import serial  # pyserial
+    ser = serial.Serial(args.port, args.baud, timeout=0.1)
+    return lambda n: ser.read(n)
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Small Oscilloscope binary sample stream decoder')
+    ap.add_argument('port', nargs='?', help='시리얼 포트 또는 pty 경로')
+    ap.add_argument('--baud', type=int, default=921600)
+    ap.add_argument('--file', help='저장된 스트림 파일에서 읽기')
+    ap.add_argument('--csv', help='샘플을 CSV로 저장 (sample,time_us,ch0,ch1)')
+    ap.add_argument('--frames', type=int, default=0, help='이만큼 받으면 종료 (0 = 계속)')
+    args = ap.parse_args()
+    if not args.port and not args.file:
+        ap.error('port 또는 --file 필요')
+
+    read = open_source(args)
+    parser = StreamParser()
+    csv = open(args.csv, 'w') if args.csv else None
+    if csv:
+        csv.write('sample,time_us,ch0,ch1\n')
+
+    expect_sample = None
+    lost = 0
+    wire_bytes = 0
+    raw_bytes = 0
+    last_report = time.monotonic()
+    report_frames = 0
+    try:
+        while True:
+            data = read(4096)
+            if not data:
+                if args.file:
+                    break
+                continue
+            wire_bytes += len(data)
+            for fr in parser.feed(data):
+                report_frames += 1
+                raw_bytes += HEADER_BYTES + len(fr['samples']) * fr['sample_count'] * 2 + CRC_BYTES
+                # 샘플 연속성 (장치가 표시한 GAP + 수신 중 깨져서 버린 프레임)
+                if expect_sample is not None and fr['first_sample'] != expect_sample:
+                    lost += (fr['first_sample'] - expect_sample) & 0xFFFFFFFF
+                expect_sample = (fr['first_sample'] + fr['sample_count']) & 0xFFFFFFFF
+
+                if csv:
+                    dt = 1e6 / fr['sample_rate_hz']
+                    s = fr['samples']
+                    for i in range(fr['sample_count']):
+                        v = [str(s[c][i]) if c in s else '' for c in range(MAX_CHANNELS)]
+                        csv.write(f"{fr['first_sample'] + i},{fr['timestamp_us'] + i * dt:.0f},{v[0]},{v[1]}\n")
+
+                now = time.monotonic()
+                if now - last_report >= 1.0:
+                    gains = ', '.join(f'CH{c}: {gain_text(fr["gain_state"], c)}' for c in fr['samples'])
+                    print(f"seq {fr['seq']} {report_frames / (now - last_report):.1f} frames/s "
+                          f"{fr['sample_rate_hz']} Hz{' packed' if fr['flags'] & FLAG_PACKED else ''}"
+                          f"{' GAP' if fr['flags'] & FLAG_GAP else ''} | {gains}")
+                    last_report = now
+                    report_frames = 0
+                if args.frames and parser.frames >= args.frames:
+                    raise KeyboardInterrupt
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv:
+            csv.close()
+        print(f'frames {parser.frames}, crc errors {parser.crc_errors}, bad headers {parser.bad_headers}, '
+              f'decode errors {parser.decode_errors}, skipped bytes {parser.skipped_bytes}, lost samples {lost}, '
+              f'{wire_bytes} bytes received ({100.0 * wire_bytes / raw_bytes if raw_bytes else 0:.1f}% of raw)',
+              file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
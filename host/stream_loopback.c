@@ -0,0 +1,280 @@
+// 샘플 스트림 루프백 테스트 (호스트, 의사 터미널)
+//
+// pty 마스터에 stream_encode() 프레임을 쓰고 슬레이브(원시 모드, 921600 baud 설정)에서
+// 읽어 stream_parser로 복원한다. 원본/압축 프레임을 번갈아 보내고, 중간에 로그 문자열을
+// 끼워 넣고 일부 프레임은 한 바이트를 깨뜨려서, 깨진 프레임만 정확히 버리고 나머지 샘플은
+// 모두 그대로 복원되는지 확인한다.
+// 끝으로 파서 처리 속도를 921600 baud 대비 배수로 출력한다.
+//
+//   stream_loopback            자체 검증
+//   stream_loopback --pty      슬레이브 경로를 출력하고 921600 baud 속도로 계속 송신
+//                              (python3 host/stream_decode.py <경로> 로 수신 확인)
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include "stream_frame.h"
+
+#define FRAMES          400
+#define BLOCK           256
+#define SAMPLE_RATE     10000
+#define CORRUPT_EVERY   37      // 이 간격마다 프레임 하나를 깨뜨림
+#define NOISE_EVERY     11      // 이 간격마다 프레임 사이에 로그 문자열
+#define LINK_BAUD       921600
+
+static uint16_t tx_samples[STREAM_MAX_CHANNELS][BLOCK];
+static uint8_t tx_buf[STREAM_MAX_FRAME_BYTES];
+
+typedef struct {
+    uint32_t received;
+    uint32_t mismatches;
+    uint32_t expect_seq;        // 다음에 받을 것으로 예상하는 프레임 번호
+} rx_check_t;
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 프레임 seq의 합성 신호 (CH0 사인, CH1 톱니) - 수신측도 같은 식으로 검증
+static uint16_t signal_at(int ch, uint32_t n)
+{
+    if (ch == 0) {
+        return (uint16_t)(2048 + 1800 * sin(2.0 * M_PI * 50.0 * n / SAMPLE_RATE));
+    }
+    return (uint16_t)((n * 7) & 0x0FFF);
+}
+
+static bool is_corrupted(uint32_t seq)
+{
+    return seq % CORRUPT_EVERY == CORRUPT_EVERY - 1;
+}
+
+static size_t make_frame(uint32_t seq)
+{
+    const uint16_t *ch[STREAM_MAX_CHANNELS] = { tx_samples[0], tx_samples[1] };
+    for (int c = 0; c < STREAM_MAX_CHANNELS; c++) {
+        for (uint32_t i = 0; i < BLOCK; i++) {
+            tx_samples[c][i] = signal_at(c, seq * BLOCK + i);
+        }
+    }
+    // 홀수 프레임은 압축 (두 형식이 섞여도 복원되는지)
+    stream_header_t hdr = {
+        .flags = (seq & 1) ? STREAM_FLAG_PACKED : 0,
+        .channel_mask = 0x03,
+        .gain_state = STREAM_GAIN_BYTE(1, 2, 3) | (STREAM_GAIN_BYTE(0, 1, 0) << 8),
+        .sample_count = BLOCK,
+        .seq = seq,
+        .first_sample = seq * BLOCK,
+        .timestamp_us = 1000000ull + (uint64_t)seq * BLOCK * 1000000 / SAMPLE_RATE,
+        .sample_rate_hz = SAMPLE_RATE,
+    };
+    return stream_encode(&hdr, ch, tx_buf, sizeof(tx_buf));
+}
+
+static void on_frame(const stream_frame_t *f, void *ctx)
+{
+    rx_check_t *chk = (rx_check_t *)ctx;
+    uint32_t seq = f->hdr.seq;
+    bool ok = f->hdr.flags == ((seq & 1) ? STREAM_FLAG_PACKED : 0) &&
+              f->hdr.channel_mask == 0x03 && f->hdr.sample_count == BLOCK &&
+              f->hdr.first_sample == seq * BLOCK && f->hdr.sample_rate_hz == SAMPLE_RATE &&
+              f->hdr.gain_state == (STREAM_GAIN_BYTE(1, 2, 3) | (STREAM_GAIN_BYTE(0, 1, 0) << 8)) &&
+              f->hdr.timestamp_us == 1000000ull + (uint64_t)seq * BLOCK * 1000000 / SAMPLE_RATE;
+
+    // 깨뜨린 프레임만 건너뛰어야 함
+    while (chk->expect_seq < seq && is_corrupted(chk->expect_seq)) {
+        chk->expect_seq++;
+    }
+    ok = ok && seq == chk->expect_seq && !is_corrupted(seq);
+    for (int c = 0; ok && c < STREAM_MAX_CHANNELS; c++) {
+        for (uint32_t i = 0; i < BLOCK; i++) {
+            if (f->samples[c][i] != signal_at(c, seq * BLOCK + i)) {
+                ok = false;
+                break;
+            }
+        }
+    }
+    if (!ok) {
+        printf("frame %u MISMATCH\n", seq);
+        chk->mismatches++;
+    }
+    chk->expect_seq = seq + 1;
+    chk->received++;
+}
+
+static int open_pty(int *slave_fd, char *name, size_t name_len)
+{
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        return -1;
+    }
+    snprintf(name, name_len, "%s", ptsname(master));
+
+    // CH340 쪽과 같은 설정: 원시 모드 8N1, 921600 baud (pty는 속도를 흉내만 냄)
+    int slave = open(name, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if (slave < 0 || tcgetattr(slave, &tio) != 0) {
+        perror("pty slave");
+        return -1;
+    }
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B921600);
+    cfsetospeed(&tio, B921600);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+    fcntl(slave, F_SETFL, fcntl(slave, F_GETFL) | O_NONBLOCK);
+    *slave_fd = slave;
+    return master;
+}
+
+// 슬레이브에서 읽을 수 있는 만큼 읽어 파서에 넣음
+static size_t drain(int fd, stream_parser_t *p, rx_check_t *chk)
+{
+    uint8_t buf[4096];
+    size_t total = 0;
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        stream_parser_feed(p, buf, (size_t)n, on_frame, chk);
+        total += (size_t)n;
+    }
+    return total;
+}
+
+// 버퍼를 모두 쓸 때까지 반대쪽을 비워 가며 씀
+static void write_all(int master, int slave, const uint8_t *data, size_t len,
+                      stream_parser_t *p, rx_check_t *chk)
+{
+    while (len > 0) {
+        ssize_t n = write(master, data, len);
+        if (n > 0) {
+            data += n;
+            len -= (size_t)n;
+        } else if (n < 0 && errno != EAGAIN) {
+            perror("write");
+            exit(1);
+        }
+        drain(slave, p, chk);
+    }
+}
+
+static int run_pty_source(void)
+{
+    int slave;
+    char name[128];
+    int master = open_pty(&slave, name, sizeof(name));
+    if (master < 0) {
+        return 1;
+    }
+    close(slave);
+    fcntl(master, F_SETFL, fcntl(master, F_GETFL) & ~O_NONBLOCK);
+    printf("%s\n", name);
+    fflush(stdout);
+
+    // 10비트/바이트로 921600 baud 속도에 맞춰 보냄 (무한 반복, 깨진 프레임 포함)
+    for (uint32_t seq = 0;; seq++) {
+        size_t len = make_frame(seq);
+        if (is_corrupted(seq)) {
+            tx_buf[STREAM_HEADER_BYTES + 17] ^= 0x40;
+        }
+        if (write(master, tx_buf, len) < 0) {
+            perror("write");
+            return 1;
+        }
+        usleep((useconds_t)(len * 10 * 1000000ull / LINK_BAUD));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static stream_parser_t parser;
+    rx_check_t chk = {0};
+    static const char noise[] = "I (1234) STREAM: log line in the middle\r\n\xA5\xA5\x5A";
+    uint32_t corrupted = 0;
+    int failures = 0;
+
+    if (argc > 1 && strcmp(argv[1], "--pty") == 0) {
+        return run_pty_source();
+    }
+
+    // CRC-32 기준값 (zlib.crc32(b"123456789") == 0xCBF43926)
+    if (stream_crc32(0, "123456789", 9) != 0xCBF43926u) {
+        printf("crc32 MISMATCH\n");
+        failures++;
+    }
+
+    int slave;
+    char name[128];
+    int master = open_pty(&slave, name, sizeof(name));
+    if (master < 0) {
+        return 1;
+    }
+    stream_parser_init(&parser);
+
+    size_t sent = 0;
+    double t0 = now_sec();
+    for (uint32_t seq = 0; seq < FRAMES; seq++) {
+        if (seq % NOISE_EVERY == 0) {
+            write_all(master, slave, (const uint8_t *)noise, sizeof(noise) - 1, &parser, &chk);
+            sent += sizeof(noise) - 1;
+        }
+        size_t len = make_frame(seq);
+        if (is_corrupted(seq)) {
+            tx_buf[STREAM_HEADER_BYTES + (seq * 13) % (len - STREAM_HEADER_BYTES)] ^= 0x10;
+            corrupted++;
+        }
+        write_all(master, slave, tx_buf, len, &parser, &chk);
+        sent += len;
+    }
+    // 남은 바이트 수신
+    for (int i = 0; i < 100 && chk.received + corrupted < FRAMES; i++) {
+        usleep(1000);
+        drain(slave, &parser, &chk);
+    }
+    double loop_sec = now_sec() - t0;
+
+    printf("pty loopback (%s): %u frames sent, %u corrupted, %u received, %u crc errors, %u skipped bytes\n",
+           name, FRAMES, corrupted, chk.received, parser.crc_errors, parser.skipped_bytes);
+    if (chk.received != FRAMES - corrupted || chk.mismatches != 0 || parser.crc_errors < corrupted) {
+        printf("loopback FAILED\n");
+        failures++;
+    }
+    close(master);
+    close(slave);
+
+    // 파서 처리 속도 (메모리에서 바로)
+    static uint8_t stream[FRAMES * STREAM_MAX_FRAME_BYTES];
+    size_t stream_len = 0;
+    for (uint32_t seq = 0; seq < FRAMES; seq++) {
+        size_t len = make_frame(seq);
+        memcpy(stream + stream_len, tx_buf, len);
+        stream_len += len;
+    }
+    uint32_t rounds = 0;
+    double t1;
+    t0 = now_sec();
+    do {
+        rx_check_t quiet = {0};
+        stream_parser_init(&parser);
+        stream_parser_feed(&parser, stream, stream_len, NULL, &quiet);
+        rounds++;
+        t1 = now_sec();
+    } while (t1 - t0 < 0.2);
+    double bps = (double)stream_len * rounds / (t1 - t0);
+    printf("pty throughput %.1f KB/s (%zu bytes in %.3f s), parser %.1f MB/s = %.0fx %d baud\n",
+           sent / loop_sec / 1024.0, sent, loop_sec, bps / 1e6, bps * 10 / LINK_BAUD, LINK_BAUD);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,249 @@
+#include <string.h>
+#include "acquisition.h"
+
+static void acq_set_state(acq_t *acq, acq_state_t state)
+{
+    atomic_store_explicit(&acq->state, (int)state, memory_order_release);
+}
+
+static bool acq_cas_state(acq_t *acq, acq_state_t from, acq_state_t to)
+{
+    int expected = (int)from;
+    return atomic_compare_exchange_strong_explicit(&acq->state, &expected, (int)to,
+                                                   memory_order_acq_rel, memory_order_acquire);
+}
+
+static bool acq_config_valid(const acq_config_t *cfg)
+{
+    return cfg != NULL && cfg->record_length != 0 && cfg->trigger_pos_pct <= 100 && cfg->sample_rate_hz != 0;
+}
+
+// 설정 필드 반영 (상태는 건드리지 않음)
+static void acq_apply_config(acq_t *acq, const acq_config_t *cfg)
+{
+    acq->cfg = *cfg;
+    acq->pre_count = (uint32_t)(((uint64_t)cfg->record_length * cfg->trigger_pos_pct) / 100);
+    acq->post_count = cfg->record_length - acq->pre_count;
+    acq->last_trigger_us = INT64_MIN / 2;   // 첫 트리거는 홀드오프 없이
+    acq->forced = false;
+    acq->record_count = 0;
+}
+
+// 설정 적용
+bool acq_init(acq_t *acq, const acq_config_t *cfg)
+{
+    if (acq == NULL || !acq_config_valid(cfg)) {
+        return false;
+    }
+
+    memset(acq, 0, sizeof(*acq));
+    acq_apply_config(acq, cfg);
+    acq_set_state(acq, ACQ_STATE_IDLE);
+    return true;
+}
+
+// [생산자] 설정 교체
+bool acq_reconfigure(acq_t *acq, const acq_config_t *cfg)
+{
+    if (acq == NULL || !acq_config_valid(cfg)) {
+        return false;
+    }
+
+    // ISR이 TRIGGERING을 잡고 필드를 쓰는 중이면 끝날 때까지 기다렸다 정지
+    acq_state_t state;
+    do {
+        state = acq_get_state(acq);
+    } while (state == ACQ_STATE_TRIGGERING || !acq_cas_state(acq, state, ACQ_STATE_IDLE));
+
+    acq_apply_config(acq, cfg);
+    atomic_store_explicit(&acq->ignored_edges, 0, memory_order_relaxed);
+    return true;
+}
+
+// 무장
+void acq_arm(acq_t *acq, uint32_t write_seq, int64_t now_us)
+{
+    acq->arm_seq = write_seq;
+    acq->arm_time_us = now_us;
+    acq->forced = false;
+    // 고정 해제 후에는 이전 데이터와 이어지지 않으므로 프리트리거 구간을 새로 채운다
+    acq_set_state(acq, acq->pre_count == 0 ? ACQ_STATE_ARMED : ACQ_STATE_PRETRIGGER);
+}
+
+// TRIGGERING을 잡은 쪽이 다시 무장. 그 사이 정지됐으면 IDLE 그대로
+static void acq_rearm_locked(acq_t *acq, uint32_t write_seq, int64_t now_us)
+{
+    acq->arm_seq = write_seq;
+    acq->arm_time_us = now_us;
+    acq->forced = false;
+    acq_cas_state(acq, ACQ_STATE_TRIGGERING, acq->pre_count == 0 ? ACQ_STATE_ARMED : ACQ_STATE_PRETRIGGER);
+}
+
+// 정지
+void acq_stop(acq_t *acq)
+{
+    acq_set_state(acq, ACQ_STATE_IDLE);
+}
+
+// 마지막 공개 위치 기록 (ISR이 엣지 시퀀스를 보정할 때 사용)
+static void acq_publish(acq_t *acq, uint32_t write_seq, int64_t now_us)
+{
+    uint32_t version = atomic_load_explicit(&acq->pub_version, memory_order_relaxed);
+    atomic_store_explicit(&acq->pub_version, version + 1, memory_order_relaxed);   // 홀수: 갱신 중
+    atomic_thread_fence(memory_order_release);
+    acq->pub_seq = write_seq;
+    acq->pub_time_us = now_us;
+    atomic_store_explicit(&acq->pub_version, version + 2, memory_order_release);
+}
+
+// 엣지 시각에 해당하는 샘플 시퀀스 추정
+static uint32_t acq_edge_seq(acq_t *acq, int64_t edge_time_us)
+{
+    uint32_t seq = 0;
+    int64_t time_us = 0;
+
+    for (int retry = 0; retry < 4; retry++) {
+        uint32_t v0 = atomic_load_explicit(&acq->pub_version, memory_order_acquire);
+        seq = acq->pub_seq;
+        time_us = acq->pub_time_us;
+        atomic_thread_fence(memory_order_acquire);
+        uint32_t v1 = atomic_load_explicit(&acq->pub_version, memory_order_relaxed);
+        if (v0 == v1 && (v0 & 1) == 0) {
+            break;
+        }
+    }
+
+    // 공개 이후(또는 이전) 경과 시간만큼 샘플 수 보정
+    int64_t delta = ((edge_time_us - time_us) * (int64_t)acq->cfg.sample_rate_hz) / 1000000;
+    uint32_t est = seq + (uint32_t)(int32_t)delta;
+
+    // 프리트리거 구간이 모자라지 않도록 제한
+    uint32_t min_seq = acq_trigger_min_seq(acq);
+    if ((int32_t)(est - min_seq) < 0) {
+        est = min_seq;
+    }
+    return est;
+}
+
+// 트리거 확정 (ISR, 소프트 트리거 또는 AUTO 강제 트리거). seq_known이 false면 시각으로 추정
+static bool acq_fire(acq_t *acq, uint32_t seq, bool seq_known, int64_t time_us, bool forced)
+{
+    if (!acq_cas_state(acq, ACQ_STATE_ARMED, ACQ_STATE_TRIGGERING)) {
+        return false;
+    }
+
+    acq->trigger_seq = seq_known ? seq : acq_edge_seq(acq, time_us);
+    acq->trigger_time_us = time_us;
+    acq->last_trigger_us = time_us;
+    acq->forced = forced;
+    // 처리하는 사이 정지됐으면 되살리지 않음
+    return acq_cas_state(acq, ACQ_STATE_TRIGGERING, ACQ_STATE_POSTTRIGGER);
+}
+
+// [생산자] 샘플 기록 후 호출
+bool acq_on_samples(acq_t *acq, uint32_t write_seq, int64_t now_us)
+{
+    acq_publish(acq, write_seq, now_us);
+
+    switch (acq_get_state(acq)) {
+        case ACQ_STATE_PRETRIGGER:
+            if (write_seq - acq->arm_seq >= acq->pre_count) {
+                acq->arm_time_us = now_us;  // AUTO 타임아웃은 무장 완료 시점부터
+                acq_cas_state(acq, ACQ_STATE_PRETRIGGER, ACQ_STATE_ARMED);
+            }
+            return true;
+
+        case ACQ_STATE_ARMED:
+            if (acq->cfg.mode == ACQ_MODE_AUTO &&
+                now_us - acq->arm_time_us >= (int64_t)acq->cfg.auto_timeout_us) {
+                // 트리거 없이 현재 위치를 트리거 지점으로 사용
+                acq_fire(acq, write_seq, true, now_us, true);
+            }
+            if (acq_get_state(acq) != ACQ_STATE_POSTTRIGGER) {
+                return true;
+            }
+            // fall through
+        case ACQ_STATE_POSTTRIGGER:
+            if ((int32_t)(write_seq - acq->trigger_seq) >= (int32_t)acq->post_count) {
+                if (acq_cas_state(acq, ACQ_STATE_POSTTRIGGER, ACQ_STATE_DONE)) {
+                    acq->record_count++;
+                }
+                return false;
+            }
+            return true;
+
+        case ACQ_STATE_DONE:
+            return false;
+
+        case ACQ_STATE_IDLE:
+        case ACQ_STATE_TRIGGERING:
+        default:
+            return true;
+    }
+}
+
+// [생산자] 샘플 끊김
+void acq_on_gap(acq_t *acq, uint32_t write_seq, int64_t now_us)
+{
+    // TRIGGERING을 잠금처럼 잡아 ISR이 바꾸는 중인 arm_seq를 함께 건드리지 않게 함
+    acq_state_t state;
+    do {
+        state = acq_get_state(acq);
+        if (state == ACQ_STATE_IDLE || state == ACQ_STATE_DONE) {
+            return;     // 고정된 레코드는 끊기기 전 데이터라 그대로 유효
+        }
+    } while (state == ACQ_STATE_TRIGGERING || !acq_cas_state(acq, state, ACQ_STATE_TRIGGERING));
+
+    acq_publish(acq, write_seq, now_us);
+    acq_rearm_locked(acq, write_seq, now_us);
+}
+
+// [ISR] 트리거 엣지
+bool acq_on_trigger(acq_t *acq, int64_t edge_time_us)
+{
+    if (acq_get_state(acq) != ACQ_STATE_ARMED ||
+        edge_time_us - acq->last_trigger_us < (int64_t)acq->cfg.holdoff_us) {
+        atomic_fetch_add_explicit(&acq->ignored_edges, 1, memory_order_relaxed);
+        return false;
+    }
+    return acq_fire(acq, 0, false, edge_time_us, false);
+}
+
+// [생산자] 샘플 위치를 아는 트리거 (소프트웨어 트리거)
+bool acq_on_trigger_at(acq_t *acq, uint32_t trigger_seq, int64_t now_us)
+{
+    if (acq_get_state(acq) != ACQ_STATE_ARMED ||
+        (int32_t)(trigger_seq - acq_trigger_min_seq(acq)) < 0 ||
+        now_us - acq->last_trigger_us < (int64_t)acq->cfg.holdoff_us) {
+        atomic_fetch_add_explicit(&acq->ignored_edges, 1, memory_order_relaxed);
+        return false;
+    }
+    return acq_fire(acq, trigger_seq, true, now_us, false);
+}
+
+// [소비자] 고정된 레코드
+bool acq_get_record(const acq_t *acq, uint32_t *start_seq, uint32_t *length, uint32_t *trigger_index)
+{
+    if (acq_get_state(acq) != ACQ_STATE_DONE) {
+        return false;
+    }
+    *start_seq = acq->trigger_seq - acq->pre_count;
+    *length = acq->pre_count + acq->post_count;
+    if (trigger_index) {
+        *trigger_index = acq->pre_count;
+    }
+    return true;
+}
+
+// [소비자] 레코드 사용 완료
+void acq_release(acq_t *acq, uint32_t write_seq, int64_t now_us)
+{
+    if (acq_get_state(acq) != ACQ_STATE_DONE) {
+        return;
+    }
+    if (acq->cfg.mode == ACQ_MODE_SINGLE) {
+        acq_set_state(acq, ACQ_STATE_IDLE);
+    } else {
+        acq_arm(acq, write_seq, now_us);
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 트리거 기반 획득 상태 머신 (trigger -> sampling)
+//
+// 링버퍼의 쓰기 시퀀스만 보고 동작하며 GPIO/FreeRTOS 의존성이 없다.
+// - 생산자(ADC 처리 태스크): 샘플을 기록한 뒤 acq_on_samples() 호출.
+//   레코드가 고정된 뒤에도 링은 계속 기록되므로 레코드 길이는 링 capacity - guard보다
+//   소비자가 읽을 여유만큼 더 짧게 잡고, 소비자는 읽은 뒤 뷰가 유효한지 확인한다.
+//   샘플이 끊기면 acq_on_gap()으로 진행 중인 레코드를 끊긴 뒤부터 다시 채운다.
+// - 트리거 ISR: acq_on_trigger()에 엣지 시각(us)만 넘긴다.
+//   엣지 시점의 시퀀스는 마지막으로 공개된 (시퀀스, 시각)과 샘플레이트로 보정한다.
+// - 소비자(UI): acq_get_record()로 고정된 레코드를 읽고 acq_release()로 재무장.
+// 상태 전이는 CAS로 하므로 acq_stop() 뒤에 ISR/생산자가 처리 중이던 트리거가 상태를 되살리지 않는다.
+// 실행 중 설정 변경은 생산자가 acq_reconfigure()로 한다 (acq_init은 구조체 전체를 지우므로 쓰기 전 한 번만).
+
+typedef enum {
+    ACQ_MODE_NORMAL = 0,    // 트리거가 올 때만 갱신
+    ACQ_MODE_AUTO,          // 타임아웃 동안 트리거가 없으면 강제 트리거
+    ACQ_MODE_SINGLE,        // 한 번 잡고 정지
+} acq_mode_t;
+
+typedef enum {
+    ACQ_STATE_IDLE = 0,     // 정지 (링에 계속 기록)
+    ACQ_STATE_PRETRIGGER,   // 프리트리거 구간 채우는 중 (트리거 무시)
+    ACQ_STATE_ARMED,        // 트리거 대기
+    ACQ_STATE_TRIGGERING,   // 트리거 처리 중 (ISR/생산자 간 경합 방지용 중간 상태)
+    ACQ_STATE_POSTTRIGGER,  // 포스트트리거 구간 기록 중
+    ACQ_STATE_DONE,         // 레코드 고정됨 (소비자 대기, 링은 계속 기록)
+} acq_state_t;
+
+typedef struct {
+    acq_mode_t mode;
+    uint32_t record_length;     // 레코드 길이 (샘플 수, 링 capacity - guard - 읽기 여유 이하)
+    uint8_t trigger_pos_pct;    // 레코드 내 트리거 위치 (0~100%, 50 = 가운데)
+    uint32_t holdoff_us;        // 직전 트리거 이후 무시 시간
+    uint32_t auto_timeout_us;   // AUTO 모드 강제 트리거 대기 시간
+    uint32_t sample_rate_hz;    // 채널당 샘플레이트 (엣지 시퀀스 보정용)
+} acq_config_t;
+
+typedef struct {
+    acq_config_t cfg;
+    uint32_t pre_count;             // 트리거 이전 샘플 수
+    uint32_t post_count;            // 트리거 이후 샘플 수
+
+    _Atomic int state;              // acq_state_t
+    uint32_t arm_seq;               // 무장 시점의 쓰기 시퀀스
+    int64_t arm_time_us;            // 무장 시각 (AUTO 타임아웃 기준)
+    uint32_t trigger_seq;           // 트리거 시점 시퀀스
+    int64_t trigger_time_us;        // 트리거 시각
+    int64_t last_trigger_us;        // 홀드오프 기준 시각
+    bool forced;                    // AUTO 강제 트리거 여부
+
+    // 마지막으로 공개된 (시퀀스, 시각) - 버전 카운터로 일관성 확보
+    _Atomic uint32_t pub_version;
+    uint32_t pub_seq;
+    int64_t pub_time_us;
+
+    uint32_t record_count;          // 고정된 레코드 누적 개수
+    _Atomic uint32_t ignored_edges; // 무장 전/홀드오프로 무시된 엣지 수 (ISR과 생산자가 함께 셈)
+} acq_t;
+
+// 설정 적용 후 IDLE 상태로 초기화
+bool acq_init(acq_t *acq, const acq_config_t *cfg);
+
+// [생산자] 정지시키고 설정 교체. ISR이 트리거를 처리 중이면 끝나기를 기다리고, 원자 변수는 지우지 않는다
+bool acq_reconfigure(acq_t *acq, const acq_config_t *cfg);
+
+// 무장 (PRETRIGGER부터 시작)
+void acq_arm(acq_t *acq, uint32_t write_seq, int64_t now_us);
+
+// 정지 (IDLE)
+void acq_stop(acq_t *acq);
+
+// [생산자] 샘플 기록 후 호출. 레코드가 고정돼 있으면 false
+bool acq_on_samples(acq_t *acq, uint32_t write_seq, int64_t now_us);
+
+// [생산자] write_seq 앞에서 샘플이 끊김. 채우던 레코드는 버리고 write_seq부터 프리트리거를 다시 채운다
+void acq_on_gap(acq_t *acq, uint32_t write_seq, int64_t now_us);
+
+// [ISR] 트리거 엣지. 받아들였으면 true
+bool acq_on_trigger(acq_t *acq, int64_t edge_time_us);
+
+// [생산자] 샘플 위치를 아는 트리거 (소프트웨어 트리거). 프리트리거 구간 이전이면 무시
+bool acq_on_trigger_at(acq_t *acq, uint32_t trigger_seq, int64_t now_us);
+
+// [소비자] 고정된 레코드 위치 (DONE 상태일 때만 true)
+bool acq_get_record(const acq_t *acq, uint32_t *start_seq, uint32_t *length, uint32_t *trigger_index);
+
+// [소비자] 레코드 사용 완료. SINGLE 모드는 IDLE로, 나머지는 재무장
+void acq_release(acq_t *acq, uint32_t write_seq, int64_t now_us);
+
+static inline acq_state_t acq_get_state(const acq_t *acq)
+{
+    return (acq_state_t)atomic_load_explicit(&((acq_t *)acq)->state, memory_order_acquire);
+}
+
+// 트리거로 받아들일 수 있는 가장 이른 시퀀스 (프리트리거 구간이 채워진 위치)
+static inline uint32_t acq_trigger_min_seq(const acq_t *acq)
+{
+    return acq->arm_seq + acq->pre_count;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ACQUISITION_H
@@ -0,0 +1,129 @@
+#include <string.h>
+#include "adc_calib.h"
+
+#define RAW_MASK    (ADC_CALIB_TABLE_SIZE - 1)
+
+// 감쇠비 x10 (프로브 전압 / 감쇠기 출력) - 정수 유리수로 계산해 표 전체에 반올림 한 번
+static const int32_t calib_primary_div10[4] = { 10, 100, 919, 1010 };
+static const int32_t calib_secondary_div[4] = { 1, 2, 5, 6 };
+
+// 표: 채널당 하나 + 예비 하나 (다시 만들 때 예비 표에 쓰고 바꿔 끼움)
+static int32_t calib_tables[ADC_CALIB_CHANNELS + 1][ADC_CALIB_TABLE_SIZE];
+static _Atomic int calib_active[ADC_CALIB_CHANNELS] = { 0, 1 };
+static _Atomic uint32_t calib_version[ADC_CALIB_CHANNELS];
+static int calib_spare = ADC_CALIB_CHANNELS;
+
+// ADC 핀 직선 (Q16 uV): pin = line_uv0_q16 + raw * line_slope_q16 (기본값은 0~3300mV 단순 비례)
+static int64_t line_uv0_q16 = 0;
+static int64_t line_slope_q16 = (3300000LL << 16) / 4095;
+
+static adc_front_end_t calib_fe[ADC_CALIB_CHANNELS];
+static int32_t calib_v12_uv = ADC_CALIB_V12_UV;
+static int32_t calib_trim_uv[ADC_CALIB_CHANNELS][2];
+
+int32_t adc_calib_pin_uv(uint16_t raw)
+{
+    return (int32_t)((line_uv0_q16 + (int64_t)(raw & RAW_MASK) * line_slope_q16 + 0x8000) >> 16);
+}
+
+// 표 다시 만들기 (설정 함수를 부르는 태스크 하나에서만)
+static void calib_rebuild(int ch)
+{
+    const adc_front_end_t *fe = &calib_fe[ch];
+    int32_t *t = calib_tables[calib_spare];
+
+    // Vi = (pin - offset) * div1 * div2 / 8, 모두 Q16에서 계산하고 마지막에 한 번 반올림
+    int64_t offset_q16 = (int64_t)((double)calib_v12_uv * 65536.0 / ADC_CALIB_SHIFTER_DIV + 0.5) +
+                         ((int64_t)calib_trim_uv[ch][fe->ac & 1] << 16);
+    int64_t num = (int64_t)calib_primary_div10[fe->primary & 3] * calib_secondary_div[fe->secondary & 3];
+    int64_t den = 10LL * ADC_CALIB_SHIFTER_GAIN << 16;
+
+    for (uint32_t raw = 0; raw < ADC_CALIB_TABLE_SIZE; raw++) {
+        int64_t v = (line_uv0_q16 + (int64_t)raw * line_slope_q16 - offset_q16) * num;
+        t[raw] = (int32_t)((v + (v >= 0 ? den / 2 : -den / 2)) / den);
+    }
+
+    // 새 표 공개 후 버전 증가 (읽는 쪽은 버전이 같을 때만 결과를 씀)
+    int old = atomic_load_explicit(&calib_active[ch], memory_order_relaxed);
+    atomic_store_explicit(&calib_active[ch], calib_spare, memory_order_release);
+    atomic_fetch_add_explicit(&calib_version[ch], 1, memory_order_release);
+    calib_spare = old;
+}
+
+// 초기화
+void adc_calib_init(uint16_t raw_lo, int32_t uv_lo, uint16_t raw_hi, int32_t uv_hi)
+{
+    if (raw_hi > raw_lo) {
+        line_slope_q16 = (((int64_t)uv_hi - uv_lo) << 16) / (raw_hi - raw_lo);
+        line_uv0_q16 = ((int64_t)uv_lo << 16) - (int64_t)raw_lo * line_slope_q16;
+    }
+    for (int ch = 0; ch < ADC_CALIB_CHANNELS; ch++) {
+        calib_rebuild(ch);
+    }
+}
+
+// 감쇠/AC-DC 상태
+bool adc_calib_set_front_end(int ch, const adc_front_end_t *fe)
+{
+    if (ch < 0 || ch >= ADC_CALIB_CHANNELS) {
+        return false;
+    }
+    adc_front_end_t next = { fe->ac & 1, fe->primary & 3, fe->secondary & 3 };
+    if (memcmp(&next, &calib_fe[ch], sizeof(next)) == 0) {
+        return false;
+    }
+    calib_fe[ch] = next;
+    calib_rebuild(ch);
+    return true;
+}
+
+void adc_calib_set_v12(int32_t v12_uv)
+{
+    calib_v12_uv = v12_uv;
+    for (int ch = 0; ch < ADC_CALIB_CHANNELS; ch++) {
+        calib_rebuild(ch);
+    }
+}
+
+void adc_calib_set_zero_trim(int ch, int ac, int32_t trim_uv)
+{
+    if (ch < 0 || ch >= ADC_CALIB_CHANNELS) {
+        return;
+    }
+    calib_trim_uv[ch][ac & 1] = trim_uv;
+    calib_rebuild(ch);
+}
+
+const int32_t *adc_calib_table(int ch)
+{
+    return calib_tables[atomic_load_explicit(&calib_active[ch], memory_order_acquire)];
+}
+
+uint32_t adc_calib_version(int ch)
+{
+    return atomic_load_explicit(&calib_version[ch], memory_order_acquire);
+}
+
+int32_t adc_calib_uv(int ch, uint16_t raw)
+{
+    return adc_calib_table(ch)[raw & RAW_MASK];
+}
+
+// 블록 변환
+void adc_calib_convert(int ch, const uint16_t *raw, int32_t *uv, uint32_t n)
+{
+    for (;;) {
+        uint32_t version = adc_calib_version(ch);
+        const int32_t *t = adc_calib_table(ch);
+
+        for (uint32_t i = 0; i < n; i++) {
+            uv[i] = t[raw[i] & RAW_MASK];
+        }
+
+        // 읽는 동안 표가 바뀌지 않았으면 끝 (바뀌었으면 예비 표로 돌아가 덮어써졌을 수 있음)
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&calib_version[ch], memory_order_relaxed) == version) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef ADC_CALIB_H
+#define ADC_CALIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ADC raw -> 프로브 전압(uV) 변환표
+//
+// 채널마다 raw 4096개 각각의 프로브 전압을 미리 계산해 둔 표 하나로 변환한다.
+//   Vadc = ADC 핀 전압 (line fitting 캘리브레이션 직선)
+//   Vi   = (Vadc - 오프셋) * 1차 감쇠비 * 2차 감쇠비 / 레벨 쉬프터 이득   (README 감쇠 회로 식)
+// 오프셋은 레벨 쉬프터 기준(V12/7.2)에 AC/DC별 보정값을 더한 것.
+// 블록 변환은 샘플마다 표 한 번 읽기뿐이라 나눗셈/부동소수점이 없다.
+// 표는 감쇠 릴레이 상태가 바뀔 때만 다시 만든다. 새 표는 예비 표에 만든 뒤 포인터를 바꾸므로
+// 변환 중인 쪽은 이전 표를 끝까지 읽고, 도중에 바뀌었으면(버전) 그 블록만 다시 변환한다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define ADC_CALIB_CHANNELS      2
+#define ADC_CALIB_TABLE_SIZE    4096        // 12비트 raw
+#define ADC_CALIB_SHIFTER_GAIN  8           // 레벨 쉬프터 이득 (Vadc = 8 * V2 + V12/7.2)
+#define ADC_CALIB_V12_UV        12000000    // 12V 레인 공칭값
+#define ADC_CALIB_SHIFTER_DIV   7.2         // 레벨 쉬프터 기준 = V12 / 7.2
+
+// 프런트엔드 상태 (interactive gain_state 값과 같음)
+typedef struct {
+    uint8_t ac;             // 0: AC, 1: DC (Q1/Q7)
+    uint8_t primary;        // 0: 1, 1: 1/10, 2: 1/91.9, 3: 1/101
+    uint8_t secondary;      // 0: 1, 1: 1/2, 2: 1/5, 3: 1/6
+} adc_front_end_t;
+
+// ADC 핀 특성 직선 (두 점). raw_lo/raw_hi에서의 핀 전압(uV)
+// IDF 쪽에서 adc_cali_raw_to_voltage() 두 번으로 얻는다. 표를 모두 다시 만든다
+void adc_calib_init(uint16_t raw_lo, int32_t uv_lo, uint16_t raw_hi, int32_t uv_hi);
+
+// 감쇠/AC-DC 상태 적용. 바뀌었으면 표를 다시 만들고 true
+bool adc_calib_set_front_end(int ch, const adc_front_end_t *fe);
+
+// 레벨 쉬프터 기준 전압 (측정한 12V 레인, uV). 표를 다시 만든다
+void adc_calib_set_v12(int32_t v12_uv);
+
+// AC/DC 모드별 영점 보정 (ADC 핀 기준 uV, 기준 전압에 더함). 표를 다시 만든다
+void adc_calib_set_zero_trim(int ch, int ac, int32_t trim_uv);
+
+// ADC 핀 전압 (uV, 표 없이 직선)
+int32_t adc_calib_pin_uv(uint16_t raw);
+
+// 한 샘플 (uV)
+int32_t adc_calib_uv(int ch, uint16_t raw);
+
+// 블록 변환 (uV). 표가 바뀌는 중이었으면 새 표로 다시 변환한다
+void adc_calib_convert(int ch, const uint16_t *raw, int32_t *uv, uint32_t n);
+
+// 표 버전 (다시 만들 때마다 증가) - 결과를 캐시하는 쪽이 비교용으로 씀
+uint32_t adc_calib_version(int ch);
+
+// 현재 채널 표 (직접 읽을 때. 쓰는 동안 바뀔 수 있으므로 adc_calib_version과 함께)
+const int32_t *adc_calib_table(int ch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADC_CALIB_H
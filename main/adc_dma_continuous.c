@@ -4,12 +4,21 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
-#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "driver/dac_oneshot.h"
 #include "esp_adc/adc_continuous.h"
 #include "esp_adc/adc_cali.h"
 #include "esp_adc/adc_cali_scheme.h"
+#include "adc_dma_continuous.h"
+#include "adc_ring.h"
+#include "adc_calib.h"
+#include "acquisition.h"
+#include "soft_trigger.h"
+#include "measure.h"
 
 static const char *TAG = "ADC_DMA_CONTINUOUS";
 
@@ -27,31 +36,76 @@ static const char *TAG = "ADC_DMA_CONTINUOUS";
 
 // DMA 버퍼 설정
 #define ADC_BUFFER_SIZE             256   // 버퍼 크기 줄여서 안정성 향상
-#define ADC_SAMPLE_FREQ_HZ          20000  // 20kHz 샘플링 (대역폭 향상)
+#define ADC_SAMPLE_FREQ_HZ          (ADC_CHANNEL_SAMPLE_HZ * ADC_CHANNEL_NUM)  // 20kHz 샘플링, 패턴 2개가 번갈아 변환됨
 
-// ADC 결과 구조체
-typedef struct {
-    uint32_t channel_0_data[ADC_BUFFER_SIZE];
-    uint32_t channel_1_data[ADC_BUFFER_SIZE];
-    uint32_t buffer_index;
-    bool buffer_full;
-} adc_dma_data_t;
+// 트리거 핀 (아날로그 비교기 출력)
+#define GPIO_TRIG0                  9
+#define GPIO_TRIG1                  10
+#define DAC_TRIG_CHANNEL            DAC_CHAN_0  // GPIO25 - 트리거 레벨
+
+// 자동 측정 창 (채널당 샘플 수, 200 ms마다 결과 하나)
+#define ADC_MEASURE_WINDOW          (ADC_CHANNEL_SAMPLE_HZ / 5)
+
+// 샘플 링버퍼 여유분 (DMA 프레임 1개 분량의 샘플 쌍)
+#define ADC_RING_GUARD              (ADC_BUFFER_SIZE / sizeof(uint16_t) / ADC_CHANNEL_NUM)
+
+// 트리거 레코드가 고정된 뒤 덮어써지기 전까지 소비자가 읽을 여유 (채널당 샘플 수, 50 ms)
+#define ADC_RECORD_MARGIN           (ADC_CHANNEL_SAMPLE_HZ / 20)
+
+// 캡처 메모리를 바꾸거나 해제하기 전에 소비자가 뷰를 돌려주기를 기다리는 최대 시간
+#define ADC_RING_DRAIN_TIMEOUT_MS   1000
+
+// 처리 태스크가 새 트리거 획득 설정을 반영하기를 기다리는 최대 시간 (큐 대기 100 ms보다 길게)
+#define ADC_ACQ_CONFIG_TIMEOUT_MS   500
 
 // 전역 변수
 static adc_continuous_handle_t adc_handle = NULL;
 static adc_cali_handle_t adc1_cali_handle = NULL;
-static adc_dma_data_t adc_data = {0};
-static SemaphoreHandle_t adc_data_mutex = NULL;
+static uint16_t *adc_record_mem = NULL;     // ch0 | ch1 캡처 메모리 (한 블록)
+static uint32_t adc_record_length = ADC_RECORD_LENGTH_DEFAULT;
+static adc_ring_t adc_rings[2];             // 레코드 길이를 바꿀 때마다 번갈아 사용
+static adc_ring_t *_Atomic adc_ring_cur = &adc_rings[0];
 static QueueHandle_t adc_queue = NULL;
 static bool adc_continuous_running = false;
+static TaskHandle_t adc_process_task = NULL;
+static _Atomic uint32_t adc_dropped_frames;    // 큐가 차서 버린 DMA 프레임 (ISR이 셈)
+
+// 마지막으로 기록한 (시퀀스, 시각, 그때까지의 끊김 횟수) - 버전 카운터로 일관성 확보
+static _Atomic uint32_t adc_anchor_version;
+static uint32_t adc_anchor_seq;
+static int64_t adc_anchor_time_us;
+static uint32_t adc_anchor_gaps;
+
+// 트리거 획득 상태 (실행 중 설정 변경은 pending으로 넘겨 처리 태스크가 반영)
+static acq_t adc_acq;
+static acq_config_t adc_acq_pending_cfg;
+static _Atomic bool adc_acq_pending = false;
+static int adc_trig_gpio = -1;
+static dac_oneshot_handle_t trig_dac_handle = NULL;
+
+// 소프트웨어 트리거 (처리 태스크 전용, 설정은 pending으로 넘겨받음)
+static soft_trig_t adc_soft_trig;
+static int adc_soft_trig_ch = -1;           // -1: 사용 안 함
+static uint32_t adc_soft_scan_seq;          // 다음에 스캔할 시퀀스
+static soft_trig_config_t soft_trig_pending_cfg;
+static int soft_trig_pending_ch = -1;
+static _Atomic bool soft_trig_pending = false;
+
+// 자동 측정 (처리 태스크가 갱신, 결과는 버전 카운터로 공개)
+static meas_t adc_meas[ADC_CHANNEL_NUM];
+static uint32_t adc_meas_seq;               // 다음에 측정할 시퀀스
 
 // ADC Continuous Mode 콜백 함수
 static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
 {
+    (void)handle;
+    (void)user_data;
     BaseType_t must_yield = pdFALSE;
     
     // ADC 데이터를 큐에 전송
     if (xQueueSendFromISR(adc_queue, edata, &must_yield) != pdTRUE) {
+        // 처리 태스크가 다음 프레임 앞에 끊김을 표시함
+        atomic_fetch_add_explicit(&adc_dropped_frames, 1, memory_order_relaxed);
         ESP_LOGE(TAG, "ADC queue full, data lost");
     }
     
@@ -61,6 +115,7 @@ static bool IRAM_ATTR s_conv_done_cb(adc_continuous_handle_t handle, const adc_c
 // ADC 캘리브레이션 초기화
 static esp_err_t adc_calibration_init(adc_unit_t unit, adc_channel_t channel, adc_atten_t atten, adc_cali_handle_t *out_handle)
 {
+    (void)channel;  // line fitting 방식은 유닛 단위
     adc_cali_handle_t handle = NULL;
     esp_err_t ret = ESP_FAIL;
     bool calibrated = false;
@@ -90,22 +145,178 @@ static esp_err_t adc_calibration_init(adc_unit_t unit, adc_channel_t channel, ad
     return ret;
 }
 
+// 변환표 초기화: line fitting 직선을 두 점에서 읽어 넘김 (이후 샘플마다 adc_cali 호출 없음)
+static void adc_calib_table_init(void)
+{
+    int mv_lo = 0, mv_hi = 3300;
+    int raw_lo = 0, raw_hi = 4095;
+
+    if (adc1_cali_handle) {
+        // 양 끝은 피하고 범위 안의 두 점 (mV 단위 오차가 기울기에 덜 묻도록 멀리)
+        raw_lo = 256;
+        raw_hi = 3840;
+        if (adc_cali_raw_to_voltage(adc1_cali_handle, raw_lo, &mv_lo) != ESP_OK ||
+            adc_cali_raw_to_voltage(adc1_cali_handle, raw_hi, &mv_hi) != ESP_OK) {
+            raw_lo = 0;
+            raw_hi = 4095;
+            mv_lo = 0;
+            mv_hi = 3300;
+        }
+    }
+    adc_calib_init((uint16_t)raw_lo, mv_lo * 1000, (uint16_t)raw_hi, mv_hi * 1000);
+    ESP_LOGI(TAG, "Calibration tables built: raw %d -> %d mV, raw %d -> %d mV", raw_lo, mv_lo, raw_hi, mv_hi);
+}
+
+// 캡처 메모리를 할당할 수 있는 힙 영역 (PSRAM 우선, 없으면 내부 DRAM)
+static const uint32_t adc_record_heap_caps[] = {
+    MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT,
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+};
+
+// 현재 링 (레코드 길이 변경 시 바뀜). 처리 태스크는 교체 전에 멈추므로 참조 없이 직접 사용
+static inline adc_ring_t *adc_ring_get(void)
+{
+    return atomic_load_explicit(&adc_ring_cur, memory_order_acquire);
+}
+
+// 현재 링 참조 (폐기 중이면 NULL). 얻은 뷰는 adc_dma_put_view로 돌려줌
+static adc_ring_t *adc_ring_ref(void)
+{
+    adc_ring_t *ring = adc_ring_get();
+    return adc_ring_acquire(ring) ? ring : NULL;
+}
+
+// 링에 새 참조를 막고 읽던 소비자가 모두 뷰를 돌려줄 때까지 대기. 시간 안에 안 끝나면 되돌리고 false
+static bool adc_ring_drain(adc_ring_t *ring)
+{
+    adc_ring_set_retired(ring, true);
+    for (int waited = 0; adc_ring_readers(ring) != 0; waited += 10) {
+        if (waited >= ADC_RING_DRAIN_TIMEOUT_MS) {
+            ESP_LOGE(TAG, "%lu ring views still held", (unsigned long)adc_ring_readers(ring));
+            adc_ring_set_retired(ring, false);
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return true;
+}
+
+static bool is_valid_record_length(uint32_t points)
+{
+    return points >= ADC_RECORD_LENGTH_MIN && points <= ADC_RECORD_LENGTH_MAX &&
+           (points & (points - 1)) == 0;
+}
+
+// 캡처 메모리 할당 후 링 재설정 (처리 태스크가 없을 때만)
+// 이미 메모리가 있으면 이전 링에 새 참조를 막고 소비자가 뷰를 모두 돌려준 뒤, 쓰지 않던 링 구조체에
+// 새 메모리를 붙여 교체하고 이전 메모리를 해제한다. 뷰를 안 돌려주면 ESP_ERR_INVALID_STATE
+static esp_err_t adc_record_alloc(uint32_t points)
+{
+    size_t bytes = adc_dma_record_memory_bytes(points);
+    uint16_t *mem = NULL;
+    
+    for (size_t i = 0; i < sizeof(adc_record_heap_caps) / sizeof(adc_record_heap_caps[0]) && mem == NULL; i++) {
+        mem = heap_caps_calloc(1, bytes, adc_record_heap_caps[i]);
+    }
+    if (mem == NULL) {
+        ESP_LOGE(TAG, "Failed to allocate %u bytes for %lu point record", (unsigned)bytes, (unsigned long)points);
+        return ESP_ERR_NO_MEM;
+    }
+    
+    adc_ring_t *old_ring = adc_ring_get();
+    uint16_t *old_mem = adc_record_mem;
+    adc_ring_t *ring = old_ring;
+    if (old_mem != NULL) {
+        if (!adc_ring_drain(old_ring)) {
+            heap_caps_free(mem);
+            return ESP_ERR_INVALID_STATE;
+        }
+        ring = (old_ring == &adc_rings[0]) ? &adc_rings[1] : &adc_rings[0];
+    }
+    if (!adc_ring_init(ring, mem, mem + points, points, ADC_RING_GUARD)) {
+        if (old_mem != NULL) {
+            adc_ring_set_retired(old_ring, false);
+        }
+        heap_caps_free(mem);
+        return ESP_ERR_INVALID_ARG;
+    }
+    
+    adc_record_mem = mem;
+    adc_record_length = points;
+    atomic_store_explicit(&adc_ring_cur, ring, memory_order_release);
+    heap_caps_free(old_mem);
+    ESP_LOGI(TAG, "Record length %lu points/ch (%u bytes)", (unsigned long)points, (unsigned)bytes);
+    return ESP_OK;
+}
+
+// 레코드 길이에 필요한 캡처 메모리 (바이트)
+size_t adc_dma_record_memory_bytes(uint32_t points)
+{
+    return (size_t)points * ADC_CHANNEL_NUM * sizeof(uint16_t);
+}
+
+// 현재 힙 상태에서 할당 가능한 최대 레코드 길이 (현재 사용 중인 메모리 포함)
+uint32_t adc_dma_get_max_record_length(void)
+{
+    size_t largest = 0;
+    for (size_t i = 0; i < sizeof(adc_record_heap_caps) / sizeof(adc_record_heap_caps[0]); i++) {
+        size_t block = heap_caps_get_largest_free_block(adc_record_heap_caps[i]);
+        if (block > largest) {
+            largest = block;
+        }
+    }
+    
+    uint32_t best = 0;
+    for (uint32_t points = ADC_RECORD_LENGTH_MIN; points <= ADC_RECORD_LENGTH_MAX; points <<= 1) {
+        // 재할당 시 기존 블록은 새 블록 할당 후 해제되므로 새 블록만 들어가면 됨
+        if (adc_dma_record_memory_bytes(points) <= largest || points == adc_record_length) {
+            best = points;
+        }
+    }
+    return best;
+}
+
+// 레코드 길이 설정 (정지 상태에서만, 처리 태스크가 끝난 뒤)
+esp_err_t adc_dma_set_record_length(uint32_t points)
+{
+    if (!is_valid_record_length(points)) {
+        ESP_LOGE(TAG, "Invalid record length: %lu", (unsigned long)points);
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (adc_continuous_running || adc_process_task != NULL || acq_get_state(&adc_acq) != ACQ_STATE_IDLE) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // 초기화 전이면 길이만 기억해 두고 init에서 할당
+    if (adc_record_mem == NULL) {
+        adc_record_length = points;
+        return ESP_OK;
+    }
+    if (points == adc_record_length) {
+        return ESP_OK;
+    }
+    return adc_record_alloc(points);
+}
+
+uint32_t adc_dma_get_record_length(void)
+{
+    return adc_record_length;
+}
+
 // ADC Continuous Mode 초기화
 esp_err_t adc_dma_continuous_init(void)
 {
     esp_err_t ret = ESP_OK;
     
-    // 뮤텍스와 큐 생성
-    adc_data_mutex = xSemaphoreCreateMutex();
-    if (adc_data_mutex == NULL) {
-        ESP_LOGE(TAG, "Failed to create mutex");
-        return ESP_ERR_NO_MEM;
+    // 캡처 메모리 할당 및 링버퍼 초기화 (소비자는 뮤텍스 없이 스냅샷으로 읽음)
+    ret = adc_record_alloc(adc_record_length);
+    if (ret != ESP_OK) {
+        return ret;
     }
     
+    // 큐 생성
     adc_queue = xQueueCreate(10, sizeof(adc_continuous_evt_data_t));
     if (adc_queue == NULL) {
         ESP_LOGE(TAG, "Failed to create queue");
-        vSemaphoreDelete(adc_data_mutex);
         return ESP_ERR_NO_MEM;
     }
     
@@ -155,6 +366,11 @@ esp_err_t adc_dma_continuous_init(void)
     if (ret != ESP_OK) {
         ESP_LOGW(TAG, "ADC calibration failed, continuing without calibration");
     }
+    adc_calib_table_init();
+    
+    for (int ch = 0; ch < ADC_CHANNEL_NUM; ch++) {
+        meas_init(&adc_meas[ch], ADC_MEASURE_WINDOW, ADC_CHANNEL_SAMPLE_HZ);
+    }
     
     // ADC 이벤트 콜백 등록
     adc_continuous_evt_cbs_t cbs = {
@@ -174,58 +390,175 @@ cleanup:
         adc_continuous_deinit(adc_handle);
         adc_handle = NULL;
     }
-    if (adc_data_mutex) {
-        vSemaphoreDelete(adc_data_mutex);
-        adc_data_mutex = NULL;
-    }
     if (adc_queue) {
         vQueueDelete(adc_queue);
         adc_queue = NULL;
     }
+    heap_caps_free(adc_record_mem);
+    adc_record_mem = NULL;
     return ret;
 }
 
-// ADC 데이터 처리 태스크
+// 새 트리거 획득 설정 반영 (처리 태스크, 태스크가 없으면 설정한 쪽에서)
+// 살아 있는 상태 구조체를 지우지 않고 정지 후 설정 필드만 바꿈 (ISR은 계속 엣지를 셀 수 있음)
+static void acq_config_process(void)
+{
+    if (atomic_load_explicit(&adc_acq_pending, memory_order_acquire)) {
+        acq_reconfigure(&adc_acq, &adc_acq_pending_cfg);
+        atomic_store_explicit(&adc_acq_pending, false, memory_order_release);
+    }
+}
+
+// 새로 기록된 구간에서 소프트웨어 트리거 스캔
+static void soft_trigger_process(uint32_t write_seq, int64_t now_us)
+{
+    // 설정 변경 반영
+    if (atomic_exchange_explicit(&soft_trig_pending, false, memory_order_acquire)) {
+        adc_soft_trig_ch = soft_trig_pending_ch;
+        if (adc_soft_trig_ch >= 0) {
+            soft_trig_init(&adc_soft_trig, &soft_trig_pending_cfg);
+            soft_trig_reset(&adc_soft_trig, write_seq);
+        }
+        adc_soft_scan_seq = write_seq;
+    }
+    if (adc_soft_trig_ch < 0) {
+        return;
+    }
+    
+    // 획득 중이 아니면 스캔하지 않음 (다시 시작할 때 상태를 새로 잡음)
+    acq_state_t state = acq_get_state(&adc_acq);
+    if (state == ACQ_STATE_IDLE || state == ACQ_STATE_DONE) {
+        adc_soft_scan_seq = write_seq;
+        soft_trig_reset(&adc_soft_trig, write_seq);
+        return;
+    }
+    
+    adc_ring_view_t view;
+    if (!adc_ring_view_since(adc_ring_get(), adc_soft_scan_seq, &view)) {
+        return;
+    }
+    if (view.start_seq != adc_soft_trig.seq) {
+        // 중간이 끊겼으면 히스테리시스 상태를 버림
+        soft_trig_reset(&adc_soft_trig, view.start_seq);
+    }
+    
+    // 링 wrap 지점 기준 연속 구간 두 개를 차례로 스캔
+    const uint16_t *seg[2];
+    uint32_t len[2];
+    adc_ring_view_segments(&view, adc_soft_trig_ch, &seg[0], &len[0], &seg[1], &len[1]);
+    for (int s = 0; s < 2; s++) {
+        uint32_t off = 0;
+        while (off < len[s]) {
+            uint32_t used;
+            if (soft_trig_scan(&adc_soft_trig, seg[s] + off, len[s] - off, &used)) {
+                acq_on_trigger_at(&adc_acq, adc_soft_trig.trigger_seq, now_us);
+            }
+            off += used;
+        }
+    }
+    adc_soft_scan_seq = view.start_seq + view.count;
+}
+
+// 새로 기록된 구간을 측정 누적값에 반영
+static void measure_process(void)
+{
+    adc_ring_view_t view;
+    if (!adc_ring_view_since(adc_ring_get(), adc_meas_seq, &view)) {
+        return;
+    }
+    for (int ch = 0; ch < ADC_CHANNEL_NUM; ch++) {
+        if (view.start_seq != adc_meas_seq) {
+            // 중간이 끊겼으면 채우던 창을 버림
+            meas_reset(&adc_meas[ch]);
+        }
+        const uint16_t *seg[2];
+        uint32_t len[2];
+        adc_ring_view_segments(&view, ch, &seg[0], &len[0], &seg[1], &len[1]);
+        meas_push(&adc_meas[ch], seg[0], len[0]);
+        meas_push(&adc_meas[ch], seg[1], len[1]);
+    }
+    adc_meas_seq = view.start_seq + view.count;
+}
+
+// 기록한 위치의 시각 공개 (샘플 시각을 샘플레이트로 길게 외삽하지 않도록 프레임마다 갱신)
+static void adc_publish_anchor(uint32_t write_seq, int64_t now_us)
+{
+    uint32_t version = atomic_load_explicit(&adc_anchor_version, memory_order_relaxed);
+    atomic_store_explicit(&adc_anchor_version, version + 1, memory_order_relaxed);   // 홀수: 갱신 중
+    atomic_thread_fence(memory_order_release);
+    adc_anchor_seq = write_seq;
+    adc_anchor_time_us = now_us;
+    adc_anchor_gaps = adc_ring_gaps(adc_ring_get(), NULL);
+    atomic_store_explicit(&adc_anchor_version, version + 2, memory_order_release);
+}
+
+// 다음에 기록할 샘플 앞에서 데이터가 끊김 (프레임 유실, 재시작)
+// 링에 끊긴 위치를 공개하고, 끊김을 넘어 이어 붙이던 측정/소프트 트리거/획득 상태를 버린다
+static void adc_mark_gap(void)
+{
+    adc_ring_t *ring = adc_ring_get();
+    uint32_t write_seq = adc_ring_write_seq(ring);
+    
+    adc_ring_mark_gap(ring);
+    for (int ch = 0; ch < ADC_CHANNEL_NUM; ch++) {
+        meas_reset(&adc_meas[ch]);
+    }
+    adc_meas_seq = write_seq;
+    if (adc_soft_trig_ch >= 0) {
+        soft_trig_reset(&adc_soft_trig, write_seq);
+    }
+    adc_soft_scan_seq = write_seq;
+    acq_on_gap(&adc_acq, write_seq, esp_timer_get_time());
+}
+
+// ADC 데이터 처리 태스크 (링버퍼의 유일한 생산자)
 static void adc_data_process_task(void *pvParameters)
 {
+    (void)pvParameters;
     adc_continuous_evt_data_t evt_data;
+    uint32_t dropped_seen = atomic_load_explicit(&adc_dropped_frames, memory_order_relaxed);
     
     ESP_LOGI(TAG, "ADC data processing task started");
     
+    // 정지했다 다시 시작하면 이전 데이터와 이어지지 않음
+    if (adc_ring_write_seq(adc_ring_get()) != 0) {
+        adc_mark_gap();
+    }
+    
     while (adc_continuous_running) {
+        acq_config_process();
         if (xQueueReceive(adc_queue, &evt_data, pdMS_TO_TICKS(100)) == pdTRUE) {
-            if (xSemaphoreTake(adc_data_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-                // ESP32 ADC continuous mode에서는 각 샘플이 16비트
-                uint16_t *data = (uint16_t *)evt_data.conv_frame_buffer;
-                uint32_t samples = evt_data.size / sizeof(uint16_t);
-                
-                // 채널별로 데이터 분리 (교대로 들어옴)
-                for (int i = 0; i < samples && adc_data.buffer_index < ADC_BUFFER_SIZE; i += 2) {
-                    if (i + 1 < samples) {
-                        // ESP32 ADC continuous mode 데이터 형식에 맞게 추출
-                        uint16_t raw0 = data[i];
-                        uint16_t raw1 = data[i + 1];
-                        
-                        // 채널 정보와 ADC 값 추출 (ESP32 specific format)
-                        uint32_t adc_val0 = raw0 & 0xFFF;  // 12비트 ADC 값
-                        uint32_t adc_val1 = raw1 & 0xFFF;  // 12비트 ADC 값
-                        
-                        adc_data.channel_0_data[adc_data.buffer_index] = adc_val0;
-                        adc_data.channel_1_data[adc_data.buffer_index] = adc_val1;
-                        adc_data.buffer_index++;
-                        
-                        if (adc_data.buffer_index >= ADC_BUFFER_SIZE) {
-                            adc_data.buffer_full = true;
-                            adc_data.buffer_index = 0;  // 버퍼 재사용
-                        }
-                    }
-                }
-                xSemaphoreGive(adc_data_mutex);
+            // ESP32 ADC continuous mode에서는 각 샘플이 16비트, 채널이 교대로 들어옴
+            const uint16_t *data = (const uint16_t *)evt_data.conv_frame_buffer;
+            uint32_t samples = evt_data.size / sizeof(uint16_t);
+            
+            uint32_t dropped = atomic_load_explicit(&adc_dropped_frames, memory_order_relaxed);
+            if (dropped != dropped_seen) {
+                dropped_seen = dropped;
+                adc_mark_gap();
+            }
+            
+            // 트리거 레코드가 고정된 동안에도 계속 기록 (측정/스트리밍이 끊기지 않음)
+            // 레코드 길이에 ADC_RECORD_MARGIN만큼 여유를 둬 소비자가 덮어써지기 전에 읽게 함
+            // 채널별로 분리해서 링에 기록 (12비트 마스크 포함)
+            adc_ring_write_interleaved(adc_ring_get(), data, samples);
+            uint32_t write_seq = adc_ring_write_seq(adc_ring_get());
+            int64_t now_us = esp_timer_get_time();
+            adc_publish_anchor(write_seq, now_us);
+            acq_on_samples(&adc_acq, write_seq, now_us);
+            
+            measure_process();
+            
+            // 소프트웨어 트리거가 잡혔으면 같은 프레임 안에서 포스트트리거 완료 여부도 확인
+            soft_trigger_process(write_seq, now_us);
+            if (acq_get_state(&adc_acq) == ACQ_STATE_POSTTRIGGER) {
+                acq_on_samples(&adc_acq, write_seq, now_us);
             }
         }
     }
     
     ESP_LOGI(TAG, "ADC data processing task ended");
+    adc_process_task = NULL;
     vTaskDelete(NULL);
 }
 
@@ -246,7 +579,13 @@ esp_err_t adc_dma_continuous_start(void)
     adc_continuous_running = true;
     
     // 데이터 처리 태스크 시작
-    xTaskCreate(adc_data_process_task, "adc_data_process", 4096, NULL, 5, NULL);
+    if (xTaskCreate(adc_data_process_task, "adc_data_process", 4096, NULL, 5, &adc_process_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create ADC data processing task");
+        adc_continuous_running = false;
+        adc_process_task = NULL;
+        adc_continuous_stop(adc_handle);
+        return ESP_ERR_NO_MEM;
+    }
     
     ESP_LOGI(TAG, "ADC DMA Continuous Mode started");
     return ESP_OK;
@@ -267,26 +606,103 @@ esp_err_t adc_dma_continuous_stop(void)
         return ret;
     }
     
+    // 처리 태스크는 큐 대기(최대 100 ms)를 마치고 끝남. 그 뒤로는 링에 쓰는 쪽이 없음
+    while (adc_process_task != NULL) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    
     ESP_LOGI(TAG, "ADC DMA Continuous Mode stopped");
     return ESP_OK;
 }
 
-// ADC 데이터 가져오기
+// ADC 샘플 스냅샷 (복사 없음)
+esp_err_t adc_dma_get_snapshot(uint32_t count, adc_ring_view_t *view)
+{
+    if (view == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    adc_ring_t *ring = adc_ring_ref();
+    if (ring == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!adc_ring_snapshot(ring, count, view)) {
+        adc_ring_release(ring);
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+// start_seq 이후 새로 들어온 샘플 뷰 (복사 없음)
+esp_err_t adc_dma_get_view_since(uint32_t start_seq, adc_ring_view_t *view)
+{
+    if (view == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    adc_ring_t *ring = adc_ring_ref();
+    if (ring == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!adc_ring_view_since(ring, start_seq, view)) {
+        adc_ring_release(ring);
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+// 뷰 반환 (읽기 끝). 읽는 동안 덮어써지지 않았으면 true
+bool adc_dma_put_view(const adc_ring_view_t *view)
+{
+    bool valid = adc_ring_view_valid(view);
+    adc_ring_release(view->ring);
+    return valid;
+}
+
+// 지금까지 기록된 샘플 쌍 누적 개수
+uint32_t adc_dma_get_write_seq(void)
+{
+    return adc_ring_write_seq(adc_ring_get());
+}
+
+// 샘플 끊김 횟수와 마지막으로 끊긴 위치
+uint32_t adc_dma_get_gaps(uint32_t *gap_seq)
+{
+    return adc_ring_gaps(adc_ring_get(), gap_seq);
+}
+
+// 마지막으로 기록한 위치의 시각
+void adc_dma_get_time_anchor(uint32_t *seq, int64_t *time_us, uint32_t *gaps)
+{
+    uint32_t v0, v1;
+    do {
+        v0 = atomic_load_explicit(&adc_anchor_version, memory_order_acquire);
+        *seq = adc_anchor_seq;
+        *time_us = adc_anchor_time_us;
+        *gaps = adc_anchor_gaps;
+        atomic_thread_fence(memory_order_acquire);
+        v1 = atomic_load_explicit(&adc_anchor_version, memory_order_relaxed);
+    } while (v0 != v1 || (v0 & 1) != 0);
+}
+
+// ADC 데이터 가져오기 (최신 ADC_BUFFER_SIZE개를 시간 순서대로 복사)
 esp_err_t adc_dma_get_data(uint32_t *channel_0_data, uint32_t *channel_1_data, uint32_t *data_count)
 {
-    if (xSemaphoreTake(adc_data_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        if (adc_data.buffer_full) {
-            memcpy(channel_0_data, adc_data.channel_0_data, ADC_BUFFER_SIZE * sizeof(uint32_t));
-            memcpy(channel_1_data, adc_data.channel_1_data, ADC_BUFFER_SIZE * sizeof(uint32_t));
-            *data_count = ADC_BUFFER_SIZE;
-            adc_data.buffer_full = false;
-        } else {
-            memcpy(channel_0_data, adc_data.channel_0_data, adc_data.buffer_index * sizeof(uint32_t));
-            memcpy(channel_1_data, adc_data.channel_1_data, adc_data.buffer_index * sizeof(uint32_t));
-            *data_count = adc_data.buffer_index;
+    // 복사 도중 덮어써지면 한 번 더 시도
+    for (int attempt = 0; attempt < 2; attempt++) {
+        adc_ring_view_t view;
+        if (adc_dma_get_snapshot(ADC_BUFFER_SIZE, &view) != ESP_OK) {
+            *data_count = 0;
+            return ESP_OK;
+        }
+        
+        for (uint32_t i = 0; i < view.count; i++) {
+            channel_0_data[i] = adc_ring_view_at(&view, 0, i);
+            channel_1_data[i] = adc_ring_view_at(&view, 1, i);
+        }
+        
+        if (adc_dma_put_view(&view)) {
+            *data_count = view.count;
+            return ESP_OK;
         }
-        xSemaphoreGive(adc_data_mutex);
-        return ESP_OK;
     }
     
     return ESP_ERR_TIMEOUT;
@@ -295,69 +711,232 @@ esp_err_t adc_dma_get_data(uint32_t *channel_0_data, uint32_t *channel_1_data, u
 // ADC 최신 값 가져오기 (캘리브레이션 적용)
 esp_err_t adc_dma_get_latest_voltage(uint32_t *voltage_ch0_mv, uint32_t *voltage_ch1_mv)
 {
-    if (xSemaphoreTake(adc_data_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        if (adc_data.buffer_index > 0) {
-            uint32_t latest_ch0 = adc_data.channel_0_data[adc_data.buffer_index - 1];
-            uint32_t latest_ch1 = adc_data.channel_1_data[adc_data.buffer_index - 1];
-            
-            // 캘리브레이션 적용
-            if (adc1_cali_handle) {
-                int voltage0, voltage1;
-                adc_cali_raw_to_voltage(adc1_cali_handle, latest_ch0, &voltage0);
-                adc_cali_raw_to_voltage(adc1_cali_handle, latest_ch1, &voltage1);
-                *voltage_ch0_mv = voltage0;
-                *voltage_ch1_mv = voltage1;
-            } else {
-                // 캘리브레이션 없이 대략적인 변환
-                *voltage_ch0_mv = (latest_ch0 * 3300) / 4095;
-                *voltage_ch1_mv = (latest_ch1 * 3300) / 4095;
-            }
-            xSemaphoreGive(adc_data_mutex);
-            return ESP_OK;
-        }
-        xSemaphoreGive(adc_data_mutex);
+    adc_ring_view_t view;
+    if (adc_dma_get_snapshot(1, &view) != ESP_OK) {
+        return ESP_ERR_NOT_FOUND;
     }
     
-    return ESP_ERR_NOT_FOUND;
+    uint32_t latest_ch0 = adc_ring_view_at(&view, 0, 0);
+    uint32_t latest_ch1 = adc_ring_view_at(&view, 1, 0);
+    adc_dma_put_view(&view);
+    
+    // 캘리브레이션 직선 (init에서 adc_cali로 맞춘 값, 캘리브레이션이 없으면 0~3300mV 비례)
+    *voltage_ch0_mv = (uint32_t)(adc_calib_pin_uv(latest_ch0) / 1000);
+    *voltage_ch1_mv = (uint32_t)(adc_calib_pin_uv(latest_ch1) / 1000);
+    return ESP_OK;
 }
 
-// ADC 통계 정보 가져오기
+// ADC 통계 정보 가져오기 (마지막 측정 창 기준, 버퍼를 다시 훑지 않음)
 esp_err_t adc_dma_get_statistics(uint32_t *min_ch0, uint32_t *max_ch0, uint32_t *avg_ch0,
                                 uint32_t *min_ch1, uint32_t *max_ch1, uint32_t *avg_ch1)
 {
-    if (xSemaphoreTake(adc_data_mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        if (adc_data.buffer_index > 0) {
-            uint32_t min0 = UINT32_MAX, max0 = 0, sum0 = 0;
-            uint32_t min1 = UINT32_MAX, max1 = 0, sum1 = 0;
-            
-            for (int i = 0; i < adc_data.buffer_index; i++) {
-                uint32_t val0 = adc_data.channel_0_data[i];
-                uint32_t val1 = adc_data.channel_1_data[i];
-                
-                if (val0 < min0) min0 = val0;
-                if (val0 > max0) max0 = val0;
-                sum0 += val0;
-                
-                if (val1 < min1) min1 = val1;
-                if (val1 > max1) max1 = val1;
-                sum1 += val1;
-            }
-            
-            *min_ch0 = min0;
-            *max_ch0 = max0;
-            *avg_ch0 = sum0 / adc_data.buffer_index;
-            
-            *min_ch1 = min1;
-            *max_ch1 = max1;
-            *avg_ch1 = sum1 / adc_data.buffer_index;
-            
-            xSemaphoreGive(adc_data_mutex);
-            return ESP_OK;
+    meas_result_t r0, r1;
+    if (!meas_read(&adc_meas[0], &r0) || !meas_read(&adc_meas[1], &r1)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    
+    *min_ch0 = r0.min;
+    *max_ch0 = r0.max;
+    *avg_ch0 = (uint32_t)(r0.mean + 0.5f);
+    
+    *min_ch1 = r1.min;
+    *max_ch1 = r1.max;
+    *avg_ch1 = (uint32_t)(r1.mean + 0.5f);
+    return ESP_OK;
+}
+
+// 자동 측정 결과 (마지막 측정 창)
+esp_err_t adc_dma_get_measurement(int channel, meas_result_t *result)
+{
+    if (channel < 0 || channel >= ADC_CHANNEL_NUM || result == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!meas_read(&adc_meas[channel], result)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+// 채널당 샘플레이트
+uint32_t adc_dma_get_sample_rate_hz(void)
+{
+    return ADC_CHANNEL_SAMPLE_HZ;
+}
+
+// 트리거 비교기 엣지 ISR - 시각만 넘기고 시퀀스 보정은 상태 머신이 처리
+static void IRAM_ATTR trig_isr_handler(void *arg)
+{
+    (void)arg;
+    acq_on_trigger(&adc_acq, esp_timer_get_time());
+}
+
+// 트리거 획득 설정 (획득 정지 상태로 바뀜)
+// 처리 태스크와 트리거 ISR이 쓰는 중인 상태를 직접 바꾸지 않고, 처리 태스크가 프레임 사이에서 반영할 때까지 대기
+esp_err_t adc_dma_acq_configure(adc_acq_mode_t mode, uint32_t record_length, uint8_t trigger_pos_pct,
+                                uint32_t holdoff_us, uint32_t auto_timeout_us)
+{
+    acq_config_t cfg = {
+        .mode = (acq_mode_t)mode,
+        .record_length = record_length,
+        .trigger_pos_pct = trigger_pos_pct,
+        .holdoff_us = holdoff_us,
+        .auto_timeout_us = auto_timeout_us,
+        .sample_rate_hz = ADC_CHANNEL_SAMPLE_HZ,
+    };
+    
+    if (record_length == 0 || record_length > adc_dma_acq_max_length()) {
+        ESP_LOGE(TAG, "Acquisition record %lu exceeds capture memory", (unsigned long)record_length);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (trigger_pos_pct > 100) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load_explicit(&adc_acq_pending, memory_order_acquire)) {
+        return ESP_ERR_INVALID_STATE;   // 이전 설정을 아직 반영하지 않음
+    }
+    
+    adc_acq_pending_cfg = cfg;
+    atomic_store_explicit(&adc_acq_pending, true, memory_order_release);
+    for (int waited = 0; adc_process_task != NULL && atomic_load_explicit(&adc_acq_pending, memory_order_acquire);
+         waited += 10) {
+        if (waited >= ADC_ACQ_CONFIG_TIMEOUT_MS) {
+            ESP_LOGE(TAG, "Acquisition config not picked up by the processing task");
+            return ESP_ERR_TIMEOUT;
         }
-        xSemaphoreGive(adc_data_mutex);
+        vTaskDelay(pdMS_TO_TICKS(10));
     }
+    // 처리 태스크가 없으면 여기서 반영 (트리거 ISR만 동시에 돌 수 있음)
+    acq_config_process();
+    return ESP_OK;
+}
+
+// 트리거 획득 레코드 최대 길이 (캡처 메모리 - DMA 프레임 여유분 - 고정된 레코드를 읽을 여유)
+uint32_t adc_dma_acq_max_length(void)
+{
+    return adc_record_length - ADC_RING_GUARD - ADC_RECORD_MARGIN;
+}
+
+// 트리거 획득 시작 (무장)
+esp_err_t adc_dma_acq_start(void)
+{
+    if (adc_acq.cfg.record_length == 0 || atomic_load_explicit(&adc_acq_pending, memory_order_acquire)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (adc_acq.cfg.record_length > adc_dma_acq_max_length()) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    acq_arm(&adc_acq, adc_ring_write_seq(adc_ring_get()), esp_timer_get_time());
+    return ESP_OK;
+}
+
+// 트리거 획득 정지 (링은 계속 갱신)
+void adc_dma_acq_stop(void)
+{
+    acq_stop(&adc_acq);
+}
+
+bool adc_dma_acq_is_running(void)
+{
+    return acq_get_state(&adc_acq) != ACQ_STATE_IDLE;
+}
+
+// 고정된 레코드 뷰 (트리거 지점 인덱스 포함)
+bool adc_dma_acq_get_record(adc_ring_view_t *view, uint32_t *trigger_index)
+{
+    uint32_t start_seq, length;
     
-    return ESP_ERR_NOT_FOUND;
+    if (!acq_get_record(&adc_acq, &start_seq, &length, trigger_index)) {
+        return false;
+    }
+    adc_ring_t *ring = adc_ring_ref();
+    if (ring == NULL) {
+        return false;
+    }
+    adc_ring_view_range(ring, start_seq, length, view);
+    return true;
+}
+
+// 레코드 사용 완료 - NORMAL/AUTO는 재무장, SINGLE은 정지
+void adc_dma_acq_release(void)
+{
+    acq_release(&adc_acq, adc_ring_write_seq(adc_ring_get()), esp_timer_get_time());
+}
+
+// 하드웨어 트리거 소스 선택 (TRIG0/TRIG1 비교기 출력 엣지 인터럽트)
+esp_err_t adc_dma_set_trigger_source(adc_trig_source_t source, bool falling_edge)
+{
+    // 기존 소스 해제
+    if (adc_trig_gpio >= 0) {
+        gpio_isr_handler_remove(adc_trig_gpio);
+        adc_trig_gpio = -1;
+    }
+    if (source == ADC_TRIG_SOURCE_NONE) {
+        return ESP_OK;
+    }
+    
+    int gpio = (source == ADC_TRIG_SOURCE_TRIG0) ? GPIO_TRIG0 : GPIO_TRIG1;
+    gpio_config_t io_conf = {
+        .pin_bit_mask = (1ULL << gpio),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = falling_edge ? GPIO_INTR_NEGEDGE : GPIO_INTR_POSEDGE,
+    };
+    esp_err_t ret = gpio_config(&io_conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Trigger GPIO config failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    // 인터럽트 서비스 설치 (이미 설치되어 있을 수 있음)
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO ISR service install failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    ret = gpio_isr_handler_add(gpio, trig_isr_handler, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Trigger ISR handler add failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    adc_trig_gpio = gpio;
+    ESP_LOGI(TAG, "Hardware trigger on GPIO%d (%s edge)", gpio, falling_edge ? "falling" : "rising");
+    return ESP_OK;
+}
+
+// 소프트웨어 트리거 설정 (channel: 0/1, cfg NULL이면 해제). 다음 DMA 프레임부터 적용
+esp_err_t adc_dma_set_soft_trigger(int channel, const soft_trig_config_t *cfg)
+{
+    if (cfg != NULL) {
+        soft_trig_t check;
+        if (channel < 0 || channel >= ADC_CHANNEL_NUM || !soft_trig_init(&check, cfg)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        soft_trig_pending_cfg = *cfg;
+        soft_trig_pending_ch = channel;
+    } else {
+        soft_trig_pending_ch = -1;
+    }
+    atomic_store_explicit(&soft_trig_pending, true, memory_order_release);
+    return ESP_OK;
+}
+
+// 트리거 비교기 기준 전압 (GPIO25 DAC, 0~255)
+esp_err_t adc_dma_set_trigger_level(uint8_t dac_value)
+{
+    if (trig_dac_handle == NULL) {
+        dac_oneshot_config_t dac_cfg = {
+            .chan_id = DAC_TRIG_CHANNEL,
+        };
+        esp_err_t ret = dac_oneshot_new_channel(&dac_cfg, &trig_dac_handle);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Trigger DAC init failed: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    return dac_oneshot_output_voltage(trig_dac_handle, dac_value);
 }
 
 // ADC 정리
@@ -367,6 +946,13 @@ void adc_dma_continuous_deinit(void)
         adc_dma_continuous_stop();
     }
     
+    acq_stop(&adc_acq);
+    adc_dma_set_trigger_source(ADC_TRIG_SOURCE_NONE, false);
+    if (trig_dac_handle) {
+        dac_oneshot_del_channel(trig_dac_handle);
+        trig_dac_handle = NULL;
+    }
+    
     if (adc_handle) {
         adc_continuous_deinit(adc_handle);
         adc_handle = NULL;
@@ -377,15 +963,16 @@ void adc_dma_continuous_deinit(void)
         adc1_cali_handle = NULL;
     }
     
-    if (adc_data_mutex) {
-        vSemaphoreDelete(adc_data_mutex);
-        adc_data_mutex = NULL;
-    }
-    
     if (adc_queue) {
         vQueueDelete(adc_queue);
         adc_queue = NULL;
     }
     
+    // 소비자가 뷰를 모두 돌려준 뒤 해제 (끝내 안 돌려주면 읽던 메모리를 해제하지 않고 남김)
+    if (adc_record_mem != NULL && adc_ring_drain(adc_ring_get())) {
+        heap_caps_free(adc_record_mem);
+    }
+    adc_record_mem = NULL;
+    
     ESP_LOGI(TAG, "ADC DMA Continuous Mode deinitialized");
 }
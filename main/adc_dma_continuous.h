@@ -3,31 +3,129 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
+#include "adc_ring.h"
+#include "soft_trigger.h"
+#include "measure.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// 레코드 길이 (채널당 샘플 수, 2의 거듭제곱)
+#define ADC_RECORD_LENGTH_MIN       1024
+#define ADC_RECORD_LENGTH_MAX       65536
+#define ADC_RECORD_LENGTH_DEFAULT   4096
+
+// 채널당 샘플레이트 (Hz). 두 채널을 번갈아 변환하므로 ADC 변환 속도는 이것의 두 배
+#define ADC_CHANNEL_SAMPLE_HZ       10000
+
+// 트리거 획득 모드 (acquisition.h의 acq_mode_t와 같은 값)
+typedef enum {
+    ADC_ACQ_MODE_NORMAL = 0,
+    ADC_ACQ_MODE_AUTO,
+    ADC_ACQ_MODE_SINGLE,
+} adc_acq_mode_t;
+
+// 하드웨어 트리거 소스
+typedef enum {
+    ADC_TRIG_SOURCE_NONE = 0,
+    ADC_TRIG_SOURCE_TRIG0,      // GPIO9 비교기 출력
+    ADC_TRIG_SOURCE_TRIG1,      // GPIO10 비교기 출력
+} adc_trig_source_t;
+
 // ADC DMA Continuous Mode 초기화
 esp_err_t adc_dma_continuous_init(void);
 
+// 레코드 길이 설정 (1K~64K, 2의 거듭제곱). 정지 상태에서만 가능하며
+// PSRAM이 있으면 PSRAM, 없으면 내부 DRAM에 채널당 16비트로 할당한다.
+// 스냅샷으로 한 번에 읽을 수 있는 양은 DMA 프레임 1개 분량만큼 적다.
+// 소비자가 들고 있는 뷰를 모두 돌려받은 뒤 바꾸며, 1초 안에 안 돌아오면 ESP_ERR_INVALID_STATE.
+esp_err_t adc_dma_set_record_length(uint32_t points);
+
+// 현재 레코드 길이
+uint32_t adc_dma_get_record_length(void);
+
+// 레코드 길이에 필요한 캡처 메모리 (바이트, 전 채널 합계)
+size_t adc_dma_record_memory_bytes(uint32_t points);
+
+// 현재 힙 상태에서 할당 가능한 최대 레코드 길이
+uint32_t adc_dma_get_max_record_length(void);
+
 // ADC DMA Continuous Mode 시작
 esp_err_t adc_dma_continuous_start(void);
 
-// ADC DMA Continuous Mode 정지
+// ADC DMA Continuous Mode 정지 (처리 태스크가 끝날 때까지 기다림)
 esp_err_t adc_dma_continuous_stop(void);
 
 // ADC 데이터 가져오기 (버퍼 전체)
 esp_err_t adc_dma_get_data(uint32_t *channel_0_data, uint32_t *channel_1_data, uint32_t *data_count);
 
-// ADC 최신 값 가져오기 (캘리브레이션 적용된 전압값)
+// ADC 샘플 스냅샷 가져오기 (복사 없이 링버퍼를 직접 가리킴, 뮤텍스 없음)
+// ESP_OK로 얻은 뷰는 캡처 메모리 참조를 쥐고 있으므로 다 읽은 뒤 반드시 adc_dma_put_view()로 돌려줄 것
+esp_err_t adc_dma_get_snapshot(uint32_t count, adc_ring_view_t *view);
+
+// start_seq 이후 새로 들어온 샘플 뷰 (이미 덮어써진 부분은 잘라냄, 돌려주는 규칙은 스냅샷과 같음)
+esp_err_t adc_dma_get_view_since(uint32_t start_seq, adc_ring_view_t *view);
+
+// 뷰 반환 (읽기 끝). 읽는 동안 덮어써지지 않았으면 true (adc_ring_view_valid)
+bool adc_dma_put_view(const adc_ring_view_t *view);
+
+// 지금까지 기록된 샘플 쌍 누적 개수 (쓰기 시퀀스)
+uint32_t adc_dma_get_write_seq(void);
+
+// 샘플이 끊긴 횟수(DMA 프레임 유실, 재시작)와 마지막으로 끊긴 위치. 횟수가 바뀌면 gap_seq 앞과 이어지지 않음
+uint32_t adc_dma_get_gaps(uint32_t *gap_seq);
+
+// 처리 태스크가 마지막으로 기록한 위치의 (시퀀스, 시각)과 그때의 끊김 횟수 (DMA 프레임마다 갱신)
+// 같은 끊김 횟수 안에서는 샘플 시각 = time_us - (seq - 샘플 시퀀스) / 샘플레이트
+void adc_dma_get_time_anchor(uint32_t *seq, int64_t *time_us, uint32_t *gaps);
+
+// ADC 최신 값 가져오기 (캘리브레이션 적용된 ADC 핀 전압값)
+// 프로브 전압은 adc_calib_convert()로 블록 단위 변환 (감쇠/오프셋 포함)
 esp_err_t adc_dma_get_latest_voltage(uint32_t *voltage_ch0_mv, uint32_t *voltage_ch1_mv);
 
-// ADC 통계 정보 가져오기 (최소, 최대, 평균값)
+// ADC 통계 정보 가져오기 (최소, 최대, 평균값 - 마지막 측정 창)
 esp_err_t adc_dma_get_statistics(uint32_t *min_ch0, uint32_t *max_ch0, uint32_t *avg_ch0,
                                 uint32_t *min_ch1, uint32_t *max_ch1, uint32_t *avg_ch1);
 
+// 자동 측정 결과 (Vpp, RMS, 주파수, 듀티, 상승/하강 시간 등, 200 ms 창마다 갱신, 락 없음)
+// 진폭은 raw 카운트 - 전압은 adc_calib로 변환. 아직 결과가 없으면 ESP_ERR_NOT_FOUND
+esp_err_t adc_dma_get_measurement(int channel, meas_result_t *result);
+
+// 채널당 샘플레이트 (Hz)
+uint32_t adc_dma_get_sample_rate_hz(void);
+
+// 트리거 획득 설정 (정지 상태로 바뀜). record_length는 adc_dma_acq_max_length() 이하
+// 처리 태스크가 돌고 있으면 다음 프레임 사이에서 반영될 때까지 기다림 (반영 못 하면 ESP_ERR_TIMEOUT,
+// 그동안 adc_dma_acq_start()와 다른 설정은 ESP_ERR_INVALID_STATE)
+esp_err_t adc_dma_acq_configure(adc_acq_mode_t mode, uint32_t record_length, uint8_t trigger_pos_pct,
+                                uint32_t holdoff_us, uint32_t auto_timeout_us);
+
+// 트리거 획득 레코드 최대 길이 (채널당 포인트, 캡처 메모리 - DMA 프레임 1개 - 50 ms 읽기 여유)
+uint32_t adc_dma_acq_max_length(void);
+
+// 트리거 획득 시작/정지
+esp_err_t adc_dma_acq_start(void);
+void adc_dma_acq_stop(void);
+bool adc_dma_acq_is_running(void);
+
+// 트리거로 고정된 레코드 가져오기 (없으면 false). 다 읽으면 adc_dma_put_view()로 뷰를 돌려주고
+// (고정된 동안에도 링은 계속 기록되므로 false면 덮어써진 것) adc_dma_acq_release() 호출
+bool adc_dma_acq_get_record(adc_ring_view_t *view, uint32_t *trigger_index);
+void adc_dma_acq_release(void);
+
+// 하드웨어 트리거 소스 (비교기 출력 엣지 인터럽트)
+esp_err_t adc_dma_set_trigger_source(adc_trig_source_t source, bool falling_edge);
+
+// 소프트웨어 트리거 (비교기가 없는 채널용, 링에 기록된 샘플을 스캔)
+// channel: 0/1, cfg가 NULL이면 해제. 하드웨어 트리거와 함께 쓰면 먼저 온 쪽이 적용됨
+esp_err_t adc_dma_set_soft_trigger(int channel, const soft_trig_config_t *cfg);
+
+// 트리거 비교기 기준 전압 (GPIO25 DAC 출력, 0~255)
+esp_err_t adc_dma_set_trigger_level(uint8_t dac_value);
+
 // ADC DMA Continuous Mode 정리
 void adc_dma_continuous_deinit(void);
 
@@ -0,0 +1,238 @@
+#include <string.h>
+#include "adc_ring.h"
+
+// 링 초기화
+bool adc_ring_init(adc_ring_t *ring, uint16_t *ch0, uint16_t *ch1, uint32_t capacity, uint32_t guard)
+{
+    if (ring == NULL || ch0 == NULL || ch1 == NULL) {
+        return false;
+    }
+    // capacity는 2의 거듭제곱이어야 마스크로 인덱싱 가능
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 || guard == 0 || guard >= capacity) {
+        return false;
+    }
+
+    ring->data[0] = ch0;
+    ring->data[1] = ch1;
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    ring->guard = guard;
+    atomic_store_explicit(&ring->write_seq, 0, memory_order_release);
+    atomic_store_explicit(&ring->filled, 0, memory_order_release);
+    atomic_store_explicit(&ring->retired, false, memory_order_release);
+    atomic_store_explicit(&ring->gap_seq, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->gap_count, 0, memory_order_release);
+    atomic_fetch_add_explicit(&ring->generation, 1, memory_order_release);
+    return true;
+}
+
+// 링 비우기
+void adc_ring_reset(adc_ring_t *ring)
+{
+    memset(ring->data[0], 0, ring->capacity * sizeof(uint16_t));
+    memset(ring->data[1], 0, ring->capacity * sizeof(uint16_t));
+    atomic_store_explicit(&ring->write_seq, 0, memory_order_release);
+    atomic_store_explicit(&ring->filled, 0, memory_order_release);
+    atomic_store_explicit(&ring->gap_seq, 0, memory_order_relaxed);
+    atomic_store_explicit(&ring->gap_count, 0, memory_order_release);
+}
+
+// 링 폐기 표시
+// 참조와 순서가 엇갈리지 않도록 seq_cst: 폐기 쪽이 readers 0을 봤다면 그 뒤 참조하는 소비자는 retired를 본다
+void adc_ring_set_retired(adc_ring_t *ring, bool retired)
+{
+    atomic_store_explicit(&ring->retired, retired, memory_order_seq_cst);
+}
+
+// [소비자] 참조
+bool adc_ring_acquire(adc_ring_t *ring)
+{
+    atomic_fetch_add_explicit(&ring->readers, 1, memory_order_seq_cst);
+    if (atomic_load_explicit(&ring->retired, memory_order_seq_cst)) {
+        atomic_fetch_sub_explicit(&ring->readers, 1, memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+// [소비자] 참조 해제 (읽기가 끝난 뒤)
+void adc_ring_release(const adc_ring_t *ring)
+{
+    atomic_fetch_sub_explicit(&((adc_ring_t *)ring)->readers, 1, memory_order_release);
+}
+
+uint32_t adc_ring_readers(const adc_ring_t *ring)
+{
+    return atomic_load_explicit(&((adc_ring_t *)ring)->readers, memory_order_seq_cst);
+}
+
+// [생산자] 끊김 표시 (위치를 먼저 쓰고 횟수로 공개)
+void adc_ring_mark_gap(adc_ring_t *ring)
+{
+    uint32_t seq = atomic_load_explicit(&ring->write_seq, memory_order_relaxed);
+    atomic_store_explicit(&ring->gap_seq, seq, memory_order_relaxed);
+    atomic_fetch_add_explicit(&ring->gap_count, 1, memory_order_release);
+}
+
+// [소비자] 끊김 횟수와 마지막 위치 (그 사이 또 끊기면 위치가 더 새것일 수 있으나 횟수도 다음에 바뀜)
+uint32_t adc_ring_gaps(const adc_ring_t *ring, uint32_t *gap_seq)
+{
+    uint32_t count = atomic_load_explicit(&((adc_ring_t *)ring)->gap_count, memory_order_acquire);
+    if (gap_seq) {
+        *gap_seq = atomic_load_explicit(&((adc_ring_t *)ring)->gap_seq, memory_order_relaxed);
+    }
+    return count;
+}
+
+// [생산자] 교대로 들어오는 ch0/ch1 워드를 채널별로 분리해서 기록
+uint32_t adc_ring_write_interleaved(adc_ring_t *ring, const uint16_t *raw, uint32_t words)
+{
+    uint32_t pairs = words / 2;
+    uint32_t seq = atomic_load_explicit(&ring->write_seq, memory_order_relaxed);
+    uint32_t filled = atomic_load_explicit(&ring->filled, memory_order_relaxed);
+    uint16_t *d0 = ring->data[0];
+    uint16_t *d1 = ring->data[1];
+    uint32_t done = 0;
+
+    // guard 단위로 나눠서 공개해야 소비자의 덮어쓰기 판정이 맞는다
+    while (done < pairs) {
+        uint32_t chunk = pairs - done;
+        if (chunk > ring->guard) {
+            chunk = ring->guard;
+        }
+
+        const uint16_t *src = raw + done * 2;
+        uint32_t idx = seq & ring->mask;
+        for (uint32_t i = 0; i < chunk; i++) {
+            d0[idx] = src[0] & ADC_RING_SAMPLE_MASK;  // 12비트 ADC 값
+            d1[idx] = src[1] & ADC_RING_SAMPLE_MASK;
+            src += 2;
+            idx = (idx + 1) & ring->mask;
+        }
+
+        seq += chunk;
+        done += chunk;
+        // 샘플 기록이 끝난 뒤 시퀀스 공개
+        atomic_store_explicit(&ring->write_seq, seq, memory_order_release);
+        // 채운 양은 시퀀스 뒤에 공개 (소비자는 filled를 먼저 읽으므로 실제보다 크게 보지 않음)
+        if (filled < ring->capacity) {
+            filled = (ring->capacity - filled > chunk) ? filled + chunk : ring->capacity;
+            atomic_store_explicit(&ring->filled, filled, memory_order_release);
+        }
+    }
+
+    return pairs;
+}
+
+// 생산자가 다음에 건드릴 수 있는 영역을 제외한 읽기 가능 샘플 수
+// filled를 write_seq보다 먼저 읽어야 아직 공개 안 된 양을 세지 않는다
+static uint32_t adc_ring_readable(const adc_ring_t *ring, uint32_t filled)
+{
+    uint32_t limit = ring->capacity - ring->guard;
+    return (filled < limit) ? filled : limit;
+}
+
+static uint32_t adc_ring_filled(const adc_ring_t *ring)
+{
+    return atomic_load_explicit(&((adc_ring_t *)ring)->filled, memory_order_acquire);
+}
+
+// [소비자] 최신 count개 샘플 뷰
+bool adc_ring_snapshot(const adc_ring_t *ring, uint32_t count, adc_ring_view_t *view)
+{
+    uint32_t readable = adc_ring_readable(ring, adc_ring_filled(ring));
+    uint32_t write_seq = adc_ring_write_seq(ring);
+
+    if (count > readable) {
+        count = readable;
+    }
+
+    view->ring = ring;
+    view->start_seq = write_seq - count;
+    view->count = count;
+    view->generation = atomic_load_explicit(&((adc_ring_t *)ring)->generation, memory_order_relaxed);
+    return count > 0;
+}
+
+// [소비자] start_seq 이후 새로 들어온 샘플 뷰
+bool adc_ring_view_since(const adc_ring_t *ring, uint32_t start_seq, adc_ring_view_t *view)
+{
+    uint32_t readable = adc_ring_readable(ring, adc_ring_filled(ring));
+    uint32_t write_seq = adc_ring_write_seq(ring);
+    uint32_t pending = write_seq - start_seq;
+
+    // 너무 오래된 위치는 이미 덮어써졌으므로 읽을 수 있는 만큼만
+    if (pending > readable) {
+        pending = readable;
+    }
+
+    view->ring = ring;
+    view->start_seq = write_seq - pending;
+    view->count = pending;
+    view->generation = atomic_load_explicit(&((adc_ring_t *)ring)->generation, memory_order_relaxed);
+    return pending > 0;
+}
+
+// [소비자] 위치를 아는 구간의 뷰
+void adc_ring_view_range(const adc_ring_t *ring, uint32_t start_seq, uint32_t count, adc_ring_view_t *view)
+{
+    view->ring = ring;
+    view->start_seq = start_seq;
+    view->count = count;
+    view->generation = atomic_load_explicit(&((adc_ring_t *)ring)->generation, memory_order_relaxed);
+}
+
+// [소비자] 뷰를 다 읽은 뒤 유효성 확인
+bool adc_ring_view_valid(const adc_ring_view_t *view)
+{
+    const adc_ring_t *ring = view->ring;
+
+    // 데이터 읽기가 시퀀스 재확인보다 먼저 끝나도록 보장
+    atomic_thread_fence(memory_order_acquire);
+    uint32_t write_seq = atomic_load_explicit(&((adc_ring_t *)ring)->write_seq, memory_order_relaxed);
+    if (atomic_load_explicit(&((adc_ring_t *)ring)->retired, memory_order_relaxed) ||
+        atomic_load_explicit(&((adc_ring_t *)ring)->generation, memory_order_relaxed) != view->generation) {
+        return false;
+    }
+
+    // 생산자는 최대 guard개까지 공개 전에 미리 기록할 수 있다
+    return (write_seq + ring->guard - view->start_seq) <= ring->capacity;
+}
+
+// [소비자] 뷰를 연속 구간 두 개로 분리
+void adc_ring_view_segments(const adc_ring_view_t *view, int ch,
+                            const uint16_t **p0, uint32_t *n0,
+                            const uint16_t **p1, uint32_t *n1)
+{
+    const adc_ring_t *ring = view->ring;
+    uint32_t start = view->start_seq & ring->mask;
+    uint32_t first = ring->capacity - start;
+
+    if (first > view->count) {
+        first = view->count;
+    }
+
+    *p0 = ring->data[ch] + start;
+    *n0 = first;
+    *p1 = ring->data[ch];
+    *n1 = view->count - first;
+}
+
+// [소비자] 뷰 데이터를 시간 순서대로 복사
+uint32_t adc_ring_view_copy(const adc_ring_view_t *view, int ch, uint16_t *dst, uint32_t max_count)
+{
+    const uint16_t *p0, *p1;
+    uint32_t n0, n1;
+
+    adc_ring_view_segments(view, ch, &p0, &n0, &p1, &n1);
+    if (n0 > max_count) {
+        n0 = max_count;
+    }
+    if (n1 > max_count - n0) {
+        n1 = max_count - n0;
+    }
+
+    memcpy(dst, p0, n0 * sizeof(uint16_t));
+    memcpy(dst + n0, p1, n1 * sizeof(uint16_t));
+    return n0 + n1;
+}
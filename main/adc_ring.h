@@ -0,0 +1,117 @@
+#ifndef ADC_RING_H
+#define ADC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ADC 샘플 링버퍼 (단일 생산자 / 단일 소비자, 락 없음)
+//
+// - 생산자: adc_data_process_task 하나만 adc_ring_write_interleaved()를 호출한다.
+// - 소비자: adc_ring_snapshot()으로 최신 구간의 "뷰"를 얻어 링 메모리를 직접 읽고,
+//   다 읽은 뒤 adc_ring_view_valid()로 그 사이에 덮어써지지 않았는지 확인한다.
+// - write_seq는 지금까지 기록된 샘플 쌍(채널0+채널1)의 누적 개수이며
+//   32비트에서 자연스럽게 wrap 된다 (모든 비교는 부호 없는 차이로 한다).
+//   링이 아직 덜 찼는지는 write_seq 값이 아니라 filled(capacity에서 멈추는 누적 개수)로 본다.
+// - 메모리를 바꾸거나 해제하는 쪽은 adc_ring_set_retired()로 새 참조를 막고 adc_ring_readers()가 0이 될 때까지
+//   기다린다. 링 메모리를 다른 태스크에서 읽는 소비자는 adc_ring_acquire()/adc_ring_release()로 감싼다.
+//   뷰에는 링 세대가 들어가므로 같은 구조체를 다시 초기화한 뒤에는 예전 뷰가 유효로 판정되지 않는다.
+// - 생산자가 기록 사이에 샘플을 잃으면(DMA 프레임 유실, 재시작) adc_ring_mark_gap()으로 끊긴 위치를
+//   공개한다. 시퀀스는 이어지므로 소비자는 adc_ring_gaps()의 횟수가 바뀌었는지 보고 끊김을 안다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define ADC_RING_CHANNELS       2
+#define ADC_RING_SAMPLE_MASK    0x0FFF  // 12비트 ADC 값
+
+typedef struct {
+    uint16_t *data[ADC_RING_CHANNELS];  // 채널별 샘플 배열 (capacity 개)
+    uint32_t capacity;                  // 2의 거듭제곱
+    uint32_t mask;                      // capacity - 1
+    uint32_t guard;                     // 한 번에 공개되는 최대 샘플 수 (덮어쓰기 여유분)
+    _Atomic uint32_t write_seq;         // 공개된 샘플 쌍 누적 개수
+    _Atomic uint32_t filled;            // 기록된 샘플 쌍 수 (capacity에서 멈춤, write_seq 뒤에 공개)
+    _Atomic bool retired;               // 메모리를 곧 해제함 (새 참조 불가, 이 링의 뷰는 모두 무효)
+    _Atomic uint32_t readers;           // 링 메모리를 읽고 있는 소비자 수 (adc_ring_acquire)
+    _Atomic uint32_t generation;        // 초기화할 때마다 증가 (뷰와 비교)
+    _Atomic uint32_t gap_count;         // 샘플이 끊긴 횟수
+    _Atomic uint32_t gap_seq;           // 마지막으로 끊긴 위치 (이 시퀀스부터 새 데이터)
+} adc_ring_t;
+
+// 링의 특정 구간을 가리키는 읽기 전용 뷰 (복사 없음)
+typedef struct {
+    const adc_ring_t *ring;
+    uint32_t start_seq;     // 첫 샘플의 시퀀스 번호
+    uint32_t count;         // 샘플 수
+    uint32_t generation;    // 뷰를 만들 때의 링 세대
+} adc_ring_view_t;
+
+// 링 초기화. capacity는 2의 거듭제곱, guard는 capacity보다 작아야 한다.
+bool adc_ring_init(adc_ring_t *ring, uint16_t *ch0, uint16_t *ch1, uint32_t capacity, uint32_t guard);
+
+// 링 비우기 (생산자가 멈춘 상태에서만 호출)
+void adc_ring_reset(adc_ring_t *ring);
+
+// 링 폐기 표시 (생산자가 멈춘 뒤). 이후 adc_ring_acquire가 실패하고 이 링의 뷰는 모두 무효가 된다.
+// adc_ring_readers()가 0이 되면 메모리를 해제해도 된다. 해제를 포기하면 false로 되돌린다
+void adc_ring_set_retired(adc_ring_t *ring, bool retired);
+
+// [소비자] 링 메모리를 읽기 전에 참조 (폐기 표시된 링이면 false)
+bool adc_ring_acquire(adc_ring_t *ring);
+
+// [소비자] 참조 해제
+void adc_ring_release(const adc_ring_t *ring);
+
+// 참조 중인 소비자 수
+uint32_t adc_ring_readers(const adc_ring_t *ring);
+
+// [생산자] ch0, ch1이 교대로 들어있는 DMA 워드 배열을 채널별로 분리해 기록
+// 반환값: 기록된 샘플 쌍 수
+uint32_t adc_ring_write_interleaved(adc_ring_t *ring, const uint16_t *raw, uint32_t words);
+
+// [생산자] 다음에 기록할 샘플 앞에서 데이터가 끊겼음을 표시
+void adc_ring_mark_gap(adc_ring_t *ring);
+
+// [소비자] 끊김 횟수와 마지막으로 끊긴 위치. 횟수가 지난번과 다르면 gap_seq 앞의 데이터와 이어 붙이지 않는다
+uint32_t adc_ring_gaps(const adc_ring_t *ring, uint32_t *gap_seq);
+
+// [소비자] 최신 count개 샘플의 뷰 얻기 (읽을 수 있는 양보다 많으면 줄여서 반환)
+bool adc_ring_snapshot(const adc_ring_t *ring, uint32_t count, adc_ring_view_t *view);
+
+// [소비자] start_seq부터 최신까지의 뷰 얻기 (이미 덮어써진 부분은 잘라냄)
+bool adc_ring_view_since(const adc_ring_t *ring, uint32_t start_seq, adc_ring_view_t *view);
+
+// [소비자] 위치를 이미 아는 구간의 뷰 (트리거 레코드 등). 유효한지는 adc_ring_view_valid로 확인
+void adc_ring_view_range(const adc_ring_t *ring, uint32_t start_seq, uint32_t count, adc_ring_view_t *view);
+
+// [소비자] 뷰를 읽은 뒤 호출 - 읽는 동안 생산자가 덮어쓰지 않았으면 true
+bool adc_ring_view_valid(const adc_ring_view_t *view);
+
+// [소비자] 뷰의 채널 데이터를 연속 구간 두 개로 나눠서 반환 (wrap 지점 기준)
+// wrap이 없으면 *n1 = 0
+void adc_ring_view_segments(const adc_ring_view_t *view, int ch,
+                            const uint16_t **p0, uint32_t *n0,
+                            const uint16_t **p1, uint32_t *n1);
+
+// [소비자] 뷰의 채널 데이터를 시간 순서대로 복사
+uint32_t adc_ring_view_copy(const adc_ring_view_t *view, int ch, uint16_t *dst, uint32_t max_count);
+
+static inline uint32_t adc_ring_write_seq(const adc_ring_t *ring)
+{
+    return atomic_load_explicit(&((adc_ring_t *)ring)->write_seq, memory_order_acquire);
+}
+
+// 뷰의 i번째 샘플 (0 = 가장 오래된 샘플)
+static inline uint16_t adc_ring_view_at(const adc_ring_view_t *view, int ch, uint32_t i)
+{
+    return view->ring->data[ch][(view->start_seq + i) & view->ring->mask];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADC_RING_H
@@ -1,4 +1,5 @@
 #include "analog_test_simple.h"
+#include "adc_calib.h"
 #include "esp_log.h"
 #include "driver/i2c.h"
 #include "driver/gpio.h"
@@ -348,7 +349,7 @@ static void serial_output_task_simple(void *pvParameters) {
         for (int ch = 0; ch < ANALOG_CHANNELS; ch++) {
             int raw_value;
             adc_oneshot_read(adc1_handle, (ch == 0) ? ADC_CHANNEL_0 : ADC_CHANNEL_1, &raw_value);
-            adc_readings[ch] = (raw_value * 3300) / 4095;  // mV로 변환
+            adc_readings[ch] = adc_calib_pin_uv((uint16_t)raw_value) / 1000;  // mV로 변환
         }
         
         // 현재 설정 가져오기
@@ -440,7 +441,7 @@ esp_err_t run_analog_comprehensive_test_simple(analog_test_results_t *results) {
         for (int ch = 0; ch < ANALOG_CHANNELS; ch++) {
             int raw_value;
             adc_oneshot_read(adc1_handle, (ch == 0) ? ADC_CHANNEL_0 : ADC_CHANNEL_1, &raw_value);
-            results->adc_readings[ch] = (raw_value * 3300) / 4095;
+            results->adc_readings[ch] = adc_calib_pin_uv((uint16_t)raw_value) / 1000;
         }
         
         adc_oneshot_del_unit(adc1_handle);
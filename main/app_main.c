@@ -13,6 +13,8 @@
 #include "hardware_test.h"
 #include "interactive_test.h"
 #include "adc_dma_test.h"
+#include "render_sched.h"
+#include "sample_stream.h"
 //#include "esp_adc/adc_oneshot.h"
 //#include "esp_adc/adc_cali.h"
 //#include "esp_adc/adc_cali_scheme.h"
@@ -23,13 +25,6 @@ static const char *TAG = "SMALL_OSCILLOSCOPE";
 // FT800 핸들
 static ft800_handle_t lcd;
 
-// FT800 인터럽트 핸들러
-static void IRAM_ATTR ft800_isr_handler(void* arg) {
-    // 인터럽트 처리 로직
-    // 여기서는 간단히 플래그만 설정
-    (void)arg;  // 사용하지 않는 변수 경고 제거
-}
-
 // FT800 화면 테스트 태스크
 static void ft800_test_task(void *pvParameters) {
     ESP_LOGI(TAG, "Starting FT800 display test task");
@@ -54,49 +49,51 @@ static void ft800_test_task(void *pvParameters) {
     
     ESP_LOGI(TAG, "FT800 display test completed successfully");
     
-    // 메인 루프 - 주기적으로 색상 변경
+    // FT800 INT로 프레임 페이싱 (REG_FRAMES 폴링 대신)
+    if (render_sched_init() != ESP_OK) {
+        ESP_LOGW(TAG, "FT800 INT unavailable, pacing frames by timeout");
+    }
+    
+    // 메인 루프 - 스왑(vsync)마다 한 프레임
     int test_phase = 0;
+    uint32_t frames = 0;
     while (1) {
-		static uint32_t frames = 0;
-        uint32_t frames_old = frames;
-        frames = HOST_MEM_RD32(REG_FRAMES);
-        if(frames_old != frames)
-        {
-            lcd_start_screen(frames);
-            //ESP_LOGI(TAG, "FRAMES: %ld", frames);
+        // 앞 프레임의 스왑이 끝날 때까지 대기 (타임아웃이어도 다음 프레임은 그림)
+        render_sched_wait_frame();
+        frames++;
 
-            char str[100];
-            sprintf(str, "FRAMES: %ld", frames);
-            cmd(COLOR_RGB(0xDE,0xDE,0xDE));
-            cmd_text(10,230, 27,0, str);
-            
-            memset(str, 0, sizeof(str));
-            sprintf(str, "GPIO12 = %d", gpio_get_level(12));
-            cmd(COLOR_RGB(0xDE,0xDE,0xDE));
-            cmd_text(470,230, 26,OPT_RIGHTX, str);
+        lcd_start_screen(frames);
+        //ESP_LOGI(TAG, "FRAMES: %ld", frames);
 
-            cmd(DISPLAY());
-            cmd(CMD_SWAP);	
+        char str[100];
+        sprintf(str, "FRAMES: %ld", frames);
+        cmd(COLOR_RGB(0xDE,0xDE,0xDE));
+        cmd_text(10,230, 27,0, str);
+        
+        memset(str, 0, sizeof(str));
+        sprintf(str, "GPIO12 = %d", gpio_get_level(12));
+        cmd(COLOR_RGB(0xDE,0xDE,0xDE));
+        cmd_text(470,230, 26,OPT_RIGHTX, str);
 
-            if((frames%60) == 10){
-                //ESP_LOGI(TAG, "FRAMES: %ld", frames);
-                HOST_MEM_WR8(REG_VOL_SOUND, 0xFF);      	
-                switch((frames%180)/60){
-                    case 0:
-                        HOST_MEM_WR16(REG_SOUND, 0x50);      	//C8 MIDI xylophone
-                        break;
-                    case 1:
-                        HOST_MEM_WR16(REG_SOUND, 0x51);      	//C8 MIDI xylophone
-                        break;
-                    case 2:
-                        HOST_MEM_WR16(REG_SOUND, 0x56);      	//C8 MIDI xylophone
-                        break;
-                }
-                HOST_MEM_WR8(REG_PLAY, 1); 
+        cmd(DISPLAY());
+        cmd(CMD_SWAP);	
+
+        if((frames%60) == 10){
+            //ESP_LOGI(TAG, "FRAMES: %ld", frames);
+            HOST_MEM_WR8(REG_VOL_SOUND, 0xFF);      	
+            switch((frames%180)/60){
+                case 0:
+                    HOST_MEM_WR16(REG_SOUND, 0x50);      	//C8 MIDI xylophone
+                    break;
+                case 1:
+                    HOST_MEM_WR16(REG_SOUND, 0x51);      	//C8 MIDI xylophone
+                    break;
+                case 2:
+                    HOST_MEM_WR16(REG_SOUND, 0x56);      	//C8 MIDI xylophone
+                    break;
             }
-            
+            HOST_MEM_WR8(REG_PLAY, 1); 
         }
-        vTaskDelay(pdMS_TO_TICKS(1));
     }
 }
 
@@ -199,6 +196,11 @@ static void analog_test_task_simple(void *pvParameters) {
     }
 }
 
+// 1이면 하드웨어 테스트 후 UART로 바이너리 샘플 스트리밍 (로그는 꺼짐, host/stream_decode.py로 수신)
+#define SAMPLE_STREAM_ENABLE 0
+// 1이면 압축 프레임 (차분 + 비트 패킹, 같은 baud에서 더 높은 샘플레이트까지 여유)
+#define SAMPLE_STREAM_PACKED 1
+
 // 하드웨어 테스트 태스크
 static void hardware_test_task(void *pvParameters) {
     ESP_LOGI(TAG, "Starting complete hardware test...");
@@ -213,6 +215,13 @@ static void hardware_test_task(void *pvParameters) {
     } else {
         ESP_LOGE(TAG, "Hardware test failed: %s", esp_err_to_name(ret));
     }
+#if SAMPLE_STREAM_ENABLE
+    // 하드웨어 테스트에서 ADC DMA가 시작된 상태
+    ret = sample_stream_start(SAMPLE_STREAM_BAUD_DEFAULT, 0x03, SAMPLE_STREAM_PACKED);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Sample stream start failed: %s", esp_err_to_name(ret));
+    }
+#endif
     // 상호작용 테스트 시작
     start_interactive_test();
     
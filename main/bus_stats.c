@@ -0,0 +1,162 @@
+#include <string.h>
+#include <stdatomic.h>
+#include "bus_stats.h"
+
+// 버스별 누적 카운터 (기록하는 쪽은 여러 태스크)
+typedef struct {
+    _Atomic uint32_t transactions;
+    _Atomic uint32_t bytes;
+    _Atomic uint32_t busy_us;
+    _Atomic uint32_t max_us;        // 시작 후 최대
+    _Atomic uint32_t frame_max_us;  // 마지막 프레임 표시 후 최대 (표시할 때 0으로)
+} bus_counter_t;
+
+// 버전 카운터로 공개하는 구간 통계 (홀수 = 갱신 중)
+typedef struct {
+    _Atomic uint32_t version;
+    bus_stats_window_t pub;
+} bus_published_t;
+
+static bus_counter_t counters[BUS_STATS_COUNT];
+
+// 아래는 렌더 태스크(bus_stats_frame_mark)만 씀
+static bus_stats_t frame_base[BUS_STATS_COUNT];     // 마지막 표시 때의 누적값
+static bus_stats_window_t second_acc;               // 모으는 중인 1초
+static int64_t frame_last_us;
+static int64_t second_start_us;
+static bool frame_started;
+static uint32_t frame_index;
+static bus_published_t pub_frame;
+static bus_published_t pub_second;
+
+static void atomic_max(_Atomic uint32_t *target, uint32_t value)
+{
+    uint32_t cur = atomic_load_explicit(target, memory_order_relaxed);
+    while (value > cur && !atomic_compare_exchange_weak_explicit(target, &cur, value, memory_order_relaxed,
+                                                                  memory_order_relaxed)) {
+    }
+}
+
+void bus_stats_record(bus_stats_bus_t bus, uint32_t transactions, uint32_t bytes, uint32_t us)
+{
+    if ((unsigned)bus >= BUS_STATS_COUNT) {
+        return;
+    }
+    bus_counter_t *c = &counters[bus];
+    atomic_fetch_add_explicit(&c->transactions, transactions, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->bytes, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&c->busy_us, us, memory_order_relaxed);
+    atomic_max(&c->frame_max_us, us);
+    atomic_max(&c->max_us, us);
+}
+
+static void publish(bus_published_t *p, const bus_stats_window_t *w)
+{
+    uint32_t version = atomic_load_explicit(&p->version, memory_order_relaxed);
+    atomic_store_explicit(&p->version, version + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    p->pub = *w;
+    atomic_store_explicit(&p->version, version + 2, memory_order_release);
+}
+
+static bool read_published(const bus_published_t *p, bus_stats_window_t *out)
+{
+    bus_published_t *pp = (bus_published_t *)p;
+    for (int retry = 0; retry < 4; retry++) {
+        uint32_t v0 = atomic_load_explicit(&pp->version, memory_order_acquire);
+        if (v0 == 0) {
+            return false;
+        }
+        *out = p->pub;
+        atomic_thread_fence(memory_order_acquire);
+        uint32_t v1 = atomic_load_explicit(&pp->version, memory_order_relaxed);
+        if (v0 == v1 && (v0 & 1) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void bus_stats_frame_mark(int64_t now_us)
+{
+    bus_stats_window_t frame = { 0 };
+
+    for (int b = 0; b < BUS_STATS_COUNT; b++) {
+        bus_counter_t *c = &counters[b];
+        bus_stats_t now = {
+            .transactions = atomic_load_explicit(&c->transactions, memory_order_relaxed),
+            .bytes = atomic_load_explicit(&c->bytes, memory_order_relaxed),
+            .busy_us = atomic_load_explicit(&c->busy_us, memory_order_relaxed),
+            .max_us = atomic_exchange_explicit(&c->frame_max_us, 0, memory_order_relaxed),
+        };
+        frame.bus[b].transactions = now.transactions - frame_base[b].transactions;
+        frame.bus[b].bytes = now.bytes - frame_base[b].bytes;
+        frame.bus[b].busy_us = now.busy_us - frame_base[b].busy_us;
+        frame.bus[b].max_us = now.max_us;
+        frame_base[b] = now;
+    }
+
+    // 첫 표시는 시작점만 잡음 (그 전 구간은 초기화 등이 섞여 있음)
+    if (!frame_started) {
+        frame_started = true;
+        frame_last_us = now_us;
+        second_start_us = now_us;
+        return;
+    }
+
+    frame.index = frame_index++;
+    frame.window_us = (uint32_t)(now_us - frame_last_us);
+    frame.frames = 1;
+    frame_last_us = now_us;
+    publish(&pub_frame, &frame);
+
+    second_acc.frames++;
+    for (int b = 0; b < BUS_STATS_COUNT; b++) {
+        second_acc.bus[b].transactions += frame.bus[b].transactions;
+        second_acc.bus[b].bytes += frame.bus[b].bytes;
+        second_acc.bus[b].busy_us += frame.bus[b].busy_us;
+        if (frame.bus[b].max_us > second_acc.bus[b].max_us) {
+            second_acc.bus[b].max_us = frame.bus[b].max_us;
+        }
+    }
+    if (now_us - second_start_us >= BUS_STATS_WINDOW_US) {
+        second_acc.window_us = (uint32_t)(now_us - second_start_us);
+        publish(&pub_second, &second_acc);
+        uint32_t next_index = second_acc.index + 1;
+        memset(&second_acc, 0, sizeof(second_acc));
+        second_acc.index = next_index;
+        second_start_us = now_us;
+    }
+}
+
+bool bus_stats_get_frame(bus_stats_window_t *out)
+{
+    return read_published(&pub_frame, out);
+}
+
+bool bus_stats_get_second(bus_stats_window_t *out)
+{
+    return read_published(&pub_second, out);
+}
+
+void bus_stats_get_total(bus_stats_bus_t bus, bus_stats_t *out)
+{
+    if ((unsigned)bus >= BUS_STATS_COUNT) {
+        memset(out, 0, sizeof(*out));
+        return;
+    }
+    bus_counter_t *c = &counters[bus];
+    out->transactions = atomic_load_explicit(&c->transactions, memory_order_relaxed);
+    out->bytes = atomic_load_explicit(&c->bytes, memory_order_relaxed);
+    out->busy_us = atomic_load_explicit(&c->busy_us, memory_order_relaxed);
+    out->max_us = atomic_load_explicit(&c->max_us, memory_order_relaxed);
+}
+
+const char *bus_stats_name(bus_stats_bus_t bus)
+{
+    switch (bus) {
+    case BUS_STATS_SPI_FT800:   return "SPI";
+    case BUS_STATS_I2C_CH423:   return "I2C";
+    default:                    return "?";
+    }
+}
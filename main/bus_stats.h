@@ -0,0 +1,61 @@
+#ifndef BUS_STATS_H
+#define BUS_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 버스(SPI/I2C) 사용량 카운터
+//
+// 드라이버가 전송 한 번마다 bus_stats_record로 트랜잭션 수, 바이트, 걸린 시간(us)을 더한다.
+// 카운터는 원자 연산만 쓰므로 여러 태스크에서 불러도 되고 락이 없다.
+// 렌더 태스크가 프레임마다 bus_stats_frame_mark를 부르면 직전 표시 이후의 증가분을
+// 프레임 통계로, 1초 넘게 모인 프레임들의 합을 초당 통계로 공개한다 (버전 카운터, 읽는 쪽은 락 없음).
+// 누적값은 32비트라 넘어가지만 (시간은 약 71분) 구간 증가분은 뺄셈으로 그대로 맞다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define BUS_STATS_WINDOW_US     1000000     // 초당 통계 구간
+
+typedef enum {
+    BUS_STATS_SPI_FT800 = 0,    // FT800 SPI (주소/더미 바이트 포함)
+    BUS_STATS_I2C_CH423,        // CH423 I2C (START마다 주소 바이트 포함)
+    BUS_STATS_COUNT,
+} bus_stats_bus_t;
+
+typedef struct {
+    uint32_t transactions;      // CS 구간 / I2C 명령 링크 수
+    uint32_t bytes;
+    uint32_t busy_us;           // 호출자가 전송을 기다린 시간 합
+    uint32_t max_us;            // 호출 한 번의 최대 시간 (블록 전송은 전체)
+} bus_stats_t;
+
+typedef struct {
+    uint32_t index;             // 공개 번호 (0부터)
+    uint32_t window_us;         // 구간 길이
+    uint32_t frames;            // 구간에 든 프레임 수
+    bus_stats_t bus[BUS_STATS_COUNT];
+} bus_stats_window_t;
+
+// 전송 한 번 기록 (us: 시작부터 끝까지)
+void bus_stats_record(bus_stats_bus_t bus, uint32_t transactions, uint32_t bytes, uint32_t us);
+
+// [렌더 태스크] 프레임 끝 (CMD_SWAP 뒤). now_us는 esp_timer_get_time()
+void bus_stats_frame_mark(int64_t now_us);
+
+// 마지막 프레임 / 마지막 1초. 아직 공개된 것이 없거나 갱신과 겹쳐 못 읽으면 false
+bool bus_stats_get_frame(bus_stats_window_t *out);
+bool bus_stats_get_second(bus_stats_window_t *out);
+
+// 시작 후 누적
+void bus_stats_get_total(bus_stats_bus_t bus, bus_stats_t *out);
+
+const char *bus_stats_name(bus_stats_bus_t bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BUS_STATS_H
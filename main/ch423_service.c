@@ -0,0 +1,167 @@
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "hardware_test.h"
+#include "ch423_service.h"
+
+static const char *TAG = "CH423_SVC";
+
+#define SVC_NOTIFY_OUTPUT   (1u << 0)
+#define SVC_NOTIFY_POLL     (1u << 1)
+
+// 출력 대기 값: 비트 0~15 값, 비트 16 대기 중
+#define SVC_OUT_PENDING     (1u << 16)
+
+// 입력 스냅샷: 비트 0~7 마지막 성공 값, 비트 8 유효, 비트 9 최근 폴링 실패, 비트 10~31 게시 횟수
+#define SVC_IN_VALID        (1u << 8)
+#define SVC_IN_FAILED       (1u << 9)
+#define SVC_IN_SEQ_SHIFT    10
+
+static TaskHandle_t svc_task = NULL;
+static _Atomic uint32_t svc_out = 0;
+static _Atomic uint32_t svc_in = 0;
+static _Atomic uint32_t svc_errors = 0;
+static input_events_t svc_events;
+
+static void svc_publish_input(uint8_t data, bool ok)
+{
+    uint32_t prev = atomic_load_explicit(&svc_in, memory_order_relaxed);
+    uint32_t seq = (prev >> SVC_IN_SEQ_SHIFT) + 1;
+    uint32_t next;
+
+    if (ok) {
+        next = data | SVC_IN_VALID;
+    } else {
+        // 마지막 성공 값은 그대로 두고 실패 표시만
+        next = (prev & (0xFF | SVC_IN_VALID)) | SVC_IN_FAILED;
+    }
+    atomic_store_explicit(&svc_in, next | (seq << SVC_IN_SEQ_SHIFT), memory_order_release);
+}
+
+static void svc_note_error(const char *what, esp_err_t err, bool *failing)
+{
+    atomic_fetch_add_explicit(&svc_errors, 1, memory_order_relaxed);
+    // 계속 실패하는 동안에는 처음 한 번만 로그
+    if (!*failing) {
+        ESP_LOGW(TAG, "CH423 %s failed: %s", what, esp_err_to_name(err));
+        *failing = true;
+    }
+}
+
+static void ch423_service_task(void *pvParameters)
+{
+    (void)pvParameters;
+    bool out_failing = false;
+    bool in_failing = false;
+    int64_t last_poll = 0;
+    uint32_t poll_ms = CH423_SERVICE_POLL_MS;
+
+    while (1) {
+        uint32_t bits = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &bits, pdMS_TO_TICKS(poll_ms));
+
+        // 출력: 마지막으로 넘어온 값 하나만 씀 (바뀐 바이트만 전송)
+        uint32_t out = atomic_exchange_explicit(&svc_out, 0, memory_order_acquire);
+        if (out & SVC_OUT_PENDING) {
+            esp_err_t ret = ch423_bus_write_outputs((uint16_t)out, CH423_SERVICE_TIMEOUT_MS);
+            if (ret != ESP_OK) {
+                svc_note_error("output write", ret, &out_failing);
+                // 다음 주기에 다시 시도 (그 사이 새 값이 왔으면 그것을 씀)
+                uint32_t expected = 0;
+                atomic_compare_exchange_strong(&svc_out, &expected, out);
+            } else {
+                out_failing = false;
+            }
+        }
+
+        // 입력: 주기가 됐거나 요청이 있을 때
+        int64_t now = esp_timer_get_time();
+        if ((bits & SVC_NOTIFY_POLL) || now - last_poll >= (int64_t)poll_ms * 1000) {
+            uint8_t data = 0;
+            esp_err_t ret = ch423_bus_read_input(&data, CH423_SERVICE_TIMEOUT_MS);
+            if (ret != ESP_OK) {
+                svc_note_error("input read", ret, &in_failing);
+            } else {
+                in_failing = false;
+                input_events_feed(&svc_events, data, now);
+            }
+            svc_publish_input(data, ret == ESP_OK);
+            last_poll = now;
+            // 확정 대기 중인 비트가 있으면 빠르게
+            poll_ms = input_events_settling(&svc_events) ? CH423_SERVICE_POLL_FAST_MS : CH423_SERVICE_POLL_MS;
+        }
+    }
+}
+
+// 시작
+esp_err_t ch423_service_start(void)
+{
+    if (svc_task != NULL) {
+        return ESP_OK;
+    }
+
+    // 태스크가 뜨기 전이라 아직 이 호출자가 버스를 쓰는 유일한 곳
+    esp_err_t ret = ch423_bus_set_speed(CH423_I2C_FAST_HZ);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    input_events_init(&svc_events, CH423_DEBOUNCE_SAMPLES);
+
+    TaskHandle_t handle = NULL;
+    if (xTaskCreate(ch423_service_task, "ch423_service", 3072, NULL, 7, &handle) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create CH423 service task");
+        return ESP_ERR_NO_MEM;
+    }
+    svc_task = handle;
+    ESP_LOGI(TAG, "CH423 service started (%d kHz, poll %d/%d ms)", CH423_I2C_FAST_HZ / 1000,
+             CH423_SERVICE_POLL_MS, CH423_SERVICE_POLL_FAST_MS);
+    return ESP_OK;
+}
+
+bool ch423_service_running(void)
+{
+    return svc_task != NULL;
+}
+
+// 출력 넘기기
+void ch423_service_post_output(uint16_t value)
+{
+    atomic_store_explicit(&svc_out, value | SVC_OUT_PENDING, memory_order_release);
+    xTaskNotify(svc_task, SVC_NOTIFY_OUTPUT, eSetBits);
+}
+
+// 즉시 폴링 요청
+void ch423_service_request_poll(void)
+{
+    xTaskNotify(svc_task, SVC_NOTIFY_POLL, eSetBits);
+}
+
+// 입력 읽기
+esp_err_t ch423_service_get_input(uint8_t *data)
+{
+    uint32_t snap = atomic_load_explicit(&svc_in, memory_order_acquire);
+    if (!(snap & SVC_IN_VALID)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *data = (uint8_t)(snap & 0xFF);
+    return (snap & SVC_IN_FAILED) ? ESP_FAIL : ESP_OK;
+}
+
+// 에지 이벤트 꺼내기
+bool ch423_service_pop_event(input_event_t *event)
+{
+    return input_events_pop(&svc_events, event);
+}
+
+uint32_t ch423_service_input_seq(void)
+{
+    return atomic_load_explicit(&svc_in, memory_order_acquire) >> SVC_IN_SEQ_SHIFT;
+}
+
+uint32_t ch423_service_error_count(void)
+{
+    return atomic_load_explicit(&svc_errors, memory_order_relaxed);
+}
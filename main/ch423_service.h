@@ -0,0 +1,54 @@
+#ifndef CH423_SERVICE_H
+#define CH423_SERVICE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "input_events.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// CH423 I2C 서비스 태스크
+//
+// 시작 후에는 이 태스크만 I2C 버스를 쓴다 (400 kHz). 출력은 ch423_commit()이 넘긴
+// 최신 값 하나만 보관했다가 쓰므로(덮어쓰기) 요청이 쌓이거나 버려지지 않는다.
+// 입력은 주기적으로(또는 요청 시) 읽어 원자 변수 하나에 게시하므로 읽는 쪽은
+// 버스를 기다리지 않는다. 버스 오류가 나도 화면 루프는 멈추지 않고 마지막 값을 본다.
+// 읽은 입력은 디바운스해서 에지 이벤트(시각 포함)로도 내보낸다. 평소에는 느리게
+// 폴링하고, 어떤 비트가 바뀌기 시작하면 확정될 때까지 빠르게 폴링한다.
+// (보드에 CH423 인터럽트 선이 없어 변화 감지는 폴링으로 한다)
+
+#define CH423_I2C_FAST_HZ           400000
+#define CH423_SERVICE_POLL_MS       20      // 입력 폴링 주기 (평소)
+#define CH423_SERVICE_POLL_FAST_MS  2       // 입력 폴링 주기 (바뀌는 중)
+#define CH423_DEBOUNCE_SAMPLES      4       // 연속 일치 횟수 (빠른 주기로 약 8 ms)
+#define CH423_SERVICE_TIMEOUT_MS    10      // 트랜잭션 하나의 최대 대기
+
+// 버스 클럭을 올리고 태스크 시작 (init_ch423 이후)
+esp_err_t ch423_service_start(void);
+bool ch423_service_running(void);
+
+// 출력 값 넘기기 (이전에 넘긴 값이 아직 안 나갔으면 덮어씀)
+void ch423_service_post_output(uint16_t value);
+
+// 다음 주기를 기다리지 않고 입력을 바로 읽게 함
+void ch423_service_request_poll(void);
+
+// 마지막으로 게시된 입력 바이트. 아직 한 번도 못 읽었으면 ESP_ERR_INVALID_STATE,
+// 가장 최근 폴링이 실패했으면 ESP_FAIL (data에는 마지막으로 성공한 값)
+esp_err_t ch423_service_get_input(uint8_t *data);
+
+// 디바운스된 입력 에지 이벤트 하나 꺼내기 (UI 태스크 하나만 호출). 없으면 false
+bool ch423_service_pop_event(input_event_t *event);
+
+// 입력 게시 횟수 (새 값이 왔는지 확인용)와 누적 버스 오류 수
+uint32_t ch423_service_input_seq(void);
+uint32_t ch423_service_error_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CH423_SERVICE_H
@@ -0,0 +1,118 @@
+#include <string.h>
+#include "decimate.h"
+
+// 설정 적용
+bool decim_init(decim_t *d, decim_mode_t mode, uint32_t samples_per_column, uint32_t columns)
+{
+    if (d == NULL || samples_per_column == 0 || columns == 0 || columns > DECIM_MAX_COLUMNS) {
+        return false;
+    }
+    // 평균 모드 합계가 넘치지 않도록 (12비트 x 2^20)
+    if (samples_per_column > (1u << 20)) {
+        return false;
+    }
+
+    d->mode = mode;
+    d->samples_per_column = samples_per_column;
+    d->columns = columns;
+    decim_reset(d);
+    return true;
+}
+
+static void decim_start_column(decim_t *d)
+{
+    d->fill = 0;
+    d->cur_min = 0xFFFF;
+    d->cur_max = 0;
+    d->cur_sum = 0;
+}
+
+// 비우기
+void decim_reset(decim_t *d)
+{
+    d->head = 0;
+    d->count = 0;
+    d->total = 0;
+    decim_start_column(d);
+}
+
+// 채우던 열을 완성 열로 넘김
+static void decim_emit(decim_t *d)
+{
+    decim_column_t *c = &d->col[d->head];
+
+    if (d->mode == DECIM_MODE_AVERAGE) {
+        uint16_t avg = (uint16_t)((d->cur_sum + d->samples_per_column / 2) / d->samples_per_column);
+        c->min = avg;
+        c->max = avg;
+    } else {
+        c->min = d->cur_min;
+        c->max = d->cur_max;
+    }
+
+    d->head = (d->head + 1 == d->columns) ? 0 : d->head + 1;
+    if (d->count < d->columns) {
+        d->count++;
+    }
+    d->total++;
+    decim_start_column(d);
+}
+
+// 샘플 추가
+uint32_t decim_push(decim_t *d, const uint16_t *samples, uint32_t count)
+{
+    uint32_t emitted = 0;
+
+    while (count > 0) {
+        uint32_t take = d->samples_per_column - d->fill;
+        if (take > count) {
+            take = count;
+        }
+
+        // 열 경계 안에서는 비교/덧셈만 하는 단순 루프
+        if (d->mode == DECIM_MODE_AVERAGE) {
+            uint32_t sum = d->cur_sum;
+            for (uint32_t i = 0; i < take; i++) {
+                sum += samples[i];
+            }
+            d->cur_sum = sum;
+        } else {
+            uint16_t lo = d->cur_min;
+            uint16_t hi = d->cur_max;
+            for (uint32_t i = 0; i < take; i++) {
+                uint16_t v = samples[i];
+                lo = (v < lo) ? v : lo;
+                hi = (v > hi) ? v : hi;
+            }
+            d->cur_min = lo;
+            d->cur_max = hi;
+        }
+
+        d->fill += take;
+        samples += take;
+        count -= take;
+
+        if (d->fill == d->samples_per_column) {
+            decim_emit(d);
+            emitted++;
+        }
+    }
+
+    return emitted;
+}
+
+// 최근 완성 열 복사 (오래된 것부터)
+uint32_t decim_read(const decim_t *d, decim_column_t *out, uint32_t max)
+{
+    uint32_t n = (d->count < max) ? d->count : max;
+    // head 바로 앞이 가장 최근 열
+    uint32_t start = (d->head + d->columns - n) % d->columns;
+    uint32_t first = d->columns - start;
+
+    if (first > n) {
+        first = n;
+    }
+    memcpy(out, &d->col[start], first * sizeof(decim_column_t));
+    memcpy(out + first, &d->col[0], (n - first) * sizeof(decim_column_t));
+    return n;
+}
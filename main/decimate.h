@@ -0,0 +1,63 @@
+#ifndef DECIMATE_H
+#define DECIMATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 화면 표시용 데시메이션 (샘플 -> 픽셀 열)
+//
+// 열 하나에 samples_per_column 개의 샘플을 모아 min/max(피크 검출) 또는 평균을 만든다.
+// 샘플은 들어오는 대로 조금씩 넣으면 되고(DMA 프레임 단위), 완성된 열은 원형 배열에
+// 쌓이므로 화면은 최근 열만 읽으면 된다. 전체 레코드를 다시 훑을 필요가 없다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define DECIM_MAX_COLUMNS   480     // FT800 화면 가로 픽셀
+
+typedef enum {
+    DECIM_MODE_PEAK = 0,    // 열마다 min/max (글리치가 사라지지 않음)
+    DECIM_MODE_AVERAGE,     // 열마다 평균 (노이즈 감소, min == max == 평균)
+} decim_mode_t;
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+} decim_column_t;
+
+typedef struct {
+    decim_mode_t mode;
+    uint32_t samples_per_column;
+    uint32_t columns;                       // 보관할 열 수 (DECIM_MAX_COLUMNS 이하)
+
+    decim_column_t col[DECIM_MAX_COLUMNS];  // 완성된 열 (원형)
+    uint32_t head;                          // 다음에 완성될 열 위치
+    uint32_t count;                         // 보관 중인 완성 열 수
+    uint32_t total;                         // 누적 완성 열 수
+
+    // 채우는 중인 열
+    uint32_t fill;
+    uint16_t cur_min;
+    uint16_t cur_max;
+    uint32_t cur_sum;
+} decim_t;
+
+// 설정 적용 후 비움 (잘못된 설정이면 false)
+bool decim_init(decim_t *d, decim_mode_t mode, uint32_t samples_per_column, uint32_t columns);
+
+// 완성된 열과 채우던 열 모두 비움
+void decim_reset(decim_t *d);
+
+// 샘플 추가. 이번 호출에서 완성된 열 수 반환
+uint32_t decim_push(decim_t *d, const uint16_t *samples, uint32_t count);
+
+// 최근 완성 열을 오래된 것부터 복사 (최대 max개). 복사한 열 수 반환
+uint32_t decim_read(const decim_t *d, decim_column_t *out, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DECIMATE_H
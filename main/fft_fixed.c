@@ -0,0 +1,106 @@
+#include <math.h>
+#include "fft_fixed.h"
+
+static int16_t to_q15(float v)
+{
+    float q = v * 32768.0f;
+    return (int16_t)(q >= 32767.0f ? 32767 : q <= -32768.0f ? -32768 : lrintf(q));
+}
+
+bool fft_fixed_init(fft_fixed_t *f, uint32_t n)
+{
+    if (n < FFT_MIN_POINTS || n > FFT_MAX_POINTS || (n & (n - 1)) != 0) {
+        return false;
+    }
+    f->n = n;
+    f->log2n = 0;
+    while ((1u << f->log2n) < n) {
+        f->log2n++;
+    }
+    for (uint32_t k = 0; k < n / 2; k++) {
+        float a = 2.0f * (float)M_PI * (float)k / (float)n;
+        f->cos_q15[k] = to_q15(cosf(a));
+        f->sin_q15[k] = to_q15(sinf(a));
+    }
+    return true;
+}
+
+// 복소 m점 FFT (제자리, re/im 교대). 트위들은 N점 표에서 간격을 두고 읽음
+static void fft_complex(const fft_fixed_t *f, int32_t *z, uint32_t m)
+{
+    // 비트 역순 재배치
+    for (uint32_t i = 0, j = 0; i < m; i++) {
+        if (i < j) {
+            int32_t tr = z[2 * i], ti = z[2 * i + 1];
+            z[2 * i] = z[2 * j];
+            z[2 * i + 1] = z[2 * j + 1];
+            z[2 * j] = tr;
+            z[2 * j + 1] = ti;
+        }
+        uint32_t bit = m >> 1;
+        while (j & bit) {
+            j ^= bit;
+            bit >>= 1;
+        }
+        j |= bit;
+    }
+
+    for (uint32_t size = 2; size <= m; size <<= 1) {
+        uint32_t half = size >> 1;
+        uint32_t step = f->n / size;        // W_size^j = W_N^(j * N / size)
+
+        // j = 0: 트위들 1 (곱셈 없음)
+        for (uint32_t i = 0; i < m; i += size) {
+            int32_t *a = z + 2 * i, *b = z + 2 * (i + half);
+            int32_t tr = b[0], ti = b[1];
+            b[0] = a[0] - tr;
+            b[1] = a[1] - ti;
+            a[0] += tr;
+            a[1] += ti;
+        }
+        for (uint32_t j = 1; j < half; j++) {
+            int64_t c = f->cos_q15[j * step];
+            int64_t s = f->sin_q15[j * step];
+            for (uint32_t i = j; i < m; i += size) {
+                int32_t *a = z + 2 * i, *b = z + 2 * (i + half);
+                // b * (c - js)
+                int32_t tr = (int32_t)((b[0] * c + b[1] * s + 0x4000) >> 15);
+                int32_t ti = (int32_t)((b[1] * c - b[0] * s + 0x4000) >> 15);
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+void fft_fixed_real(const fft_fixed_t *f, int32_t *data)
+{
+    uint32_t m = f->n / 2;
+
+    // 짝/홀 샘플을 실수/허수로 묶은 m점 복소 FFT: Z[k] = E[k] + j O[k]
+    fft_complex(f, data, m);
+
+    // 분리: X'[k] = E'[k] + W_N^k O'[k], E' = Z[k] + Z*[m-k], O' = (Z[k] - Z*[m-k]) / j
+    int32_t r0 = data[0], i0 = data[1];
+    data[0] = 2 * (r0 + i0);
+    data[1] = 0;
+    data[2 * m] = 2 * (r0 - i0);
+    data[2 * m + 1] = 0;
+
+    for (uint32_t k = 1; k <= m / 2; k++) {
+        int32_t *a = data + 2 * k, *b = data + 2 * (m - k);
+        int32_t er = a[0] + b[0], ei = a[1] - b[1];
+        int64_t or_ = (int64_t)a[1] + b[1], oi = (int64_t)b[0] - a[0];
+        int64_t c = f->cos_q15[k], s = f->sin_q15[k];
+        int32_t wr = (int32_t)((or_ * c + oi * s + 0x4000) >> 15);
+        int32_t wi = (int32_t)((oi * c - or_ * s + 0x4000) >> 15);
+
+        // X'[m-k]는 E'와 O'의 켤레, 트위들 W_N^(m-k) = -(c + js)에서 같은 곱으로 나옴
+        a[0] = er + wr;
+        a[1] = ei + wi;
+        b[0] = er - wr;
+        b[1] = wi - ei;
+    }
+}
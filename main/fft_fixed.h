@@ -0,0 +1,40 @@
+#ifndef FFT_FIXED_H
+#define FFT_FIXED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 고정소수점 실수 FFT (32비트 정수 데이터, Q15 트위들)
+//
+// 실수 N점을 N/2점 복소 FFT(radix-2, 제자리) 한 번과 분리 단계로 계산한다.
+// 단계마다 1/2 스케일링을 하지 않으므로 반올림 오차는 트위들 곱에서만 생긴다.
+// 대신 입력은 |x| < 2^31 / (2 * N)이어야 한다 (N = 4096이면 2^18 미만).
+// 결과는 X'[k] = 2 * X[k] (X는 입력의 DFT), k = 0..N/2 - 실수 입력이므로 나머지는 켤레.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define FFT_MIN_POINTS      16
+#define FFT_MAX_POINTS      4096
+
+typedef struct {
+    uint32_t n;                             // 실수 점 수 (2의 거듭제곱)
+    uint32_t log2n;
+    int16_t cos_q15[FFT_MAX_POINTS / 2];    // cos(2 pi k / N), k < N/2
+    int16_t sin_q15[FFT_MAX_POINTS / 2];    // sin(2 pi k / N)
+} fft_fixed_t;
+
+// 트위들 표 준비 (n이 2의 거듭제곱이 아니거나 범위 밖이면 false)
+bool fft_fixed_init(fft_fixed_t *f, uint32_t n);
+
+// 실수 FFT (제자리). data: 입력 n개 -> 출력 복소 n/2 + 1개 (re, im 교대, n + 2 워드 필요)
+// 출력 X'[0], X'[n/2]의 허수부는 0
+void fft_fixed_real(const fft_fixed_t *f, int32_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FFT_FIXED_H
@@ -2,7 +2,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
 #include "analog_test_simple.h"
+#include "bus_stats.h"
 #include <math.h>
 
 #define LOG_TAG "FT800"
@@ -10,13 +15,28 @@
 // 전역 변수 정의
 ft800_handle_t *driver_dev = NULL;
 
+// 블록 전송용 DMA 바운스 버퍼 (호출자 버퍼가 DMA로 못 읽는 메모리일 때만 사용)
+static uint8_t *spi_bounce_buf[FT800_SPI_QUEUE_DEPTH];
+
+// 코프로세서 명령 스테이징 버퍼
+// 명령 워드를 쌓아두고 flush 때 ft800_write_block()으로 RAM_CMD에 한 번에 쓴다.
+// DMA 가능 메모리라 바운스 복사 없이 바로 전송된다.
+static DMA_ATTR uint8_t cmd_stage_buf[FT800_CMD_STAGE_BYTES];
+static uint32_t cmd_stage_len = 0;      // 쌓인 명령 바이트 수
+static uint32_t cmd_fifo_wr = 0;        // 호스트가 아는 REG_CMD_WRITE (이 값은 호스트만 바꾼다)
+static uint32_t cmd_fifo_free = 0;      // 마지막으로 확인한 FIFO 빈 공간 (캐시)
+static bool cmd_fifo_synced = false;
+static uint32_t cmd_flushed_total = 0;  // 지금까지 FIFO로 보낸 명령 바이트 누적 (wrap 허용)
+
 static void ft800_spi_transfer(ft800_handle_t *dev, const uint8_t *tx, uint8_t *rx, size_t len) {
     spi_transaction_t t = {
         .length = len * 8,
         .tx_buffer = tx,
         .rx_buffer = rx,
     };
+    int64_t start = esp_timer_get_time();
     spi_device_polling_transmit(dev->spi, &t);
+    bus_stats_record(BUS_STATS_SPI_FT800, 1, len, (uint32_t)(esp_timer_get_time() - start));
 }
 
 void ft800_write8(ft800_handle_t *dev, uint32_t addr, uint8_t data) {
@@ -52,6 +72,122 @@ uint32_t ft800_read32(ft800_handle_t *dev, uint32_t addr) {
     return rx[4] | (rx[5] << 8) | (rx[6] << 16) | (rx[7] << 24);
 }
 
+// 블록 전송 주소 phase (쓰기: 0x80 | addr 24비트, 읽기: addr 24비트 + 더미 1바이트)
+#define FT800_WRITE_ADDR(a)     (0x800000UL | ((a) & 0x3FFFFFUL))
+#define FT800_READ_ADDR(a)      (((a) & 0x3FFFFFUL) << 8)
+
+// DMA로 직접 보낼 수 있는 버퍼인지 (내부 RAM, 4바이트 정렬)
+static bool ft800_dma_ok(const void *p, size_t len)
+{
+    return esp_ptr_dma_capable(p) && (((uintptr_t)p & 3) == 0) && ((len & 3) == 0);
+}
+
+// 바운스 버퍼 확보 (처음 블록 전송 시 한 번)
+static esp_err_t ft800_bounce_alloc(void)
+{
+    for (int i = 0; i < FT800_SPI_QUEUE_DEPTH; i++) {
+        if (spi_bounce_buf[i] == NULL) {
+            spi_bounce_buf[i] = heap_caps_malloc(FT800_SPI_MAX_CHUNK, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+            if (spi_bounce_buf[i] == NULL) {
+                ESP_LOGE(LOG_TAG, "SPI bounce buffer alloc failed");
+                return ESP_ERR_NO_MEM;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+// 블록 전송 공통: FT800_SPI_MAX_CHUNK 단위로 나눠 큐에 넣고 최대 FT800_SPI_QUEUE_DEPTH개를 겹쳐서 전송
+// 호출자 버퍼가 DMA로 직접 접근 가능하면 복사 없이, 아니면 바운스 버퍼를 거친다.
+static esp_err_t ft800_block_transfer(ft800_handle_t *dev, uint32_t addr, const uint8_t *tx_src,
+                                      uint8_t *rx_dst, size_t len)
+{
+    spi_transaction_ext_t trans[FT800_SPI_QUEUE_DEPTH];
+    size_t chunk_off[FT800_SPI_QUEUE_DEPTH];
+    size_t chunk_len[FT800_SPI_QUEUE_DEPTH];
+    bool direct = ft800_dma_ok(tx_src ? (const void *)tx_src : (const void *)rx_dst, len);
+    uint32_t submitted = 0, completed = 0;
+    size_t next_off = 0;
+    esp_err_t ret = ESP_OK;
+    int64_t start = esp_timer_get_time();
+
+    if (!direct && ft800_bounce_alloc() != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    while (completed < submitted || (next_off < len && ret == ESP_OK)) {
+        // 빈 슬롯이 있으면 다음 구간을 큐에 넣음
+        if (next_off < len && ret == ESP_OK && submitted - completed < FT800_SPI_QUEUE_DEPTH) {
+            int slot = submitted % FT800_SPI_QUEUE_DEPTH;
+            size_t n = len - next_off;
+            if (n > FT800_SPI_MAX_CHUNK) {
+                n = FT800_SPI_MAX_CHUNK;
+            }
+            chunk_off[slot] = next_off;
+            chunk_len[slot] = n;
+
+            trans[slot] = (spi_transaction_ext_t) {
+                .base = {
+                    .flags = SPI_TRANS_VARIABLE_ADDR,
+                    .length = n * 8,
+                },
+            };
+            if (tx_src) {
+                const uint8_t *tx = tx_src + next_off;
+                if (!direct) {
+                    memcpy(spi_bounce_buf[slot], tx, n);
+                    tx = spi_bounce_buf[slot];
+                }
+                trans[slot].base.addr = FT800_WRITE_ADDR(addr + next_off);
+                trans[slot].base.tx_buffer = tx;
+                trans[slot].address_bits = 24;
+            } else {
+                trans[slot].base.addr = FT800_READ_ADDR(addr + next_off);
+                trans[slot].base.rxlength = n * 8;
+                trans[slot].base.rx_buffer = direct ? rx_dst + next_off : spi_bounce_buf[slot];
+                trans[slot].address_bits = 32;
+            }
+
+            ret = spi_device_queue_trans(dev->spi, &trans[slot].base, portMAX_DELAY);
+            if (ret != ESP_OK) {
+                ESP_LOGE(LOG_TAG, "SPI queue failed: %s", esp_err_to_name(ret));
+                continue;
+            }
+            submitted++;
+            next_off += n;
+            continue;
+        }
+
+        // 가장 오래된 전송 완료 처리 (큐는 넣은 순서대로 끝남)
+        int slot = completed % FT800_SPI_QUEUE_DEPTH;
+        spi_transaction_t *done;
+        esp_err_t r = spi_device_get_trans_result(dev->spi, &done, portMAX_DELAY);
+        if (ret == ESP_OK) {
+            ret = r;
+        }
+        if (rx_dst && !direct && r == ESP_OK) {
+            memcpy(rx_dst + chunk_off[slot], spi_bounce_buf[slot], chunk_len[slot]);
+        }
+        completed++;
+    }
+    // 구간마다 주소 phase (쓰기 3바이트, 읽기 더미 포함 4바이트)
+    bus_stats_record(BUS_STATS_SPI_FT800, submitted, next_off + submitted * (tx_src ? 3 : 4),
+                     (uint32_t)(esp_timer_get_time() - start));
+    return ret;
+}
+
+// 블록 쓰기 (RAM_G, RAM_CMD, RAM_DL 등 연속 주소)
+esp_err_t ft800_write_block(ft800_handle_t *dev, uint32_t addr, const void *data, size_t len)
+{
+    return ft800_block_transfer(dev, addr, data, NULL, len);
+}
+
+// 블록 읽기
+esp_err_t ft800_read_block(ft800_handle_t *dev, uint32_t addr, void *data, size_t len)
+{
+    return ft800_block_transfer(dev, addr, NULL, data, len);
+}
+
 esp_err_t ft800_init(ft800_handle_t *pdev, spi_host_device_t host, int mosi, int sclk, int cs) {
     return ft800_init_with_int(pdev, host, mosi, sclk, cs, -1);
 }
@@ -72,7 +208,7 @@ esp_err_t ft800_spi_speedup(ft800_handle_t *pdev, spi_host_device_t host) {
         .clock_speed_hz = FT800_SPI_SPEED_HZ, // 32MHz로 설정
         .mode = 0,
         .spics_io_num = pdev->cs_pin,
-        .queue_size = 3,
+        .queue_size = FT800_SPI_QUEUE_DEPTH,
     };
 
     // buscfg는 bus마다 1회만 initialize 필요, 이미 되어 있다면 생략 가능
@@ -110,13 +246,13 @@ esp_err_t ft800_init_with_int(ft800_handle_t *pdev, spi_host_device_t host, int
         .sclk_io_num = sclk,
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
-        .max_transfer_sz = 64,
+        .max_transfer_sz = FT800_SPI_MAX_CHUNK + 4,  // 블록 전송 (주소/더미는 별도 phase)
     };
     spi_device_interface_config_t devcfg = {
         .clock_speed_hz = FT800_SPI_INIT_SPEED_HZ, // 5MHz로 낮춤
         .mode = 0,
         .spics_io_num = cs,
-        .queue_size = 3,
+        .queue_size = FT800_SPI_QUEUE_DEPTH,
     };
     
     // SPI 버스 초기화 (이미 초기화된 경우 무시)
@@ -140,6 +276,23 @@ esp_err_t ft800_init_with_int(ft800_handle_t *pdev, spi_host_device_t host, int
     return ESP_OK;
 }
 
+// INT 핀 (active low): 처리하지 않은 인터럽트 플래그가 있으면 true
+bool ft800_get_interrupt_status(ft800_handle_t *dev) {
+    if (dev == NULL || dev->int_pin < 0) {
+        return false;
+    }
+    return gpio_get_level(dev->int_pin) == 0;
+}
+
+// REG_INT_FLAGS 읽기 (읽으면 지워지고 INT 핀이 풀림)
+uint32_t ft800_read_interrupt_flags(ft800_handle_t *dev) {
+    return ft800_read8(dev, REG_INT_FLAGS);
+}
+
+void ft800_clear_interrupt(ft800_handle_t *dev) {
+    (void)ft800_read_interrupt_flags(dev);
+}
+
 ft800_handle_t *get_driver_dev(void) {
     return driver_dev;
 }
@@ -238,40 +391,149 @@ uint32_t HOST_MEM_RD32(uint32_t addr)
 
 
 /*** CMD Functions *****************************************************************/
-uint8_t cmd_execute(uint32_t data)
+// FIFO 포인터를 FT800에서 다시 읽음 (초기화 직후, 코프로세서 리셋 후)
+void cmd_sync(void)
 {
-	uint32_t cmdBufferRd = 0;
-    uint32_t cmdBufferWr = 0;
-    
-    cmdBufferRd = HOST_MEM_RD32(REG_CMD_READ);
-    cmdBufferWr = HOST_MEM_RD32(REG_CMD_WRITE);
-    
-    uint32_t cmdBufferDiff = cmdBufferWr-cmdBufferRd;
-    
-    if( (4096-cmdBufferDiff) > 4)
-    {
-        HOST_MEM_WR32(RAM_CMD + cmdBufferWr, data);
-        HOST_MEM_WR32(REG_CMD_WRITE, cmdBufferWr + 4);
+    cmd_fifo_wr = HOST_MEM_RD32(REG_CMD_WRITE) & FT800_CMD_FIFO_MASK;
+    uint32_t rd = HOST_MEM_RD32(REG_CMD_READ) & FT800_CMD_FIFO_MASK;
+    cmd_fifo_free = FT800_CMD_FIFO_SIZE - 4 - ((cmd_fifo_wr - rd) & FT800_CMD_FIFO_MASK);
+    cmd_fifo_synced = true;
+}
+
+// 스테이징 버퍼의 [off, off+len) 구간을 RAM_CMD의 현재 쓰기 위치에 한 번에 전송
+static void cmd_burst_write(uint32_t off, uint32_t len)
+{
+    ft800_write_block(driver_dev, RAM_CMD + cmd_fifo_wr, cmd_stage_buf + off, len);
+    cmd_fifo_wr = (cmd_fifo_wr + len) & FT800_CMD_FIFO_MASK;
+}
+
+// 쌓인 명령을 FIFO로 전송. FIFO가 가득 차 있으면 코프로세서가 비울 때까지 기다린다
+uint8_t cmd_flush(void)
+{
+    uint32_t off = 0;
+    int64_t wait_start = 0;
+
+    if (cmd_stage_len == 0) {
         return 1;
     }
-    return 0;
+    if (!cmd_fifo_synced) {
+        cmd_sync();
+    }
+
+    while (off < cmd_stage_len) {
+        uint32_t len = cmd_stage_len - off;
+
+        // 캐시된 빈 공간이 모자랄 때만 REG_CMD_READ를 다시 읽음
+        if (cmd_fifo_free < len) {
+            uint32_t rd = HOST_MEM_RD32(REG_CMD_READ) & FT800_CMD_FIFO_MASK;
+            cmd_fifo_free = FT800_CMD_FIFO_SIZE - 4 - ((cmd_fifo_wr - rd) & FT800_CMD_FIFO_MASK);
+        }
+        if (cmd_fifo_free == 0) {
+            // 코프로세서가 처리 중 - 잠깐 양보하고 다시 확인
+            if (wait_start == 0) {
+                wait_start = esp_timer_get_time();
+            } else if (esp_timer_get_time() - wait_start > FT800_CMD_TIMEOUT_US) {
+                ESP_LOGE(LOG_TAG, "Command FIFO stuck, dropped %lu bytes", (unsigned long)(cmd_stage_len - off));
+                cmd_stage_len = 0;
+                cmd_fifo_synced = false;
+                return 0;
+            }
+            taskYIELD();
+            continue;
+        }
+        wait_start = 0;
+        if (len > cmd_fifo_free) {
+            len = cmd_fifo_free;
+        }
+
+        // RAM_CMD 끝에서 잘리면 두 번에 나눠 보냄
+        uint32_t to_end = FT800_CMD_FIFO_SIZE - cmd_fifo_wr;
+        if (len > to_end) {
+            cmd_burst_write(off, to_end);
+            cmd_burst_write(off + to_end, len - to_end);
+        } else {
+            cmd_burst_write(off, len);
+        }
+        cmd_fifo_free -= len;
+        cmd_flushed_total += len;
+        off += len;
+
+        // 보낸 만큼 한 번에 공개
+        HOST_MEM_WR32(REG_CMD_WRITE, cmd_fifo_wr);
+    }
+
+    cmd_stage_len = 0;
+    return 1;
+}
+
+uint8_t cmd_execute(uint32_t data)
+{
+    // 스테이징 버퍼가 차면 먼저 비움
+    if (cmd_stage_len + 4 > FT800_CMD_STAGE_BYTES && !cmd_flush()) {
+        return 0;
+    }
+
+    uint8_t *p = cmd_stage_buf + cmd_stage_len;
+    p[0] = data & 0xFF;
+    p[1] = (data >> 8) & 0xFF;
+    p[2] = (data >> 16) & 0xFF;
+    p[3] = (data >> 24) & 0xFF;
+    cmd_stage_len += 4;
+    return 1;
 }
 
 uint8_t cmd(uint32_t data)
 {
-	for(int8_t tryCount = 10; tryCount > 0; --tryCount)
-	{
-		if(cmd_execute(data)) { return 1; }
-	}
-	return 0;
+    if (!cmd_execute(data)) {
+        return 0;
+    }
+    // 프레임 끝에서 디스플레이 리스트 전체를 한 번에 전송
+    if (data == CMD_SWAP) {
+        return cmd_flush();
+    }
+    return 1;
+}
+
+// 지금까지 FIFO로 보낸 명령 바이트 누적
+uint32_t cmd_flushed_bytes(void)
+{
+    return cmd_flushed_total;
+}
+
+// 코프로세서가 지금까지 처리한 명령 바이트 누적 (cmd_flushed_bytes()와 비교해서 완료 여부 판단)
+uint32_t cmd_consumed_bytes(void)
+{
+    uint32_t rd = HOST_MEM_RD32(REG_CMD_READ) & FT800_CMD_FIFO_MASK;
+    uint32_t pending = (cmd_fifo_wr - rd) & FT800_CMD_FIFO_MASK;
+
+    // 읽은 김에 빈 공간 캐시도 갱신
+    cmd_fifo_free = FT800_CMD_FIFO_SIZE - 4 - pending;
+    return cmd_flushed_total - pending;
 }
 
 uint8_t cmd_ready(void)
 {
-    uint32_t cmdBufferRd = HOST_MEM_RD32(REG_CMD_READ);
-    uint32_t cmdBufferWr = HOST_MEM_RD32(REG_CMD_WRITE);
+    cmd_flush();
+    uint32_t rd = HOST_MEM_RD32(REG_CMD_READ) & FT800_CMD_FIFO_MASK;
     
-    return (cmdBufferRd == cmdBufferWr) ? 1 : 0;
+    return (rd == cmd_fifo_wr) ? 1 : 0;
+}
+
+// 문자열을 NUL 포함 4바이트 단위로 명령 버퍼에 추가
+static void cmd_str(const char *str, uint16_t length)
+{
+    uint32_t word = 0;
+    uint16_t i;
+
+    for (i = 0; i < length; i++) {
+        word |= (uint32_t)(uint8_t)str[i] << ((i & 3) * 8);
+        if ((i & 3) == 3) {
+            cmd(word);
+            word = 0;
+        }
+    }
+    // 길이가 4의 배수여도 NUL 워드 하나는 붙음
+    cmd(word);
 }
 
 /*** Track *************************************************************************/
@@ -305,108 +567,39 @@ void cmd_slider(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t options, ui
 /*** Draw Text *********************************************************************/
 void cmd_text(int16_t x, int16_t y, int16_t font, uint16_t options, const char* str)
 {
-	/* 	
-		i: data pointer
-		q: str  pointer
-		j: loop counter
-	*/
-	
-	uint16_t i,j,q;
 	const uint16_t length = strlen(str);
-	if(!length) return ;	
-	
-	uint32_t* data = (uint32_t*) calloc((length/4)+1, sizeof(uint32_t));
-	
-	q = 0;
-	for(i=0; i<(length/4); ++i, q=q+4)
-	{
-		data[i] = (uint32_t)str[q+3]<<24 | (uint32_t)str[q+2]<<16 | (uint32_t)str[q+1]<<8 | (uint32_t)str[q];
-	}
-	for(j=0; j<(length%4); ++j, ++q)
-	{
-		data[i] |= (uint32_t)str[q] << (j*8);
-	}
+	if(!length) return ;
 	
 	cmd(CMD_TEXT);
 	cmd( ((uint32_t)y<<16)|(x & 0xffff) );
-    cmd( ((uint32_t)options<<16)|(font & 0xffff) );
-	for(j=0; j<(length/4)+1; ++j)
-	{
-		cmd(data[j]);
-	}
-	free(data);
+	cmd( ((uint32_t)options<<16)|(font & 0xffff) );
+	cmd_str(str, length);
 }
 
 /*** Draw Button *******************************************************************/
 void cmd_button(int16_t x, int16_t y, int16_t w, int16_t h, int16_t font, uint16_t options, const char* str)
-{	
-	/* 	
-		i: data pointer
-		q: str  pointer
-		j: loop counter
-	*/
-	
-	uint16_t i,j,q;
+{
 	const uint16_t length = strlen(str);
 	if(!length) return ;
 	
-	uint32_t* data = (uint32_t*) calloc((length/4)+1, sizeof(uint32_t));
-	
-	q = 0;
-	for(i=0; i<(length/4); ++i, q=q+4)
-	{
-		data[i] = (uint32_t)str[q+3]<<24 | (uint32_t)str[q+2]<<16 | (uint32_t)str[q+1]<<8 | (uint32_t)str[q];
-	}
-	for(j=0; j<(length%4); ++j, ++q)
-	{
-		data[i] |= (uint32_t)str[q] << (j*8);
-	}
-	
 	cmd(CMD_BUTTON);
 	cmd( ((uint32_t)y<<16)|(x & 0xffff) );
 	cmd( ((uint32_t)h<<16)|(w & 0xffff) );
-    cmd( ((uint32_t)options<<16)|(font & 0xffff) );
-	for(j=0; j<(length/4)+1; ++j)
-	{
-		cmd(data[j]);
-	}
-	free(data);
+	cmd( ((uint32_t)options<<16)|(font & 0xffff) );
+	cmd_str(str, length);
 }
 
 /*** Draw Keyboard *****************************************************************/
 void cmd_keys(int16_t x, int16_t y, int16_t w, int16_t h, int16_t font, uint16_t options, const char* str)
 {
-	/* 	
-		i: data pointer
-		q: str  pointer
-		j: loop counter
-	*/
-	
-	uint16_t i,j,q;
 	const uint16_t length = strlen(str);
 	if(!length) return ;
 	
-	uint32_t* data = (uint32_t*) calloc((length/4)+1, sizeof(uint32_t));
-	
-	q = 0;
-	for(i=0; i<(length/4); ++i, q=q+4)
-	{
-		data[i] = (uint32_t)str[q+3]<<24 | (uint32_t)str[q+2]<<16 | (uint32_t)str[q+1]<<8 | (uint32_t)str[q];
-	}
-	for(j=0; j<(length%4); ++j, ++q)
-	{
-		data[i] |= (uint32_t)str[q] << (j*8);
-	}
-	
 	cmd(CMD_KEYS);
 	cmd( ((uint32_t)y<<16)|(x & 0xffff) );
 	cmd( ((uint32_t)h<<16)|(w & 0xffff) );
-    cmd( ((uint32_t)options<<16)|(font & 0xffff) );
-	for(j=0; j<(length/4)+1; ++j)
-	{
-		cmd(data[j]);
-	}
-	free(data);
+	cmd( ((uint32_t)options<<16)|(font & 0xffff) );
+	cmd_str(str, length);
 }
 
 /*** Write zero to a block of memory ***********************************************/
@@ -479,7 +672,6 @@ uint8_t spi_speedup(void)
     spi_host_device_t host = SPI2_HOST;
     return ft800_spi_speedup(pdev, host);
 }
-extern void ft800_isr_handler(void* arg);
 
 /* Init function for an 5" LCD display */
 uint8_t initFT800(void)
@@ -569,6 +761,10 @@ uint8_t initFT800(void)
 
     spi_speedup();
 
+    // 명령 FIFO 포인터 캐시 초기화
+    cmd_stage_len = 0;
+    cmd_sync();
+
 	return 0;
 }
 
@@ -15,6 +15,24 @@
 #define FT800_SPI_SPEED_HZ      20000000UL  // 20MHz (안정적)
 #define FT800_SPI_INIT_SPEED_HZ  5000000UL  // 5MHz (초기화용)
 
+// 코프로세서 명령 FIFO (RAM_CMD, 4KB 링)
+#define FT800_CMD_FIFO_SIZE      4096
+#define FT800_CMD_FIFO_MASK      (FT800_CMD_FIFO_SIZE - 1)
+#define FT800_CMD_STAGE_BYTES    4092       // 호스트 명령 버퍼 (FIFO 최대 사용량과 같음)
+#define FT800_CMD_TIMEOUT_US     100000     // FIFO가 비지 않을 때 포기하는 시간
+
+// RAM_G 메모리 맵 (256KB)
+#define RAM_G_WAVE_BASE          0x00000UL  // 파형 DL 스니펫: 채널 2 x 더블 버퍼
+#define RAM_G_WAVE_SLOT_BYTES    0x1000UL   // 스니펫 하나 (480열 x VERTEX2F 2개 + 앞뒤 명령)
+#define RAM_G_WAVE_SIZE          (RAM_G_WAVE_SLOT_BYTES * 4)
+#define RAM_G_UI_BASE            (RAM_G_WAVE_BASE + RAM_G_WAVE_SIZE)  // 정적 UI DL 캐시: 더블 버퍼
+#define RAM_G_UI_SLOT_BYTES      0x2000UL   // RAM_DL 전체 크기 (8KB)
+#define RAM_G_UI_SIZE            (RAM_G_UI_SLOT_BYTES * 2)
+
+// 블록 전송 (DMA, 큐 방식)
+#define FT800_SPI_MAX_CHUNK      4096       // 트랜잭션 하나의 최대 데이터 길이
+#define FT800_SPI_QUEUE_DEPTH    2          // 동시에 큐에 넣는 트랜잭션 수 (바운스 버퍼 개수)
+
 typedef struct {
     spi_device_handle_t spi;
     int cs_pin;
@@ -31,6 +49,7 @@ esp_err_t ft800_init_with_int(ft800_handle_t *pdev, spi_host_device_t host, int
 esp_err_t ft800_check_id(ft800_handle_t *pdev);
 esp_err_t ft800_spi_speedup(ft800_handle_t *pdev, spi_host_device_t host);
 bool ft800_get_interrupt_status(ft800_handle_t *pdev);
+uint32_t ft800_read_interrupt_flags(ft800_handle_t *pdev);
 void ft800_clear_interrupt(ft800_handle_t *pdev);
 void ft800_write8(ft800_handle_t *pdev, uint32_t addr, uint8_t data);
 void ft800_write16(ft800_handle_t *pdev, uint32_t addr, uint16_t data);
@@ -38,6 +57,9 @@ void ft800_write32(ft800_handle_t *pdev, uint32_t addr, uint32_t data);
 uint8_t ft800_read8(ft800_handle_t *pdev, uint32_t addr);
 uint16_t ft800_read16(ft800_handle_t *pdev, uint32_t addr);
 uint32_t ft800_read32(ft800_handle_t *pdev, uint32_t addr);
+// 블록 전송 (최대 4KB씩 DMA로, 큐에 겹쳐 넣어 전송). 호출자 버퍼는 아무 메모리나 가능
+esp_err_t ft800_write_block(ft800_handle_t *pdev, uint32_t addr, const void *data, size_t len);
+esp_err_t ft800_read_block(ft800_handle_t *pdev, uint32_t addr, void *data, size_t len);
 
 ft800_handle_t *get_driver_dev(void);
 ft800_handle_t **get_driver_dev_ptr(void);
@@ -379,9 +401,13 @@ uint32_t HOST_MEM_RD16(uint32_t addr);				/* read  16bit (2bytes) data from memo
 uint32_t HOST_MEM_RD32(uint32_t addr);				/* read  32bit (4bytes) data from memory */
 
 /*** CO-PROCESSOR ******************************************************************/
-uint8_t cmd_ready(void);				/* check if co-processor is ready */
-uint8_t cmd(uint32_t data);				/* command function (tries to execute command max. 255 times) */
-uint8_t cmd_execute(uint32_t data);		/* execute function (returns 0: when failed to execute command, ie. co-p. is busy) */
+uint8_t cmd_ready(void);				/* flush, then check if co-processor is ready */
+uint8_t cmd(uint32_t data);				/* stage command word (CMD_SWAP flushes the whole list) */
+uint8_t cmd_execute(uint32_t data);		/* stage command word (returns 0: staging buffer could not be flushed) */
+uint8_t cmd_flush(void);				/* write staged commands to RAM_CMD in one burst + one REG_CMD_WRITE update */
+void cmd_sync(void);					/* re-read REG_CMD_READ/WRITE into the host-side cache */
+uint32_t cmd_flushed_bytes(void);		/* running total of command bytes sent to the FIFO */
+uint32_t cmd_consumed_bytes(void);		/* running total of command bytes the co-processor has executed */
 
 void cmd_track(int16_t x, int16_t y, int16_t w, int16_t h, int16_t tag);										/* set touch engine for tracking */
 void cmd_spinner(int16_t x, int16_t y, uint16_t style, uint16_t scale);											/* draw spinner */
@@ -1,5 +1,7 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -11,11 +13,16 @@
 #include "ft800.h"
 #include "analog_test_simple.h"
 #include "adc_dma_continuous.h"
+#include "hardware_test.h"
+#include "ch423_service.h"
+#include "bus_stats.h"
 
 static const char *TAG = "HARDWARE_TEST";
 
 // CH423 I2C 주소
 #define CH423_I2C_ADDR 0x20
+#define CH423_ADDR_OC_L 0x22    // OC0~7 쓰기 (명령이 주소 자리에 들어감)
+#define CH423_ADDR_OC_H 0x23    // OC8~15 쓰기
 
 // GPIO 핀 정의
 #define GPIO_RE1B 12
@@ -47,30 +54,22 @@ static const char *TAG = "HARDWARE_TEST";
 #define CH423_IO_STDBY 6
 #define CH423_IO_CHRG 7
 
-// 테스트 결과 구조체
-typedef struct {
-    bool ch423_ok;
-    bool lcd_ok;
-    bool buttons_ok;
-    bool leds_ok;
-    bool rotary_encoders_ok;
-    bool adc_ok;
-    bool dac_ok;
-    bool trigger_ok;
-    bool battery_ok;
-    bool relays_ok;
-} hardware_test_results_t;
-
-// I2C 초기화
-static esp_err_t init_i2c(void) {
+// I2C 설정 (핀 고정, 클럭만 다름)
+static i2c_config_t ch423_i2c_config(uint32_t clk_hz) {
     i2c_config_t conf = {
         .mode = I2C_MODE_MASTER,
         .sda_io_num = 22,
         .scl_io_num = 21,
         .sda_pullup_en = GPIO_PULLUP_ENABLE,
         .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = 100000,
+        .master.clk_speed = clk_hz,
     };
+    return conf;
+}
+
+// I2C 초기화
+static esp_err_t init_i2c(void) {
+    i2c_config_t conf = ch423_i2c_config(100000);
     
     esp_err_t ret = i2c_driver_install(I2C_NUM_0, conf.mode, 0, 0, 0);
     if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
@@ -88,63 +87,151 @@ static esp_err_t init_i2c(void) {
     return ESP_OK;
 }
 
+uint16_t ch423_OC_output_data = 0x0000;
+
+// 출력 배치 상태 (ch423_OC_output_data는 아직 보내지 않은 변경까지 포함한 그림자)
+static uint16_t ch423_oc_committed = 0x0000;    // 칩에 마지막으로 쓴 값
+static bool ch423_oc_synced = false;            // committed가 칩과 같은지 (처음/오류 후에는 모두 씀)
+static int ch423_batch_depth = 0;
+static uint32_t ch423_oc_written = 0;
+static uint32_t ch423_oc_elided = 0;
+
+// CH423 I2C 전송 한 번 계측 (바이트는 START마다 주소 바이트 포함, 실패해도 버스를 쓴 시간은 기록)
+static void ch423_bus_account(int64_t start, uint32_t bytes) {
+    bus_stats_record(BUS_STATS_I2C_CH423, 1, bytes, (uint32_t)(esp_timer_get_time() - start));
+}
+
+static esp_err_t ch423_i2c_write_byte(uint8_t data, TickType_t timeout) {
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = i2c_master_write_to_device(I2C_NUM_0, CH423_I2C_ADDR, &data, 1, timeout);
+    ch423_bus_account(start, 2);
+    return ret;
+}
+
+static esp_err_t ch423_i2c_read_io(uint8_t *data, TickType_t timeout) {
+    uint8_t cmd = CH423_CMD_IO_IN;
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = i2c_master_write_read_device(I2C_NUM_0, CH423_I2C_ADDR, &cmd, 1, data, 1, timeout);
+    ch423_bus_account(start, 4);
+    return ret;
+}
+
 esp_err_t ch423_set_output(uint8_t pin, bool state);
 // CH423 초기화
 static esp_err_t init_ch423(void) {
     // CH423 IO 출력 설정
     uint8_t cmd = CH423_CMD_IO_OUT;
     uint8_t data = 0x00;  // 모든 핀을 LOW로 설정
-    esp_err_t ret = i2c_master_write_to_device(I2C_NUM_0, CH423_I2C_ADDR, &cmd, 1, pdMS_TO_TICKS(1000));
+    esp_err_t ret = ch423_i2c_write_byte(cmd, pdMS_TO_TICKS(1000));
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "CH423 IO output config failed: %s", esp_err_to_name(ret));
         return ret;
     }
     
-    ret = i2c_master_write_to_device(I2C_NUM_0, CH423_I2C_ADDR, &data, 1, pdMS_TO_TICKS(1000));
+    ret = ch423_i2c_write_byte(data, pdMS_TO_TICKS(1000));
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "CH423 IO output data failed: %s", esp_err_to_name(ret));
         return ret;
     }
+    // 칩 상태를 모르므로 OC 두 바이트를 모두 다시 씀
+    ch423_oc_synced = false;
     ch423_set_output(0,0);
     return ESP_OK;
 }
 
-uint16_t ch423_OC_output_data = 0x0000;
-// CH423 출력 핀 제어
-esp_err_t ch423_set_output(uint8_t pin, bool state) {
-    if(state)
-    {
-        ch423_OC_output_data |= (1 << pin);
+// 바뀐 OC 바이트만 한 번의 I2C 트랜잭션으로 (OC_L/OC_H는 주소가 달라 반복 START로 이어 씀)
+static esp_err_t ch423_write_outputs(uint16_t out, TickType_t timeout) {
+    uint16_t diff = ch423_oc_synced ? (uint16_t)(out ^ ch423_oc_committed) : 0xFFFF;
+    bool write_lo = (diff & 0x00FF) != 0;
+    bool write_hi = (diff & 0xFF00) != 0;
+
+    ch423_oc_elided += (write_lo ? 0 : 1) + (write_hi ? 0 : 1);
+    if (!write_lo && !write_hi) {
+        return ESP_OK;
     }
-    else
-    {
-        ch423_OC_output_data &= ~(1 << pin);
+
+    i2c_cmd_handle_t link = i2c_cmd_link_create();
+    if (link == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    if (write_lo) {
+        i2c_master_start(link);
+        i2c_master_write_byte(link, (CH423_ADDR_OC_L << 1) | I2C_MASTER_WRITE, true);
+        i2c_master_write_byte(link, out & 0xFF, true);
     }
+    if (write_hi) {
+        i2c_master_start(link);
+        i2c_master_write_byte(link, (CH423_ADDR_OC_H << 1) | I2C_MASTER_WRITE, true);
+        i2c_master_write_byte(link, out >> 8, true);
+    }
+    i2c_master_stop(link);
+    int64_t start = esp_timer_get_time();
+    esp_err_t ret = i2c_master_cmd_begin(I2C_NUM_0, link, timeout);
+    ch423_bus_account(start, (write_lo ? 2 : 0) + (write_hi ? 2 : 0));
+    i2c_cmd_link_delete(link);
 
-    uint8_t data = ch423_OC_output_data&0xFF;    
-    //CH423 OC 출력 켜기
-    esp_err_t ret = i2c_master_write_to_device(I2C_NUM_0, 0x22, &data, 1, pdMS_TO_TICKS(1000));
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "CH423 OC output low data failed: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "CH423 OC output write failed: %s", esp_err_to_name(ret));
+        ch423_oc_synced = false;    // 어디까지 들어갔는지 모르므로 다음엔 모두 씀
         return ret;
     }
+    ch423_oc_written += (write_lo ? 1 : 0) + (write_hi ? 1 : 0);
+    ch423_oc_committed = out;
+    ch423_oc_synced = true;
+    return ESP_OK;
+}
 
-    data = ch423_OC_output_data>>8;   
-    ret = i2c_master_write_to_device(I2C_NUM_0, 0x23, &data, 1, pdMS_TO_TICKS(1000));
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "CH423 OC output high data failed: %s", esp_err_to_name(ret));
-        return ret;
+// 배치 시작 (중첩 가능, 가장 바깥 commit에서만 전송)
+void ch423_begin(void) {
+    ch423_batch_depth++;
+}
+
+// 그림자 레지스터만 변경
+void ch423_set(uint8_t pin, bool state) {
+    if (state) {
+        ch423_OC_output_data |= (1 << pin);
+    } else {
+        ch423_OC_output_data &= ~(1 << pin);
     }
+}
 
-    //uint8_t cmd[] = {0x60, state ? 0xFF : 0x00}; // 출력 설정
-    //return i2c_master_write_to_device(I2C_NUM_0, CH423_I2C_ADDR, cmd, 2, pdMS_TO_TICKS(1000));
-    return ESP_OK;
+// 배치 종료
+esp_err_t ch423_commit(void) {
+    if (ch423_batch_depth > 0 && --ch423_batch_depth > 0) {
+        return ESP_OK;
+    }
+    // 서비스 태스크가 버스를 가지고 있으면 넘기기만 함 (블로킹 없음)
+    if (ch423_service_running()) {
+        ch423_service_post_output(ch423_OC_output_data);
+        return ESP_OK;
+    }
+    return ch423_write_outputs(ch423_OC_output_data, pdMS_TO_TICKS(1000));
+}
+
+// I2C 쓰기 통계 (written: 실제로 보낸 바이트, elided: 값이 같아 생략한 바이트)
+void ch423_get_write_stats(uint32_t *written, uint32_t *elided) {
+    if (written) {
+        *written = ch423_oc_written;
+    }
+    if (elided) {
+        *elided = ch423_oc_elided;
+    }
+}
+
+// CH423 출력 핀 제어 (핀 하나짜리 배치; 배치 안에서 부르면 commit 때 함께 전송)
+esp_err_t ch423_set_output(uint8_t pin, bool state) {
+    ch423_begin();
+    ch423_set(pin, state);
+    return ch423_commit();
 }
 
 // CH423 입력 핀 읽기
 esp_err_t ch423_read_input(uint8_t *data) {
-    uint8_t cmd = CH423_CMD_IO_IN;
-    esp_err_t ret = i2c_master_write_read_device(I2C_NUM_0, CH423_I2C_ADDR, &cmd, 1, data, 1, pdMS_TO_TICKS(1000));
+    // 서비스 태스크가 돌고 있으면 마지막 폴링 결과 (블로킹 없음)
+    if (ch423_service_running()) {
+        return ch423_service_get_input(data);
+    }
+    esp_err_t ret = ch423_i2c_read_io(data, pdMS_TO_TICKS(1000));
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "CH423 read failed: %s", esp_err_to_name(ret));
         i2c_driver_delete(I2C_NUM_0);
@@ -153,6 +240,25 @@ esp_err_t ch423_read_input(uint8_t *data) {
     return ESP_OK;
 }
 
+// 버스 직접 접근 (ch423_service 태스크 전용)
+esp_err_t ch423_bus_set_speed(uint32_t clk_hz) {
+    i2c_config_t conf = ch423_i2c_config(clk_hz);
+    esp_err_t ret = i2c_param_config(I2C_NUM_0, &conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "I2C clock change failed: %s", esp_err_to_name(ret));
+    }
+    return ret;
+}
+
+esp_err_t ch423_bus_write_outputs(uint16_t value, uint32_t timeout_ms) {
+    return ch423_write_outputs(value, pdMS_TO_TICKS(timeout_ms));
+}
+
+// 실패해도 드라이버를 지우지 않음 (다음 폴링에서 다시 시도)
+esp_err_t ch423_bus_read_input(uint8_t *data, uint32_t timeout_ms) {
+    return ch423_i2c_read_io(data, pdMS_TO_TICKS(timeout_ms));
+}
+
 // GPIO 초기화
 static esp_err_t init_gpio(void) {
     // 로터리 인코더 핀 설정 (폴링 방식)
@@ -177,14 +283,37 @@ static esp_err_t init_gpio(void) {
 
 // ADC 버퍼 (256 샘플) - ADC DMA Continuous Mode 사용
 #define ADC_BUFFER_SIZE 256
-static uint32_t adc_buffer_ch0[ADC_BUFFER_SIZE]; // 채널 0 데이터
-static uint32_t adc_buffer_ch1[ADC_BUFFER_SIZE]; // 채널 1 데이터
-static uint16_t adc_buffer_compat[ADC_BUFFER_SIZE * 2]; // 호환성을 위한 16비트 버퍼
+static uint16_t adc_buffer_compat[ADC_BUFFER_SIZE * 2]; // 호환성을 위한 16비트 버퍼 (ch0 | ch1)
 static volatile uint16_t adc_latest_value1 = 0;
 static volatile uint16_t adc_latest_value2 = 0;
 static volatile int adc_buffer_index = 0;
 static bool adc_dma_enabled = false;
 
+// 화면용 데시메이션 (adc_read_task가 갱신, UI는 공개된 열만 읽음)
+static decim_t adc_decim[2];
+static uint32_t adc_display_spc = 1;                // 열(픽셀)당 샘플 수
+static decim_mode_t adc_display_mode = DECIM_MODE_PEAK;
+static uint32_t adc_display_next_spc;
+static decim_mode_t adc_display_next_mode;
+static _Atomic bool adc_display_pending = false;
+static uint32_t adc_display_seq;                     // 프리런 모드에서 다음에 넣을 시퀀스
+
+// 공개된 열 (버전 카운터로 일관성 확보, 홀수 = 갱신 중)
+static decim_column_t adc_display_cols[2][ADC_DISPLAY_COLUMNS];
+static _Atomic uint32_t adc_display_count = 0;   // 버전 카운터 안에서 갱신, 읽는 쪽은 한 번만 읽음
+static _Atomic uint32_t adc_display_version = 0;
+
+// 스펙트럼 모드 (points = 0이면 꺼짐). 켜져 있는 동안 트리거 획득을 멈추고
+// 최신 points개 샘플로 주기마다 두 채널 스펙트럼을 만들어 같은 열 버퍼로 공개
+#define ADC_SPECTRUM_PERIOD_MS 100
+static spectrum_t *adc_spectrum = NULL;             // 켤 때 할당 (약 36KB)
+static uint32_t adc_spectrum_points = 0;
+static spectrum_window_t adc_spectrum_window = SPECTRUM_WINDOW_HANN;
+static uint32_t adc_spectrum_next_points = 0;
+static spectrum_window_t adc_spectrum_next_window = SPECTRUM_WINDOW_HANN;
+static decim_column_t adc_spectrum_cols[ADC_DISPLAY_COLUMNS];  // ch0 임시 (ch1 계산 동안)
+static TickType_t adc_spectrum_last;
+
 // ADC 초기화 (DMA Continuous Mode)
 static esp_err_t init_adc(void) {
     // ADC DMA Continuous Mode 초기화
@@ -200,6 +329,11 @@ static esp_err_t init_adc(void) {
         return ESP_OK;
     }
     
+    ESP_LOGI(TAG, "ADC record: %lu points/ch, %u bytes (max %lu points)",
+             (unsigned long)adc_dma_get_record_length(),
+             (unsigned)adc_dma_record_memory_bytes(adc_dma_get_record_length()),
+             (unsigned long)adc_dma_get_max_record_length());
+    
     // ADC DMA Continuous Mode 시작
     ret = adc_dma_continuous_start();
     if (ret != ESP_OK) {
@@ -213,31 +347,233 @@ static esp_err_t init_adc(void) {
         return ESP_OK;
     }
     
+    // 트리거 획득: TRIG0 하강 엣지, 트리거 지점을 화면 가운데에 둠
+    // AUTO 모드라 트리거가 없어도 100ms마다 화면이 갱신됨. 레코드 하나 = 화면 한 폭
+    ret = adc_dma_acq_configure(ADC_ACQ_MODE_AUTO, ADC_DISPLAY_COLUMNS * adc_display_spc, 50, 0, 100000);
+    if (ret == ESP_OK) {
+        ret = adc_dma_set_trigger_source(ADC_TRIG_SOURCE_TRIG0, true);
+    }
+    if (ret == ESP_OK) {
+        ret = adc_dma_acq_start();
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Trigger acquisition unavailable (%s), free-running display", esp_err_to_name(ret));
+    }
+    
     adc_dma_enabled = true;
     ESP_LOGI(TAG, "ADC DMA Continuous Mode initialized successfully");
     return ESP_OK;
 }
 
+// 스펙트럼 설정 적용 (apply_display_settings에서만 호출)
+static void apply_spectrum_settings(void)
+{
+    uint32_t points = adc_spectrum_next_points;
+    
+    if (points == 0) {
+        free(adc_spectrum);
+        adc_spectrum = NULL;
+    } else {
+        if (adc_spectrum == NULL) {
+            adc_spectrum = malloc(sizeof(spectrum_t));
+        }
+        if (adc_spectrum == NULL || !spectrum_init(adc_spectrum, points, adc_spectrum_next_window)) {
+            ESP_LOGE(TAG, "Spectrum %lu points unavailable (%u bytes)", (unsigned long)points,
+                     (unsigned)sizeof(spectrum_t));
+            free(adc_spectrum);
+            adc_spectrum = NULL;
+            points = 0;
+        }
+    }
+    if (points != adc_spectrum_points || adc_spectrum_next_window != adc_spectrum_window) {
+        ESP_LOGI(TAG, "Spectrum: %s", points ? spectrum_window_name(adc_spectrum_next_window) : "off");
+    }
+    adc_spectrum_points = points;
+    adc_spectrum_window = adc_spectrum_next_window;
+    adc_spectrum_last = xTaskGetTickCount() - pdMS_TO_TICKS(ADC_SPECTRUM_PERIOD_MS);
+}
+
+// 데시메이션 설정 적용 (adc_read_task에서만 호출)
+static void apply_display_settings(void)
+{
+    if (atomic_exchange_explicit(&adc_display_pending, false, memory_order_acquire)) {
+        adc_display_spc = adc_display_next_spc;
+        adc_display_mode = adc_display_next_mode;
+        bool was_spectrum = adc_spectrum_points != 0;
+        apply_spectrum_settings();
+        
+        if (adc_dma_enabled && adc_spectrum_points != 0) {
+            // 스펙트럼은 프리런 스냅샷으로 만듦 (4096점 레코드는 채우는 데만 0.4초)
+            adc_dma_acq_stop();
+        } else if (adc_dma_enabled && (was_spectrum || adc_dma_acq_is_running())) {
+            // 트리거 획득 중이었거나 스펙트럼에서 돌아오면 레코드 길이를 새 시간축에 맞춰 다시 무장
+            esp_err_t ret = adc_dma_acq_configure(ADC_ACQ_MODE_AUTO, ADC_DISPLAY_COLUMNS * adc_display_spc,
+                                                  50, 0, 100000);
+            if (ret == ESP_OK) {
+                ret = adc_dma_acq_start();
+            }
+            if (ret != ESP_OK) {
+                ESP_LOGW(TAG, "Trigger acquisition restart failed: %s", esp_err_to_name(ret));
+            }
+        }
+        adc_display_seq = adc_dma_get_write_seq();
+    }
+    for (int ch = 0; ch < 2; ch++) {
+        decim_init(&adc_decim[ch], adc_display_mode, adc_display_spc, ADC_DISPLAY_COLUMNS);
+    }
+}
+
+// 완성된 열을 UI에 공개
+static void publish_display_columns(void)
+{
+    uint32_t version = atomic_load_explicit(&adc_display_version, memory_order_relaxed);
+    atomic_store_explicit(&adc_display_version, version + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    uint32_t count = decim_read(&adc_decim[0], adc_display_cols[0], ADC_DISPLAY_COLUMNS);
+    decim_read(&adc_decim[1], adc_display_cols[1], ADC_DISPLAY_COLUMNS);
+    atomic_store_explicit(&adc_display_count, count, memory_order_relaxed);
+    
+    atomic_store_explicit(&adc_display_version, version + 2, memory_order_release);
+}
+
+// 뷰의 두 채널 샘플을 데시메이터에 넣음 (링 wrap 지점 기준 두 구간)
+static void push_view_to_decim(const adc_ring_view_t *view)
+{
+    for (int ch = 0; ch < 2; ch++) {
+        const uint16_t *p0, *p1;
+        uint32_t n0, n1;
+        adc_ring_view_segments(view, ch, &p0, &n0, &p1, &n1);
+        decim_push(&adc_decim[ch], p0, n0);
+        decim_push(&adc_decim[ch], p1, n1);
+    }
+}
+
+// 뷰 한 채널을 창 곱해 스펙트럼에 넣고 계산 (덮어써졌으면 false)
+static bool compute_view_spectrum(const adc_ring_view_t *view, int ch)
+{
+    const uint16_t *p0, *p1;
+    uint32_t n0, n1;
+    adc_ring_view_segments(view, ch, &p0, &n0, &p1, &n1);
+    spectrum_reset(adc_spectrum);
+    spectrum_push(adc_spectrum, p0, n0);
+    spectrum_push(adc_spectrum, p1, n1);
+    return adc_ring_view_valid(view) && spectrum_compute(adc_spectrum);
+}
+
+// 최신 points개로 두 채널 스펙트럼을 만들어 공개 (작업 버퍼가 하나라 채널은 차례로)
+static void update_display_spectrum(void)
+{
+    TickType_t now = xTaskGetTickCount();
+    if (now - adc_spectrum_last < pdMS_TO_TICKS(ADC_SPECTRUM_PERIOD_MS)) {
+        return;
+    }
+    
+    adc_ring_view_t view;
+    if (adc_dma_get_snapshot(adc_spectrum_points, &view) != ESP_OK) {
+        return;
+    }
+    if (view.count < adc_spectrum_points) {
+        adc_dma_put_view(&view);
+        return;     // 켠 직후 샘플이 모자람
+    }
+    adc_spectrum_last = now;
+    
+    bool ok = compute_view_spectrum(&view, 0);
+    if (ok) {
+        spectrum_columns(adc_spectrum, adc_spectrum_cols, ADC_DISPLAY_COLUMNS);
+        ok = compute_view_spectrum(&view, 1);
+    }
+    adc_dma_put_view(&view);
+    if (!ok) {
+        return;
+    }
+    
+    uint32_t version = atomic_load_explicit(&adc_display_version, memory_order_relaxed);
+    atomic_store_explicit(&adc_display_version, version + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    
+    memcpy(adc_display_cols[0], adc_spectrum_cols, sizeof(adc_spectrum_cols));
+    atomic_store_explicit(&adc_display_count, spectrum_columns(adc_spectrum, adc_display_cols[1], ADC_DISPLAY_COLUMNS),
+                          memory_order_relaxed);
+    
+    atomic_store_explicit(&adc_display_version, version + 2, memory_order_release);
+}
+
 // ADC 읽기 태스크 (DMA 또는 폴링 방식)
 static void adc_read_task(void *pvParameters) {
+    (void)pvParameters;
     ESP_LOGI(TAG, "ADC read task started (DMA enabled: %s)", adc_dma_enabled ? "Yes" : "No");
     
+    atomic_store(&adc_display_pending, false);
+    adc_display_next_spc = adc_display_spc;
+    adc_display_next_mode = adc_display_mode;
+    adc_spectrum_next_points = adc_spectrum_points;
+    adc_spectrum_next_window = adc_spectrum_window;
+    apply_display_settings();
+    if (adc_dma_enabled) {
+        adc_display_seq = adc_dma_get_write_seq();
+    }
+    
     while (1) {
+        if (atomic_load_explicit(&adc_display_pending, memory_order_relaxed)) {
+            apply_display_settings();
+        }
+        
         if (adc_dma_enabled) {
-            // DMA 모드: 최신 전압값 가져오기
-            uint32_t voltage_ch0_mv, voltage_ch1_mv;
-            esp_err_t ret = adc_dma_get_latest_voltage(&voltage_ch0_mv, &voltage_ch1_mv);
-            if (ret == ESP_OK) {
-                // mV를 12비트 ADC 값으로 변환 (대략적인 역변환)
-                adc_latest_value1 = (voltage_ch0_mv * 4095) / 3300;
-                adc_latest_value2 = (voltage_ch1_mv * 4095) / 3300;
-            }
-            
-            // 전체 버퍼 데이터 가져오기 (주기적으로)
-            uint32_t data_count;
-            ret = adc_dma_get_data(adc_buffer_ch0, adc_buffer_ch1, &data_count);
-            if (ret == ESP_OK && data_count > 0) {
-                adc_buffer_index = data_count - 1; // 마지막 샘플 인덱스
+            // DMA 모드: 링버퍼 뷰에서 바로 읽음 (뮤텍스/중간 버퍼 없음)
+            // 트리거 획득 중이면 고정된 레코드만 사용 (트리거 지점이 화면에서 흔들리지 않음)
+            adc_ring_view_t view;
+            if (adc_dma_acq_is_running()) {
+                if (adc_dma_acq_get_record(&view, NULL)) {
+                    // 레코드 하나가 화면 한 폭이므로 새로 채움
+                    decim_reset(&adc_decim[0]);
+                    decim_reset(&adc_decim[1]);
+                    push_view_to_decim(&view);
+                    
+                    // 호환 버퍼는 레코드의 마지막 256개
+                    adc_ring_view_t tail = view;
+                    if (tail.count > ADC_BUFFER_SIZE) {
+                        tail.start_seq += tail.count - ADC_BUFFER_SIZE;
+                        tail.count = ADC_BUFFER_SIZE;
+                    }
+                    uint32_t count = adc_ring_view_copy(&tail, 0, adc_buffer_compat, ADC_BUFFER_SIZE);
+                    adc_ring_view_copy(&tail, 1, adc_buffer_compat + ADC_BUFFER_SIZE, ADC_BUFFER_SIZE);
+                    
+                    // 고정된 동안에도 링은 계속 기록되므로 읽는 사이 덮어써진 레코드는 버림
+                    if (adc_dma_put_view(&view)) {
+                        publish_display_columns();
+                        adc_latest_value1 = adc_buffer_compat[count - 1];
+                        adc_latest_value2 = adc_buffer_compat[ADC_BUFFER_SIZE + count - 1];
+                        adc_buffer_index = count - 1; // 마지막 샘플 인덱스
+                    }
+                    
+                    // 다 읽었으므로 다음 레코드 획득 재개
+                    adc_dma_acq_release();
+                }
+            } else if (adc_dma_get_snapshot(ADC_BUFFER_SIZE, &view) == ESP_OK) {
+                uint32_t count = adc_ring_view_copy(&view, 0, adc_buffer_compat, ADC_BUFFER_SIZE);
+                adc_ring_view_copy(&view, 1, adc_buffer_compat + ADC_BUFFER_SIZE, ADC_BUFFER_SIZE);
+                
+                // 복사 중 덮어써진 스냅샷은 버림 (다음 주기에 다시 가져옴)
+                if (adc_dma_put_view(&view)) {
+                    adc_latest_value1 = adc_buffer_compat[count - 1];
+                    adc_latest_value2 = adc_buffer_compat[ADC_BUFFER_SIZE + count - 1];
+                    adc_buffer_index = count - 1; // 마지막 샘플 인덱스
+                }
+                
+                // 스펙트럼 모드면 시간 영역 열 대신 스펙트럼
+                // 프리런: 지난번 이후 새로 들어온 샘플만 데시메이터에 추가 (롤 표시)
+                adc_ring_view_t fresh;
+                if (adc_spectrum_points != 0) {
+                    update_display_spectrum();
+                } else if (get_adc_dma_view_since(adc_display_seq, &fresh) == ESP_OK) {
+                    push_view_to_decim(&fresh);
+                    if (adc_dma_put_view(&fresh)) {
+                        publish_display_columns();
+                    }
+                    adc_display_seq = fresh.start_seq + fresh.count;
+                }
             }
             
             vTaskDelay(pdMS_TO_TICKS(10)); // 100Hz 업데이트
@@ -256,6 +592,12 @@ static void adc_read_task(void *pvParameters) {
             // 버퍼 인덱스 업데이트
             adc_buffer_index = (adc_buffer_index + 1) % ADC_BUFFER_SIZE;
             
+            // 데시메이터에도 한 샘플씩
+            uint16_t v1 = adc_latest_value1, v2 = adc_latest_value2;
+            if (decim_push(&adc_decim[0], &v1, 1) + decim_push(&adc_decim[1], &v2, 1) > 0) {
+                publish_display_columns();
+            }
+            
             vTaskDelay(pdMS_TO_TICKS(1)); // 1000Hz 업데이트
         }
     }
@@ -268,15 +610,8 @@ uint16_t get_adc_latest_value(void) {
 
 // ADC 버퍼 접근 함수들
 uint16_t* get_adc_buffer(void) {
-    if (adc_dma_enabled) {
-        // DMA 데이터를 호환성 버퍼로 복사 (32비트 -> 16비트)
-        for (int i = 0; i < ADC_BUFFER_SIZE; i++) {
-            adc_buffer_compat[i] = (uint16_t)(adc_buffer_ch0[i] & 0xFFF); // 12비트 마스크
-            adc_buffer_compat[i + ADC_BUFFER_SIZE] = (uint16_t)(adc_buffer_ch1[i] & 0xFFF);
-        }
-        return adc_buffer_compat;
-    }
-    return adc_buffer_compat; // 폴링 모드에서도 동일한 버퍼 사용
+    // DMA/폴링 모드 모두 adc_read_task가 16비트 버퍼를 직접 채움
+    return adc_buffer_compat;
 }
 
 int get_adc_buffer_index(void) {
@@ -292,12 +627,104 @@ uint16_t get_adc_latest_value2(void) {
 }
 
 // 새로운 DMA 전용 함수들
-uint32_t* get_adc_dma_buffer_ch0(void) {
-    return adc_dma_enabled ? adc_buffer_ch0 : NULL;
+esp_err_t get_adc_dma_snapshot(uint32_t count, adc_ring_view_t *view) {
+    if (!adc_dma_enabled) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return adc_dma_get_snapshot(count, view);
 }
 
-uint32_t* get_adc_dma_buffer_ch1(void) {
-    return adc_dma_enabled ? adc_buffer_ch1 : NULL;
+esp_err_t get_adc_dma_view_since(uint32_t start_seq, adc_ring_view_t *view) {
+    if (!adc_dma_enabled) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    return adc_dma_get_view_since(start_seq, view);
+}
+
+// 화면 시간축 설정 (열당 샘플 수, 피크/평균). 다음 ADC 읽기 주기에 적용
+esp_err_t set_adc_display_timebase(uint32_t samples_per_column, decim_mode_t mode) {
+    if (samples_per_column == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    // 트리거 모드에서는 레코드 하나가 화면 한 폭이어야 함
+    if (adc_dma_enabled && samples_per_column * ADC_DISPLAY_COLUMNS > adc_dma_acq_max_length()) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    adc_display_next_spc = samples_per_column;
+    adc_display_next_mode = mode;
+    atomic_store_explicit(&adc_display_pending, true, memory_order_release);
+    return ESP_OK;
+}
+
+uint32_t get_adc_display_timebase(decim_mode_t *mode) {
+    if (mode) {
+        *mode = adc_display_mode;
+    }
+    return adc_display_spc;
+}
+
+// 스펙트럼 모드 설정 (points = 0이면 끄고 시간 영역으로). 다음 ADC 읽기 주기에 적용
+// 열 값은 0 dBFS = 4095 ~ -SPECTRUM_DISPLAY_RANGE_DB dBFS = 0, 왼쪽 DC ~ 오른쪽 fs/2
+esp_err_t set_adc_display_spectrum(uint32_t points, spectrum_window_t window) {
+    if (!adc_dma_enabled) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (points != 0 && (points < SPECTRUM_MIN_POINTS || points > SPECTRUM_MAX_POINTS ||
+                        (points & (points - 1)) != 0 || (unsigned)window >= SPECTRUM_WINDOW_COUNT)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (points > adc_dma_acq_max_length()) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    adc_spectrum_next_points = points;
+    adc_spectrum_next_window = window;
+    atomic_store_explicit(&adc_display_pending, true, memory_order_release);
+    return ESP_OK;
+}
+
+uint32_t get_adc_display_spectrum(spectrum_window_t *window) {
+    if (window) {
+        *window = adc_spectrum_window;
+    }
+    return adc_spectrum_points;
+}
+
+// 스펙트럼 모드에서 쓸 점 수 (캡처 메모리 안에서 가장 큰 2의 거듭제곱, 없으면 0)
+uint32_t get_adc_spectrum_max_points(void) {
+    uint32_t max = adc_dma_enabled ? adc_dma_acq_max_length() : 0;
+    uint32_t points = SPECTRUM_MAX_POINTS;
+    while (points > max && points >= SPECTRUM_MIN_POINTS) {
+        points >>= 1;
+    }
+    return points >= SPECTRUM_MIN_POINTS ? points : 0;
+}
+
+// 공개된 표시 열 읽기 (ch0, ch1 각각 max개까지). 읽은 열 수 반환
+// 갱신 중이면 버전이 안정될 때까지 다시 읽음 (0을 돌려주면 화면이 한 프레임 비어 깜박임)
+uint32_t get_adc_display_columns(decim_column_t *ch0, decim_column_t *ch1, uint32_t max) {
+    for (uint32_t retry = 1; ; retry++) {
+        uint32_t v0 = atomic_load_explicit(&adc_display_version, memory_order_acquire);
+        if ((v0 & 1) == 0) {
+            // 열 수는 한 번만 읽고 배열 크기로 제한 (갱신 중 바뀌어도 복사 범위는 배열 안)
+            uint32_t total = atomic_load_explicit(&adc_display_count, memory_order_relaxed);
+            if (total > ADC_DISPLAY_COLUMNS) {
+                total = ADC_DISPLAY_COLUMNS;
+            }
+            uint32_t count = (total < max) ? total : max;
+            // 오른쪽 정렬: 가장 최근 열이 마지막
+            uint32_t skip = total - count;
+            memcpy(ch0, adc_display_cols[0] + skip, count * sizeof(decim_column_t));
+            memcpy(ch1, adc_display_cols[1] + skip, count * sizeof(decim_column_t));
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&adc_display_version, memory_order_relaxed) == v0) {
+                return count;
+            }
+        }
+        // 공개하는 태스크가 같은 코어에서 선점됐을 수 있으므로 몇 번 실패하면 한 틱 양보
+        if ((retry & 3) == 0) {
+            vTaskDelay(1);
+        }
+    }
 }
 
 bool is_adc_dma_enabled(void) {
@@ -529,12 +956,12 @@ static bool test_dac(void) {
 static bool test_trigger(void) {
     ESP_LOGI(TAG, "Testing trigger...");
     
-    // 트리거 레벨 설정 (DAC 출력) - 기존 코드와 충돌하므로 주석 처리
-    // esp_err_t ret = dac_output_voltage(DAC_CHANNEL_1, 128); // 중간 레벨
-    // if (ret != ESP_OK) {
-    //     ESP_LOGE(TAG, "Trigger DAC output failed: %s", esp_err_to_name(ret));
-    //     return false;
-    // }
+    // 트리거 레벨 설정 (GPIO25 DAC 출력, 중간 레벨)
+    esp_err_t ret = adc_dma_set_trigger_level(128);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Trigger DAC output failed: %s", esp_err_to_name(ret));
+        return false;
+    }
     
     // 트리거 핀 상태 읽기
     int trig0_level = gpio_get_level(GPIO_TRIG0);
@@ -543,9 +970,6 @@ static bool test_trigger(void) {
     ESP_LOGI(TAG, "TRIG0 level: %d", trig0_level);
     ESP_LOGI(TAG, "TRIG1 level: %d", trig1_level);
     
-    // DAC 출력 끄기
-    // dac_output_voltage(DAC_CHANNEL_1, 0);
-    
     ESP_LOGI(TAG, "Trigger test passed");
     return true;
 }
@@ -4,6 +4,12 @@
 #include "esp_err.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include "adc_ring.h"
+#include "decimate.h"
+#include "spectrum.h"
+
+// 화면 그래프 폭 (열 = 픽셀)
+#define ADC_DISPLAY_COLUMNS 250
 
 // 테스트 결과 구조체
 typedef struct {
@@ -25,7 +31,20 @@ esp_err_t run_hardware_test(hardware_test_results_t *results);
 // 테스트 결과 출력
 void print_hardware_test_results(const hardware_test_results_t *results);
 
+// CH423 출력: 핀 하나 바로 쓰기
 esp_err_t ch423_set_output(uint8_t pin, bool state);
+
+// CH423 출력 배치: begin -> set ... -> commit. commit은 마지막으로 쓴 값과 비교해
+// 바뀐 OC 바이트만 한 트랜잭션으로 보낸다. 중첩 가능 (가장 바깥 commit에서 전송)
+void ch423_begin(void);
+void ch423_set(uint8_t pin, bool state);
+esp_err_t ch423_commit(void);
+void ch423_get_write_stats(uint32_t *written, uint32_t *elided);
+
+// CH423 버스 직접 접근 (ch423_service 태스크 전용, 다른 곳에서는 위 함수 사용)
+esp_err_t ch423_bus_set_speed(uint32_t clk_hz);
+esp_err_t ch423_bus_write_outputs(uint16_t value, uint32_t timeout_ms);
+esp_err_t ch423_bus_read_input(uint8_t *data, uint32_t timeout_ms);
 esp_err_t ch423_read_input(uint8_t *data);
 
 // ADC 함수들 (기존 호환성 유지)
@@ -36,9 +55,19 @@ uint16_t get_adc_latest_value1(void);
 uint16_t get_adc_latest_value2(void);
 
 // 새로운 ADC DMA 전용 함수들
-uint32_t* get_adc_dma_buffer_ch0(void);
-uint32_t* get_adc_dma_buffer_ch1(void);
+esp_err_t get_adc_dma_snapshot(uint32_t count, adc_ring_view_t *view);
+esp_err_t get_adc_dma_view_since(uint32_t start_seq, adc_ring_view_t *view);
 bool is_adc_dma_enabled(void);
+
+// 화면용 데시메이션 (열당 samples_per_column 샘플을 min/max 또는 평균으로)
+esp_err_t set_adc_display_timebase(uint32_t samples_per_column, decim_mode_t mode);
+uint32_t get_adc_display_timebase(decim_mode_t *mode);
+uint32_t get_adc_display_columns(decim_column_t *ch0, decim_column_t *ch1, uint32_t max);
+
+// 스펙트럼 모드 (points = 0이면 끔). 켜져 있으면 get_adc_display_columns가 dB 스펙트럼 열을 돌려줌
+esp_err_t set_adc_display_spectrum(uint32_t points, spectrum_window_t window);
+uint32_t get_adc_display_spectrum(spectrum_window_t *window);
+uint32_t get_adc_spectrum_max_points(void);
 esp_err_t get_adc_statistics(uint32_t *min_ch0, uint32_t *max_ch0, uint32_t *avg_ch0,
                             uint32_t *min_ch1, uint32_t *max_ch1, uint32_t *avg_ch1);
 
@@ -0,0 +1,89 @@
+#include <string.h>
+#include "input_events.h"
+
+// 초기화
+void input_events_init(input_events_t *ev, uint8_t threshold)
+{
+    memset(ev, 0, sizeof(*ev));
+    ev->threshold = threshold > 0 ? threshold : 1;
+    atomic_init(&ev->head, 0);
+    atomic_init(&ev->tail, 0);
+    atomic_init(&ev->dropped, 0);
+}
+
+static void input_events_push(input_events_t *ev, const input_event_t *e)
+{
+    uint32_t head = atomic_load_explicit(&ev->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ev->tail, memory_order_acquire);
+
+    if (head - tail >= INPUT_EVENTS_QUEUE_LEN) {
+        atomic_fetch_add_explicit(&ev->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    ev->queue[head & (INPUT_EVENTS_QUEUE_LEN - 1)] = *e;
+    atomic_store_explicit(&ev->head, head + 1, memory_order_release);
+}
+
+// 원시 입력 넣기
+uint8_t input_events_feed(input_events_t *ev, uint8_t raw, int64_t now_us)
+{
+    if (!ev->primed) {
+        ev->stable = raw;
+        ev->primed = true;
+        return 0;
+    }
+
+    uint8_t diff = raw ^ ev->stable;
+    uint8_t changed = 0;
+
+    for (int b = 0; b < INPUT_EVENTS_BITS; b++) {
+        uint8_t m = (uint8_t)(1u << b);
+        if (!(diff & m)) {
+            // 확정 값으로 돌아옴 (바운스) - 처음부터 다시
+            ev->count[b] = 0;
+            continue;
+        }
+        if (ev->count[b] == 0) {
+            ev->since[b] = now_us;
+        }
+        if (++ev->count[b] < ev->threshold) {
+            continue;
+        }
+
+        ev->stable ^= m;
+        ev->count[b] = 0;
+        changed |= m;
+
+        input_event_t e = {
+            .time_us = ev->since[b],
+            .bit = (uint8_t)b,
+            .level = (raw & m) != 0,
+        };
+        input_events_push(ev, &e);
+    }
+    return changed;
+}
+
+bool input_events_settling(const input_events_t *ev)
+{
+    for (int b = 0; b < INPUT_EVENTS_BITS; b++) {
+        if (ev->count[b] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 이벤트 꺼내기
+bool input_events_pop(input_events_t *ev, input_event_t *out)
+{
+    uint32_t tail = atomic_load_explicit(&ev->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ev->head, memory_order_acquire);
+
+    if (tail == head) {
+        return false;
+    }
+    *out = ev->queue[tail & (INPUT_EVENTS_QUEUE_LEN - 1)];
+    atomic_store_explicit(&ev->tail, tail + 1, memory_order_release);
+    return true;
+}
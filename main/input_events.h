@@ -0,0 +1,73 @@
+#ifndef INPUT_EVENTS_H
+#define INPUT_EVENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 입력 바이트 디바운스 + 에지 이벤트 큐 (단일 생산자 / 단일 소비자, 락 없음)
+//
+// - 생산자: 입력을 폴링하는 태스크가 input_events_feed()로 원시 바이트를 넣는다.
+//   비트마다 같은 값이 threshold번 연속으로 보이면 확정하고, 확정 값이 바뀌면
+//   처음 바뀐 것이 보인 시각을 붙여 이벤트를 큐에 넣는다.
+// - 소비자: UI가 input_events_pop()으로 꺼낸다. 프레임 사이의 짧은 눌림도 남는다.
+// - 큐가 가득 차면 새 이벤트를 버리고 dropped를 센다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define INPUT_EVENTS_BITS       8
+#define INPUT_EVENTS_QUEUE_LEN  32      // 2의 거듭제곱
+
+typedef struct {
+    int64_t time_us;        // 원시 입력이 처음 새 값으로 바뀐 폴링 시각
+    uint8_t bit;            // 입력 비트 번호 (0~7)
+    bool level;             // 확정된 새 논리 레벨
+} input_event_t;
+
+typedef struct {
+    // 디바운스 (생산자 전용)
+    uint8_t threshold;                      // 확정에 필요한 연속 일치 횟수
+    bool primed;                            // 첫 입력으로 초기 상태를 잡았는지
+    uint8_t stable;                         // 확정 값
+    uint8_t count[INPUT_EVENTS_BITS];       // 확정 값과 다른 값이 연속으로 보인 횟수
+    int64_t since[INPUT_EVENTS_BITS];       // 다른 값이 처음 보인 시각
+
+    // 이벤트 큐
+    input_event_t queue[INPUT_EVENTS_QUEUE_LEN];
+    _Atomic uint32_t head;                  // 생산자가 다음에 쓸 위치 (누적)
+    _Atomic uint32_t tail;                  // 소비자가 다음에 읽을 위치 (누적)
+    _Atomic uint32_t dropped;
+} input_events_t;
+
+// 초기화 (threshold는 1 이상)
+void input_events_init(input_events_t *ev, uint8_t threshold);
+
+// 원시 입력 바이트 하나 넣기 (생산자). 확정 값이 바뀐 비트 마스크 반환
+uint8_t input_events_feed(input_events_t *ev, uint8_t raw, int64_t now_us);
+
+// 확정 대기 중인 비트가 있으면 true (생산자가 폴링 주기를 줄일 때 사용)
+bool input_events_settling(const input_events_t *ev);
+
+// 확정 값 (생산자)
+static inline uint8_t input_events_stable(const input_events_t *ev)
+{
+    return ev->stable;
+}
+
+// 이벤트 하나 꺼내기 (소비자). 없으면 false
+bool input_events_pop(input_events_t *ev, input_event_t *out);
+
+// 큐가 가득 차서 버린 이벤트 수
+static inline uint32_t input_events_dropped(input_events_t *ev)
+{
+    return atomic_load_explicit(&ev->dropped, memory_order_relaxed);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INPUT_EVENTS_H
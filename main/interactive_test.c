@@ -9,34 +9,27 @@
 #include "esp_timer.h"
 #include "ft800.h"
 #include "hardware_test.h"
+#include "waveform_render.h"
+#include "ui_dl_cache.h"
+#include "render_sched.h"
+#include "bus_stats.h"
+#include "ch423_service.h"
+#include "rotary_encoder.h"
+#include "sample_stream.h"
+#include "stream_frame.h"
+#include "adc_calib.h"
+#include "adc_dma_continuous.h"
 #include "analog_test_simple.h"
 
 static const char *TAG = "INTERACTIVE_TEST";
 
-// 공용 변수 - 인코더 카운터 (태스크 간 공유)
-static volatile int g_re0_counter = 0;
-static volatile int g_re1_counter = 0;
-static volatile bool g_re0_pressed = false;
-static volatile bool g_re1_pressed = false;
+// 인코더 카운터 (UI 태스크 전용: rotary_encoder에서 가져온 클릭 누적, 처리 후 리셋)
+static int g_re0_counter = 0;
+static int g_re1_counter = 0;
 
-// 인코더 폴링 관련 변수
-static int re0_last_state = 0;
-static int re1_last_state = 0;
-
-// 버튼 폴링 관련 변수
-static bool button_polling_enabled = false;
-static uint8_t last_button_state = 0xFF; // 초기값 (모든 버튼이 눌리지 않은 상태)
-
-// 인코더 인터럽트 관련 변수
-static QueueHandle_t encoder_queue = NULL;
-static volatile bool encoder_interrupt_enabled = false;
-
-// 인코더 인터럽트 데이터 구조체
-typedef struct {
-    uint8_t encoder_id;  // 0: RE0, 1: RE1
-    bool direction;      // true: clockwise, false: counter-clockwise
-    uint64_t timestamp;
-} encoder_interrupt_data_t;
+// 인코더 속도 가속 (스코프 조작에서 빠르게 돌리면 큰 단위로)
+static quad_accel_t re0_accel;
+static quad_accel_t re1_accel;
 
 // CH423 I2C 주소 (기존 코드와 맞춤)
 // CH423_I2C_ADDR는 analog_test_simple.h에서 이미 정의됨
@@ -49,6 +42,12 @@ typedef struct {
 #define GPIO_TRIG0 9
 #define GPIO_TRIG1 10
 
+// 릴레이 테스트 모드 점멸 주기
+#define RELAY_BLINK_PERIOD_US 1000000
+
+// 인코더 백엔드 (PCNT: 에지마다 인터럽트 없음, ADC DMA 부하가 커도 CPU를 깨우지 않음)
+#define ENCODER_BACKEND ROTARY_BACKEND_PCNT
+
 // CH423 출력 핀 정의
 #define CH423_OC_BACKLIGHT 1
 #define CH423_OC_LED0 12
@@ -101,7 +100,7 @@ typedef struct {
     int gain_test_mode;  // 릴레이 테스트 모드
     int gain_state[6]; // 0번 AC/DC, 1차, 2차 | 1번 AC/DC, 1차, 2차
     int gain_selected_state; // 0-5
-    int relay_blink_count;  // 점멸 카운터
+    int64_t relay_blink_time;  // 마지막 점멸 시각 (us)
 } relay_control_t;
 
 // 입력 상태 구조체
@@ -131,153 +130,51 @@ typedef struct {
     // 인코더 카운터
     int re0_counter;
     int re1_counter;
+    
+    // 이번 프레임 인코더 변화량 (속도 가속 적용)
+    int re0_steps;
+    int re1_steps;
 } input_status_t;
 
 static led_control_t led_ctrl = {0};
 static relay_control_t relay_ctrl = {0};
 static input_status_t input_status = {0};
 
+// 스코프 조작 모드 (RE0 푸시로 전환): RE0 = 시간축, RE1 = 트리거 레벨
+typedef struct {
+    bool active;
+    int trigger_level;  // 트리거 DAC 값 (0-255)
+} scope_control_t;
 
-uint64_t encoder_last_time[2] = {0U,0U};
-// 인코더 인터럽트 ISR 핸들러
-static void IRAM_ATTR encoder_isr_handler(void* arg) {
-    if (!encoder_interrupt_enabled) return;
-    
-    // 어떤 인코더에서 인터럽트가 발생했는지 확인
-    uint32_t gpio_num = (uint32_t)arg;
-    encoder_interrupt_data_t data;
-    
-    if (gpio_num == GPIO_RE1A && gpio_get_level(GPIO_RE1A) == 1) {
-        data.encoder_id = 1; // RE1
-        // RE1A 상승엣지에서 RE1B 상태 확인
-        data.direction = gpio_get_level(GPIO_RE1B) == 1; // B=1이면 시계방향
-    } else if (gpio_num == GPIO_RE0B && gpio_get_level(GPIO_RE0B) == 1) {
-        data.encoder_id = 0; // RE0
-        // RE0B 상승엣지에서 RE0A 상태 확인
-        data.direction = gpio_get_level(GPIO_RE0A) == 0; // A=0이면 시계방향
-    } else {
-        return; // 알 수 없는 핀
-    }
-    
-    data.timestamp = esp_timer_get_time();
-
-    if(data.timestamp - encoder_last_time[data.encoder_id] > 500) { // 5ms 이하  차이나면 인터럽트 무시
-        encoder_last_time[data.encoder_id] = data.timestamp;
-    } else {
-        return;
-    }
-    
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    xQueueSendFromISR(encoder_queue, &data, &xHigherPriorityTaskWoken);
-    if (xHigherPriorityTaskWoken) {
-        portYIELD_FROM_ISR();
-    }
-}
-
-// 인코더 전용 태스크 (인터럽트 방식으로 변경됨)
-static void encoder_task(void *pvParameters) {
-    ESP_LOGI(TAG, "Encoder task started (interrupt mode)");
-    
-    // 초기 상태 읽기 (인터럽트 방식에서는 사용하지 않음)
-    re0_last_state = (gpio_get_level(GPIO_RE0A) << 1) | gpio_get_level(GPIO_RE0B);
-    re1_last_state = (gpio_get_level(GPIO_RE1A) << 1) | gpio_get_level(GPIO_RE1B);
-    
-    while (1) {
-        // 인터럽트 방식으로 변경되었으므로 폴링 로직 제거
-        // 인터럽트에서 카운터가 업데이트됨
-        vTaskDelay(pdMS_TO_TICKS(100)); // 10Hz로 변경 (인터럽트 방식이므로 느려도 됨)
-    }
-}
+static scope_control_t scope_ctrl = { .active = false, .trigger_level = 128 };
 
-// 인코더 인터럽트 처리 태스크
-static void encoder_interrupt_task(void *pvParameters) {
-    ESP_LOGI(TAG, "Encoder interrupt task started");
+// 버튼 눌림 (서비스 태스크의 에지 이벤트 사용, 버튼은 active low)
+static void update_button_events(void) {
+    input_event_t ev;
     
-    encoder_interrupt_data_t data;
+    input_status.sw0_pressed = false;
+    input_status.sw1_pressed = false;
+    input_status.sw2_pressed = false;
+    input_status.sw3_pressed = false;
+    input_status.re0_pressed = false;
+    input_status.re1_pressed = false;
     
-    while (1) {
-        if (xQueueReceive(encoder_queue, &data, portMAX_DELAY) == pdTRUE) {
-            ESP_LOGI(TAG, "Encoder interrupt: id=%d, dir=%s, time=%llu", 
-                     data.encoder_id, data.direction ? "CW" : "CCW", data.timestamp);
-            
-            // 인코더 카운터 업데이트
-            if (data.encoder_id == 0) { // RE0
-                if (data.direction) {
-                    g_re0_counter++;
-                } else {
-                    g_re0_counter--;
-                }
-            } else if (data.encoder_id == 1) { // RE1
-                if (data.direction) {
-                    g_re1_counter++;
-                } else {
-                    g_re1_counter--;
-                }
-            }
+    while (ch423_service_pop_event(&ev)) {
+        if (ev.level) {
+            continue;   // 뗌
+        }
+        switch (ev.bit) {
+            case CH423_IO_SW0: input_status.sw0_pressed = true; break;
+            case CH423_IO_SW1: input_status.sw1_pressed = true; break;
+            case CH423_IO_SW2: input_status.sw2_pressed = true; break;
+            case CH423_IO_SW3: input_status.sw3_pressed = true; break;
+            case CH423_IO_RE0P: input_status.re0_pressed = true; break;
+            case CH423_IO_RE1P: input_status.re1_pressed = true; break;
+            default: break;
         }
     }
 }
 
-
-// 인코더 인터럽트 설정
-static esp_err_t setup_encoder_interrupts(void) {
-    // 인코더 인터럽트 큐 생성
-    encoder_queue = xQueueCreate(20, sizeof(encoder_interrupt_data_t));
-    if (encoder_queue == NULL) {
-        ESP_LOGE(TAG, "Failed to create encoder queue");
-        return ESP_FAIL;
-    }
-    
-    // 인코더 A 핀들을 상승엣지 인터럽트로 설정
-    gpio_config_t io_conf = {
-        .pin_bit_mask = (1ULL << GPIO_RE1A),
-        .mode = GPIO_MODE_INPUT,
-        .pull_up_en = GPIO_PULLUP_ENABLE,
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_NEGEDGE, // 상승엣지
-    };
-    
-    esp_err_t ret = gpio_config(&io_conf);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "GPIO config 1 failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    // 인코더 A 핀들을 상승엣지 인터럽트로 설정
-    io_conf.pin_bit_mask = (1ULL << GPIO_RE0B);
-    io_conf.intr_type = GPIO_INTR_POSEDGE; // 상승엣지
-    
-    ret = gpio_config(&io_conf);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "GPIO config 2 failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    // 인터럽트 핸들러 설치 (이미 설치되어 있을 수 있음)
-    ret = gpio_install_isr_service(0);
-    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
-        ESP_LOGE(TAG, "GPIO ISR service install failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    // RE1A 인터럽트 핸들러 추가
-    ret = gpio_isr_handler_add(GPIO_RE1A, encoder_isr_handler, (void*)GPIO_RE1A);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "GPIO RE1A ISR handler add failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    // RE0B 인터럽트 핸들러 추가
-    ret = gpio_isr_handler_add(GPIO_RE0B, encoder_isr_handler, (void*)GPIO_RE0B);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "GPIO RE0B ISR handler add failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    
-    encoder_interrupt_enabled = true;
-    ESP_LOGI(TAG, "Encoder interrupts configured successfully");
-    return ESP_OK;
-}
-
 // 입력 상태 업데이트
 static void update_input_status(void) {
     // 로터리 인코더 상태 읽기
@@ -286,9 +183,17 @@ static void update_input_status(void) {
     input_status.re1_a = gpio_get_level(GPIO_RE1A);
     input_status.re1_b = gpio_get_level(GPIO_RE1B);
     
-    // 공용 변수에서 인코더 카운터 가져오기
+    // 새로 완성된 클릭을 가져와 누적 (디코딩은 ISR에서 끝남)
+    int64_t now = esp_timer_get_time();
+    int32_t re0_detents = rotary_encoder_take_detents(0);
+    int32_t re1_detents = rotary_encoder_take_detents(1);
+    g_re0_counter += re0_detents;
+    g_re1_counter += re1_detents;
     input_status.re0_counter = g_re0_counter;
     input_status.re1_counter = g_re1_counter;
+    // 클릭이 없어도 매 프레임 불러야 속도가 줄어듦
+    input_status.re0_steps = quad_accel_apply(&re0_accel, re0_detents, now);
+    input_status.re1_steps = quad_accel_apply(&re1_accel, re1_detents, now);
     
     // 트리거 상태 읽기
     input_status.trig0_active = !gpio_get_level(GPIO_TRIG0); // Active LOW
@@ -302,6 +207,12 @@ static void update_input_status(void) {
         input_status.battery_charging = (input_data & (1 << CH423_IO_CHRG)) != 0;
         input_status.battery_standby = (input_data & (1 << CH423_IO_STDBY)) != 0;
         
+        if (ch423_service_running()) {
+            // 디바운스된 에지 이벤트로 눌림 판정 (프레임 사이의 짧은 눌림도 놓치지 않음)
+            update_button_events();
+            return;
+        }
+        
         // 버튼 상태를 여기서 직접 관리
         static bool prev_sw0 = false, prev_sw1 = false, prev_sw2 = false, prev_sw3 = false;
         static bool prev_re0 = false, prev_re1 = false;
@@ -352,106 +263,161 @@ static void reset_encoder_counters(void) {
 }
 
 static void gain_test_mode_update(int* gain_state){
-
+    // 12개 핀을 모아 바뀐 바이트만 한 번에 씀
+    ch423_begin();
 
     switch(gain_state[0]){
         case 0://AC - 현재는 CONNECT (AC/DC와 관계없음)
-            ch423_set_output(CH423_OC_Q1, false);
+            ch423_set(CH423_OC_Q1, false);
             break;
         case 1://DC - 현재는 NO_CONECT (AC/DC와 관계없음)
-            ch423_set_output(CH423_OC_Q1, true);
+            ch423_set(CH423_OC_Q1, true);
             break;
     }
 
     switch(gain_state[1]){
         case 0: // 1차 1x
-            ch423_set_output(CH423_OC_Q3, false);
-            ch423_set_output(CH423_OC_Q4, false);
+            ch423_set(CH423_OC_Q3, false);
+            ch423_set(CH423_OC_Q4, false);
             break;
         case 1: // 1차 1/10x
-            ch423_set_output(CH423_OC_Q3, true);
-            ch423_set_output(CH423_OC_Q4, false);
+            ch423_set(CH423_OC_Q3, true);
+            ch423_set(CH423_OC_Q4, false);
             break;
         case 2: // 1차 1/91.9x
-            ch423_set_output(CH423_OC_Q3, false);
-            ch423_set_output(CH423_OC_Q4, true);
+            ch423_set(CH423_OC_Q3, false);
+            ch423_set(CH423_OC_Q4, true);
             break;
         case 3: // 1차 invalid (1/101x)
-            ch423_set_output(CH423_OC_Q3, true);
-            ch423_set_output(CH423_OC_Q4, true);
+            ch423_set(CH423_OC_Q3, true);
+            ch423_set(CH423_OC_Q4, true);
             break;
     }
 
     switch(gain_state[2]){
         case 0: // 2차 1x
-            ch423_set_output(CH423_OC_Q6, false);
-            ch423_set_output(CH423_OC_Q5, false);
+            ch423_set(CH423_OC_Q6, false);
+            ch423_set(CH423_OC_Q5, false);
             break;
         case 1: // 2차 1/2x
-            ch423_set_output(CH423_OC_Q6, true);
-            ch423_set_output(CH423_OC_Q5, false);
+            ch423_set(CH423_OC_Q6, true);
+            ch423_set(CH423_OC_Q5, false);
             break;
         case 2: // 2차 1/5x
-            ch423_set_output(CH423_OC_Q6, false);
-            ch423_set_output(CH423_OC_Q5, true);
+            ch423_set(CH423_OC_Q6, false);
+            ch423_set(CH423_OC_Q5, true);
             break;
         case 3: // 2차 invalid (1/6x)
-            ch423_set_output(CH423_OC_Q6, true);
-            ch423_set_output(CH423_OC_Q5, true);
+            ch423_set(CH423_OC_Q6, true);
+            ch423_set(CH423_OC_Q5, true);
             break;
     }
     
     switch(gain_state[3]){
         case 0://AC - 현재는 CONNECT (AC/DC와 관계없음)
-            ch423_set_output(CH423_OC_Q7, false);
+            ch423_set(CH423_OC_Q7, false);
             break;
         case 1://DC - 현재는 NO_CONECT (AC/DC와 관계없음)
-            ch423_set_output(CH423_OC_Q7, true);
+            ch423_set(CH423_OC_Q7, true);
             break;
     }
 
     switch(gain_state[4]){
         case 0: // 1차 1x
-            ch423_set_output(CH423_OC_Q9, false);
-            ch423_set_output(CH423_OC_Q10, false);
+            ch423_set(CH423_OC_Q9, false);
+            ch423_set(CH423_OC_Q10, false);
             break;
         case 1: // 1차 1/10x
-            ch423_set_output(CH423_OC_Q9, true);
-            ch423_set_output(CH423_OC_Q10, false);
+            ch423_set(CH423_OC_Q9, true);
+            ch423_set(CH423_OC_Q10, false);
             break;
         case 2: // 1차 1/91.9x
-            ch423_set_output(CH423_OC_Q9, false);
-            ch423_set_output(CH423_OC_Q10, true);
+            ch423_set(CH423_OC_Q9, false);
+            ch423_set(CH423_OC_Q10, true);
             break;
         case 3: // 1차 invalid (1/101x)
-            ch423_set_output(CH423_OC_Q9, true);
-            ch423_set_output(CH423_OC_Q10, true);
+            ch423_set(CH423_OC_Q9, true);
+            ch423_set(CH423_OC_Q10, true);
             break;
     }
 
     switch(gain_state[5]){
         case 0: // 2차 1x
-            ch423_set_output(CH423_OC_Q12, false);
-            ch423_set_output(CH423_OC_Q11, false);
+            ch423_set(CH423_OC_Q12, false);
+            ch423_set(CH423_OC_Q11, false);
             break;
         case 1: // 2차 1/2x
-            ch423_set_output(CH423_OC_Q12, true);
-            ch423_set_output(CH423_OC_Q11, false);
+            ch423_set(CH423_OC_Q12, true);
+            ch423_set(CH423_OC_Q11, false);
             break;
         case 2: // 2차 1/5x
-            ch423_set_output(CH423_OC_Q12, false);
-            ch423_set_output(CH423_OC_Q11, true);
+            ch423_set(CH423_OC_Q12, false);
+            ch423_set(CH423_OC_Q11, true);
             break;
         case 3: // 2차 invalid (1/6x)
-            ch423_set_output(CH423_OC_Q12, true);
-            ch423_set_output(CH423_OC_Q11, true);
+            ch423_set(CH423_OC_Q12, true);
+            ch423_set(CH423_OC_Q11, true);
             break;
     }
+    ch423_commit();
+
+    // 변환표는 릴레이가 실제로 바뀐 채널만 다시 만듦
+    for (int ch = 0; ch < ADC_CALIB_CHANNELS; ch++) {
+        adc_front_end_t fe = { gain_state[ch * 3], gain_state[ch * 3 + 1], gain_state[ch * 3 + 2] };
+        adc_calib_set_front_end(ch, &fe);
+    }
+
+    // 스트림 프레임 헤더에도 현재 감쇠 상태를 실음
+    sample_stream_set_gain_state(STREAM_GAIN_BYTE(gain_state[0], gain_state[1], gain_state[2]) |
+                                 (STREAM_GAIN_BYTE(gain_state[3], gain_state[4], gain_state[5]) << 8));
+}
+
+// 스코프 조작 (RE0: 시간축, RE1: 트리거 레벨, 빠르게 돌리면 큰 단위, RE1 푸시: 스펙트럼 창 순환)
+static void update_scope_control(void) {
+    if (!scope_ctrl.active) return;
+    
+    if (input_status.re0_steps != 0) {
+        decim_mode_t mode;
+        int32_t spc = (int32_t)get_adc_display_timebase(&mode) + input_status.re0_steps;
+        int32_t max_spc = (int32_t)(adc_dma_acq_max_length() / ADC_DISPLAY_COLUMNS);
+        if (spc < 1) spc = 1;
+        if (spc > max_spc) spc = max_spc;
+        set_adc_display_timebase((uint32_t)spc, mode);
+    }
+    
+    if (input_status.re1_steps != 0) {
+        int level = scope_ctrl.trigger_level + input_status.re1_steps;
+        if (level < 0) level = 0;
+        if (level > 255) level = 255;
+        if (level != scope_ctrl.trigger_level) {
+            scope_ctrl.trigger_level = level;
+            adc_dma_set_trigger_level((uint8_t)level);
+        }
+    }
+    
+    // RE1 푸시: 스펙트럼 꺼짐 -> HANN -> BLACKMAN-HARRIS -> FLATTOP -> 꺼짐
+    if (input_status.re1_pressed) {
+        spectrum_window_t window;
+        uint32_t points = get_adc_display_spectrum(&window);
+        if (points == 0) {
+            points = get_adc_spectrum_max_points();
+            window = SPECTRUM_WINDOW_HANN;
+        } else if (window + 1 < SPECTRUM_WINDOW_COUNT) {
+            window = (spectrum_window_t)(window + 1);
+        } else {
+            points = 0;
+        }
+        esp_err_t ret = set_adc_display_spectrum(points, window);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Spectrum mode unavailable: %s", esp_err_to_name(ret));
+        }
+    }
+    reset_encoder_counters(); // 다른 모드로 넘어가지 않도록
 }
 
 // LED 상태 업데이트 (공용 변수 사용)
 static void update_led_states(void) {
-    if(relay_ctrl.gain_test_mode || relay_ctrl.relay_test_mode)return;
+    if(scope_ctrl.active || relay_ctrl.gain_test_mode || relay_ctrl.relay_test_mode)return;
     // RE0으로 LED 선택 변경
     if (input_status.re0_counter != 0) {
         int change = input_status.re0_counter > 0 ? 1 : -1;
@@ -476,16 +442,18 @@ static void update_led_states(void) {
         reset_encoder_counters(); // 공용 변수 카운터 리셋
     }
     
-    // LED 상태를 CH423에 적용 (실패해도 계속 진행)
-    ch423_set_output(CH423_OC_LED0, led_ctrl.led0_state);
-    ch423_set_output(CH423_OC_LED1, led_ctrl.led1_state);
-    ch423_set_output(CH423_OC_LEDRE0, led_ctrl.ledre0_state);
-    ch423_set_output(CH423_OC_LEDRE1, led_ctrl.ledre1_state);
+    // LED 상태를 CH423에 적용 (실패해도 계속 진행, 바뀐 바이트만 전송)
+    ch423_begin();
+    ch423_set(CH423_OC_LED0, led_ctrl.led0_state);
+    ch423_set(CH423_OC_LED1, led_ctrl.led1_state);
+    ch423_set(CH423_OC_LEDRE0, led_ctrl.ledre0_state);
+    ch423_set(CH423_OC_LEDRE1, led_ctrl.ledre1_state);
+    ch423_commit();
 }
 
 // gain test 관련 컨트롤 함수 (공용 변수 사용)
 static void update_gain_test(void) {
-    if(!relay_ctrl.gain_test_mode)return;
+    if(scope_ctrl.active || !relay_ctrl.gain_test_mode)return;
 
     // RE0으로 LED 선택 변경
     if (input_status.re0_counter != 0) {
@@ -517,238 +485,330 @@ static void update_relay_states(void) {
     if(!relay_ctrl.relay_test_mode)return;
     // 릴레이 테스트 모드에서 점멸
     if (relay_ctrl.relay_test_mode) {
-        relay_ctrl.relay_blink_count++;
-        if (relay_ctrl.relay_blink_count >= 10) { // 1초마다 토글 (10 * 100ms)
+        // 프레임 주기와 무관하게 1초마다 토글
+        int64_t now = esp_timer_get_time();
+        if (now - relay_ctrl.relay_blink_time >= RELAY_BLINK_PERIOD_US) {
             relay_ctrl.relay1_state = !relay_ctrl.relay1_state;
             relay_ctrl.relay2_state = !relay_ctrl.relay2_state;
             relay_ctrl.relay3_state = !relay_ctrl.relay3_state;
             relay_ctrl.relay4_state = !relay_ctrl.relay4_state;
-            relay_ctrl.relay_blink_count = 0;
+            relay_ctrl.relay_blink_time = now;
         }
     }
     
-    // 릴레이 상태를 CH423에 적용
-    ch423_set_output(CH423_OC_RELAY1, relay_ctrl.relay1_state);
-    ch423_set_output(CH423_OC_RELAY2, relay_ctrl.relay2_state);
-    ch423_set_output(CH423_OC_RELAY3, relay_ctrl.relay3_state);
-    ch423_set_output(CH423_OC_RELAY4, relay_ctrl.relay4_state);
+    // 릴레이 상태를 CH423에 적용 (바뀐 바이트만 전송)
+    ch423_begin();
+    ch423_set(CH423_OC_RELAY1, relay_ctrl.relay1_state);
+    ch423_set(CH423_OC_RELAY2, relay_ctrl.relay2_state);
+    ch423_set(CH423_OC_RELAY3, relay_ctrl.relay3_state);
+    ch423_set(CH423_OC_RELAY4, relay_ctrl.relay4_state);
+    ch423_commit();
 }
 
 // UI 그리기
-static void draw_ui(void) {
+// 화면 표시용 열 (interactive_draw_frame 전용)
+static decim_column_t display_cols[2][ADC_DISPLAY_COLUMNS];
+
+// 정적 UI(테두리, 제목, 메뉴 글씨, 안내문, LED 하이라이트) 캐시
+static ui_dl_cache_t ui_chrome_cache;
+
+#define UI_GRAPH_X          200
+#define UI_GRAPH_Y          25
+#define UI_GRAPH_WIDTH      ADC_DISPLAY_COLUMNS
+#define UI_GRAPH_HEIGHT     180
+
+// 1이면 화면 오른쪽 아래에 버스 사용량 (SPI: 직전 프레임, I2C: 직전 1초)
+#define UI_BUS_STATS_OVERLAY    0
+
+// 자동 측정 한 줄 (진폭은 변환표로 프로브 전압 환산)
+static void format_measurement(int ch, char *text, size_t len) {
+    meas_result_t r;
+    if (adc_dma_get_measurement(ch, &r) != ESP_OK) {
+        snprintf(text, len, "CH%d: --", ch + 1);
+        return;
+    }
+    // raw 1 카운트당 uV (표는 raw에 대해 직선)
+    float uv_per_count = (adc_calib_uv(ch, 4095) - adc_calib_uv(ch, 0)) / 4095.0f;
+    float vpp = (adc_calib_uv(ch, r.max) - adc_calib_uv(ch, r.min)) * 1e-6f;
+    float vrms = r.ac_rms * uv_per_count * 1e-6f;
+    float mean = (adc_calib_uv(ch, 0) + r.mean * uv_per_count) * 1e-6f;
+
+    int n = snprintf(text, len, "CH%d: Vpp %.2fV Vrms %.2fV Mean %.2fV", ch + 1, vpp, vrms, mean);
+    if (r.valid & MEAS_VALID_FREQ) {
+        n += snprintf(text + n, len - n, " %.1fHz Duty %.0f%%", r.frequency_hz, r.duty_pct);
+    }
+    if (r.valid & MEAS_VALID_RISE) {
+        snprintf(text + n, len - n, " Rise %.2fms", r.rise_us * 1e-3f);
+    }
+}
+
+// 정적 UI가 달라지는 상태: 모드와 선택된 LED
+static uint32_t ui_chrome_key(void) {
+    return (relay_ctrl.gain_test_mode ? 1u : 0u)
+         | (relay_ctrl.relay_test_mode ? 2u : 0u)
+         | ((uint32_t)led_ctrl.selected_led << 2)
+         | (scope_ctrl.active ? 1u << 8 : 0u);
+}
+
+// 화면 배치. chrome이 true면 정적 부분만, false면 매 프레임 바뀌는 부분만 그린다.
+// 두 경우 모두 같은 순서로 y를 진행하므로 배치는 여기 한 곳에만 있다
+static void draw_ui_layout(bool chrome) {
     char status_text[200];
     
     int y = 0, inc = 15;
-	cmd(CMD_DLSTART);
-    // 배경색 설정
-    cmd(COLOR_RGB(0x20, 0x20, 0x20));
-    cmd(CLEAR(1, 1, 1));
-    
-    cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-    // ADC 값 표시
-    sprintf(status_text, "ADC1: %d, ADC2: %d", get_adc_latest_value1(), get_adc_latest_value2());
-    cmd_text(10, y, 20, 0, status_text);
-    y+=inc;
-    // ADC 그래프 그리기
-    cmd(COLOR_RGB(0x00, 0xFF, 0x00)); // 초록색 (ADC1)
-    cmd(BEGIN(LINES));
-    uint16_t* adc_buffer = get_adc_buffer();
-    int buffer_index = get_adc_buffer_index();
-    int graph_width = 250;
-    int graph_height = 180;
-    int graph_x = 200;
-    int graph_y = 25;
-    
-
-    // ADC1 그래프 (초록색)
-    for (int i = 0; i < graph_width; i+=3) {
-        int buffer_pos = (buffer_index - graph_width + i + 256) % 256;
-        int adc_value = adc_buffer[buffer_pos];
-        int y_pos = graph_y + graph_height - (adc_value * graph_height / 4096);
-        
-        if (i > 0) {
-            int prev_buffer_pos = (buffer_index - graph_width + i - 3 + 256) % 256;
-            int prev_adc_value = adc_buffer[prev_buffer_pos];
-            int prev_y_pos = graph_y + graph_height - (prev_adc_value * graph_height / 4096);
-            
-            cmd(VERTEX2F((graph_x + i - 3) * 16, prev_y_pos * 16));
-            cmd(VERTEX2F((graph_x + i) * 16, y_pos * 16));
-        }
+    int graph_x = UI_GRAPH_X;
+    int graph_y = UI_GRAPH_Y;
+    int graph_width = UI_GRAPH_WIDTH;
+    int graph_height = UI_GRAPH_HEIGHT;
+
+    if (!chrome) {
+        cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+        // ADC 값 표시
+        sprintf(status_text, "ADC1: %d, ADC2: %d", get_adc_latest_value1(), get_adc_latest_value2());
+        cmd_text(10, y, 20, 0, status_text);
     }
-    cmd(END());
-    
-    
-    // ADC2 그래프 (파란색)
-    cmd(COLOR_RGB(0x00, 0x00, 0xFF));
-    cmd(BEGIN(LINES));
-    for (int i = 0; i < graph_width; i+=3) {
-        int buffer_pos = (buffer_index - graph_width + i + 256) % 256;
-        int adc_value = adc_buffer[buffer_pos + 256]; // ADC2는 버퍼의 후반부
-        int y_pos = graph_y + graph_height - (adc_value * graph_height / 4096);
-        
-        if (i > 0) {
-            int prev_buffer_pos = (buffer_index - graph_width + i - 3 + 256) % 256;
-            int prev_adc_value = adc_buffer[prev_buffer_pos + 256];
-            int prev_y_pos = graph_y + graph_height - (prev_adc_value * graph_height / 4096);
-            
-            cmd(VERTEX2F((graph_x + i - 3) * 16, prev_y_pos * 16));
-            cmd(VERTEX2F((graph_x + i) * 16, y_pos * 16));
+    y+=inc;
+    if (!chrome) {
+        decim_mode_t decim_mode;
+        spectrum_window_t window;
+        uint32_t spc = get_adc_display_timebase(&decim_mode);
+        uint32_t fft_points = get_adc_display_spectrum(&window);
+        if (fft_points != 0) {
+            // 스펙트럼: 가로 DC ~ fs/2, 세로 0 ~ -100 dBFS
+            sprintf(status_text, "FFT %lu pts %s %.1fHz/bin", (unsigned long)fft_points,
+                    spectrum_window_name(window), (float)adc_dma_get_sample_rate_hz() / fft_points);
+        } else {
+            sprintf(status_text, "TB: %lu smp/px %s", (unsigned long)spc,
+                    decim_mode == DECIM_MODE_PEAK ? "PEAK" : "AVG");
         }
+        cmd_text(10, y, 20, 0, status_text);
     }
-    cmd(END());
+    y+=inc;
 
-    // 그래프 둘레에 흰색 선 그리기
-    cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-    cmd(BEGIN(LINES));
-    // 왼쪽 세로선
-    cmd(VERTEX2F(graph_x * 16, graph_y * 16));
-    cmd(VERTEX2F(graph_x * 16, (graph_y + graph_height) * 16));
-    // 오른쪽 세로선
-    cmd(VERTEX2F((graph_x + graph_width) * 16, graph_y * 16));
-    cmd(VERTEX2F((graph_x + graph_width) * 16, (graph_y + graph_height) * 16));
-    // 위쪽 가로선
-    cmd(VERTEX2F(graph_x * 16, graph_y * 16));
-    cmd(VERTEX2F((graph_x + graph_width) * 16, graph_y * 16));
-    // 아래쪽 가로선
-    cmd(VERTEX2F(graph_x * 16, (graph_y + graph_height) * 16));
-    cmd(VERTEX2F((graph_x + graph_width) * 16, (graph_y + graph_height) * 16));
-    cmd(END());
+    if (!chrome) {
+        // ADC 그래프 그리기 (데시메이션된 열: 픽셀마다 min/max 또는 평균)
+        uint32_t columns = get_adc_display_columns(display_cols[0], display_cols[1], graph_width);
+        // 열이 모자라면 오른쪽 정렬 (가장 최근 열이 오른쪽 끝)
+        int col_x = graph_x + graph_width - (int)columns;
 
+        // 트레이스는 RAM_G 스니펫으로 올리고 CMD_APPEND로 붙임 (점 개수와 무관하게 명령 3워드)
+        wave_area_t area = { .x = col_x, .y = graph_y, .height = graph_height };
+        waveform_draw(0, display_cols[0], columns, &area, COLOR_RGB(0x00, 0xFF, 0x00)); // 초록색 (ADC1)
+        waveform_draw(1, display_cols[1], columns, &area, COLOR_RGB(0x00, 0x00, 0xFF)); // 파란색 (ADC2)
+    } else {
+        // 그래프 둘레에 흰색 선 그리기
+        cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+        cmd(BEGIN(LINES));
+        // 왼쪽 세로선
+        cmd(VERTEX2F(graph_x * 16, graph_y * 16));
+        cmd(VERTEX2F(graph_x * 16, (graph_y + graph_height) * 16));
+        // 오른쪽 세로선
+        cmd(VERTEX2F((graph_x + graph_width) * 16, graph_y * 16));
+        cmd(VERTEX2F((graph_x + graph_width) * 16, (graph_y + graph_height) * 16));
+        // 위쪽 가로선
+        cmd(VERTEX2F(graph_x * 16, graph_y * 16));
+        cmd(VERTEX2F((graph_x + graph_width) * 16, graph_y * 16));
+        // 아래쪽 가로선
+        cmd(VERTEX2F(graph_x * 16, (graph_y + graph_height) * 16));
+        cmd(VERTEX2F((graph_x + graph_width) * 16, (graph_y + graph_height) * 16));
+        cmd(END());
 
-    // 제목
-    cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-    cmd_text(320, 10, 28, OPT_CENTER, "Interactive Hardware Test");
+        // 제목
+        cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+        cmd_text(320, 10, 28, OPT_CENTER, "Interactive Hardware Test");
+    }
     y+=inc/2;
-    // 구분선
-    cmd(COLOR_RGB(0x40, 0x40, 0x40));
-    // LINE 함수 대신 사각형으로 구분선 그리기
-    cmd(BEGIN(LINES));
-    cmd(VERTEX2F(10 * 16, y * 16));
-    cmd(VERTEX2F(470 * 16, y * 16));
-    cmd(END());
-    
-    // 로터리 인코더 상태
-    cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-    
-    sprintf(status_text, "RE0: A=%d B=%d Pressed=%s Counter=%d", 
-            input_status.re0_a, input_status.re0_b, 
-            input_status.re0_pressed ? "YES" : "NO", 
-            input_status.re0_counter);
-    cmd_text(10, y, 20, 0, status_text);
-    y+=inc;
-    
-    sprintf(status_text, "RE1: A=%d B=%d Pressed=%s Counter=%d", 
-            input_status.re1_a, input_status.re1_b, 
-            input_status.re1_pressed ? "YES" : "NO", 
-            input_status.re1_counter);
-    cmd_text(10, y, 20, 0, status_text);
-    y+=inc;
-    
-        // 버튼 상태
-    sprintf(status_text, "SW0=%s SW1=%s SW2=%s SW3=%s", 
-            input_status.sw0_pressed ? "HI" : "LO",
-            input_status.sw1_pressed ? "HI" : "LO",
-            input_status.sw2_pressed ? "HI" : "LO",
-            input_status.sw3_pressed ? "HI" : "LO");
-    cmd_text(10, y, 20, 0, status_text);
-    y+=inc;
-    
-    // 트리거 상태
-    sprintf(status_text, "TRIG0=%s TRIG1=%s", 
-            input_status.trig0_active ? "ACTIVE" : "INACTIVE",
-            input_status.trig1_active ? "ACTIVE" : "INACTIVE");
-    cmd_text(10, y, 20, 0, status_text);
-    y+=inc;
-    
-    // 배터리 상태
-    sprintf(status_text, "Battery: Charging=%s Standby=%s", 
-            input_status.battery_charging ? "YES" : "NO",
-            input_status.battery_standby ? "YES" : "NO");
-    cmd_text(10, y, 20, 0, status_text);
-    y+=inc;
+    if (chrome) {
+        // 구분선
+        cmd(COLOR_RGB(0x40, 0x40, 0x40));
+        // LINE 함수 대신 사각형으로 구분선 그리기
+        cmd(BEGIN(LINES));
+        cmd(VERTEX2F(10 * 16, y * 16));
+        cmd(VERTEX2F(470 * 16, y * 16));
+        cmd(END());
+    }
     
-    y+=inc/2;
-
-    if(relay_ctrl.gain_test_mode){
-        // LED 제어 섹션
-        cmd(COLOR_RGB(0x00, 0xFF, 0x00));
-        cmd_text(10, y, 24, 0, "GAIN CONTROL:");
-        y+=inc*2;
-        
-        // LED 상태 표시
+    if (!chrome) {
+        // 로터리 인코더 상태
         cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-        sprintf(status_text, "GAIN MODE : %d, focus : %d, val : %d", relay_ctrl.gain_test_mode, relay_ctrl.gain_selected_state, relay_ctrl.gain_state[relay_ctrl.gain_selected_state]);
-        cmd_text(10, y, 20, 0, status_text);
-        y+=inc;
-
-        char *acdc_gate_txt[2] = {"AC", "DC"};
-        char *first_gate_txt[4] = {"1/1x  ", "1/10x ", "1/92x ", "1/101x"};
-        char *second_gate_txt[4] = {"1/1x", "1/2x", "1/5x", "1/6x"};
-
-        sprintf(status_text, "ch0: [%d,%d,%d] %s %s %s", relay_ctrl.gain_state[0], relay_ctrl.gain_state[1], relay_ctrl.gain_state[2]
-            , acdc_gate_txt[relay_ctrl.gain_state[0]], first_gate_txt[relay_ctrl.gain_state[1]], second_gate_txt[relay_ctrl.gain_state[2]]);
+        
+        sprintf(status_text, "RE0: A=%d B=%d Pressed=%s Counter=%d", 
+                input_status.re0_a, input_status.re0_b, 
+                input_status.re0_pressed ? "YES" : "NO", 
+                input_status.re0_counter);
         cmd_text(10, y, 20, 0, status_text);
         y+=inc;
-
-        sprintf(status_text, "ch1: [%d,%d,%d] %s %s %s", relay_ctrl.gain_state[3], relay_ctrl.gain_state[4], relay_ctrl.gain_state[5]
-            , acdc_gate_txt[relay_ctrl.gain_state[3]], first_gate_txt[relay_ctrl.gain_state[4]], second_gate_txt[relay_ctrl.gain_state[5]]);
+        
+        sprintf(status_text, "RE1: A=%d B=%d Pressed=%s Counter=%d", 
+                input_status.re1_a, input_status.re1_b, 
+                input_status.re1_pressed ? "YES" : "NO", 
+                input_status.re1_counter);
         cmd_text(10, y, 20, 0, status_text);
         y+=inc;
-    }else if(!relay_ctrl.relay_test_mode){
-        // LED 제어 섹션
-        cmd(COLOR_RGB(0x00, 0xFF, 0x00));
-        cmd_text(10, y, 24, 0, "LED CONTROL:");
-        y+=inc*2;
         
-        // 선택된 LED 표시
-        const char* led_names[] = {"LED0", "LED1", "LEDRE0", "LEDRE1"};
-        cmd(COLOR_RGB(0xFF, 0xFF, 0x00));
-        sprintf(status_text, "Selected: %s", led_names[led_ctrl.selected_led]);
-        cmd_text(10, y, 22, 0, status_text);
+        // 버튼 상태
+        sprintf(status_text, "SW0=%s SW1=%s SW2=%s SW3=%s", 
+                input_status.sw0_pressed ? "HI" : "LO",
+                input_status.sw1_pressed ? "HI" : "LO",
+                input_status.sw2_pressed ? "HI" : "LO",
+                input_status.sw3_pressed ? "HI" : "LO");
+        cmd_text(10, y, 20, 0, status_text);
         y+=inc;
         
-        // LED 상태 표시
-        cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-        sprintf(status_text, "LED0: %s  LED1: %s", 
-                led_ctrl.led0_state ? "HI" : "LO",
-                led_ctrl.led1_state ? "HI" : "LO");
+        // 트리거 상태
+        sprintf(status_text, "TRIG0=%s TRIG1=%s", 
+                input_status.trig0_active ? "ACTIVE" : "INACTIVE",
+                input_status.trig1_active ? "ACTIVE" : "INACTIVE");
         cmd_text(10, y, 20, 0, status_text);
         y+=inc;
         
-        sprintf(status_text, "LEDRE0: %s  LEDRE1: %s", 
-                led_ctrl.ledre0_state ? "HI" : "LO",
-                led_ctrl.ledre1_state ? "HI" : "LO");
+        // 배터리 상태
+        sprintf(status_text, "Battery: Charging=%s Standby=%s", 
+                input_status.battery_charging ? "YES" : "NO",
+                input_status.battery_standby ? "YES" : "NO");
         cmd_text(10, y, 20, 0, status_text);
         y+=inc;
-    }else{
-        // 릴레이 제어 섹션
-        cmd(COLOR_RGB(0x00, 0xFF, 0x00));
-        cmd_text(10, y, 24, 0, "RELAY CONTROL:");
+    } else {
+        y+=inc*5;
+    }
+    
+    y+=inc/2;
+
+    if(scope_ctrl.active){
+        if (chrome) {
+            // 스코프 조작 섹션
+            cmd(COLOR_RGB(0x00, 0xFF, 0x00));
+            cmd_text(10, y, 24, 0, "SCOPE CONTROL:");
+        }
         y+=inc*2;
         
-        // 릴레이 상태 표시
-        cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
-        sprintf(status_text, "RELAY1: %s  RELAY2: %s", 
-                relay_ctrl.relay1_state ? "HI" : "LO",
-                relay_ctrl.relay2_state ? "HI" : "LO");
-        cmd_text(10, y, 20, 0, status_text);
-        y+=inc;
+        if (!chrome) {
+            decim_mode_t decim_mode;
+            cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+            sprintf(status_text, "Timebase: %lu smp/px", (unsigned long)get_adc_display_timebase(&decim_mode));
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+            
+            sprintf(status_text, "Trigger level: %d / 255", scope_ctrl.trigger_level);
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+
+            // 자동 측정 (채널마다 한 줄)
+            for (int ch = 0; ch < 2; ch++) {
+                format_measurement(ch, status_text, sizeof(status_text));
+                cmd_text(10, y, 20, 0, status_text);
+                y+=inc;
+            }
+        } else {
+            y+=inc*4;
+        }
+    }else if(relay_ctrl.gain_test_mode){
+        if (chrome) {
+            // LED 제어 섹션
+            cmd(COLOR_RGB(0x00, 0xFF, 0x00));
+            cmd_text(10, y, 24, 0, "GAIN CONTROL:");
+        }
+        y+=inc*2;
         
-        sprintf(status_text, "RELAY3: %s  RELAY4: %s", 
-                relay_ctrl.relay3_state ? "HI" : "LO",
-                relay_ctrl.relay4_state ? "HI" : "LO");
-        cmd_text(10, y, 20, 0, status_text);
+        if (!chrome) {
+            // LED 상태 표시
+            cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+            sprintf(status_text, "GAIN MODE : %d, focus : %d, val : %d", relay_ctrl.gain_test_mode, relay_ctrl.gain_selected_state, relay_ctrl.gain_state[relay_ctrl.gain_selected_state]);
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+
+            char *acdc_gate_txt[2] = {"AC", "DC"};
+            char *first_gate_txt[4] = {"1/1x  ", "1/10x ", "1/92x ", "1/101x"};
+            char *second_gate_txt[4] = {"1/1x", "1/2x", "1/5x", "1/6x"};
+
+            sprintf(status_text, "ch0: [%d,%d,%d] %s %s %s", relay_ctrl.gain_state[0], relay_ctrl.gain_state[1], relay_ctrl.gain_state[2]
+                , acdc_gate_txt[relay_ctrl.gain_state[0]], first_gate_txt[relay_ctrl.gain_state[1]], second_gate_txt[relay_ctrl.gain_state[2]]);
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+
+            sprintf(status_text, "ch1: [%d,%d,%d] %s %s %s", relay_ctrl.gain_state[3], relay_ctrl.gain_state[4], relay_ctrl.gain_state[5]
+                , acdc_gate_txt[relay_ctrl.gain_state[3]], first_gate_txt[relay_ctrl.gain_state[4]], second_gate_txt[relay_ctrl.gain_state[5]]);
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+        } else {
+            y+=inc*3;
+        }
+    }else if(!relay_ctrl.relay_test_mode){
+        if (chrome) {
+            // LED 제어 섹션
+            cmd(COLOR_RGB(0x00, 0xFF, 0x00));
+            cmd_text(10, y, 24, 0, "LED CONTROL:");
+        }
+        y+=inc*2;
+        
+        if (chrome) {
+            // 선택된 LED 표시 (selected_led는 캐시 키에 포함)
+            const char* led_names[] = {"LED0", "LED1", "LEDRE0", "LEDRE1"};
+            cmd(COLOR_RGB(0xFF, 0xFF, 0x00));
+            sprintf(status_text, "Selected: %s", led_names[led_ctrl.selected_led]);
+            cmd_text(10, y, 22, 0, status_text);
+        }
         y+=inc;
         
-        // 릴레이 테스트 모드 상태
-        cmd(COLOR_RGB(0xFF, 0xFF, 0x00));
-        sprintf(status_text, "Relay Test Mode: %s", 
-                relay_ctrl.relay_test_mode ? "ON (1Hz Blink)" : "OFF");
-        cmd_text(10, y, 18, 0, status_text);
+        if (!chrome) {
+            // LED 상태 표시
+            cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+            sprintf(status_text, "LED0: %s  LED1: %s", 
+                    led_ctrl.led0_state ? "HI" : "LO",
+                    led_ctrl.led1_state ? "HI" : "LO");
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+            
+            sprintf(status_text, "LEDRE0: %s  LEDRE1: %s", 
+                    led_ctrl.ledre0_state ? "HI" : "LO",
+                    led_ctrl.ledre1_state ? "HI" : "LO");
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+        } else {
+            y+=inc*2;
+        }
+    }else{
+        if (chrome) {
+            // 릴레이 제어 섹션
+            cmd(COLOR_RGB(0x00, 0xFF, 0x00));
+            cmd_text(10, y, 24, 0, "RELAY CONTROL:");
+        }
+        y+=inc*2;
+        
+        if (!chrome) {
+            // 릴레이 상태 표시
+            cmd(COLOR_RGB(0xFF, 0xFF, 0xFF));
+            sprintf(status_text, "RELAY1: %s  RELAY2: %s", 
+                    relay_ctrl.relay1_state ? "HI" : "LO",
+                    relay_ctrl.relay2_state ? "HI" : "LO");
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+            
+            sprintf(status_text, "RELAY3: %s  RELAY4: %s", 
+                    relay_ctrl.relay3_state ? "HI" : "LO",
+                    relay_ctrl.relay4_state ? "HI" : "LO");
+            cmd_text(10, y, 20, 0, status_text);
+            y+=inc;
+        } else {
+            y+=inc*2;
+        }
+        
+        if (chrome) {
+            // 릴레이 테스트 모드 상태 (relay_test_mode는 캐시 키에 포함)
+            cmd(COLOR_RGB(0xFF, 0xFF, 0x00));
+            sprintf(status_text, "Relay Test Mode: %s", 
+                    relay_ctrl.relay_test_mode ? "ON (1Hz Blink)" : "OFF");
+            cmd_text(10, y, 18, 0, status_text);
+        }
         y+=inc;
 
     }
 
+    // 아래는 모두 정적 부분
+    if (!chrome) {
+        return;
+    }
+
     // graph 아래에 글씨 두기
     if(y<graph_height+graph_y){
         y=graph_height+graph_y+inc/2;
@@ -758,7 +818,10 @@ static void draw_ui(void) {
     
     // 조작법 안내
     cmd(COLOR_RGB(0x00, 0xFF, 0xFF));
-    if(!relay_ctrl.gain_test_mode && !relay_ctrl.relay_test_mode){
+    if(scope_ctrl.active){
+        cmd_text(10, y, 18, 0, "RE0: Timebase, RE1: Trigger Level (spin fast = big steps), RE1 push: FFT");
+        y+=inc;
+    }else if(!relay_ctrl.gain_test_mode && !relay_ctrl.relay_test_mode){
         cmd_text(10, y, 18, 0, "RE0: Select LED, RE1: Toggle LED");
         y+=inc;
     }else if(relay_ctrl.gain_test_mode){
@@ -770,6 +833,8 @@ static void draw_ui(void) {
     }
     cmd_text(10, y, 18, 0, "SW0: Toggle Relay Mode, SW2: Toggle Gain Mode");
     y+=inc;
+    cmd_text(10, y, 18, 0, "SW1: Timebase, SW3: Peak/Average, RE0 Push: Scope");
+    y+=inc;
     
     // 선택된 LED 하이라이트
     int led_x = 10 + (led_ctrl.selected_led * 120);
@@ -779,6 +844,54 @@ static void draw_ui(void) {
     cmd(VERTEX2F(led_x * 16, (led_y + 25) * 16));
     cmd(VERTEX2F((led_x + 100) * 16, (led_y + 25) * 16));
     cmd(END());
+}
+
+#if UI_BUS_STATS_OVERLAY
+// 버스 사용량 한 줄 (매 프레임 바뀌므로 캐시 밖)
+static void draw_bus_stats_overlay(void) {
+    bus_stats_window_t frame, second;
+    if (!bus_stats_get_frame(&frame) || !bus_stats_get_second(&second)) {
+        return;
+    }
+    const bus_stats_t *spi = &frame.bus[BUS_STATS_SPI_FT800];
+    const bus_stats_t *i2c = &second.bus[BUS_STATS_I2C_CH423];
+    char text[100];
+    snprintf(text, sizeof(text), "%lufps SPI %lutr %luB %luus max %luus | I2C %lutr/s %lu%%",
+             (unsigned long)((uint64_t)second.frames * 1000000 / second.window_us),
+             (unsigned long)spi->transactions, (unsigned long)spi->bytes,
+             (unsigned long)spi->busy_us, (unsigned long)spi->max_us,
+             (unsigned long)((uint64_t)i2c->transactions * 1000000 / second.window_us),
+             (unsigned long)((uint64_t)i2c->busy_us * 100 / second.window_us));
+    cmd(COLOR_RGB(0xFF, 0x80, 0x00));
+    cmd_text(470, 256, 18, OPT_RIGHTX, text);
+}
+#endif
+
+static void draw_ui_chrome(void *arg) {
+    (void)arg;
+    draw_ui_layout(true);
+}
+
+// 화면 한 프레임 (상호작용 루프가 프레임마다 부름)
+void interactive_draw_frame(void) {
+    // 정적 부분은 UI 상태가 바뀔 때만 RAM_G에 다시 만든다 (프레임 DL 밖에서)
+    ui_dl_cache_update(&ui_chrome_cache, ui_chrome_key(), draw_ui_chrome, NULL);
+
+	cmd(CMD_DLSTART);
+    waveform_begin_frame();
+    // 배경색 설정
+    cmd(COLOR_RGB(0x20, 0x20, 0x20));
+    cmd(CLEAR(1, 1, 1));
+    
+    // 정적 부분: 캐시가 있으면 CMD_APPEND, 없으면 직접 그림
+    if (!ui_dl_cache_append(&ui_chrome_cache)) {
+        draw_ui_layout(true);
+    }
+    // 매 프레임 바뀌는 부분 (트레이스, 수치)
+    draw_ui_layout(false);
+#if UI_BUS_STATS_OVERLAY
+    draw_bus_stats_overlay();
+#endif
     
     // 화면 업데이트
     cmd(DISPLAY());
@@ -789,23 +902,32 @@ static void draw_ui(void) {
 
 // 실시간 상호작용 테스트 태스크
 static void interactive_test_task(void *pvParameters) {
+    (void)pvParameters;
     ESP_LOGI(TAG, "Starting interactive hardware test...");
     
     // I2C가 이미 초기화되어 있는지 확인하고 대기
     vTaskDelay(pdMS_TO_TICKS(2000)); // 기존 코드의 I2C 초기화 완료 대기
     
-    // 인코더 인터럽트 설정 및 태스크 시작
-    esp_err_t ret = setup_encoder_interrupts();
-    if (ret == ESP_OK) {
-        xTaskCreate(encoder_interrupt_task, "encoder_interrupt", 4096, NULL, 8, NULL);
-        ESP_LOGI(TAG, "Encoder interrupt mode enabled");
-    } else {
-        ESP_LOGW(TAG, "Encoder interrupt setup failed, using polling mode");
-        xTaskCreate(encoder_task, "encoder_task", 4096, NULL, 8, NULL);
+    // 인코더 (PCNT 하드웨어 디코딩, 안 되면 ISR)
+    esp_err_t ret = rotary_encoder_init(ENCODER_BACKEND);
+    if (ret != ESP_OK && ENCODER_BACKEND != ROTARY_BACKEND_ISR) {
+        ESP_LOGW(TAG, "Encoder backend unavailable (%s), falling back to ISR", esp_err_to_name(ret));
+        ret = rotary_encoder_init(ROTARY_BACKEND_ISR);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Rotary encoder init failed: %s", esp_err_to_name(ret));
     }
+    // 5클릭/초부터 가속, 30클릭/초에서 최대 배율
+    quad_accel_init(&re0_accel, 5.0f, 30.0f, 10.0f);
+    quad_accel_init(&re1_accel, 5.0f, 30.0f, 16.0f);
     
     // 백라이트 ON
     ch423_set_output(CH423_OC_BACKLIGHT, false);
+    
+    // 이후 CH423 I/O는 서비스 태스크가 맡음 (UI 루프는 I2C를 기다리지 않음)
+    if (ch423_service_start() != ESP_OK) {
+        ESP_LOGW(TAG, "CH423 service not started, using blocking I2C");
+    }
     /*
     // FT800 초기화
     if (initFT800() != 0) {
@@ -813,6 +935,12 @@ static void interactive_test_task(void *pvParameters) {
         vTaskDelete(NULL);
         return;
     }*/
+    ui_dl_cache_init(&ui_chrome_cache);
+    
+    // FT800 INT로 프레임 페이싱 (스왑마다 한 프레임)
+    if (render_sched_init() != ESP_OK) {
+        ESP_LOGW(TAG, "FT800 INT unavailable, pacing frames by timeout");
+    }
     
     // 초기 LED 상태 설정
     led_ctrl.selected_led = 0;
@@ -831,10 +959,18 @@ static void interactive_test_task(void *pvParameters) {
         // 입력 상태 업데이트 (공용 변수에서 인코더 값 가져오기)
         update_input_status();
         
+        // RE0 푸시: 스코프 조작 모드 토글
+        if (input_status.re0_pressed) {
+            scope_ctrl.active = !scope_ctrl.active;
+            reset_encoder_counters();
+            ESP_LOGI(TAG, "RE0 pressed: Scope control %s", scope_ctrl.active ? "ENABLED" : "DISABLED");
+        }
+        
         // 버튼 0이 눌렸을 때 relay_test_mode 토글
         if (input_status.sw0_pressed) {
+            scope_ctrl.active = false;
             relay_ctrl.relay_test_mode = !relay_ctrl.relay_test_mode;
-            relay_ctrl.relay_blink_count = 0; // 점멸 카운터 리셋
+            relay_ctrl.relay_blink_time = esp_timer_get_time(); // 점멸 시각 리셋
             ESP_LOGI(TAG, "SW0 pressed: Relay test mode %s", 
                      relay_ctrl.relay_test_mode ? "ENABLED" : "DISABLED");
             
@@ -852,6 +988,7 @@ static void interactive_test_task(void *pvParameters) {
             ESP_LOGI(TAG, "SW2 pressed: Gain test mode %s", 
                      relay_ctrl.gain_test_mode ? "ENABLED" : "DISABLED");
             
+            scope_ctrl.active = false;
             if(relay_ctrl.relay_test_mode){
                 relay_ctrl.relay_test_mode = false;
             }
@@ -863,6 +1000,35 @@ static void interactive_test_task(void *pvParameters) {
             relay_ctrl.gain_test_mode = !relay_ctrl.gain_test_mode;
         }
         
+        // 버튼 1: 시간축 (열당 샘플 수) 순환, 버튼 3: 피크/평균 전환
+        if (input_status.sw1_pressed || input_status.sw3_pressed) {
+            static const uint32_t timebase_steps[] = {1, 2, 5, 10, 16};
+            static int timebase_index = 0;
+            decim_mode_t mode;
+            get_adc_display_timebase(&mode);
+            
+            if (input_status.sw1_pressed) {
+                timebase_index = (timebase_index + 1) % (int)(sizeof(timebase_steps) / sizeof(timebase_steps[0]));
+            }
+            if (input_status.sw3_pressed) {
+                mode = (mode == DECIM_MODE_PEAK) ? DECIM_MODE_AVERAGE : DECIM_MODE_PEAK;
+            }
+            esp_err_t tb_ret = set_adc_display_timebase(timebase_steps[timebase_index], mode);
+            if (tb_ret != ESP_OK) {
+                // 레코드 길이가 모자라면 처음으로
+                timebase_index = 0;
+                set_adc_display_timebase(timebase_steps[0], mode);
+            }
+            ESP_LOGI(TAG, "Timebase: %lu samples/column (%s)", (unsigned long)timebase_steps[timebase_index],
+                     mode == DECIM_MODE_PEAK ? "peak" : "average");
+        }
+        
+        // 출력 변경은 프레임당 한 번만 전송 (바뀐 것이 없으면 I2C 쓰기 없음)
+        ch423_begin();
+        
+        // 스코프 조작 (시간축, 트리거 레벨)
+        update_scope_control();
+        
         // LED 상태 업데이트
         update_led_states();
         
@@ -872,14 +1038,23 @@ static void interactive_test_task(void *pvParameters) {
         // gain 상태 업데이트
         update_gain_test();
         
+        ch423_commit();
+        
         // UI 그리기
-        draw_ui();
+        interactive_draw_frame();
         
-        // 100ms 대기 (10 FPS) - 깜빡임 줄이기
-        vTaskDelay(pdMS_TO_TICKS(100));
+        // 스왑(vsync)이 끝날 때까지 대기 - 고정 10 FPS 대신 화면 주기에 맞춤
+        render_sched_wait_frame();
+        // 버스 사용량 프레임/초 단위로 끊기
+        bus_stats_frame_mark(esp_timer_get_time());
     }
 }
 
+// 스코프 조작 화면 (RE0 푸시와 같은 화면 전환, 상호작용 태스크가 돌지 않을 때만)
+void interactive_set_scope_mode(bool active) {
+    scope_ctrl.active = active;
+}
+
 // 실시간 상호작용 테스트 시작
 esp_err_t start_interactive_test(void) {
     xTaskCreate(interactive_test_task, "interactive_test", 8192, NULL, 5, NULL);
@@ -1,9 +1,17 @@
 #ifndef INTERACTIVE_TEST_H
 #define INTERACTIVE_TEST_H
 
+#include <stdbool.h>
 #include "esp_err.h"
 
 // 실시간 상호작용 테스트 시작
 esp_err_t start_interactive_test(void);
 
+// 화면 한 프레임 명령 생성 (CMD_DLSTART ~ CMD_SWAP). 상호작용 루프가 vsync마다 부르고,
+// 호스트 벤치는 태스크 없이 직접 불러 렌더 시간을 잰다
+void interactive_draw_frame(void);
+
+// 스코프 조작 화면 켜기/끄기 (RE0 푸시와 같음). 상호작용 태스크가 돌지 않을 때만
+void interactive_set_scope_mode(bool active);
+
 #endif // INTERACTIVE_TEST_H
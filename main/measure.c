@@ -0,0 +1,334 @@
+#include <string.h>
+#include <math.h>
+#include "measure.h"
+
+// 상승/하강 시간 상태
+enum {
+    EDGE_NONE = 0,
+    EDGE_ARM_RISE,      // 10% 아래로 내려옴, 90% 도달을 기다림
+    EDGE_ARM_FALL,      // 90% 위로 올라감, 10% 도달을 기다림
+};
+
+// 창 누적값 비우기 (교차 레벨과 위치는 유지)
+static void meas_clear_window(meas_t *m)
+{
+    m->fill = 0;
+    m->cur_min = UINT16_MAX;
+    m->cur_max = 0;
+    m->sum = 0;
+    m->sum_sq = 0;
+    memset(m->hist, 0, sizeof(m->hist));
+
+    m->rises = 0;
+    m->fall_seen = false;
+    m->high_sum_q8 = 0;
+    m->rise_sum_q8 = 0;
+    m->rise_n = 0;
+    m->fall_sum_q8 = 0;
+    m->fall_n = 0;
+}
+
+bool meas_init(meas_t *m, uint32_t window, uint32_t sample_rate_hz)
+{
+    if (window < 2 || window > MEAS_WINDOW_MAX || sample_rate_hz == 0) {
+        return false;
+    }
+    memset(m, 0, sizeof(*m));
+    m->window = window;
+    m->sample_rate_hz = sample_rate_hz;
+    meas_clear_window(m);
+    return true;
+}
+
+void meas_reset(meas_t *m)
+{
+    meas_clear_window(m);
+    m->have_prev = false;
+    m->edge_state = EDGE_NONE;
+    m->edge_start_valid = false;
+}
+
+// (pos-1, prev) ~ (pos, x) 사이에서 level을 지나는 위치 (Q8)
+static inline int64_t meas_cross_q8(int64_t pos, uint16_t prev, uint16_t x, uint16_t level)
+{
+    return ((pos - 1) << 8) + (((int32_t)level - prev) * 256) / ((int32_t)x - prev);
+}
+
+static void meas_on_rise(meas_t *m, int64_t t)
+{
+    if (m->rises == 0) {
+        m->first_rise_q8 = t;
+    } else if (m->fall_seen) {
+        m->high_sum_q8 += m->last_fall_q8 - m->last_rise_q8;
+    }
+    m->last_rise_q8 = t;
+    m->fall_seen = false;
+    m->rises++;
+}
+
+static void meas_on_fall(meas_t *m, int64_t t)
+{
+    if (m->rises > 0) {
+        m->last_fall_q8 = t;
+        m->fall_seen = true;
+    }
+}
+
+// 최소/최대/합/제곱합/히스토그램
+static void meas_accumulate(meas_t *m, const uint16_t *s, uint32_t n)
+{
+    uint16_t lo = m->cur_min, hi = m->cur_max;
+    uint32_t sum = 0;
+    uint64_t sum_sq = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t x = s[i];
+        lo = x < lo ? x : lo;
+        hi = x > hi ? x : hi;
+        sum += x;
+        sum_sq += x * x;
+        m->hist[x >> MEAS_HIST_SHIFT]++;
+    }
+    m->cur_min = lo;
+    m->cur_max = hi;
+    m->sum += sum;
+    m->sum_sq += sum_sq;
+}
+
+// 50% 교차(주기/듀티)와 10%/90% 교차(상승/하강 시간)
+static void meas_cross(meas_t *m, const uint16_t *s, uint32_t n)
+{
+    const uint16_t mid = m->mid, hys = m->hys, lo = m->lo, hi = m->hi;
+    int64_t pos = m->pos;
+    uint32_t i = 0;
+
+    if (!m->have_prev && n > 0) {
+        m->prev = s[0];
+        m->high = s[0] >= mid;
+        m->have_prev = true;
+        pos++;
+        i = 1;
+    }
+    uint16_t p = m->prev;
+
+    for (; i < n; i++, pos++) {
+        uint16_t x = s[i];
+
+        // 50%: 레벨을 지난 위치를 후보로 두고, 히스테리시스 밖까지 가면 확정
+        if (!m->high) {
+            if (p < mid && x >= mid) {
+                m->mid_cand_q8 = meas_cross_q8(pos, p, x, mid);
+            }
+            if (x >= mid + hys) {
+                m->high = true;
+                meas_on_rise(m, m->mid_cand_q8);
+            }
+        } else {
+            if (p > mid && x <= mid) {
+                m->mid_cand_q8 = meas_cross_q8(pos, p, x, mid);
+            }
+            if (x + hys <= mid) {
+                m->high = false;
+                meas_on_fall(m, m->mid_cand_q8);
+            }
+        }
+
+        // 10% -> 90%, 90% -> 10% (반대쪽 레벨을 넘은 뒤에만 무장)
+        switch (m->edge_state) {
+            case EDGE_ARM_RISE:
+                if (p < lo && x >= lo) {
+                    m->edge_start_q8 = meas_cross_q8(pos, p, x, lo);
+                    m->edge_start_valid = true;
+                }
+                if (x >= hi) {
+                    if (m->edge_start_valid) {
+                        m->rise_sum_q8 += meas_cross_q8(pos, p, x, hi) - m->edge_start_q8;
+                        m->rise_n++;
+                    }
+                    m->edge_state = EDGE_ARM_FALL;
+                    m->edge_start_valid = false;
+                }
+                break;
+            case EDGE_ARM_FALL:
+                if (p > hi && x <= hi) {
+                    m->edge_start_q8 = meas_cross_q8(pos, p, x, hi);
+                    m->edge_start_valid = true;
+                }
+                if (x <= lo) {
+                    if (m->edge_start_valid) {
+                        m->fall_sum_q8 += meas_cross_q8(pos, p, x, lo) - m->edge_start_q8;
+                        m->fall_n++;
+                    }
+                    m->edge_state = EDGE_ARM_RISE;
+                    m->edge_start_valid = false;
+                }
+                break;
+            default:
+                if (x <= lo) {
+                    m->edge_state = EDGE_ARM_RISE;
+                } else if (x >= hi) {
+                    m->edge_state = EDGE_ARM_FALL;
+                }
+                break;
+        }
+        p = x;
+    }
+    m->prev = p;
+    m->pos = pos;
+}
+
+// 히스토그램 [from, to] 칸의 최빈 레벨. 뚜렷한 봉우리(평균의 3배 이상)가 없으면 fallback
+static float meas_hist_level(const uint32_t *hist, int from, int to, float fallback)
+{
+    if (from > to) {
+        return fallback;
+    }
+    uint32_t total = 0;
+    int best = from;
+    for (int b = from; b <= to; b++) {
+        total += hist[b];
+        if (hist[b] > hist[best]) {
+            best = b;
+        }
+    }
+    if (total == 0 || (uint64_t)hist[best] * (uint32_t)(to - from + 1) < 3ull * total) {
+        return fallback;
+    }
+
+    // 이웃 칸까지 가중 평균 (칸 중심 = b * 8 + 3.5)
+    float num = 0, den = 0;
+    for (int b = best - 1; b <= best + 1; b++) {
+        if (b >= from && b <= to) {
+            num += (float)hist[b] * ((b << MEAS_HIST_SHIFT) + ((1 << MEAS_HIST_SHIFT) - 1) * 0.5f);
+            den += (float)hist[b];
+        }
+    }
+    return num / den;
+}
+
+// 창 마감: 결과 계산/공개 후 다음 창의 교차 레벨 결정
+static void meas_close(meas_t *m)
+{
+    meas_result_t r;
+    memset(&r, 0, sizeof(r));
+
+    uint32_t n = m->fill;
+    r.index = m->results;
+    r.samples = n;
+    r.min = m->cur_min;
+    r.max = m->cur_max;
+    r.mean = (float)m->sum / n;
+    r.rms = sqrtf((float)m->sum_sq / n);
+    // 분산은 정수로 (n * sum_sq - sum^2) / n^2 - 큰 값끼리 빼는 float 오차를 피함
+    uint64_t var_n2 = (uint64_t)n * m->sum_sq - (uint64_t)m->sum * m->sum;
+    r.ac_rms = sqrtf((float)var_n2) / n;
+
+    if (r.max - r.min >= MEAS_MIN_AMPLITUDE) {
+        int mid_bin = ((r.min + r.max) / 2) >> MEAS_HIST_SHIFT;
+        r.top = meas_hist_level(m->hist, mid_bin + 1, r.max >> MEAS_HIST_SHIFT, r.max);
+        r.base = meas_hist_level(m->hist, r.min >> MEAS_HIST_SHIFT, mid_bin - 1, r.min);
+        r.top = r.top > r.max ? r.max : r.top;
+        r.base = r.base < r.min ? r.min : r.base;
+        float amp = r.top - r.base;
+        if (amp >= MEAS_MIN_AMPLITUDE) {
+            r.overshoot_pct = (r.max - r.top) * 100.0f / amp;
+            r.undershoot_pct = (r.base - r.min) * 100.0f / amp;
+            r.valid |= MEAS_VALID_LEVELS;
+        }
+    }
+
+    // 교차 결과 (직전 창 레벨로 이번 창에서 잰 것)
+    const float q8_to_us = 1e6f / (256.0f * m->sample_rate_hz);
+    if (m->rises >= 2) {
+        float span = (float)(m->last_rise_q8 - m->first_rise_q8);
+        r.cycles = m->rises - 1;
+        r.period_us = span / r.cycles * q8_to_us;
+        r.frequency_hz = 1e6f / r.period_us;
+        r.duty_pct = (float)m->high_sum_q8 * 100.0f / span;
+        r.valid |= MEAS_VALID_FREQ | MEAS_VALID_DUTY;
+    }
+    if (m->rise_n > 0) {
+        r.rise_us = (float)m->rise_sum_q8 / m->rise_n * q8_to_us;
+        r.valid |= MEAS_VALID_RISE;
+    }
+    if (m->fall_n > 0) {
+        r.fall_us = (float)m->fall_sum_q8 / m->fall_n * q8_to_us;
+        r.valid |= MEAS_VALID_FALL;
+    }
+
+    // 공개
+    uint32_t version = atomic_load_explicit(&m->version, memory_order_relaxed);
+    atomic_store_explicit(&m->version, version + 1, memory_order_relaxed);     // 홀수: 갱신 중
+    atomic_thread_fence(memory_order_release);
+    m->pub = r;
+    atomic_store_explicit(&m->version, version + 2, memory_order_release);
+    m->results++;
+
+    // 다음 창 레벨: 상단/하단 기준 50%, 10%, 90%
+    bool was_valid = m->levels_valid;
+    m->levels_valid = (r.valid & MEAS_VALID_LEVELS) != 0;
+    if (m->levels_valid) {
+        float amp = r.top - r.base;
+        uint16_t hys = (uint16_t)(amp / 10);
+        m->mid = (uint16_t)((r.top + r.base) * 0.5f + 0.5f);
+        m->hys = hys < MEAS_HYST_MIN ? MEAS_HYST_MIN : hys;
+        m->lo = (uint16_t)(r.base + amp * 0.1f + 0.5f);
+        m->hi = (uint16_t)(r.top - amp * 0.1f + 0.5f);
+        // 레벨이 바뀌었으므로 교차 상태는 이전 샘플 기준으로 다시 잡음
+        if (m->have_prev) {
+            m->high = m->prev >= m->mid;
+        }
+        m->edge_state = EDGE_NONE;
+        m->edge_start_valid = false;
+    } else if (was_valid) {
+        m->edge_state = EDGE_NONE;
+        m->edge_start_valid = false;
+    }
+    meas_clear_window(m);
+}
+
+uint32_t meas_push(meas_t *m, const uint16_t *samples, uint32_t count)
+{
+    uint32_t done = 0;
+    while (count > 0) {
+        uint32_t n = m->window - m->fill;
+        n = count < n ? count : n;
+
+        meas_accumulate(m, samples, n);
+        if (m->levels_valid) {
+            meas_cross(m, samples, n);
+        } else {
+            // 교차 검출을 하지 않는 동안에도 위치와 이전 샘플은 따라감
+            m->prev = samples[n - 1];
+            m->have_prev = true;
+            m->pos += n;
+        }
+        m->fill += n;
+        samples += n;
+        count -= n;
+
+        if (m->fill == m->window) {
+            meas_close(m);
+            done++;
+        }
+    }
+    return done;
+}
+
+bool meas_read(const meas_t *m, meas_result_t *out)
+{
+    meas_t *mm = (meas_t *)m;
+    for (int retry = 0; retry < 4; retry++) {
+        uint32_t v0 = atomic_load_explicit(&mm->version, memory_order_acquire);
+        if (v0 == 0) {
+            return false;
+        }
+        *out = m->pub;
+        atomic_thread_fence(memory_order_acquire);
+        uint32_t v1 = atomic_load_explicit(&mm->version, memory_order_relaxed);
+        if (v0 == v1 && (v0 & 1) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,120 @@
+#ifndef MEASURE_H
+#define MEASURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 자동 측정 (Vpp, 평균, RMS, 주파수/주기, 듀티, 상승/하강 시간, 오버슈트)
+//
+// 샘플은 DMA 프레임 단위로 들어오는 대로 넣으면 되고, 누적값만 갱신하므로 버퍼를 다시 훑지 않는다.
+// window 샘플마다 결과 하나를 만들어 버전 카운터로 공개한다 (읽는 쪽은 락 없이 meas_read).
+// 주기/듀티는 50% 레벨 교차(히스테리시스)로, 상승/하강 시간은 10%/90% 교차로 재며
+// 교차 시각은 두 샘플 사이를 선형 보간한다 (1/256 샘플 단위).
+// 교차 레벨은 직전 창의 상단/하단 레벨에서 정하므로 진폭이 바뀌면 한 창 늦게 따라간다.
+// 진폭 값은 raw 카운트이고 전압은 adc_calib로 바꾼다.
+// 입력은 12비트 샘플(0~4095)이어야 한다 (adc_ring에 기록된 값).
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define MEAS_WINDOW_MAX     65536
+#define MEAS_HIST_SHIFT     3                           // 상단/하단 레벨 히스토그램 칸 = 8 카운트
+#define MEAS_HIST_BINS      (4096 >> MEAS_HIST_SHIFT)
+#define MEAS_MIN_AMPLITUDE  24      // p-p가 이보다 작으면 (잡음뿐) 교차 검출을 하지 않음
+#define MEAS_HYST_MIN       4       // 50% 교차 히스테리시스 최소값 (raw)
+
+// meas_result_t.valid 비트
+#define MEAS_VALID_FREQ     0x01    // 주파수/주기 (창 안에 상승 교차 2개 이상)
+#define MEAS_VALID_DUTY     0x02
+#define MEAS_VALID_RISE     0x04
+#define MEAS_VALID_FALL     0x08
+#define MEAS_VALID_LEVELS   0x10    // 상단/하단/오버슈트 (진폭이 충분할 때)
+
+typedef struct {
+    uint32_t index;             // 창 번호 (0부터)
+    uint32_t samples;           // 창 샘플 수
+    uint32_t valid;             // MEAS_VALID_*
+    uint16_t min;
+    uint16_t max;
+    float mean;                 // raw
+    float rms;                  // raw, DC 포함
+    float ac_rms;               // raw, 평균을 뺀 값 (표준편차)
+    float top;                  // 상단 레벨 (히스토그램 최빈값, 평탄부가 없으면 max)
+    float base;                 // 하단 레벨 (같은 방식, 없으면 min)
+    float frequency_hz;
+    float period_us;
+    float duty_pct;             // 양의 듀티
+    float rise_us;              // 10% -> 90% 평균
+    float fall_us;              // 90% -> 10% 평균
+    float overshoot_pct;        // (max - top) / (top - base)
+    float undershoot_pct;       // (base - min) / (top - base)
+    uint32_t cycles;            // 주기 계산에 쓴 완전한 주기 수
+} meas_result_t;
+
+typedef struct {
+    uint32_t window;            // 결과 하나당 샘플 수
+    uint32_t sample_rate_hz;
+
+    // 교차 레벨 (직전 창에서 정함)
+    bool levels_valid;
+    uint16_t mid;               // 50%
+    uint16_t hys;               // 50% 교차 히스테리시스
+    uint16_t lo;                // 10%
+    uint16_t hi;                // 90%
+
+    // 이번 창 누적
+    uint32_t fill;
+    uint16_t cur_min;
+    uint16_t cur_max;
+    uint32_t sum;
+    uint64_t sum_sq;
+    uint32_t hist[MEAS_HIST_BINS];
+
+    // 교차 상태 (창을 마감하며 레벨이 바뀌면 이전 샘플 기준으로 다시 잡음). 위치는 리셋 이후 샘플 번호 Q8
+    int64_t pos;                // 다음 입력 샘플 번호
+    bool have_prev;
+    uint16_t prev;
+    bool high;                  // 50% 히스테리시스 상태
+    int64_t mid_cand_q8;        // 확정 전 마지막 50% 교차
+    int edge_state;             // 상승/하강 시간 상태 (내부)
+    int64_t edge_start_q8;      // 10%(상승) 또는 90%(하강) 교차
+    bool edge_start_valid;
+
+    // 이번 창 교차 누적
+    uint32_t rises;
+    int64_t first_rise_q8;
+    int64_t last_rise_q8;
+    int64_t last_fall_q8;
+    bool fall_seen;             // last_rise 이후 하강 확정
+    int64_t high_sum_q8;        // 완전한 주기들의 high 구간 합
+    int64_t rise_sum_q8;
+    uint32_t rise_n;
+    int64_t fall_sum_q8;
+    uint32_t fall_n;
+
+    // 공개된 결과 (버전 카운터, 홀수 = 갱신 중)
+    _Atomic uint32_t version;
+    uint32_t results;
+    meas_result_t pub;
+} meas_t;
+
+// 설정 적용 후 비움 (잘못된 설정이면 false)
+bool meas_init(meas_t *m, uint32_t window, uint32_t sample_rate_hz);
+
+// 입력이 끊겼을 때: 채우던 창과 교차 상태를 버림 (교차 레벨과 공개된 결과는 유지)
+void meas_reset(meas_t *m);
+
+// [생산자] 샘플 추가. 이번 호출에서 완성된 창(공개된 결과) 수 반환
+uint32_t meas_push(meas_t *m, const uint16_t *samples, uint32_t count);
+
+// [소비자] 마지막 결과 복사. 아직 결과가 없으면 false
+bool meas_read(const meas_t *m, meas_result_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MEASURE_H
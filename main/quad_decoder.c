@@ -0,0 +1,45 @@
+#include "quad_decoder.h"
+
+#define QUAD_ACCEL_TAU_S        0.1f    // 속도 평균 시상수
+#define QUAD_ACCEL_MAX_GAP_S    0.5f    // 이보다 오래 멈추면 속도 0부터
+
+// 초기화
+void quad_accel_init(quad_accel_t *a, float start_rate, float full_rate, float max_multiplier)
+{
+    a->start_rate = start_rate;
+    a->full_rate = full_rate > start_rate ? full_rate : start_rate + 1.0f;
+    a->max_multiplier = max_multiplier >= 1.0f ? max_multiplier : 1.0f;
+    a->tau_s = QUAD_ACCEL_TAU_S;
+    a->rate = 0.0f;
+    a->last_us = 0;
+    a->started = false;
+}
+
+// 가속 적용
+int32_t quad_accel_apply(quad_accel_t *a, int32_t detents, int64_t now_us)
+{
+    float dt = a->started ? (float)(now_us - a->last_us) * 1e-6f : 0.0f;
+    a->last_us = now_us;
+    a->started = true;
+
+    // 지수 평균 (dt가 들쑥날쑥해도 시간 기준으로 같은 감쇠)
+    if (dt > QUAD_ACCEL_MAX_GAP_S) {
+        a->rate = 0.0f;
+    } else if (dt > 0.0f) {
+        float n = (float)(detents < 0 ? -detents : detents);
+        float alpha = dt / (a->tau_s + dt);
+        a->rate += (n / dt - a->rate) * alpha;
+    }
+
+    if (detents == 0) {
+        return 0;
+    }
+
+    float mult = 1.0f;
+    if (a->rate > a->start_rate) {
+        float t = (a->rate - a->start_rate) / (a->full_rate - a->start_rate);
+        mult = 1.0f + (a->max_multiplier - 1.0f) * (t < 1.0f ? t : 1.0f);
+    }
+    float units = (float)detents * mult;
+    return (int32_t)(units < 0.0f ? units - 0.5f : units + 0.5f);
+}
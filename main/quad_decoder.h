@@ -0,0 +1,82 @@
+#ifndef QUAD_DECODER_H
+#define QUAD_DECODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 로터리 인코더 4체배 쿼드러처 디코더 + 속도 가속
+//
+// 상태 ab = (A << 1) | B. 이전/현재 상태 쌍(16가지)을 표로 찾아 1/4 스텝 단위로
+// +1/-1/0을 더한다. A, B 어느 쪽의 상승/하강 에지든 모두 센다.
+// 두 비트가 한꺼번에 바뀐 경우(에지를 놓침)는 방향을 알 수 없으므로 세지 않고 errors만 센다.
+// 00 -> 01 -> 11 -> 10 -> 00 순서가 + 방향 (기존 인코더 코드의 시계 방향과 같음).
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define QUAD_STEPS_PER_DETENT   4       // 클릭 하나에 한 주기 (EC11 계열)
+
+typedef struct {
+    uint8_t state;          // 마지막 ab
+    uint32_t errors;        // 두 비트가 동시에 바뀐 횟수
+} quad_decoder_t;
+
+static inline void quad_decoder_init(quad_decoder_t *q, uint8_t ab)
+{
+    q->state = ab & 3;
+    q->errors = 0;
+}
+
+// 새 ab 상태 반영. 1/4 스텝 변화량(-1, 0, +1) 반환 (ISR에서 호출 가능)
+static inline int quad_decoder_step(quad_decoder_t *q, uint8_t ab)
+{
+    // [prev << 2 | cur]
+    static const int8_t table[16] = {
+         0, +1, -1,  0,
+        -1,  0,  0, +1,
+        +1,  0,  0, -1,
+         0, -1, +1,  0,
+    };
+    uint8_t idx = (uint8_t)((q->state << 2) | (ab & 3));
+
+    // 두 비트가 모두 바뀜: 방향 모름
+    if ((q->state ^ ab) == 3) {
+        q->errors++;
+    }
+    q->state = ab & 3;
+    return table[idx];
+}
+
+// 누적 1/4 스텝 위치에서 새로 완성된 클릭 수를 꺼냄 (남은 1/4 스텝은 다음으로 넘김)
+static inline int32_t quad_take_detents(int32_t position, int32_t *taken)
+{
+    int32_t detents = (position - *taken) / QUAD_STEPS_PER_DETENT;
+    *taken += detents * QUAD_STEPS_PER_DETENT;
+    return detents;
+}
+
+// 속도 가속: 빠르게 돌리면 클릭 하나가 여러 단위가 된다
+typedef struct {
+    float start_rate;       // 이 속도(클릭/초)까지는 배율 1
+    float full_rate;        // 이 속도 이상이면 max_multiplier
+    float max_multiplier;
+    float tau_s;            // 속도 평균 시상수
+
+    float rate;             // 평균 속도 (클릭/초)
+    int64_t last_us;
+    bool started;
+} quad_accel_t;
+
+void quad_accel_init(quad_accel_t *a, float start_rate, float full_rate, float max_multiplier);
+
+// detents 클릭을 now_us에 받았을 때 적용할 단위 수 반환 (부호 유지, 0이면 0).
+// 클릭이 없어도 주기적으로 불러 주면 속도가 줄어든다
+int32_t quad_accel_apply(quad_accel_t *a, int32_t detents, int64_t now_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // QUAD_DECODER_H
@@ -0,0 +1,127 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "ft800.h"
+#include "render_sched.h"
+
+static const char *TAG = "RENDER";
+
+static TaskHandle_t render_task = NULL;     // 알림 받을 태스크 (NULL이면 미초기화)
+static uint32_t render_flags;               // 읽었지만 아직 소비하지 않은 REG_INT_FLAGS
+static uint32_t render_missed;
+
+static void IRAM_ATTR render_isr_handler(void *arg)
+{
+    (void)arg;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(render_task, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+// ms -> tick (최소 1 tick)
+static TickType_t render_ticks(uint32_t ms)
+{
+    TickType_t ticks = pdMS_TO_TICKS(ms);
+    return ticks > 0 ? ticks : 1;
+}
+
+// 초기화
+esp_err_t render_sched_init(void)
+{
+    ft800_handle_t *dev = get_driver_dev();
+    if (dev == NULL || dev->int_pin < 0) {
+        ESP_LOGW(TAG, "FT800 INT pin not configured");
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // INT_N은 오픈 드레인, active low
+    gpio_config_t io_conf = {
+        .pin_bit_mask = (1ULL << dev->int_pin),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
+    };
+    esp_err_t ret = gpio_config(&io_conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "INT GPIO config failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 인터럽트 서비스 설치 (이미 설치되어 있을 수 있음)
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO ISR service install failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    render_task = xTaskGetCurrentTaskHandle();
+    render_flags = 0;
+    render_missed = 0;
+
+    ret = gpio_isr_handler_add(dev->int_pin, render_isr_handler, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "INT ISR handler add failed: %s", esp_err_to_name(ret));
+        render_task = NULL;
+        return ret;
+    }
+
+    cmd_flush();
+    HOST_MEM_WR8(REG_INT_MASK, INT_SWAP | INT_CMDEMPTY);
+    HOST_MEM_WR8(REG_INT_EN, 1);
+    // 남아 있던 플래그를 지워 INT 핀을 풀어 둠 (다음 하강 에지부터 받음)
+    ft800_clear_interrupt(dev);
+
+    ESP_LOGI(TAG, "Frame pacing on FT800 INT (GPIO%d)", dev->int_pin);
+    return ESP_OK;
+}
+
+// 인터럽트 대기
+uint32_t render_sched_wait(uint32_t mask, uint32_t timeout_ms)
+{
+    if (render_task == NULL) {
+        vTaskDelay(render_ticks(timeout_ms));
+        return 0;
+    }
+
+    ft800_handle_t *dev = get_driver_dev();
+    int64_t deadline = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+
+    while (1) {
+        // 핀이 내려가 있을 때만 플래그를 읽음 (읽으면 지워지고 핀이 풀림)
+        if (ft800_get_interrupt_status(dev)) {
+            render_flags |= ft800_read_interrupt_flags(dev);
+        }
+        uint32_t hit = render_flags & mask;
+        if (hit) {
+            render_flags &= ~hit;
+            return hit;
+        }
+
+        int64_t left_us = deadline - esp_timer_get_time();
+        if (left_us <= 0) {
+            return 0;
+        }
+        // 확인과 대기 사이에 온 알림은 카운트로 남아 있어 놓치지 않음
+        ulTaskNotifyTake(pdTRUE, render_ticks((uint32_t)((left_us + 999) / 1000)));
+    }
+}
+
+// 스왑 대기
+bool render_sched_wait_frame(void)
+{
+    if (render_sched_wait(INT_SWAP, RENDER_FRAME_TIMEOUT_MS) == 0) {
+        render_missed++;
+        return false;
+    }
+    return true;
+}
+
+uint32_t render_sched_missed_frames(void)
+{
+    return render_missed;
+}
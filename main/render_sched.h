@@ -0,0 +1,39 @@
+#ifndef RENDER_SCHED_H
+#define RENDER_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// FT800 인터럽트 기반 프레임 페이싱
+//
+// REG_INT_MASK에 INT_SWAP(디스플레이 리스트 교체 완료 = vsync)과 INT_CMDEMPTY(명령 FIFO 비움)를
+// 켜고, INT 핀(GPIO27, active low) ISR에서 렌더 태스크에 태스크 알림만 보낸다.
+// 렌더 태스크는 알림을 받은 뒤에만 REG_INT_FLAGS를 읽으므로 SPI 폴링이 없다.
+// REG_INT_FLAGS는 읽으면 모두 지워지므로 읽은 플래그는 여기서 모아 두고 요청한 것만 소비한다.
+// 모든 함수는 render_sched_init을 호출한 렌더 태스크에서만 부른다.
+
+#define RENDER_FRAME_TIMEOUT_MS     50  // INT가 오지 않을 때 최소 프레임 주기 (20 fps)
+
+// 인터럽트 설정, 호출한 태스크를 렌더 태스크로 등록 (initFT800 이후)
+esp_err_t render_sched_init(void);
+
+// mask 중 하나가 들어올 때까지 대기. 들어온 플래그 반환 (타임아웃이면 0).
+// 초기화 전이면 timeout_ms만큼 쉬고 0 반환
+uint32_t render_sched_wait(uint32_t mask, uint32_t timeout_ms);
+
+// CMD_SWAP 뒤에 호출: 스왑(vsync)이 끝날 때까지 대기. 타임아웃이면 false
+bool render_sched_wait_frame(void);
+
+// INT_SWAP을 못 받고 타임아웃으로 넘어간 프레임 수
+uint32_t render_sched_missed_frames(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RENDER_SCHED_H
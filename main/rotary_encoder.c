@@ -0,0 +1,266 @@
+#include <stdatomic.h>
+#include "driver/gpio.h"
+#include "driver/pulse_cnt.h"
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "rotary_encoder.h"
+
+static const char *TAG = "ROTARY";
+
+typedef struct {
+    int pin_a;
+    int pin_b;
+    quad_decoder_t dec;             // ISR 전용
+    _Atomic int32_t position;       // 1/4 스텝 누적 (ISR이 씀)
+    int32_t taken;                  // 소비자가 클릭으로 가져간 위치
+    pcnt_unit_handle_t unit;        // PCNT 백엔드
+    pcnt_channel_handle_t pcnt_a;
+    pcnt_channel_handle_t pcnt_b;
+} rotary_channel_t;
+
+static rotary_channel_t rotary_ch[ROTARY_ENCODER_COUNT] = {
+    { .pin_a = ROTARY_RE0_PIN_A, .pin_b = ROTARY_RE0_PIN_B },
+    { .pin_a = ROTARY_RE1_PIN_A, .pin_b = ROTARY_RE1_PIN_B },
+};
+
+static rotary_backend_t rotary_backend = ROTARY_BACKEND_ISR;
+static bool rotary_initialized = false;
+
+static inline uint8_t rotary_read_ab(const rotary_channel_t *ch)
+{
+    // 두 상을 같은 순간에 읽음 (GPIO0~31 입력 레지스터 한 번)
+    uint32_t in = REG_READ(GPIO_IN_REG);
+    return (uint8_t)((((in >> ch->pin_a) & 1) << 1) | ((in >> ch->pin_b) & 1));
+}
+
+static void IRAM_ATTR rotary_isr_handler(void *arg)
+{
+    rotary_channel_t *ch = (rotary_channel_t *)arg;
+    int delta = quad_decoder_step(&ch->dec, rotary_read_ab(ch));
+    if (delta != 0) {
+        atomic_fetch_add_explicit(&ch->position, delta, memory_order_relaxed);
+    }
+}
+
+// ISR 백엔드
+static esp_err_t rotary_init_isr(void)
+{
+    uint64_t mask = 0;
+    for (int i = 0; i < ROTARY_ENCODER_COUNT; i++) {
+        mask |= (1ULL << rotary_ch[i].pin_a) | (1ULL << rotary_ch[i].pin_b);
+    }
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = mask,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    esp_err_t ret = gpio_config(&io_conf);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Encoder GPIO config failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // 인터럽트 서비스 설치 (이미 설치되어 있을 수 있음)
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO ISR service install failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    for (int i = 0; i < ROTARY_ENCODER_COUNT; i++) {
+        rotary_channel_t *ch = &rotary_ch[i];
+        quad_decoder_init(&ch->dec, rotary_read_ab(ch));
+        atomic_store(&ch->position, 0);
+        ch->taken = 0;
+
+        ret = gpio_isr_handler_add(ch->pin_a, rotary_isr_handler, ch);
+        if (ret == ESP_OK) {
+            ret = gpio_isr_handler_add(ch->pin_b, rotary_isr_handler, ch);
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "RE%d ISR handler add failed: %s", i, esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    return ESP_OK;
+}
+
+// PCNT 유닛 정리 (초기화 실패 시)
+static void rotary_pcnt_release(rotary_channel_t *ch)
+{
+    if (ch->unit == NULL) {
+        return;
+    }
+    pcnt_unit_stop(ch->unit);
+    pcnt_unit_disable(ch->unit);
+    if (ch->pcnt_a != NULL) {
+        pcnt_del_channel(ch->pcnt_a);
+        ch->pcnt_a = NULL;
+    }
+    if (ch->pcnt_b != NULL) {
+        pcnt_del_channel(ch->pcnt_b);
+        ch->pcnt_b = NULL;
+    }
+    pcnt_del_unit(ch->unit);
+    ch->unit = NULL;
+}
+
+// 인코더 하나를 PCNT 유닛 하나에 연결
+static esp_err_t rotary_pcnt_setup(rotary_channel_t *ch)
+{
+    // 하드웨어 카운터는 16비트. 한계에 닿으면 드라이버가 누적해 int 범위로 넓혀 준다
+    pcnt_unit_config_t unit_conf = {
+        .low_limit = INT16_MIN,
+        .high_limit = INT16_MAX,
+        .flags.accum_count = 1,
+    };
+    esp_err_t ret = pcnt_new_unit(&unit_conf, &ch->unit);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    pcnt_glitch_filter_config_t filter_conf = {
+        .max_glitch_ns = ROTARY_PCNT_GLITCH_NS,
+    };
+    ret = pcnt_unit_set_glitch_filter(ch->unit, &filter_conf);
+
+    // 채널 A: A 에지를 B 레벨로, 채널 B: B 에지를 A 레벨로 세어 4체배
+    pcnt_chan_config_t a_conf = {
+        .edge_gpio_num = ch->pin_a,
+        .level_gpio_num = ch->pin_b,
+    };
+    pcnt_chan_config_t b_conf = {
+        .edge_gpio_num = ch->pin_b,
+        .level_gpio_num = ch->pin_a,
+    };
+    if (ret == ESP_OK) {
+        ret = pcnt_new_channel(ch->unit, &a_conf, &ch->pcnt_a);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_new_channel(ch->unit, &b_conf, &ch->pcnt_b);
+    }
+
+    // quad_decoder와 같은 방향 (AB 00->01->11->10 이 +)
+    //  A 상승: B=1이면 +, A 하강: B=1이면 -  (B=0이면 반대)
+    //  B 상승: A=0이면 +, B 하강: A=0이면 -  (A=1이면 반대)
+    if (ret == ESP_OK) {
+        ret = pcnt_channel_set_edge_action(ch->pcnt_a, PCNT_CHANNEL_EDGE_ACTION_INCREASE,
+                                           PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_channel_set_level_action(ch->pcnt_a, PCNT_CHANNEL_LEVEL_ACTION_KEEP,
+                                            PCNT_CHANNEL_LEVEL_ACTION_INVERSE);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_channel_set_edge_action(ch->pcnt_b, PCNT_CHANNEL_EDGE_ACTION_INCREASE,
+                                           PCNT_CHANNEL_EDGE_ACTION_DECREASE);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_channel_set_level_action(ch->pcnt_b, PCNT_CHANNEL_LEVEL_ACTION_INVERSE,
+                                            PCNT_CHANNEL_LEVEL_ACTION_KEEP);
+    }
+
+    // 누적 모드는 한계값에 관찰점이 있어야 넘침을 잡는다
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_add_watch_point(ch->unit, INT16_MIN);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_add_watch_point(ch->unit, INT16_MAX);
+    }
+
+    // PCNT는 GPIO 풀업을 건드리지 않음 (ISR 백엔드와 같은 내부 풀업)
+    if (ret == ESP_OK) {
+        gpio_pullup_en(ch->pin_a);
+        gpio_pullup_en(ch->pin_b);
+        ret = pcnt_unit_enable(ch->unit);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_clear_count(ch->unit);
+    }
+    if (ret == ESP_OK) {
+        ret = pcnt_unit_start(ch->unit);
+    }
+    return ret;
+}
+
+// PCNT 백엔드
+static esp_err_t rotary_init_pcnt(void)
+{
+    for (int i = 0; i < ROTARY_ENCODER_COUNT; i++) {
+        rotary_channel_t *ch = &rotary_ch[i];
+        ch->taken = 0;
+
+        esp_err_t ret = rotary_pcnt_setup(ch);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "RE%d PCNT setup failed: %s", i, esp_err_to_name(ret));
+            for (int j = 0; j <= i; j++) {
+                rotary_pcnt_release(&rotary_ch[j]);
+            }
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
+
+// 초기화
+esp_err_t rotary_encoder_init(rotary_backend_t backend)
+{
+    if (rotary_initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = (backend == ROTARY_BACKEND_PCNT) ? rotary_init_pcnt() : rotary_init_isr();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    rotary_backend = backend;
+    rotary_initialized = true;
+    ESP_LOGI(TAG, "Rotary encoders (%s): 4x quadrature decoding on GPIO%d/%d, GPIO%d/%d",
+             backend == ROTARY_BACKEND_PCNT ? "PCNT" : "ISR",
+             rotary_ch[0].pin_a, rotary_ch[0].pin_b, rotary_ch[1].pin_a, rotary_ch[1].pin_b);
+    return ESP_OK;
+}
+
+rotary_backend_t rotary_encoder_backend(void)
+{
+    return rotary_backend;
+}
+
+int32_t rotary_encoder_position(int id)
+{
+    if (id < 0 || id >= ROTARY_ENCODER_COUNT) {
+        return 0;
+    }
+    if (rotary_backend == ROTARY_BACKEND_PCNT) {
+        int count = 0;
+        if (rotary_ch[id].unit == NULL || pcnt_unit_get_count(rotary_ch[id].unit, &count) != ESP_OK) {
+            return rotary_ch[id].taken;     // 읽기 실패: 새 클릭 없음
+        }
+        return (int32_t)count;
+    }
+    return atomic_load_explicit(&rotary_ch[id].position, memory_order_relaxed);
+}
+
+// 새 클릭 가져가기
+int32_t rotary_encoder_take_detents(int id)
+{
+    if (id < 0 || id >= ROTARY_ENCODER_COUNT) {
+        return 0;
+    }
+    return quad_take_detents(rotary_encoder_position(id), &rotary_ch[id].taken);
+}
+
+uint32_t rotary_encoder_errors(int id)
+{
+    if (id < 0 || id >= ROTARY_ENCODER_COUNT) {
+        return 0;
+    }
+    return rotary_ch[id].dec.errors;
+}
@@ -0,0 +1,56 @@
+#ifndef ROTARY_ENCODER_H
+#define ROTARY_ENCODER_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "quad_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 로터리 인코더 (RE0: Time Div/Pos, RE1: Volt Div/Pos)
+//
+// 백엔드 두 가지 중 하나를 init에서 고른다.
+//  - ISR : A/B 네 핀 모두 양쪽 에지 인터럽트. ISR은 GPIO 입력 레지스터를 한 번 읽어 두 상을
+//          함께 보고 quad_decoder 표로 1/4 스텝을 원자 카운터에 바로 더한다 (큐, 태스크 없음).
+//  - PCNT: 인코더마다 펄스 카운터 유닛 하나(채널 2개)로 하드웨어가 4체배 디코딩과 글리치
+//          필터를 맡는다. 카운터 한계 도달 시에만 인터럽트가 나므로 ADC DMA 부하가 커도
+//          에지마다 CPU를 깨우지 않는다.
+// 위치 단위(1/4 스텝)와 방향이 같으므로 소비자(UI 태스크 하나)는 백엔드와 상관없이
+// rotary_encoder_take_detents()로 새로 완성된 클릭 수를 가져간다.
+
+#define ROTARY_ENCODER_COUNT    2
+
+#define ROTARY_RE0_PIN_A        15
+#define ROTARY_RE0_PIN_B        14
+#define ROTARY_RE1_PIN_A        13
+#define ROTARY_RE1_PIN_B        12
+
+#define ROTARY_PCNT_GLITCH_NS   1000    // 이보다 짧은 펄스는 무시 (접점 채터링)
+
+typedef enum {
+    ROTARY_BACKEND_ISR = 0,     // GPIO 에지 인터럽트 + 상태표
+    ROTARY_BACKEND_PCNT,        // 하드웨어 펄스 카운터
+} rotary_backend_t;
+
+// 초기화. 이미 초기화되어 있으면 ESP_ERR_INVALID_STATE
+esp_err_t rotary_encoder_init(rotary_backend_t backend);
+
+// 사용 중인 백엔드
+rotary_backend_t rotary_encoder_backend(void);
+
+// 누적 위치 (1/4 스텝)
+int32_t rotary_encoder_position(int id);
+
+// 지난 호출 이후 완성된 클릭 수 (+: 시계 방향). 소비자 태스크 하나만 호출
+int32_t rotary_encoder_take_detents(int id);
+
+// 에지를 놓쳐 방향을 알 수 없었던 횟수 (PCNT 백엔드는 항상 0)
+uint32_t rotary_encoder_errors(int id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROTARY_ENCODER_H
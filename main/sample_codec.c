@@ -0,0 +1,138 @@
+#include "sample_codec.h"
+
+#define SAMPLE_MASK     0x0FFF
+
+// 비트 쓰기 (acc에는 항상 8비트 미만이 남음)
+typedef struct {
+    uint8_t *p;
+    uint32_t acc;
+    int bits;
+} bit_writer_t;
+
+static inline void bw_put(bit_writer_t *w, uint32_t v, int n)
+{
+    w->acc |= v << w->bits;
+    w->bits += n;
+    while (w->bits >= 8) {
+        *w->p++ = (uint8_t)w->acc;
+        w->acc >>= 8;
+        w->bits -= 8;
+    }
+}
+
+static inline void bw_flush(bit_writer_t *w)
+{
+    if (w->bits > 0) {
+        *w->p++ = (uint8_t)w->acc;
+        w->acc = 0;
+        w->bits = 0;
+    }
+}
+
+// 비트 읽기
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint32_t acc;
+    int bits;
+} bit_reader_t;
+
+static inline int br_get(bit_reader_t *r, int n, uint32_t *v)
+{
+    while (r->bits < n) {
+        if (r->p == r->end) {
+            return 0;
+        }
+        r->acc |= (uint32_t)*r->p++ << r->bits;
+        r->bits += 8;
+    }
+    *v = r->acc & ((1u << n) - 1);
+    r->acc >>= n;
+    r->bits -= n;
+    return 1;
+}
+
+static inline uint32_t zigzag(int32_t d)
+{
+    return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t z)
+{
+    return (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+}
+
+// 압축
+size_t sample_codec_encode(const uint16_t *in, uint32_t n, uint8_t *out, size_t cap)
+{
+    if (n == 0 || cap < SAMPLE_CODEC_MAX_BYTES(n)) {
+        return 0;
+    }
+
+    bit_writer_t w = { .p = out };
+    int32_t prev = in[0] & SAMPLE_MASK;
+    bw_put(&w, (uint32_t)prev, 12);
+
+    uint32_t zz[SAMPLE_CODEC_GROUP];
+    for (uint32_t i = 1; i < n; i += SAMPLE_CODEC_GROUP) {
+        uint32_t count = n - i < SAMPLE_CODEC_GROUP ? n - i : SAMPLE_CODEC_GROUP;
+
+        // 그룹의 지그재그 차분과 필요한 폭
+        uint32_t any = 0;
+        for (uint32_t k = 0; k < count; k++) {
+            int32_t cur = in[i + k] & SAMPLE_MASK;
+            zz[k] = zigzag(cur - prev);
+            any |= zz[k];
+            prev = cur;
+        }
+        int width = any ? 32 - __builtin_clz(any) : 0;
+
+        bw_put(&w, (uint32_t)width, 4);
+        if (width > 0) {
+            for (uint32_t k = 0; k < count; k++) {
+                bw_put(&w, zz[k], width);
+            }
+        }
+    }
+
+    bw_flush(&w);
+    return (size_t)(w.p - out);
+}
+
+// 복원
+size_t sample_codec_decode(const uint8_t *in, size_t len, uint16_t *out, uint32_t n)
+{
+    if (n == 0) {
+        return 0;
+    }
+
+    bit_reader_t r = { .p = in, .end = in + len };
+    uint32_t v;
+    if (!br_get(&r, 12, &v)) {
+        return 0;
+    }
+    int32_t prev = (int32_t)v;
+    out[0] = (uint16_t)prev;
+
+    for (uint32_t i = 1; i < n; i += SAMPLE_CODEC_GROUP) {
+        uint32_t count = n - i < SAMPLE_CODEC_GROUP ? n - i : SAMPLE_CODEC_GROUP;
+        uint32_t width;
+        if (!br_get(&r, 4, &width) || width > SAMPLE_CODEC_MAX_WIDTH) {
+            return 0;
+        }
+        for (uint32_t k = 0; k < count; k++) {
+            uint32_t z = 0;
+            if (width > 0 && !br_get(&r, (int)width, &z)) {
+                return 0;
+            }
+            prev += unzigzag(z);
+            if (prev < 0 || prev > SAMPLE_MASK) {
+                return 0;
+            }
+            out[i + k] = (uint16_t)prev;
+        }
+    }
+
+    // 남은 비트는 바이트 채움 (이미 읽은 바이트까지가 이 블록)
+    return (size_t)(r.p - in);
+}
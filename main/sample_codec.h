@@ -0,0 +1,40 @@
+#ifndef SAMPLE_CODEC_H
+#define SAMPLE_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 12비트 샘플 블록 무손실 압축 (차분 + 지그재그 + 그룹별 비트 패킹)
+//
+// 비트 스트림 (LSB부터 채움):
+//   첫 샘플 12비트
+//   이후 차분을 SAMPLE_CODEC_GROUP개씩 묶어 그룹마다 [폭 4비트][지그재그 차분 x 폭비트]
+//   (마지막 그룹은 남은 개수만큼). 폭 0 그룹은 같은 값이 이어지는 구간이라 4비트로 끝난다 (RLE).
+// 블록 하나는 바이트 경계에서 끝나므로 채널 블록을 그대로 이어 붙일 수 있다.
+// 차분은 12비트 범위라 폭은 최대 13 -> 최악의 경우에도 샘플당 약 13.3비트 (uint16보다 작음).
+// 표 없이 덧셈과 시프트만 쓰므로 ESP32에서도 ADC 속도보다 훨씬 빠르다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define SAMPLE_CODEC_GROUP      16
+#define SAMPLE_CODEC_MAX_WIDTH  13
+
+// n개 샘플을 압축했을 때의 최대 바이트 수
+#define SAMPLE_CODEC_MAX_BYTES(n) \
+    ((12 + (((n) + SAMPLE_CODEC_GROUP - 1) / SAMPLE_CODEC_GROUP) * 4 + (size_t)(n) * SAMPLE_CODEC_MAX_WIDTH + 7) / 8)
+
+// 압축. in은 12비트 샘플 (상위 비트는 무시). cap이 SAMPLE_CODEC_MAX_BYTES(n)보다 작으면 0
+// 쓴 바이트 수 반환
+size_t sample_codec_encode(const uint16_t *in, uint32_t n, uint8_t *out, size_t cap);
+
+// 복원. n개 샘플을 풀고 읽은 바이트 수 반환, 데이터가 모자라거나 잘못됐으면 0
+size_t sample_codec_decode(const uint8_t *in, size_t len, uint16_t *out, uint32_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_CODEC_H
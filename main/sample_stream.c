@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "adc_dma_continuous.h"
+#include "stream_frame.h"
+#include "sample_stream.h"
+
+static const char *TAG = "STREAM";
+
+#define STREAM_UART             UART_NUM_0      // CH340 (콘솔과 같은 포트)
+#define STREAM_UART_TX_BUF      8192            // 프레임 약 8개분, 태스크는 여기서만 막힘
+#define STREAM_POLL_MS          10
+
+_Static_assert(SAMPLE_STREAM_BLOCK_SAMPLES <= STREAM_MAX_SAMPLES, "stream block too large");
+
+static TaskHandle_t stream_task = NULL;
+static _Atomic bool stream_run = false;
+static _Atomic uint32_t stream_gain = 0;
+static _Atomic uint32_t stream_frames = 0;
+static _Atomic uint32_t stream_lost = 0;
+static _Atomic uint32_t stream_sent_bytes = 0;
+static _Atomic uint32_t stream_raw_bytes = 0;
+static uint8_t stream_mask;
+static bool stream_packed;
+static vprintf_like_t stream_prev_vprintf = NULL;
+
+static uint16_t stream_samples[STREAM_MAX_CHANNELS][SAMPLE_STREAM_BLOCK_SAMPLES];
+static uint8_t stream_buf[STREAM_MAX_FRAME_BYTES];
+
+// 스트리밍 중 로그는 버림 (같은 UART에 섞이면 프레임이 깨짐)
+static int stream_null_vprintf(const char *fmt, va_list args)
+{
+    (void)fmt;
+    (void)args;
+    return 0;
+}
+
+static void sample_stream_task(void *pvParameters)
+{
+    (void)pvParameters;
+    const uint16_t *ch[STREAM_MAX_CHANNELS] = { stream_samples[0], stream_samples[1] };
+    uint32_t rate = adc_dma_get_sample_rate_hz();
+    uint32_t next_seq = adc_dma_get_write_seq();
+    uint32_t gaps_seen = adc_dma_get_gaps(NULL);
+    uint32_t frame_seq = 0;
+    bool gap = false;
+
+    while (atomic_load(&stream_run)) {
+        vTaskDelay(pdMS_TO_TICKS(STREAM_POLL_MS));
+
+        adc_ring_view_t view;
+        while (atomic_load(&stream_run) && adc_dma_get_view_since(next_seq, &view) == ESP_OK) {
+            // 이미 덮어써진 구간은 건너뜀
+            if (view.start_seq != next_seq) {
+                atomic_fetch_add(&stream_lost, view.start_seq - next_seq);
+                next_seq = view.start_seq;
+                gap = true;
+            }
+            // 생산자가 알린 끊김 (프레임 유실, 재시작): 끊긴 위치 앞의 남은 샘플은 시각을 이어 붙일 수 없으므로 버림
+            uint32_t gap_seq;
+            uint32_t gaps = adc_dma_get_gaps(&gap_seq);
+            if (gaps != gaps_seen) {
+                gaps_seen = gaps;
+                if ((int32_t)(gap_seq - next_seq) > 0) {
+                    atomic_fetch_add(&stream_lost, gap_seq - next_seq);
+                    next_seq = gap_seq;
+                }
+                gap = true;
+                adc_dma_put_view(&view);
+                continue;
+            }
+            if (view.count < SAMPLE_STREAM_BLOCK_SAMPLES) {
+                adc_dma_put_view(&view);
+                break;
+            }
+
+            // 첫 샘플 시각: 생산자가 기록한 (시퀀스, 시각) 기준. 끊긴 뒤 아직 새 기준이 없으면 다음 주기에
+            uint32_t anchor_seq, anchor_gaps;
+            int64_t anchor_us;
+            adc_dma_get_time_anchor(&anchor_seq, &anchor_us, &anchor_gaps);
+            if (anchor_gaps != gaps_seen) {
+                adc_dma_put_view(&view);
+                break;
+            }
+            int64_t first_us = anchor_us - (int64_t)(int32_t)(anchor_seq - next_seq) * 1000000 / rate;
+
+            view.count = SAMPLE_STREAM_BLOCK_SAMPLES;
+            for (int c = 0; c < STREAM_MAX_CHANNELS; c++) {
+                if (stream_mask & (1u << c)) {
+                    adc_ring_view_copy(&view, c, stream_samples[c], SAMPLE_STREAM_BLOCK_SAMPLES);
+                }
+            }
+            // 복사하는 동안 덮어써졌으면 다음 뷰에서 빠진 만큼 건너뜀
+            if (!adc_dma_put_view(&view)) {
+                continue;
+            }
+
+            stream_header_t hdr = {
+                .flags = (gap ? STREAM_FLAG_GAP : 0) | (stream_packed ? STREAM_FLAG_PACKED : 0),
+                .channel_mask = stream_mask,
+                .gain_state = (uint16_t)atomic_load_explicit(&stream_gain, memory_order_relaxed),
+                .sample_count = SAMPLE_STREAM_BLOCK_SAMPLES,
+                .seq = frame_seq++,
+                .first_sample = next_seq,
+                .timestamp_us = (uint64_t)first_us,
+                .sample_rate_hz = rate,
+            };
+            size_t len = stream_encode(&hdr, ch, stream_buf, sizeof(stream_buf));
+            uart_write_bytes(STREAM_UART, stream_buf, len);
+            atomic_fetch_add_explicit(&stream_sent_bytes, len, memory_order_relaxed);
+            atomic_fetch_add_explicit(&stream_raw_bytes, stream_frame_bytes(stream_mask, SAMPLE_STREAM_BLOCK_SAMPLES),
+                                      memory_order_relaxed);
+
+            next_seq += SAMPLE_STREAM_BLOCK_SAMPLES;
+            gap = false;
+            atomic_fetch_add_explicit(&stream_frames, 1, memory_order_relaxed);
+        }
+    }
+
+    uart_wait_tx_done(STREAM_UART, pdMS_TO_TICKS(100));
+    stream_task = NULL;
+    vTaskDelete(NULL);
+}
+
+// 스트리밍 시작
+esp_err_t sample_stream_start(uint32_t baud, uint8_t channel_mask, bool packed)
+{
+    if (stream_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    channel_mask &= (1u << STREAM_MAX_CHANNELS) - 1;
+    if (channel_mask == 0 || adc_dma_get_sample_rate_hz() == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // 콘솔은 드라이버 없이 쓰므로 TX 버퍼가 있는 드라이버를 설치
+    if (!uart_is_driver_installed(STREAM_UART)) {
+        esp_err_t ret = uart_driver_install(STREAM_UART, 256, STREAM_UART_TX_BUF, 0, NULL, 0);
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "UART driver install failed: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    // 마지막 로그 후 속도 전환
+    ESP_LOGI(TAG, "Streaming %s samples at %lu baud (mask 0x%X), console log muted",
+             packed ? "packed" : "raw", (unsigned long)baud, channel_mask);
+    uart_wait_tx_done(STREAM_UART, pdMS_TO_TICKS(100));
+    esp_err_t ret = uart_set_baudrate(STREAM_UART, baud);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "UART baud rate %lu failed: %s", (unsigned long)baud, esp_err_to_name(ret));
+        return ret;
+    }
+    stream_prev_vprintf = esp_log_set_vprintf(stream_null_vprintf);
+
+    stream_mask = channel_mask;
+    stream_packed = packed;
+    atomic_store(&stream_frames, 0);
+    atomic_store(&stream_sent_bytes, 0);
+    atomic_store(&stream_raw_bytes, 0);
+    atomic_store(&stream_lost, 0);
+    atomic_store(&stream_run, true);
+    if (xTaskCreate(sample_stream_task, "sample_stream", 4096, NULL, 4, &stream_task) != pdPASS) {
+        atomic_store(&stream_run, false);
+        esp_log_set_vprintf(stream_prev_vprintf);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+// 스트리밍 정지
+void sample_stream_stop(void)
+{
+    if (stream_task == NULL) {
+        return;
+    }
+    atomic_store(&stream_run, false);
+    while (stream_task != NULL) {
+        vTaskDelay(pdMS_TO_TICKS(STREAM_POLL_MS));
+    }
+    esp_log_set_vprintf(stream_prev_vprintf);
+
+    uint32_t frames, lost, sent, raw;
+    sample_stream_get_stats(&frames, &lost);
+    sample_stream_get_bytes(&sent, &raw);
+    ESP_LOGI(TAG, "Streaming stopped: %lu frames, %lu samples lost, %lu bytes (%.1f%% of raw)",
+             (unsigned long)frames, (unsigned long)lost, (unsigned long)sent, raw ? 100.0 * sent / raw : 0.0);
+}
+
+bool sample_stream_running(void)
+{
+    return stream_task != NULL;
+}
+
+void sample_stream_set_gain_state(uint16_t gain_state)
+{
+    atomic_store_explicit(&stream_gain, gain_state, memory_order_relaxed);
+}
+
+void sample_stream_get_stats(uint32_t *frames, uint32_t *lost_samples)
+{
+    if (frames != NULL) {
+        *frames = atomic_load_explicit(&stream_frames, memory_order_relaxed);
+    }
+    if (lost_samples != NULL) {
+        *lost_samples = atomic_load_explicit(&stream_lost, memory_order_relaxed);
+    }
+}
+
+void sample_stream_get_bytes(uint32_t *sent, uint32_t *raw)
+{
+    if (sent != NULL) {
+        *sent = atomic_load_explicit(&stream_sent_bytes, memory_order_relaxed);
+    }
+    if (raw != NULL) {
+        *raw = atomic_load_explicit(&stream_raw_bytes, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef SAMPLE_STREAM_H
+#define SAMPLE_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 라이브 샘플 스트리밍 (UART0 -> CH340)
+//
+// ADC 링버퍼에서 새로 들어온 샘플을 STREAM_BLOCK_SAMPLES개씩 잘라 stream_frame 형식으로
+// 보낸다. 링 쓰기 시퀀스를 따라가므로 샘플을 빠짐없이 보내고, UART가 못 따라가서
+// 링이 덮어써지거나 ADC 쪽에서 샘플이 끊기면(DMA 프레임 유실, 재시작) 그 다음 프레임에
+// STREAM_FLAG_GAP을 세운다. 첫 샘플 시각은 처리 태스크가 프레임마다 기록한 (시퀀스, 시각)에서 계산한다.
+// 스트리밍 중에는 같은 UART의 ESP_LOG 출력을 막는다 (정지하면 복구).
+// ADC DMA가 동작 중이어야 한다. 호스트 디코더: host/stream_decode.py
+
+#define SAMPLE_STREAM_BAUD_DEFAULT  921600
+#define SAMPLE_STREAM_BLOCK_SAMPLES 256     // 프레임당 채널별 샘플 수 (10kHz에서 약 39프레임/초)
+
+// 스트리밍 시작. channel_mask: bit0 = CH0, bit1 = CH1
+// packed이면 샘플을 sample_codec으로 압축해서 보냄 (보통 원본의 절반 이하)
+esp_err_t sample_stream_start(uint32_t baud, uint8_t channel_mask, bool packed);
+
+// 스트리밍 정지 (태스크가 끝날 때까지 기다림)
+void sample_stream_stop(void);
+
+bool sample_stream_running(void);
+
+// 프레임 헤더에 넣을 감쇠 상태 (STREAM_GAIN_BYTE 두 개, CH0 = 하위 바이트)
+void sample_stream_set_gain_state(uint16_t gain_state);
+
+// 보낸 프레임 수, 링 덮어쓰기로 빠진 샘플 수
+void sample_stream_get_stats(uint32_t *frames, uint32_t *lost_samples);
+
+// 보낸 바이트 수와 같은 샘플을 압축 없이 보냈을 때의 바이트 수 (압축률 확인용)
+void sample_stream_get_bytes(uint32_t *sent, uint32_t *raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SAMPLE_STREAM_H
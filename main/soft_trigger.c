@@ -0,0 +1,302 @@
+#include <string.h>
+#include "soft_trigger.h"
+
+// 샘플 범위 밖 임계값 ("절대 만족하지 않음" 용도)
+#define TRIG_NEVER_LOW      0x0000  // x < 0 은 없음
+#define TRIG_NEVER_HIGH     0x8000  // 12비트 샘플은 0x8000 이상이 될 수 없음
+
+// 내부 상태
+enum {
+    ST_NEUTRAL = 0,     // 어느 쪽으로도 무장 안 됨
+    ST_LOW,             // 아래쪽 (상승 교차 대기)
+    ST_HIGH,            // 위쪽 (하강 교차 대기)
+    ST_RUNT_FROM_LOW,   // 하한을 넘어 밴드 안 (양의 런트 후보)
+    ST_RUNT_FROM_HIGH,  // 상한 아래로 내려와 밴드 안 (음의 런트 후보)
+};
+
+// 처음으로 x < lo 또는 x >= hi 인 샘플 인덱스 (없으면 n)
+//
+// LX6에는 SIMD가 없으므로 32비트 워드에 샘플 2개를 넣고 레인별로 비교한다 (SWAR).
+// 12비트 값에 (0x8000 - T)를 더하면 x >= T 일 때만 bit15가 선다. 합이 0x8FFF를
+// 넘지 않으므로 옆 레인으로 캐리가 넘어가지 않는다.
+static uint32_t find_outside(const uint16_t *x, uint32_t i, uint32_t n, uint32_t lo, uint32_t hi)
+{
+    // 정렬될 때까지 한 샘플씩
+    while (i < n && ((uintptr_t)(x + i) & 3) != 0) {
+        if (x[i] < lo || x[i] >= hi) {
+            return i;
+        }
+        i++;
+    }
+
+    const uint32_t k_lo = (0x8000 - lo) * 0x00010001u;
+    const uint32_t k_hi = (0x8000 - hi) * 0x00010001u;
+
+    // 워드 4개(샘플 8개) 단위로 검사, 걸리면 그 구간만 다시 한 샘플씩
+    while (i + 8 <= n) {
+        uint32_t w0, w1, w2, w3;
+        memcpy(&w0, x + i, 4);
+        memcpy(&w1, x + i + 2, 4);
+        memcpy(&w2, x + i + 4, 4);
+        memcpy(&w3, x + i + 6, 4);
+
+        uint32_t m = ~(w0 + k_lo) | (w0 + k_hi) |
+                     ~(w1 + k_lo) | (w1 + k_hi) |
+                     ~(w2 + k_lo) | (w2 + k_hi) |
+                     ~(w3 + k_lo) | (w3 + k_hi);
+        if (m & 0x80008000u) {
+            break;
+        }
+        i += 8;
+    }
+
+    for (; i < n; i++) {
+        if (x[i] < lo || x[i] >= hi) {
+            return i;
+        }
+    }
+    return n;
+}
+
+static uint16_t clamp_level(int32_t v)
+{
+    if (v < 0) {
+        return 0;
+    }
+    if (v > 0x1000) {
+        return 0x1000;
+    }
+    return (uint16_t)v;
+}
+
+// 설정 적용
+bool soft_trig_init(soft_trig_t *trig, const soft_trig_config_t *cfg)
+{
+    if (trig == NULL || cfg == NULL || cfg->level > 0x0FFF || cfg->level_high > 0x0FFF) {
+        return false;
+    }
+    if (cfg->type == SOFT_TRIG_RUNT && cfg->level_high <= cfg->level) {
+        return false;
+    }
+
+    memset(trig, 0, sizeof(*trig));
+    trig->cfg = *cfg;
+    if (cfg->type == SOFT_TRIG_RUNT) {
+        // 런트는 하한/상한 밖으로 hys 만큼 더 나가야 돌아온 것으로 본다
+        trig->arm_rise = clamp_level((int32_t)cfg->level - cfg->hysteresis);
+        trig->arm_fall = clamp_level((int32_t)cfg->level_high + cfg->hysteresis);
+    } else {
+        // 상승: level - hys 아래를 본 뒤 level 교차, 하강: level + hys 이상을 본 뒤 level 교차
+        trig->arm_rise = clamp_level((int32_t)cfg->level - cfg->hysteresis);
+        trig->arm_fall = clamp_level((int32_t)cfg->level + cfg->hysteresis);
+    }
+    soft_trig_reset(trig, 0);
+    return true;
+}
+
+// 상태 초기화
+void soft_trig_reset(soft_trig_t *trig, uint32_t start_seq)
+{
+    trig->state = ST_NEUTRAL;
+    trig->seq = start_seq;
+    trig->edge_seq = start_seq;
+    trig->edge_valid = false;
+}
+
+static bool slope_has_rising(const soft_trig_t *trig)
+{
+    return trig->cfg.slope != SOFT_TRIG_SLOPE_FALLING;
+}
+
+static bool slope_has_falling(const soft_trig_t *trig)
+{
+    return trig->cfg.slope != SOFT_TRIG_SLOPE_RISING;
+}
+
+// 트리거 기록
+static bool fire(soft_trig_t *trig, uint32_t seq, uint32_t width, bool rising)
+{
+    trig->trigger_seq = seq;
+    trig->last_width = width;
+    trig->last_rising = rising;
+    return true;
+}
+
+// 레벨 교차 하나 처리 - 트리거 조건이면 true
+static bool on_crossing(soft_trig_t *trig, uint32_t seq, bool rising)
+{
+    bool hit = false;
+
+    if (trig->cfg.type == SOFT_TRIG_EDGE) {
+        if (rising ? slope_has_rising(trig) : slope_has_falling(trig)) {
+            hit = fire(trig, seq, 0, rising);
+        }
+    } else if (trig->edge_valid && trig->edge_rising != rising) {
+        // 펄스가 끝나는 교차: 하강이면 양의 펄스, 상승이면 음의 펄스
+        uint32_t width = seq - trig->edge_seq;
+        bool positive = !rising;
+        bool want = positive ? slope_has_rising(trig) : slope_has_falling(trig);
+        bool match = (trig->cfg.width_cond == SOFT_TRIG_WIDTH_GREATER) ?
+                     (width > trig->cfg.width_samples) : (width < trig->cfg.width_samples);
+        if (want && match) {
+            hit = fire(trig, seq, width, positive);
+        }
+    }
+
+    trig->edge_seq = seq;
+    trig->edge_rising = rising;
+    trig->edge_valid = true;
+    return hit;
+}
+
+// 엣지/펄스 폭: 히스테리시스 밴드로 무장한 뒤 레벨 교차를 찾는다
+static bool scan_level(soft_trig_t *trig, const uint16_t *x, uint32_t n, uint32_t *pos)
+{
+    // 엣지 모드에서 한쪽 방향만 쓰면 반대쪽 무장은 볼 필요 없음 (펄스는 양쪽 다 추적)
+    const bool edge = (trig->cfg.type == SOFT_TRIG_EDGE);
+    const bool want_rise = !edge || slope_has_rising(trig);
+    const bool want_fall = !edge || slope_has_falling(trig);
+    const uint32_t level = trig->cfg.level;
+    uint32_t i = *pos;
+
+    while (i < n) {
+        bool hit;
+
+        if (trig->state == ST_NEUTRAL) {
+            i = find_outside(x, i, n,
+                             want_rise ? trig->arm_rise : TRIG_NEVER_LOW,
+                             want_fall ? trig->arm_fall : TRIG_NEVER_HIGH);
+            if (i < n) {
+                trig->state = (want_rise && x[i] < trig->arm_rise) ? ST_LOW : ST_HIGH;
+                i++;
+            }
+            continue;
+        }
+
+        if (trig->state == ST_LOW) {
+            i = find_outside(x, i, n, TRIG_NEVER_LOW, level);
+            if (i == n) {
+                break;
+            }
+            hit = on_crossing(trig, trig->seq + i, true);
+        } else {
+            i = find_outside(x, i, n, level, TRIG_NEVER_HIGH);
+            if (i == n) {
+                break;
+            }
+            hit = on_crossing(trig, trig->seq + i, false);
+        }
+
+        // 교차 후에는 다시 밴드 밖으로 나가야 무장됨
+        trig->state = ST_NEUTRAL;
+        i++;
+        if (hit) {
+            *pos = i;
+            return true;
+        }
+    }
+
+    *pos = i;
+    return false;
+}
+
+// 런트: 한쪽 임계값만 넘고 반대쪽에 못 미친 채 돌아온 펄스
+static bool scan_runt(soft_trig_t *trig, const uint16_t *x, uint32_t n, uint32_t *pos)
+{
+    const uint32_t lo = trig->cfg.level;
+    const uint32_t hi = trig->cfg.level_high;
+    uint32_t i = *pos;
+
+    while (i < n) {
+        uint32_t seq;
+
+        switch (trig->state) {
+            case ST_NEUTRAL:
+                i = find_outside(x, i, n, lo, hi);
+                if (i < n) {
+                    trig->state = (x[i] < lo) ? ST_LOW : ST_HIGH;
+                    i++;
+                }
+                break;
+
+            case ST_LOW:
+                i = find_outside(x, i, n, TRIG_NEVER_LOW, lo);
+                if (i < n) {
+                    trig->edge_seq = trig->seq + i;
+                    trig->state = ST_RUNT_FROM_LOW;
+                    i++;
+                }
+                break;
+
+            case ST_HIGH:
+                i = find_outside(x, i, n, hi, TRIG_NEVER_HIGH);
+                if (i < n) {
+                    trig->edge_seq = trig->seq + i;
+                    trig->state = ST_RUNT_FROM_HIGH;
+                    i++;
+                }
+                break;
+
+            case ST_RUNT_FROM_LOW:
+                i = find_outside(x, i, n, trig->arm_rise, hi);
+                if (i == n) {
+                    break;
+                }
+                if (x[i] >= hi) {
+                    trig->state = ST_HIGH;     // 정상 펄스
+                    i++;
+                    break;
+                }
+                seq = trig->seq + i;
+                trig->state = ST_LOW;
+                i++;
+                if (slope_has_rising(trig)) {
+                    *pos = i;
+                    return fire(trig, seq, seq - trig->edge_seq, true);
+                }
+                break;
+
+            case ST_RUNT_FROM_HIGH:
+            default:
+                i = find_outside(x, i, n, lo, trig->arm_fall);
+                if (i == n) {
+                    break;
+                }
+                if (x[i] < lo) {
+                    trig->state = ST_LOW;      // 정상 펄스
+                    i++;
+                    break;
+                }
+                seq = trig->seq + i;
+                trig->state = ST_HIGH;
+                i++;
+                if (slope_has_falling(trig)) {
+                    *pos = i;
+                    return fire(trig, seq, seq - trig->edge_seq, false);
+                }
+                break;
+        }
+    }
+
+    *pos = i;
+    return false;
+}
+
+// 샘플 스캔
+bool soft_trig_scan(soft_trig_t *trig, const uint16_t *samples, uint32_t count, uint32_t *consumed)
+{
+    uint32_t pos = 0;
+    bool hit;
+
+    if (trig->cfg.type == SOFT_TRIG_RUNT) {
+        hit = scan_runt(trig, samples, count, &pos);
+    } else {
+        hit = scan_level(trig, samples, count, &pos);
+    }
+
+    trig->seq += pos;
+    if (consumed) {
+        *consumed = pos;
+    }
+    return hit;
+}
@@ -0,0 +1,73 @@
+#ifndef SOFT_TRIGGER_H
+#define SOFT_TRIGGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 소프트웨어 디지털 트리거 (비교기가 연결되지 않은 채널용)
+//
+// 링버퍼의 채널별 연속 구간을 그대로 넘겨서 스캔한다. 상태는 호출 사이에 유지되므로
+// DMA 프레임 단위로 잘라서 넣어도 한 번에 넣은 것과 결과가 같다.
+// 입력은 12비트 샘플(0~4095)이어야 한다 (adc_ring에 기록된 값).
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+typedef enum {
+    SOFT_TRIG_EDGE = 0,         // 레벨 교차
+    SOFT_TRIG_PULSE_WIDTH,      // 펄스 폭 조건 (펄스가 끝나는 엣지에서 트리거)
+    SOFT_TRIG_RUNT,             // 하한은 넘었지만 상한에 못 미치고 돌아온 펄스
+} soft_trig_type_t;
+
+typedef enum {
+    SOFT_TRIG_SLOPE_RISING = 0, // EDGE: 상승 / PULSE: 양의 펄스 / RUNT: 양의 런트
+    SOFT_TRIG_SLOPE_FALLING,    // EDGE: 하강 / PULSE: 음의 펄스 / RUNT: 음의 런트
+    SOFT_TRIG_SLOPE_EITHER,
+} soft_trig_slope_t;
+
+typedef enum {
+    SOFT_TRIG_WIDTH_GREATER = 0,    // 폭 > width_samples
+    SOFT_TRIG_WIDTH_LESS,           // 폭 < width_samples
+} soft_trig_width_cond_t;
+
+typedef struct {
+    soft_trig_type_t type;
+    soft_trig_slope_t slope;
+    uint16_t level;                 // 트리거 레벨 (EDGE/PULSE), RUNT에서는 하한
+    uint16_t level_high;            // RUNT 상한
+    uint16_t hysteresis;            // 노이즈 제거 밴드 (raw 카운트)
+    soft_trig_width_cond_t width_cond;
+    uint32_t width_samples;         // PULSE 폭 기준 (샘플 수)
+} soft_trig_config_t;
+
+typedef struct {
+    soft_trig_config_t cfg;
+    uint16_t arm_rise;              // 상승 무장 기준 (EDGE/PULSE: level - hys, RUNT: 하한 - hys)
+    uint16_t arm_fall;              // 하강 무장 기준 (EDGE/PULSE: level + hys, RUNT: 상한 + hys)
+    int state;                      // 내부 상태
+    uint32_t seq;                   // 다음 입력 샘플의 시퀀스 번호
+    uint32_t edge_seq;              // 마지막 레벨 교차 시퀀스 (펄스/런트 시작)
+    bool edge_valid;                // edge_seq가 유효한지 (리셋 직후에는 false)
+    bool edge_rising;               // 마지막 레벨 교차 방향
+    uint32_t trigger_seq;           // 마지막 트리거 시퀀스
+    uint32_t last_width;            // 마지막 트리거 펄스 폭 (PULSE/RUNT)
+    bool last_rising;               // 마지막 트리거 방향 (양의 펄스/상승 엣지이면 true)
+} soft_trig_t;
+
+// 설정 적용 (잘못된 설정이면 false)
+bool soft_trig_init(soft_trig_t *trig, const soft_trig_config_t *cfg);
+
+// 상태 초기화 - 입력이 끊겼을 때 (start_seq = 다음 입력의 시퀀스)
+void soft_trig_reset(soft_trig_t *trig, uint32_t start_seq);
+
+// 샘플 스캔. 트리거가 나오면 그 샘플까지만 소비하고 true (trig->trigger_seq에 위치)
+// 없으면 전부 소비하고 false. *consumed에 소비한 샘플 수
+bool soft_trig_scan(soft_trig_t *trig, const uint16_t *samples, uint32_t count, uint32_t *consumed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOFT_TRIGGER_H
@@ -0,0 +1,145 @@
+#include <string.h>
+#include <math.h>
+#include "spectrum.h"
+
+// dB 변환: log2(전력) Q16 -> 0.01 dB (10 log10(2) * 100 / 65536, Q32)
+#define CDB_PER_LOG2_Q16_Q32    19728302
+
+// log2(1 + i / 256) Q16, 칸 사이는 선형 보간
+static uint32_t log2_frac_q16[257];
+static bool log2_ready;
+
+// 코사인 합 창 계수 (주기형: 분모 N)
+static const float window_coef[SPECTRUM_WINDOW_COUNT][5] = {
+    [SPECTRUM_WINDOW_RECT]            = { 1.0f },
+    [SPECTRUM_WINDOW_HANN]            = { 0.5f, 0.5f },
+    [SPECTRUM_WINDOW_BLACKMAN_HARRIS] = { 0.35875f, 0.48829f, 0.14128f, 0.01168f },
+    [SPECTRUM_WINDOW_FLATTOP]         = { 0.21557895f, 0.41663158f, 0.277263158f, 0.083578947f, 0.006947368f },
+};
+
+static const char *const window_names[SPECTRUM_WINDOW_COUNT] = {
+    "RECT", "HANN", "BLACKMAN-HARRIS", "FLATTOP",
+};
+
+const char *spectrum_window_name(spectrum_window_t window)
+{
+    return (unsigned)window < SPECTRUM_WINDOW_COUNT ? window_names[window] : "?";
+}
+
+// log2(p) Q16 (p > 0)
+static int32_t log2_q16(uint64_t p)
+{
+    int e = 63 - __builtin_clzll(p);
+    // 맨 앞 1 다음 16비트: 위 8비트는 표 칸, 아래 8비트는 보간
+    uint32_t m = (uint32_t)((e >= 16 ? p >> (e - 16) : p << (16 - e)) & 0xFFFF);
+    uint32_t idx = m >> 8, frac = m & 0xFF;
+    uint32_t lo = log2_frac_q16[idx], hi = log2_frac_q16[idx + 1];
+    return e * 65536 + (int32_t)(lo + (((hi - lo) * frac + 128) >> 8));
+}
+
+bool spectrum_init(spectrum_t *s, uint32_t points, spectrum_window_t window)
+{
+    if (points < SPECTRUM_MIN_POINTS || (unsigned)window >= SPECTRUM_WINDOW_COUNT ||
+        !fft_fixed_init(&s->fft, points)) {
+        return false;
+    }
+    if (!log2_ready) {
+        for (int i = 0; i <= 256; i++) {
+            log2_frac_q16[i] = (uint32_t)lrint(log2(1.0 + i / 256.0) * 65536.0);
+        }
+        log2_ready = true;
+    }
+    s->points = points;
+    s->window = window;
+
+    // 창: w[n] = a0 - a1 cos(x) + a2 cos(2x) - a3 cos(3x) + a4 cos(4x), x = 2 pi n / N
+    const float *a = window_coef[window];
+    double sum = 0, sum_sq = 0;
+    for (uint32_t n = 0; n < points; n++) {
+        float x = 2.0f * (float)M_PI * (float)n / (float)points;
+        float w = a[0] - a[1] * cosf(x) + a[2] * cosf(2 * x) - a[3] * cosf(3 * x) + a[4] * cosf(4 * x);
+        float q = w * 32768.0f;
+        s->win_q15[n] = (int16_t)(q >= 32767.0f ? 32767 : q <= -32768.0f ? -32768 : lrintf(q));
+        sum += s->win_q15[n] / 32768.0;
+        sum_sq += (s->win_q15[n] / 32768.0) * (s->win_q15[n] / 32768.0);
+    }
+    s->coherent_gain = (float)(sum / points);
+    s->enbw_bins = (float)(points * sum_sq / (sum * sum));
+
+    // 입력은 (raw - 2048) * w >> 9 이므로 풀스케일 진폭 = 2^17, 빈 중앙 사인의 |X'| = 2^17 * sum(w)
+    s->fs_log2_q16 = (int32_t)lrint(2.0 * (17.0 + log2(sum)) * 65536.0);
+
+    spectrum_reset(s);
+    return true;
+}
+
+void spectrum_reset(spectrum_t *s)
+{
+    s->fill = 0;
+}
+
+uint32_t spectrum_push(spectrum_t *s, const uint16_t *samples, uint32_t count)
+{
+    uint32_t n = s->points - s->fill;
+    n = count < n ? count : n;
+
+    int32_t *dst = s->work + s->fill;
+    const int16_t *w = s->win_q15 + s->fill;
+    for (uint32_t i = 0; i < n; i++) {
+        // 12비트 중앙(2048)을 0으로, |값| < 2^17 (FFT 입력 한도 2^18 안쪽)
+        dst[i] = (((int32_t)(samples[i] & 0x0FFF) - 2048) * w[i]) >> 9;
+    }
+    s->fill += n;
+    return n;
+}
+
+bool spectrum_compute(spectrum_t *s)
+{
+    if (s->fill < s->points) {
+        return false;
+    }
+    fft_fixed_real(&s->fft, s->work);
+
+    uint32_t bins = spectrum_bins(s);
+    for (uint32_t k = 0; k < bins; k++) {
+        int64_t re = s->work[2 * k], im = s->work[2 * k + 1];
+        uint64_t p = (uint64_t)(re * re) + (uint64_t)(im * im);
+        int32_t cdb = SPECTRUM_FLOOR_CDB;
+        if (p != 0) {
+            cdb = (int32_t)(((int64_t)(log2_q16(p) - s->fs_log2_q16) * CDB_PER_LOG2_Q16_Q32) >> 32);
+            cdb = cdb < SPECTRUM_FLOOR_CDB ? SPECTRUM_FLOOR_CDB : cdb > INT16_MAX ? INT16_MAX : cdb;
+        }
+        s->db[k] = (int16_t)cdb;
+    }
+    s->fill = 0;
+    return true;
+}
+
+// 0.01 dB -> 화면 값 (0 dBFS = 4095, -RANGE dB = 0)
+static uint16_t cdb_to_display(int32_t cdb)
+{
+    int32_t v = (cdb + SPECTRUM_DISPLAY_RANGE_DB * 100) * 4095 / (SPECTRUM_DISPLAY_RANGE_DB * 100);
+    return (uint16_t)(v < 0 ? 0 : v > 4095 ? 4095 : v);
+}
+
+uint32_t spectrum_columns(const spectrum_t *s, decim_column_t *cols, uint32_t columns)
+{
+    uint32_t bins = spectrum_bins(s);
+    columns = columns > SPECTRUM_MAX_COLUMNS ? SPECTRUM_MAX_COLUMNS : columns;
+
+    for (uint32_t c = 0; c < columns; c++) {
+        // 빈이 열보다 적으면 같은 빈을 여러 열에 반복
+        uint32_t b0 = c * bins / columns;
+        uint32_t b1 = (c + 1) * bins / columns;
+        b1 = b1 > b0 ? b1 : b0 + 1;
+
+        int16_t lo = s->db[b0], hi = s->db[b0];
+        for (uint32_t b = b0 + 1; b < b1; b++) {
+            lo = s->db[b] < lo ? s->db[b] : lo;
+            hi = s->db[b] > hi ? s->db[b] : hi;
+        }
+        cols[c].min = cdb_to_display(lo);
+        cols[c].max = cdb_to_display(hi);
+    }
+    return columns;
+}
@@ -0,0 +1,76 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft_fixed.h"
+#include "decimate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 스펙트럼 분석 (창 함수 -> 고정소수점 실수 FFT -> dBFS -> 화면 열)
+//
+// 12비트 raw 샘플을 spectrum_push로 points개 채운 뒤 spectrum_compute를 부르면
+// 빈마다 dBFS(0.01 dB 단위)를 db[]에 만들고, spectrum_columns로 화면 열(열마다 min/max)로 줄인다.
+// 0 dBFS = raw 진폭 2048(ADC 풀스케일)의 사인이 빈 중앙에 있을 때의 피크 (창 이득 보정).
+// 창은 points가 바뀔 때만 다시 만든다. 작업 버퍼가 하나라 채널은 차례로 계산한다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define SPECTRUM_MIN_POINTS         256
+#define SPECTRUM_MAX_POINTS         FFT_MAX_POINTS
+#define SPECTRUM_MAX_COLUMNS        DECIM_MAX_COLUMNS
+#define SPECTRUM_FLOOR_CDB          (-14000)    // dB 하한 (0.01 dB 단위)
+#define SPECTRUM_DISPLAY_RANGE_DB   100         // 화면 열: 0 dBFS가 4095, -100 dBFS가 0
+
+typedef enum {
+    SPECTRUM_WINDOW_RECT = 0,
+    SPECTRUM_WINDOW_HANN,
+    SPECTRUM_WINDOW_BLACKMAN_HARRIS,    // 4항, 사이드로브 -92 dB
+    SPECTRUM_WINDOW_FLATTOP,            // 진폭 오차 0.01 dB 이하 (빈 사이 주파수에서도)
+    SPECTRUM_WINDOW_COUNT,
+} spectrum_window_t;
+
+typedef struct {
+    uint32_t points;
+    spectrum_window_t window;
+    float coherent_gain;                        // 창 평균값
+    float enbw_bins;                            // 등가 잡음 대역폭 (빈)
+    int32_t fs_log2_q16;                        // 0 dBFS 전력의 log2 (Q16)
+
+    fft_fixed_t fft;
+    int16_t win_q15[SPECTRUM_MAX_POINTS];
+    uint32_t fill;                              // 채운 샘플 수
+    int32_t work[SPECTRUM_MAX_POINTS + 2];      // 창을 곱한 입력 -> FFT 결과
+    int16_t db[SPECTRUM_MAX_POINTS / 2 + 1];    // 빈별 dBFS (0.01 dB), 빈 k = k * fs / points
+} spectrum_t;
+
+// 설정 적용 후 비움 (points는 2의 거듭제곱 256~4096, 아니면 false)
+bool spectrum_init(spectrum_t *s, uint32_t points, spectrum_window_t window);
+
+// 채우던 샘플 버림
+void spectrum_reset(spectrum_t *s);
+
+// 샘플 추가 (창을 곱해 작업 버퍼에). 받아들인 샘플 수 반환 (가득 차면 나머지는 버림)
+uint32_t spectrum_push(spectrum_t *s, const uint16_t *samples, uint32_t count);
+
+// 가득 찼으면 FFT 후 db[] 갱신하고 비움. 덜 찼으면 false
+bool spectrum_compute(spectrum_t *s);
+
+// db[]를 화면 열로 (열마다 그 열에 들어가는 빈들의 min/max, 값 0~4095). 만든 열 수 반환
+uint32_t spectrum_columns(const spectrum_t *s, decim_column_t *cols, uint32_t columns);
+
+// 빈 개수 (points / 2 + 1)
+static inline uint32_t spectrum_bins(const spectrum_t *s)
+{
+    return s->points / 2 + 1;
+}
+
+const char *spectrum_window_name(spectrum_window_t window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPECTRUM_H
@@ -0,0 +1,265 @@
+#include <string.h>
+#include "stream_frame.h"
+
+// 4비트 단위 CRC 표 (반사형 다항식 0xEDB88320)
+static const uint32_t stream_crc_table[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+};
+
+uint32_t stream_crc32(uint32_t crc, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ stream_crc_table[crc & 0x0F];
+        crc = (crc >> 4) ^ stream_crc_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+static int stream_channel_count(uint8_t mask)
+{
+    return (mask & 1) + ((mask >> 1) & 1);
+}
+
+size_t stream_frame_bytes(uint8_t channel_mask, uint16_t sample_count)
+{
+    return STREAM_HEADER_BYTES + (size_t)stream_channel_count(channel_mask) * sample_count * 2 + STREAM_CRC_BYTES;
+}
+
+// 압축 프레임의 최대 길이 (STREAM_MAX_FRAME_BYTES 이하)
+static size_t stream_packed_max_bytes(uint8_t channel_mask, uint16_t sample_count)
+{
+    return STREAM_HEADER_BYTES + 2 + (size_t)stream_channel_count(channel_mask) * SAMPLE_CODEC_MAX_BYTES(sample_count) +
+           STREAM_CRC_BYTES;
+}
+
+static bool stream_header_valid(uint8_t channel_mask, uint16_t sample_count)
+{
+    return channel_mask != 0 && (channel_mask & ~((1u << STREAM_MAX_CHANNELS) - 1)) == 0 &&
+           sample_count > 0 && sample_count <= STREAM_MAX_SAMPLES;
+}
+
+static inline void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v)
+{
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get_u32(const uint8_t *p)
+{
+    return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+// 프레임 만들기
+size_t stream_encode(const stream_header_t *hdr, const uint16_t *const ch[STREAM_MAX_CHANNELS],
+                     uint8_t *out, size_t cap)
+{
+    if (!stream_header_valid(hdr->channel_mask, hdr->sample_count)) {
+        return 0;
+    }
+    bool packed = (hdr->flags & STREAM_FLAG_PACKED) != 0;
+    size_t total = stream_frame_bytes(hdr->channel_mask, hdr->sample_count);
+    if (cap < (packed ? stream_packed_max_bytes(hdr->channel_mask, hdr->sample_count) : total)) {
+        return 0;
+    }
+
+    out[0] = STREAM_SYNC0;
+    out[1] = STREAM_SYNC1;
+    out[2] = STREAM_VERSION;
+    out[3] = hdr->flags;
+    out[4] = hdr->channel_mask;
+    out[5] = 0;
+    put_u16(out + 6, hdr->gain_state);
+    put_u16(out + 8, hdr->sample_count);
+    put_u32(out + 10, hdr->seq);
+    put_u32(out + 14, hdr->first_sample);
+    put_u32(out + 18, (uint32_t)hdr->timestamp_us);
+    put_u32(out + 22, (uint32_t)(hdr->timestamp_us >> 32));
+    put_u32(out + 26, hdr->sample_rate_hz);
+
+    uint8_t *p = out + STREAM_HEADER_BYTES;
+    if (packed) {
+        // 길이 자리를 비워 두고 채널 블록을 이어 붙임
+        uint8_t *len_at = p;
+        p += 2;
+        for (int c = 0; c < STREAM_MAX_CHANNELS; c++) {
+            if (hdr->channel_mask & (1u << c)) {
+                p += sample_codec_encode(ch[c], hdr->sample_count, p, (size_t)(out + cap - p));
+            }
+        }
+        put_u16(len_at, (uint16_t)(p - len_at - 2));
+        total = (size_t)(p - out) + STREAM_CRC_BYTES;
+    } else {
+        for (int c = 0; c < STREAM_MAX_CHANNELS; c++) {
+            if (!(hdr->channel_mask & (1u << c))) {
+                continue;
+            }
+            for (uint32_t i = 0; i < hdr->sample_count; i++) {
+                put_u16(p, ch[c][i]);
+                p += 2;
+            }
+        }
+    }
+
+    put_u32(p, stream_crc32(0, out + 2, (size_t)(p - out) - 2));
+    return total;
+}
+
+void stream_parser_init(stream_parser_t *p)
+{
+    memset(p, 0, sizeof(*p));
+}
+
+static void stream_parser_drop(stream_parser_t *p, size_t n)
+{
+    memmove(p->buf, p->buf + n, p->fill - n);
+    p->fill -= n;
+}
+
+static bool stream_parser_decode(stream_parser_t *p)
+{
+    const uint8_t *b = p->buf;
+    stream_header_t *h = &p->frame.hdr;
+
+    h->flags = b[3];
+    h->channel_mask = b[4];
+    h->gain_state = get_u16(b + 6);
+    h->sample_count = get_u16(b + 8);
+    h->seq = get_u32(b + 10);
+    h->first_sample = get_u32(b + 14);
+    h->timestamp_us = get_u32(b + 18) | ((uint64_t)get_u32(b + 22) << 32);
+    h->sample_rate_hz = get_u32(b + 26);
+
+    const uint8_t *s = b + STREAM_HEADER_BYTES;
+    if (h->flags & STREAM_FLAG_PACKED) {
+        const uint8_t *end = s + 2 + get_u16(s);
+        s += 2;
+        for (int c = 0; c < STREAM_MAX_CHANNELS; c++) {
+            if (!(h->channel_mask & (1u << c))) {
+                continue;
+            }
+            size_t used = sample_codec_decode(s, (size_t)(end - s), p->frame.samples[c], h->sample_count);
+            if (used == 0) {
+                return false;
+            }
+            s += used;
+        }
+        return s == end;
+    }
+
+    for (int c = 0; c < STREAM_MAX_CHANNELS; c++) {
+        if (!(h->channel_mask & (1u << c))) {
+            continue;
+        }
+        for (uint32_t i = 0; i < h->sample_count; i++) {
+            p->frame.samples[c][i] = get_u16(s);
+            s += 2;
+        }
+    }
+    return true;
+}
+
+// 버퍼에 있는 프레임 처리. 받은 프레임 수 반환
+static uint32_t stream_parser_scan(stream_parser_t *p, stream_frame_cb_t cb, void *ctx)
+{
+    uint32_t frames = 0;
+
+    for (;;) {
+        // sync 찾기 (마지막 바이트가 SYNC0이면 다음 입력을 기다림)
+        size_t i = 0;
+        while (i < p->fill && !(p->buf[i] == STREAM_SYNC0 && (i + 1 == p->fill || p->buf[i + 1] == STREAM_SYNC1))) {
+            i++;
+        }
+        if (i > 0) {
+            p->skipped_bytes += i;
+            stream_parser_drop(p, i);
+        }
+        if (p->fill < STREAM_HEADER_BYTES) {
+            return frames;
+        }
+
+        uint8_t mask = p->buf[4];
+        uint16_t count = get_u16(p->buf + 8);
+        if (p->buf[2] != STREAM_VERSION || !stream_header_valid(mask, count)) {
+            p->bad_headers++;
+            p->skipped_bytes++;
+            stream_parser_drop(p, 1);
+            continue;
+        }
+
+        size_t total = stream_frame_bytes(mask, count);
+        if (p->buf[3] & STREAM_FLAG_PACKED) {
+            // 압축 길이 필드로 프레임 길이 결정
+            if (p->fill < STREAM_HEADER_BYTES + 2) {
+                return frames;
+            }
+            size_t packed = get_u16(p->buf + STREAM_HEADER_BYTES);
+            if (STREAM_HEADER_BYTES + 2 + packed + STREAM_CRC_BYTES > stream_packed_max_bytes(mask, count)) {
+                p->bad_headers++;
+                p->skipped_bytes++;
+                stream_parser_drop(p, 1);
+                continue;
+            }
+            total = STREAM_HEADER_BYTES + 2 + packed + STREAM_CRC_BYTES;
+        }
+        if (p->fill < total) {
+            return frames;
+        }
+
+        size_t body = total - STREAM_CRC_BYTES;
+        if (stream_crc32(0, p->buf + 2, body - 2) != get_u32(p->buf + body)) {
+            // sync가 데이터 중간에 우연히 나온 경우도 여기로 옴 - 한 바이트 뒤부터 다시
+            p->crc_errors++;
+            p->skipped_bytes++;
+            stream_parser_drop(p, 1);
+            continue;
+        }
+
+        bool decoded = stream_parser_decode(p);
+        stream_parser_drop(p, total);
+        if (!decoded) {
+            p->decode_errors++;
+            continue;
+        }
+        p->frames++;
+        frames++;
+        if (cb != NULL) {
+            cb(&p->frame, ctx);
+        }
+    }
+}
+
+// 받은 바이트 넣기
+uint32_t stream_parser_feed(stream_parser_t *p, const uint8_t *data, size_t len,
+                            stream_frame_cb_t cb, void *ctx)
+{
+    uint32_t frames = 0;
+
+    // 버퍼는 최대 프레임 하나 크기. scan 후에는 항상 빈자리가 남는다
+    while (len > 0) {
+        size_t n = sizeof(p->buf) - p->fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(p->buf + p->fill, data, n);
+        p->fill += n;
+        data += n;
+        len -= n;
+        frames += stream_parser_scan(p, cb, ctx);
+    }
+    return frames;
+}
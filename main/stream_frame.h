@@ -0,0 +1,107 @@
+#ifndef STREAM_FRAME_H
+#define STREAM_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "sample_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 샘플 스트리밍 프레임 (UART 바이너리 프로토콜)
+//
+// 프레임 하나 = 헤더 30바이트 + 샘플 + CRC32 4바이트. 정수는 모두 리틀 엔디언.
+//   off size
+//    0   2  sync 0xA5 0x5A
+//    2   1  version (STREAM_VERSION)
+//    3   1  flags (STREAM_FLAG_*)
+//    4   1  channel_mask (bit0 = CH0, bit1 = CH1)
+//    5   1  reserved (0)
+//    6   2  gain_state (채널당 1바이트, STREAM_GAIN_BYTE)
+//    8   2  sample_count (채널당 샘플 수)
+//   10   4  seq (프레임 번호)
+//   14   4  first_sample (첫 샘플의 링 쓰기 시퀀스)
+//   18   8  timestamp_us (첫 샘플 시각, esp_timer 기준)
+//   26   4  sample_rate_hz (채널당)
+//   30  ..  샘플 uint16, 채널 순서대로 한 채널씩 모아서 (CH0 전체, CH1 전체)
+//           STREAM_FLAG_PACKED이면 uint16 압축 길이 + 채널별 sample_codec 블록을 이어 붙인 것
+//  end   4  CRC-32 (IEEE, zlib.crc32와 같음) - version부터 샘플 끝까지
+// 수신측은 sync를 찾아 헤더를 검사하고 CRC가 맞을 때만 받아들인다. 깨진 프레임은
+// sync 다음 바이트부터 다시 찾으므로 중간에 로그 문자열이 끼어도 복구된다.
+// ESP-IDF 의존성이 없으므로 호스트(Linux)에서도 그대로 빌드된다.
+
+#define STREAM_SYNC0            0xA5
+#define STREAM_SYNC1            0x5A
+#define STREAM_VERSION          1
+#define STREAM_MAX_CHANNELS     2
+#define STREAM_MAX_SAMPLES      512     // 프레임당 채널별 최대 샘플 수
+#define STREAM_HEADER_BYTES     30
+#define STREAM_CRC_BYTES        4
+#define STREAM_MAX_FRAME_BYTES  (STREAM_HEADER_BYTES + STREAM_MAX_CHANNELS * STREAM_MAX_SAMPLES * 2 + STREAM_CRC_BYTES)
+
+#define STREAM_FLAG_GAP         0x01    // 이 프레임 앞에서 샘플이 빠졌음 (링 덮어쓰기, ADC 프레임 유실/재시작)
+#define STREAM_FLAG_PACKED      0x02    // 샘플이 sample_codec으로 압축됨
+
+// 압축 프레임도 STREAM_MAX_FRAME_BYTES 안에 들어가야 함 (파서 버퍼)
+_Static_assert(2 + STREAM_MAX_CHANNELS * SAMPLE_CODEC_MAX_BYTES(STREAM_MAX_SAMPLES) <= STREAM_MAX_CHANNELS * STREAM_MAX_SAMPLES * 2,
+               "packed payload must fit in a raw frame");
+
+// gain_state 채널 바이트: bit0 AC/DC, bit1-2 1차 감쇠, bit3-4 2차 감쇠 (interactive gain_state 값)
+#define STREAM_GAIN_BYTE(acdc, primary, secondary) \
+    ((uint8_t)(((acdc) & 1) | (((primary) & 3) << 1) | (((secondary) & 3) << 3)))
+
+typedef struct {
+    uint8_t flags;
+    uint8_t channel_mask;
+    uint16_t gain_state;        // CH0 = 하위 바이트, CH1 = 상위 바이트
+    uint16_t sample_count;
+    uint32_t seq;
+    uint32_t first_sample;
+    uint64_t timestamp_us;
+    uint32_t sample_rate_hz;
+} stream_header_t;
+
+typedef struct {
+    stream_header_t hdr;
+    uint16_t samples[STREAM_MAX_CHANNELS][STREAM_MAX_SAMPLES];  // channel_mask에 없는 채널은 비어 있음
+} stream_frame_t;
+
+typedef void (*stream_frame_cb_t)(const stream_frame_t *frame, void *ctx);
+
+typedef struct {
+    uint8_t buf[STREAM_MAX_FRAME_BYTES];
+    size_t fill;
+    stream_frame_t frame;       // 마지막으로 받은 프레임 (콜백에 넘김)
+
+    uint32_t frames;            // 받은 프레임 수
+    uint32_t crc_errors;        // 헤더는 맞았지만 CRC가 틀린 프레임 수
+    uint32_t bad_headers;       // sync 뒤 헤더가 잘못된 횟수
+    uint32_t decode_errors;     // CRC는 맞았지만 압축을 풀 수 없었던 프레임 수
+    uint32_t skipped_bytes;     // sync를 찾느라 버린 바이트 수
+} stream_parser_t;
+
+// CRC-32 (IEEE 802.3). crc는 처음에 0, 이어서 계산할 때는 이전 반환값
+uint32_t stream_crc32(uint32_t crc, const void *data, size_t len);
+
+// 압축하지 않은 프레임 길이 (바이트). 압축 프레임 길이는 헤더 뒤 길이 필드로 정해진다
+size_t stream_frame_bytes(uint8_t channel_mask, uint16_t sample_count);
+
+// 프레임 만들기. ch[c]는 channel_mask에 켜진 채널의 샘플 배열 (sample_count개)
+// hdr->flags에 STREAM_FLAG_PACKED가 있으면 샘플을 압축해서 넣는다
+// 쓴 바이트 수 반환, 헤더가 잘못됐거나 cap이 모자라면 0
+size_t stream_encode(const stream_header_t *hdr, const uint16_t *const ch[STREAM_MAX_CHANNELS],
+                     uint8_t *out, size_t cap);
+
+void stream_parser_init(stream_parser_t *p);
+
+// 받은 바이트 넣기. 완성된 프레임마다 cb 호출, 이번 호출에서 받은 프레임 수 반환
+uint32_t stream_parser_feed(stream_parser_t *p, const uint8_t *data, size_t len,
+                            stream_frame_cb_t cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // STREAM_FRAME_H
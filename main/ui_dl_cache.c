@@ -0,0 +1,90 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "ft800.h"
+#include "ui_dl_cache.h"
+#include "render_sched.h"
+
+static const char *TAG = "UI_DL";
+
+static uint32_t ui_slot_addr(int slot)
+{
+    return RAM_G_UI_BASE + (uint32_t)slot * RAM_G_UI_SLOT_BYTES;
+}
+
+// 초기화
+void ui_dl_cache_init(ui_dl_cache_t *cache)
+{
+    cache->key = 0;
+    cache->valid = false;
+    cache->slot = 0;
+    cache->size[0] = 0;
+    cache->size[1] = 0;
+}
+
+// 무효화
+void ui_dl_cache_invalidate(ui_dl_cache_t *cache)
+{
+    cache->valid = false;
+}
+
+// 필요하면 다시 만들기
+bool ui_dl_cache_update(ui_dl_cache_t *cache, uint32_t key, ui_dl_build_fn build, void *arg)
+{
+    if (cache->valid && cache->key == key) {
+        return true;
+    }
+
+    // 지금 쓰는 슬롯은 그대로 두고 반대쪽에 만든다
+    int next = cache->slot ^ 1;
+
+    // 코프로세서로 RAM_DL에 그린 뒤 통째로 RAM_G에 복사.
+    // 앞 프레임 명령 뒤에 줄을 서므로 화면에 나가는 DL과 겹치지 않는다
+    cmd(CMD_DLSTART);
+    cmd(SAVE_CONTEXT());
+    build(arg);
+    cmd(RESTORE_CONTEXT());
+    cmd(CMD_MEMCPY);
+    cmd(ui_slot_addr(next));
+    cmd(RAM_DL);
+    cmd(RAM_G_UI_SLOT_BYTES);
+
+    // 크기(REG_CMD_DL)는 코프로세서가 다 처리한 뒤에만 알 수 있음
+    int64_t start = esp_timer_get_time();
+    while (!cmd_ready()) {
+        if (esp_timer_get_time() - start > FT800_CMD_TIMEOUT_US) {
+            ESP_LOGW(TAG, "Co-processor busy, drawing UI without cache");
+            cache->key = key;
+            cache->valid = false;
+            return false;
+        }
+        // FIFO가 비면 INT_CMDEMPTY로 깨어남
+        render_sched_wait(INT_CMDEMPTY, 1);
+    }
+
+    uint32_t size = HOST_MEM_RD32(REG_CMD_DL);
+    // 이번 키로는 다시 시도하지 않음 (실패하면 키가 바뀔 때까지 직접 그리기)
+    cache->key = key;
+    if (size == 0 || size > RAM_G_UI_SLOT_BYTES) {
+        ESP_LOGW(TAG, "Invalid cached DL size: %lu", (unsigned long)size);
+        cache->valid = false;
+        return false;
+    }
+
+    cache->size[next] = size;
+    cache->slot = next;
+    cache->valid = true;
+    ESP_LOGD(TAG, "UI cache rebuilt: key=0x%08lx, %lu bytes", (unsigned long)key, (unsigned long)size);
+    return true;
+}
+
+// 캐시 붙이기
+bool ui_dl_cache_append(const ui_dl_cache_t *cache)
+{
+    if (!cache->valid) {
+        return false;
+    }
+    cmd(CMD_APPEND);
+    cmd(ui_slot_addr(cache->slot));
+    cmd(cache->size[cache->slot]);
+    return true;
+}
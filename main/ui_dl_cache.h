@@ -0,0 +1,44 @@
+#ifndef UI_DL_CACHE_H
+#define UI_DL_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 정적 UI 디스플레이 리스트 캐시 (RAM_G + CMD_APPEND)
+//
+// 테두리, 눈금, 메뉴 글씨처럼 UI 상태가 바뀔 때만 달라지는 부분을 한 번 코프로세서로
+// 그려 RAM_DL에 만들고, CMD_MEMCPY로 RAM_G에 복사해 둔다. 이후 프레임에서는
+// CMD_APPEND 3워드로 그대로 붙인다. 키(UI 상태)가 바뀌면 반대쪽 슬롯에 새로 만들고
+// 다 만들어진 뒤에야 슬롯을 바꾸므로, 만드는 도중에 이전 내용이 깨지지 않는다.
+
+// 캐시 내용을 그리는 함수 (cmd()/cmd_text() 등으로 DL 명령만 넣을 것)
+typedef void (*ui_dl_build_fn)(void *arg);
+
+typedef struct {
+    uint32_t key;       // 현재 슬롯을 만든 UI 상태
+    bool valid;         // key에 해당하는 캐시가 있음
+    int slot;           // APPEND할 슬롯 (0/1)
+    uint32_t size[2];   // 슬롯별 DL 바이트 수
+} ui_dl_cache_t;
+
+void ui_dl_cache_init(ui_dl_cache_t *cache);
+
+// 다음 update에서 무조건 다시 만들게 함 (FT800 재초기화 후 등)
+void ui_dl_cache_invalidate(ui_dl_cache_t *cache);
+
+// 프레임의 CMD_DLSTART 전에 호출. 키가 바뀌었으면 build로 다시 만든다
+// (코프로세서가 끝날 때까지 기다림). 캐시를 쓸 수 있으면 true
+bool ui_dl_cache_update(ui_dl_cache_t *cache, uint32_t key, ui_dl_build_fn build, void *arg);
+
+// 프레임 안에서 캐시를 CMD_APPEND. 캐시가 없으면 false (직접 그릴 것)
+bool ui_dl_cache_append(const ui_dl_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UI_DL_CACHE_H
@@ -0,0 +1,94 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "ft800.h"
+#include "waveform_render.h"
+
+static const char *TAG = "WAVE";
+
+// 스니펫 워드 수: COLOR_RGB + BEGIN + 열당 VERTEX2F 2개 + END
+#define WAVE_DL_WORDS       (3 + DECIM_MAX_COLUMNS * 2)
+#define WAVE_WAIT_US        50000   // 코프로세서가 슬롯을 놓아줄 때까지 최대 대기
+
+_Static_assert(WAVE_DL_WORDS * 4 <= RAM_G_WAVE_SLOT_BYTES, "wave slot too small");
+
+// 스니펫 작성 버퍼 (DMA로 바로 전송)
+static DMA_ATTR uint32_t wave_dl[WAVE_DL_WORDS];
+
+static int wave_slot = 0;                   // 이번 프레임 슬롯 (0/1)
+static uint32_t wave_slot_done[2];          // 슬롯을 마지막으로 쓴 프레임의 명령 끝 위치
+static bool wave_slot_used[2];
+
+static uint32_t wave_slot_addr(int trace, int slot)
+{
+    return RAM_G_WAVE_BASE + (uint32_t)(trace * 2 + slot) * RAM_G_WAVE_SLOT_BYTES;
+}
+
+// 프레임 시작
+void waveform_begin_frame(void)
+{
+    // 지난 프레임은 CMD_SWAP에서 이미 전송됨 - 그 끝 위치를 슬롯에 기록
+    wave_slot_done[wave_slot] = cmd_flushed_bytes();
+    wave_slot_used[wave_slot] = true;
+    wave_slot ^= 1;
+
+    if (!wave_slot_used[wave_slot]) {
+        return;
+    }
+
+    // 이 슬롯을 쓴 프레임(두 프레임 전)을 코프로세서가 다 처리했는지 확인
+    int64_t start = esp_timer_get_time();
+    while ((int32_t)(cmd_consumed_bytes() - wave_slot_done[wave_slot]) < 0) {
+        if (esp_timer_get_time() - start > WAVE_WAIT_US) {
+            ESP_LOGW(TAG, "Co-processor busy, overwriting wave slot %d", wave_slot);
+            break;
+        }
+        taskYIELD();
+    }
+}
+
+// 트레이스 그리기
+bool waveform_draw(int trace, const decim_column_t *cols, uint32_t count, const wave_area_t *area, uint32_t color)
+{
+    if (trace < 0 || trace >= WAVE_MAX_TRACES || count == 0) {
+        return false;
+    }
+    if (count > DECIM_MAX_COLUMNS) {
+        count = DECIM_MAX_COLUMNS;
+    }
+
+    // 좌표는 1/16 픽셀 단위. 값 v -> y = top + h - v*h/4096
+    const int32_t bottom16 = (area->y + area->height) * 16;
+    const int32_t h = area->height;
+    uint32_t n = 0;
+
+    wave_dl[n++] = color;
+    wave_dl[n++] = BEGIN(LINE_STRIP);
+    // 짝수 열은 min->max, 홀수 열은 max->min 순서로 이어서 열마다 세로선이 되게 함
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t x16 = (area->x + (int32_t)i) * 16;
+        int32_t y_min = bottom16 - ((int32_t)cols[i].min * h * 16) / 4096;
+        int32_t y_max = bottom16 - ((int32_t)cols[i].max * h * 16) / 4096;
+        if (i & 1) {
+            wave_dl[n++] = VERTEX2F(x16, y_max);
+            wave_dl[n++] = VERTEX2F(x16, y_min);
+        } else {
+            wave_dl[n++] = VERTEX2F(x16, y_min);
+            wave_dl[n++] = VERTEX2F(x16, y_max);
+        }
+    }
+    wave_dl[n++] = END();
+
+    // RAM_G에 한 번에 올리고 DL에는 CMD_APPEND만
+    uint32_t addr = wave_slot_addr(trace, wave_slot);
+    if (ft800_write_block(get_driver_dev(), addr, wave_dl, n * 4) != ESP_OK) {
+        return false;
+    }
+    cmd(CMD_APPEND);
+    cmd(addr);
+    cmd(n * 4);
+    return true;
+}
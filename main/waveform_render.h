@@ -0,0 +1,37 @@
+#ifndef WAVEFORM_RENDER_H
+#define WAVEFORM_RENDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "decimate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 파형 렌더러 (RAM_G 디스플레이 리스트 스니펫 + CMD_APPEND)
+//
+// 트레이스 하나의 LINE_STRIP 디스플레이 리스트를 호스트에서 만들어 RAM_G에 한 번의
+// 블록 전송으로 올리고, 명령 FIFO에는 CMD_APPEND 3워드만 넣는다.
+// 점 개수와 상관없이 코프로세서 명령과 SPI 트랜잭션 수가 일정하다.
+// 슬롯은 프레임마다 번갈아 쓰며, 코프로세서가 아직 이전 내용을 APPEND 중이면 기다린다.
+
+#define WAVE_MAX_TRACES     2
+
+typedef struct {
+    int x;              // 첫 열의 화면 x (픽셀)
+    int y;              // 그래프 위쪽 y (픽셀)
+    int height;         // 그래프 높이 (픽셀, 값 4096이 맨 위)
+} wave_area_t;
+
+// 프레임 시작 (draw_ui의 CMD_DLSTART 직후). 이번 프레임에 쓸 슬롯을 고른다
+void waveform_begin_frame(void);
+
+// 트레이스 그리기 (열마다 min/max 세로선). 실패하면 false
+bool waveform_draw(int trace, const decim_column_t *cols, uint32_t count, const wave_area_t *area, uint32_t color);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WAVEFORM_RENDER_H